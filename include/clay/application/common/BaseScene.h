@@ -5,7 +5,9 @@
 #include "clay/application/common/IInputHandler.h"
 #include "clay/application/common/Resources.h"
 #include "clay/entity/Entity.h"
+#include "clay/entity/TransformHierarchy.h"
 #include "clay/graphics/common/Camera.h"
+#include "clay/graphics/common/OcclusionCuller.h"
 #include "clay/graphics/common/Renderer.h"
 
 namespace clay {
@@ -76,6 +78,9 @@ public:
     /** @brief Get this scene's resources */
     Resources& getResources();
 
+    /** @brief Get the parent/child transforms of this scene's Entities */
+    TransformHierarchy& getTransformHierarchy();
+
     /**
      * On keyboard key press handler
      * @param code key code for pressed key
@@ -109,10 +114,38 @@ public:
     virtual void onMouseWheel(const IInputHandler::MouseEvent& mouseEvent);
 
 protected:
+    /**
+     * @brief Collect the entities whose bounds are inside the frustum. Call before rendering so culled
+     * entities cost no GL work
+     *
+     * @param entities Entities to test
+     * @param frustum View frustum, such as Renderer::getFrustum
+     * @param outVisible Set to the entities that are at least partially visible
+     * @param workerPool Threads to split the plane tests of large entity counts across, null to cull on the
+     * calling thread
+     */
+    void cullEntities(const std::vector<Entity*>& entities, const Frustum& frustum, std::vector<Entity*>& outVisible, utils::WorkerPool* workerPool = nullptr);
+
+    /**
+     * @brief Collect the entities inside the frustum that are not hidden behind occluder entities. The
+     * Models of visible occluders are rasterized into the occlusion culler, then the bounds of the other
+     * entities are tested against it. The culler's stats hold the tested and culled counts
+     *
+     * @param entities Entities to test
+     * @param renderer Renderer with the current camera
+     * @param occlusionCuller Culler to rasterize the occluders with
+     * @param outVisible Set to the entities that may be visible
+     * @param workerPool Threads to split the frustum tests and the occluder tiles across, null to cull on
+     * the calling thread
+     */
+    void cullEntities(const std::vector<Entity*>& entities, const Renderer& renderer, OcclusionCuller& occlusionCuller, std::vector<Entity*>& outVisible, utils::WorkerPool* workerPool = nullptr);
+
     /** Parent app handling this Scene*/
     IApp& mApp_;
     /** Resource for this Scene */
     Resources mResources_;
+    /** Transform hierarchy of the Entities in this Scene. Must outlive the Entities */
+    TransformHierarchy mTransformHierarchy_;
     /** Camera for this scene */
     std::unique_ptr<Camera> mpSceneCamera_;
     /** The current focused camera the scene is rendered through */
@@ -123,6 +156,10 @@ protected:
     bool mIsRemove_ = false;
     /** If this scene is currently updating */
     bool mIsRunning_ = true;
+    /** World bounds of the entities being culled */
+    std::vector<BoundingSphere> mCullSpheres_;
+    /** Visibility of the entities being culled */
+    std::vector<uint8_t> mCullVisible_;
 };
 
 } // namespace clay
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+// standard lib
+#include <cstdint>
+
+namespace clay {
+
+/**
+ * @brief Typed reference to a resource in a Resources container. Packs the slot index of the resource
+ * with the generation of the slot, which changes when the resource is released, so a handle to a
+ * released resource resolves to nullptr instead of dangling.
+ *
+ * Resolve a handle from the resource name once when loading, then look the resource up by handle.
+ *
+ * @tparam T Type of resource
+ */
+template<typename T>
+class ResourceHandle {
+public:
+    /** Bits of the slot index. The remaining bits hold the generation */
+    static constexpr uint32_t INDEX_BITS = 20;
+    /** Largest number of slots per resource type */
+    static constexpr uint32_t MAX_INDEX = (1u << INDEX_BITS) - 1;
+    /** Generations wrap at this value. Generation 0 is never used, so a default handle is invalid */
+    static constexpr uint32_t MAX_GENERATION = (1u << (32 - INDEX_BITS)) - 1;
+
+    /** Constructor for an invalid handle */
+    ResourceHandle() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param index Slot index
+     * @param generation Generation of the slot
+     */
+    ResourceHandle(uint32_t index, uint32_t generation)
+        : mValue_((generation << INDEX_BITS) | (index & MAX_INDEX)) {}
+
+    /** Get the slot index */
+    uint32_t getIndex() const {
+        return mValue_ & MAX_INDEX;
+    }
+
+    /** Get the generation of the slot the handle was created with */
+    uint32_t getGeneration() const {
+        return mValue_ >> INDEX_BITS;
+    }
+
+    /** If the handle was returned for a resource. It may still be stale */
+    bool isValid() const {
+        return getGeneration() != 0;
+    }
+
+    bool operator==(const ResourceHandle& other) const {
+        return mValue_ == other.mValue_;
+    }
+
+    bool operator!=(const ResourceHandle& other) const {
+        return mValue_ != other.mValue_;
+    }
+
+private:
+    /** Generation in the high bits, index in the low bits */
+    uint32_t mValue_ = 0;
+};
+
+} // namespace clay
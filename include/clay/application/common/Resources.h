@@ -1,11 +1,19 @@
 #pragma once
 // standard lib
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 // project
+#include "clay/application/common/ResourceHandle.h"
 #include "clay/audio/Audio.h"
 #include "clay/graphics/common/Font.h"
 #include "clay/graphics/common/Mesh.h"
@@ -20,26 +28,75 @@ namespace clay {
 
 class Resources {
 public:
+    /** Progress of a resource loaded with loadResourceAsync */
+    class LoadHandle {
+    public:
+        enum class Status : uint8_t {
+            LOADING,
+            READY,
+            FAILED
+        };
+
+        /** Get the status of the load. A default constructed handle has failed */
+        Status getStatus() const;
+
+        /** If the resource is ready or failed to load */
+        bool isDone() const;
+
+        /** Get the name the resource is saved as */
+        const std::string& getName() const;
+
+        /** Get the reason the load failed */
+        const std::string& getError() const;
+
+    private:
+        friend class Resources;
+
+        /** Shared between the handles and the load */
+        struct State {
+            std::string name;
+            /** Set before the status becomes FAILED */
+            std::string error;
+            std::atomic<Status> status{Status::LOADING};
+        };
+
+        std::shared_ptr<State> mState_;
+    };
+
+    /** Handles of a group of loads, such as the asset list of a scene, polled together */
+    class LoadBatch {
+    public:
+        /**
+         * @brief Add a load to the batch
+         *
+         * @param handle Handle returned by loadResourceAsync
+         */
+        void add(LoadHandle handle);
+
+        /** If every load in the batch is ready or failed */
+        bool isDone() const;
+
+        /** Get the fraction of the loads that are done, 1 for an empty batch */
+        float getProgress() const;
+
+        /** Get the number of loads that failed */
+        size_t getFailedCount() const;
+
+        /** Get the handles of the batch */
+        const std::vector<LoadHandle>& getHandles() const;
+
+    private:
+        std::vector<LoadHandle> mHandles_;
+    };
+
+    /** Most threads decoding asynchronous loads */
+    static constexpr unsigned int MAX_LOADER_COUNT = 4;
+
     static std::function<utils::FileData(const std::string&)> loadFileToMemory;
 
     /** Path to resource folder */
     static std::filesystem::path RESOURCE_PATH;
 
-    /** Loaded/Built Mesh resources */
-    std::unordered_map<std::string, std::unique_ptr<Mesh>> mMeshes_;
-    /** Loaded/Built Model resources */
-    std::unordered_map<std::string, std::unique_ptr<Model>> mModels_;
-    /** Loaded/Built Model textures */
-    std::unordered_map<std::string, std::unique_ptr<Texture>> mTextures_;
-    /** Loaded/Built Shader resources */
-    std::unordered_map<std::string, std::unique_ptr<ShaderProgram>> mShaders_;
-    /** Loaded/Built Audio resources */
-    std::unordered_map<std::string, std::unique_ptr<Audio>> mAudios_;
-    /** Loaded/Built Fonts resources */
-    std::unordered_map<std::string, std::unique_ptr<Font>> mFonts_;
-    /** Loaded Sprite Sheets */
-    std::unordered_map<std::string, std::unique_ptr<SpriteSheet>> mSpriteSheets;
-
     IGraphicsAPI* mGraphicsAPI_;
 
     /** Constructor default */
@@ -54,19 +111,55 @@ public:
      * @tparam T Type of resource
      * @param resourcePaths Paths to load the resource from
      * @param resourceName Name to save the resource as for retrieval
+     * @return Handle of the resource, invalid if the type is not loaded from files
      */
     template<typename T>
-    void loadResource(const std::vector<std::filesystem::path>& resourcePaths, const std::string& resourceName);
+    ResourceHandle<T> loadResource(const std::vector<std::filesystem::path>& resourcePaths, const std::string& resourceName);
+
+    /**
+     * @brief Start loading a resource. The files are read and decoded on loader threads and the GPU
+     * objects are created by update, so the resource is only available after an update. Supports
+     * Mesh, Model, Texture, Audio and Font
+     *
+     * @tparam T Type of resource
+     * @param resourcePaths Paths to load the resource from, as for loadResource
+     * @param resourceName Name to save the resource as for retrieval
+     * @return Handle to poll the load with
+     */
+    template<typename T>
+    LoadHandle loadResourceAsync(const std::vector<std::filesystem::path>& resourcePaths, const std::string& resourceName);
+
+    /** Create the resources of the decoded asynchronous loads. Call once per frame on the thread owning the graphics context */
+    void update();
+
+    /** Block until every asynchronous load is ready or failed */
+    void finishLoading();
+
+    /** If asynchronous loads are waiting to be decoded or created */
+    bool isLoading() const;
 
     /**
      * Add a resource and transfer ownership to this resource container. Generally std::move should be used here
      *
      * @tparam T Type of resource
      * @param resource Resource rvalue reference
-     * @param resourceName Name to save the resource as for retrieval
+     * @param resourceName Name to save the resource as for retrieval. Replaces the resource of the same
+     * name, making its handles stale
+     * @return Handle of the resource
+     */
+    template<typename T>
+    ResourceHandle<T> addResource(std::unique_ptr<T> resource, const std::string& resourceName);
+
+    /**
+     * @brief Get the handle of a resource by name. Resolve handles once, such as after loading, and look
+     * the resource up by handle after that
+     *
+     * @tparam T Type of resource
+     * @param resourceName Name of the resource
+     * @return Invalid handle if there is no resource of that name
      */
     template<typename T>
-    void addResource(std::unique_ptr<T> resource, const std::string& resourceName);
+    ResourceHandle<T> getHandle(const std::string& resourceName) const;
 
     /**
      * @brief Get a pointer to the loaded resource
@@ -77,6 +170,16 @@ public:
     template<typename T>
     T* getResource(const std::string& resourceName);
 
+    /**
+     * @brief Get a pointer to the resource of a handle
+     *
+     * @tparam T Type of resource
+     * @param handle Handle of the resource
+     * @return nullptr if the resource was released
+     */
+    template<typename T>
+    T* getResource(ResourceHandle<T> handle);
+
     /**
      * Release the resource if it is owned in this resource container
      *
@@ -86,10 +189,126 @@ public:
     template<typename T>
     void release(const std::string& resourceName);
 
+    /**
+     * @brief Release the resource of a handle. Its handles become stale
+     *
+     * @tparam T Type of resource
+     * @param handle Handle of the resource
+     */
+    template<typename T>
+    void release(ResourceHandle<T> handle);
+
     /**
      * Release all the resources in this container. (This not need to be called
      * when deleting a Resource Object since the destructor will manage that itself)
      */
     void releaseAll();
+
+private:
+    /** Resources of one type in slots indexed by their handles */
+    template<typename T>
+    struct Pool {
+        struct Slot {
+            std::unique_ptr<T> resource;
+            /** Generation of the handles to the current resource. Bumped on release */
+            uint32_t generation = 1;
+            /** Name of the current resource */
+            std::string name;
+        };
+
+        /**
+         * @brief Store a resource in a free slot, releasing the resource of the same name
+         *
+         * @param resource Resource to own
+         * @param name Name of the resource
+         */
+        ResourceHandle<T> add(std::unique_ptr<T> resource, const std::string& name);
+
+        /** Get the resource of a handle, nullptr if it is stale */
+        T* get(ResourceHandle<T> handle) const;
+
+        /** Get the handle of a named resource, invalid if there is none */
+        ResourceHandle<T> find(const std::string& name) const;
+
+        /** Release the resource of a slot and free the slot */
+        void releaseSlot(uint32_t index);
+
+        /** Release every resource. The generations are kept so existing handles stay stale */
+        void clear();
+
+        std::vector<Slot> slots;
+        /** Indices of the empty slots */
+        std::vector<uint32_t> freeSlots;
+        /** Slot index of each named resource, only used to resolve handles */
+        std::unordered_map<std::string, uint32_t> names;
+    };
+
+    /** Get the pool of a resource type */
+    template<typename T>
+    Pool<T>& getPool();
+
+    /** Get the pool of a resource type */
+    template<typename T>
+    const Pool<T>& getPool() const;
+
+    /** Loaded/Built Mesh resources */
+    Pool<Mesh> mMeshes_;
+    /** Loaded/Built Model resources */
+    Pool<Model> mModels_;
+    /** Loaded/Built Model textures */
+    Pool<Texture> mTextures_;
+    /** Loaded/Built Shader resources */
+    Pool<ShaderProgram> mShaders_;
+    /** Loaded/Built Audio resources */
+    Pool<Audio> mAudios_;
+    /** Loaded/Built Fonts resources */
+    Pool<Font> mFonts_;
+    /** Loaded Sprite Sheets */
+    Pool<SpriteSheet> mSpriteSheets_;
+
+    /** Load started by loadResourceAsync */
+    struct AsyncLoad {
+        std::shared_ptr<LoadHandle::State> state;
+        /** Reads and decodes the files, called on a loader thread */
+        std::function<void()> decode;
+        /** Creates the resource from the decoded data, called by update */
+        std::function<void()> create;
+        /** Set if decode threw */
+        bool failed = false;
+    };
+
+    /**
+     * @brief Queue a load for the loader threads, starting them on first use
+     *
+     * @param load Load to decode
+     */
+    void enqueue(std::shared_ptr<AsyncLoad> load);
+
+    /** Take queued loads and decode them until stopped */
+    void loaderLoop();
+
+    /**
+     * @brief Create the resource of a decoded load and update its status
+     *
+     * @param load Decoded load
+     */
+    void finishLoad(AsyncLoad& load);
+
+    /** Loads waiting for a loader thread */
+    std::deque<std::shared_ptr<AsyncLoad>> mLoadQueue_;
+    /** Loads decoded and waiting for update */
+    std::vector<std::shared_ptr<AsyncLoad>> mDecodedLoads_;
+    /** Loads started and not finished, only used on the thread calling update */
+    size_t mPendingLoadCount_ = 0;
+    /** Guards mLoadQueue_, mDecodedLoads_ and mStopping_ */
+    std::mutex mLoadMutex_;
+    /** Wakes loaders when loads are queued or on shutdown */
+    std::condition_variable mLoadCondition_;
+    /** Wakes finishLoading when a load is decoded */
+    std::condition_variable mDecodedCondition_;
+    /** Set on destruction to end the loaders */
+    bool mStopping_ = false;
+    /** Loader threads, started by the first asynchronous load */
+    std::vector<std::thread> mLoaders_;
 };
 } // namespace clay
\ No newline at end of file
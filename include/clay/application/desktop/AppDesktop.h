@@ -12,6 +12,7 @@
 #include "clay/application/common/BaseScene.h"
 #include "clay/audio/AudioManager.h"
 #include "clay/graphics/common/Renderer.h"
+#include "clay/graphics/common/TextureStreamer.h"
 #include "clay/gui/desktop/WindowDesktop.h"
 #include "clay/gui/common/IWindow.h"
 #include "clay/application/common/IApp.h"
@@ -72,6 +73,9 @@ public:
     /** Get the Renderer for this App */
     Renderer& getRenderer();
 
+    /** Get the streamer that loads textures in the background */
+    TextureStreamer& getTextureStreamer();
+
     // TODO USE THIS IN SCENES TO PASS TO RESOURCES
     IGraphicsAPI* getGraphicsAPI();
 
@@ -97,6 +101,8 @@ private:
     Resources mResources_;
 
     IGraphicsAPI* mGraphicsAPI_ = nullptr;
+    /** Loads textures in the background, uploaded during update */
+    std::unique_ptr<TextureStreamer> mpTextureStreamer_;
 };
 } // namespace clay
 
@@ -1,6 +1,7 @@
 #pragma once
 // standard lib
 #include <filesystem>
+#include <vector>
 // third party
 // project
 #include "clay/utils/common/Utils.h"
@@ -9,8 +10,32 @@ namespace clay {
 
 class Audio {
 public:
+    /** 16 bit samples decoded from an audio file, before they are buffered */
+    struct Samples {
+        /** Interleaved samples */
+        std::vector<short> data;
+        /** AL buffer format */
+        int format;
+        /** Samples per second */
+        int sampleRate;
+    };
+
     Audio(utils::FileData& fileData);
 
+    /**
+     * @brief Create the AL buffer from samples decoded by decode
+     *
+     * @param samples Decoded samples
+     */
+    Audio(Samples&& samples);
+
+    /**
+     * @brief Decode a whole audio file. Safe to call from worker threads
+     *
+     * @param fileData Audio file contents
+     */
+    static Samples decode(utils::FileData& fileData);
+
     /** @brief Destructor */
     ~Audio();
 
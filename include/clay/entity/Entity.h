@@ -1,5 +1,6 @@
 #pragma once
 // standard lib
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 // third party
@@ -13,6 +14,7 @@
 #include "clay/entity/render/ModelRenderable.h"
 #include "clay/entity/render/SpriteRenderable.h"
 #include "clay/entity/render/TextRenderable.h"
+#include "clay/entity/TransformHierarchy.h"
 
 namespace clay {
 
@@ -51,6 +53,57 @@ public:
     /** Get the velocity of this Entity*/
     glm::vec3 getVelocity() const;
 
+    /**
+     * @brief Get the transform of this Entity relative to its parent. Composed only when the transform
+     * changed since the last call
+     */
+    const glm::mat4& getModelMatrix() const;
+
+    /** Get the world transform of this Entity, including the transforms of its parents */
+    const glm::mat4& getWorldMatrix() const;
+
+    /**
+     * @brief Set the parent of this Entity. The position, rotation and scale become relative to the parent.
+     * Both Entities must be in the same scene
+     *
+     * @param parent New parent, or nullptr to make this Entity a root
+     */
+    void setParent(const Entity* parent);
+
+    /** Get the parent of this Entity. nullptr if it is a root */
+    const Entity* getParent() const;
+
+    /**
+     * @brief Get a counter that is incremented on each change of this Entity's own transform. Equal values
+     * mean the same local transform
+     */
+    uint32_t getTransformGeneration() const;
+
+    /**
+     * @brief Get the world space sphere enclosing the bounds of all enabled renderables. The sphere is
+     * invalid if any enabled renderable has no bounds, so the Entity is never culled
+     */
+    BoundingSphere getWorldBoundingSphere() const;
+
+    /**
+     * @brief Get the world space box enclosing the bounds of all enabled renderables
+     *
+     * @param outBounds Set to the box if every enabled renderable has bounds
+     * @return false if any enabled renderable has no bounds, so the Entity is never culled
+     */
+    bool getWorldBounds(AABB& outBounds) const;
+
+    /**
+     * @brief Set if the Models of this Entity hide the Entities behind them during occlusion culling. Meant
+     * for large static geometry such as walls and terrain
+     *
+     * @param occluder If this Entity is an occluder
+     */
+    void setOccluder(bool occluder);
+
+    /** If this Entity is an occluder */
+    bool isOccluder() const;
+
     /**
      * @brief Render the highlight of this Entity
      *
@@ -150,6 +203,9 @@ public:
     std::vector<T*> getPhysicsComponents();
 
 protected:
+    /** Invalidate the cached model matrix. Call after writing mPosition_, mRotation_ or mScale_ directly */
+    void markTransformDirty();
+
     /** Scene this Entity is in*/
     BaseScene& mScene_;
     /** Collider TODO fix this*/
@@ -162,6 +218,16 @@ protected:
     glm::vec3 mScale_ = { 1.0f, 1.0f, 1.0f };
     /** Velocity*/
     glm::vec3 mVelocity_ = {0.0f, 0.0f, 0.0f};
+    /** Cached composed transform */
+    mutable glm::mat4 mModelMatrix_ = glm::mat4(1.0f);
+    /** If mModelMatrix_ needs to be composed again */
+    mutable bool mModelMatrixDirty_ = true;
+    /** Incremented on each transform change */
+    uint32_t mTransformGeneration_ = 0;
+    /** If this Entity is rasterized as an occluder */
+    bool mIsOccluder_ = false;
+    /** Node of this Entity in the scene's transform hierarchy */
+    TransformHierarchy::NodeId mTransformNode_;
     /** List of all rendering components attached to this Entity */
     std::vector<std::unique_ptr<BaseRenderable>> mRenderableComponents_;
     /** Physics components attached to this Entity*/
@@ -0,0 +1,122 @@
+#pragma once
+// standard lib
+#include <cstdint>
+#include <limits>
+#include <vector>
+// third party
+#include <glm/glm.hpp>
+
+namespace clay {
+
+class Entity;
+
+/**
+ * @brief Parent/child links and world matrices of the Entities of a scene.
+ *
+ * Nodes are stored in flat arrays ordered by depth so every parent comes before its children. World
+ * matrices are propagated in one linear pass that only recomposes nodes whose local transform changed
+ * and the descendants of those nodes.
+ */
+class TransformHierarchy {
+public:
+    /** Id of a node. Stays the same while the node exists, unlike its position in the arrays */
+    using NodeId = uint32_t;
+
+    /** Id for no node */
+    static constexpr NodeId INVALID_NODE = std::numeric_limits<NodeId>::max();
+
+    /** Constructor */
+    TransformHierarchy();
+
+    /** Destructor */
+    ~TransformHierarchy();
+
+    /**
+     * @brief Add a root node for the Entity
+     *
+     * @param entity Entity whose model matrix is the local transform of the node
+     * @return Id of the new node
+     */
+    NodeId addNode(const Entity* entity);
+
+    /**
+     * @brief Remove a node. Its children become root nodes
+     *
+     * @param node Node to remove
+     */
+    void removeNode(NodeId node);
+
+    /**
+     * @brief Set the parent of a node. Throws if the parent is the node or one of its descendants
+     *
+     * @param node Node to reparent
+     * @param parent New parent, or INVALID_NODE to make the node a root
+     */
+    void setParent(NodeId node, NodeId parent);
+
+    /** Get the parent of a node. INVALID_NODE for root nodes */
+    NodeId getParent(NodeId node) const;
+
+    /** Get the Entity of a node */
+    const Entity* getEntity(NodeId node) const;
+
+    /**
+     * @brief Mark the local transform of a node as changed
+     *
+     * @param node Changed node
+     */
+    void markDirty(NodeId node);
+
+    /**
+     * @brief Get the world matrix of a node. Pending changes are propagated first
+     *
+     * @param node Node to get the matrix of
+     */
+    const glm::mat4& getWorldMatrix(NodeId node) const;
+
+    /** Propagate pending transform changes to the world matrices */
+    void update() const;
+
+    /** Get the number of world matrices recomposed by the last update */
+    size_t getLastUpdateCount() const;
+
+private:
+    /** Position of a node in the arrays */
+    uint32_t getIndex(NodeId node) const;
+
+    /** Depth of a node, counted by walking the parent ids */
+    uint32_t computeDepth(NodeId node) const;
+
+    /** Sort the arrays by depth after a change of parents */
+    void rebuildOrder() const;
+
+    // Arrays indexed by position in depth order
+    /** Entity of each node */
+    mutable std::vector<const Entity*> mEntities_;
+    /** Id of each node */
+    mutable std::vector<NodeId> mIds_;
+    /** Parent id of each node */
+    mutable std::vector<NodeId> mParentIds_;
+    /** Position of the parent of each node, -1 for roots */
+    mutable std::vector<int32_t> mParentIndices_;
+    /** World matrix of each node */
+    mutable std::vector<glm::mat4> mWorldMatrices_;
+    /** If the local transform of each node changed since the last update */
+    mutable std::vector<uint8_t> mDirty_;
+    /** If the world matrix of each node was recomposed in the current update */
+    mutable std::vector<uint8_t> mUpdated_;
+
+    /** Position in the arrays by node id, max value for free ids */
+    mutable std::vector<uint32_t> mIndexById_;
+    /** Ids available for reuse */
+    std::vector<NodeId> mFreeIds_;
+
+    /** If any node is dirty */
+    mutable bool mAnyDirty_ = false;
+    /** If parents changed and the arrays need to be sorted */
+    mutable bool mOrderDirty_ = false;
+    /** Number of world matrices recomposed by the last update */
+    mutable size_t mLastUpdateCount_ = 0;
+};
+
+} // namespace clay
@@ -1,9 +1,12 @@
 #pragma once
+// standard lib
+#include <cstdint>
 // third party
 #include <glm/vec3.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 // project
+#include "clay/graphics/common/BoundingVolume.h"
 #include "clay/graphics/common/Renderer.h"
 
 namespace clay {
@@ -18,6 +21,24 @@ public:
      */
     virtual void render(const Renderer& theRenderer, const glm::mat4& parentModelMat) const = 0;
 
+    /**
+     * @brief Get the bounds of this Renderable in its parent's space. Renderables without bounds are
+     * never culled
+     *
+     * @param outBounds Set to the bounds if this Renderable has them
+     * @return true if this Renderable has bounds
+     */
+    virtual bool getBounds(AABB& outBounds) const;
+
+    /**
+     * @brief Get the transform of this Renderable relative to its parent. Composed only when the transform
+     * changed since the last call
+     */
+    const glm::mat4& getLocalModelMatrix() const;
+
+    /** Get a counter that is incremented on each transform change. Equal values mean the same transform */
+    uint32_t getTransformGeneration() const;
+
     /**
      * Set if this Renderable is enabled
      * @param isEnabled New enabled value
@@ -70,6 +91,9 @@ public:
     void setColor(int newColor);
 
 protected:
+    /** Invalidate the cached model matrix. Call after writing mPosition_, mRotation_ or mScale_ directly */
+    void markTransformDirty();
+
     /** Renderable Position */
     glm::vec3 mPosition_ = {0.0f, 0.0f, 0.0f};
     /** Renderable Rotation */
@@ -80,6 +104,12 @@ protected:
     glm::vec4 mColor_ = {1.0f, 1.0f, 1.0f, 1.0f};
     /** If this Renderable is enabled (should be rendered)*/
     bool mEnabled_ = true;
+    /** Cached composed transform */
+    mutable glm::mat4 mLocalModelMatrix_ = glm::mat4(1.0f);
+    /** If mLocalModelMatrix_ needs to be composed again */
+    mutable bool mLocalModelMatrixDirty_ = true;
+    /** Incremented on each transform change */
+    uint32_t mTransformGeneration_ = 0;
 };
 
 } // namespace clay
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 // standard lib
 #include <unordered_map>
+#include <vector>
 // project
 #include "clay/entity/render/BaseRenderable.h"
 #include "clay/graphics/common/Model.h"
@@ -26,6 +27,17 @@ public:
      */
     void render(const Renderer& theRenderer, const glm::mat4& parentModelMat) const override;
 
+    /**
+     * @brief Get the bounds of the Model in the parent's space
+     *
+     * @param outBounds Set to the bounds if there is a Model with bounds
+     * @return true if there is a Model with bounds
+     */
+    bool getBounds(AABB& outBounds) const override;
+
+    /** Get the level of detail the Model was last rendered at */
+    unsigned int getLod() const;
+
     /** Get the Model for this Renderable */
     const Model* getModel() const;
 
@@ -50,7 +62,15 @@ public:
      * @param textureId texture Id
      * @param uniformName uniform this texture is binded to
      */
-    void setTexture(unsigned int textureUnit, unsigned int textureId, const std::string& uniformName);
+    void setTexture(unsigned int textureUnit, unsigned int textureId, const std::string& uniformName, unsigned int samplerId = 0);
+
+    /**
+     * Set a texture and its sampler when rendering this renderable with the assign Texture unit
+     * @param textureUnit The unit this texture is binded to
+     * @param texture Texture to bind
+     * @param uniformName uniform this texture is binded to
+     */
+    void setTexture(unsigned int textureUnit, const Texture& texture, const std::string& uniformName);
 
     /**
      * Set if wireframes should be rendered
@@ -63,18 +83,57 @@ public:
     void setSubTextureTopLeft(const glm::vec2& pos);
 
 private:
+    /** Texture bound to a texture unit when rendering */
+    struct TextureBinding {
+        /** Texture id */
+        unsigned int textureId;
+        /** Sampler id, 0 to use the texture's own parameters */
+        unsigned int samplerId;
+        /** Sampler uniform name */
+        std::string uniformName;
+        /** Sampler uniform resolved for the current shader */
+        ShaderProgram::Uniform<int> uniform;
+    };
+
+    /**
+     * @brief Select the level of detail from the projected size of the Model
+     *
+     * @param theRenderer Renderer with the current camera
+     * @param modelMat World transform of the Model
+     */
+    void updateLod(const Renderer& theRenderer, const glm::mat4& modelMat) const;
+
+    /** Resolve the uniforms used for rendering for the current shader */
+    void resolveUniforms();
+
+    /** Rebuild the texture list submitted with queued draws from the texture map */
+    void updateQueueTextures();
+
     /**The Model of this Model Renderable */
     const Model* mpModel_ = nullptr;
     /** The Shader used to render this model */
     const ShaderProgram* mpShader_ = nullptr;
-    /** Map of texture ids and the uniform name for the shader*/
-    std::unordered_map<unsigned int, std::pair<unsigned int, std::string>> mTextureByUnit_;
+    /** Map of texture unit to the texture bound to it */
+    std::unordered_map<unsigned int, TextureBinding> mTextureByUnit_;
+    /** Textures of mTextureByUnit_ sorted by unit, referenced by queued draws */
+    std::vector<RenderQueue::TextureBinding> mQueueTextures_;
+    /** Level of detail of the last render, kept to apply hysteresis */
+    mutable unsigned int mLod_ = 0;
     /** If the wire frames are also rendered */
     bool renderWireframe_ = false;
     /** Size of the sub texture rendered on this model */
     glm::vec2 mSubTextureSize = {1.f, 1.f};
     /** Top left corner of the sub texture rendered on this model */
     glm::vec2 mSubTextureTopLeft = {0.f, 0.f};
+
+    /** Pre-resolved uniforms of the current shader */
+    struct {
+        ShaderProgram::Uniform<glm::mat4> model;
+        ShaderProgram::Uniform<glm::vec4> color;
+        ShaderProgram::Uniform<glm::vec2> subImageTopLeft;
+        ShaderProgram::Uniform<glm::vec2> subImageSize;
+        ShaderProgram::Uniform<bool> wireframeMode;
+    } mUniforms_;
 };
 
 } // namespace clay
\ No newline at end of file
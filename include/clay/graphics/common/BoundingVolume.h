@@ -0,0 +1,61 @@
+#pragma once
+// standard lib
+#include <limits>
+// third party
+#include <glm/glm.hpp>
+
+namespace clay {
+
+/** Axis aligned bounding box */
+struct AABB {
+    /** Minimum corner */
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+    /** Maximum corner */
+    glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max());
+
+    /** If the box contains at least one point */
+    bool isValid() const;
+
+    /**
+     * @brief Grow the box to contain the point
+     *
+     * @param point Point to add
+     */
+    void expand(const glm::vec3& point);
+
+    /**
+     * @brief Grow the box to contain another box
+     *
+     * @param other Box to add
+     */
+    void expand(const AABB& other);
+
+    /**
+     * @brief Get the box containing this box after the transform
+     *
+     * @param transform Affine transform to apply
+     */
+    AABB transformed(const glm::mat4& transform) const;
+};
+
+/** Bounding sphere. Laid out as 4 floats so arrays of spheres can be loaded directly into SIMD registers */
+struct BoundingSphere {
+    /** Center of the sphere */
+    glm::vec3 center = {0.0f, 0.0f, 0.0f};
+    /** Radius of the sphere. Negative if the sphere is empty */
+    float radius = -1.0f;
+
+    /** If the sphere contains at least one point */
+    bool isValid() const;
+
+    /**
+     * @brief Get the sphere enclosing the box
+     *
+     * @param box Box to enclose
+     */
+    static BoundingSphere fromAABB(const AABB& box);
+};
+
+static_assert(sizeof(BoundingSphere) == 4 * sizeof(float), "BoundingSphere must be tightly packed");
+
+} // namespace clay
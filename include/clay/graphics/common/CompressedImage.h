@@ -0,0 +1,112 @@
+#pragma once
+// standard lib
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+// project
+#include "clay/graphics/common/IGraphicsAPI.h"
+#include "clay/utils/common/Utils.h"
+
+namespace clay {
+
+/**
+ * @brief Block compressed mip chain loaded from a KTX2 file. Levels are kept compressed so they can be
+ * uploaded as is, or decoded to RGBA8 on the CPU when the driver cannot sample the format.
+ *
+ * Only 2D textures without supercompression are supported. Basis Universal and Zstandard compressed
+ * files must be transcoded offline.
+ */
+class CompressedImage {
+public:
+    /** A mip level in the file */
+    struct Level {
+        /** Byte offset of the level in the file */
+        size_t offset;
+        /** Size of the level in bytes */
+        size_t size;
+        /** Width in texels */
+        unsigned int width;
+        /** Height in texels */
+        unsigned int height;
+    };
+
+    /**
+     * @brief Check if file data starts with the KTX2 identifier
+     *
+     * @param fileData Loaded file
+     */
+    static bool isKtx2(const utils::FileData& fileData);
+
+    /**
+     * @brief Parse a KTX2 file. Throws if the file is invalid or its format is not supported
+     *
+     * @param fileData Loaded file, owned by the image
+     */
+    static CompressedImage parseKtx2(utils::FileData&& fileData);
+
+    /**
+     * @brief Check if a format can be decoded on the CPU
+     *
+     * @param format Compressed format
+     */
+    static bool canDecode(IGraphicsAPI::CompressedFormat format);
+
+    /**
+     * @brief Check if the texels of a format are sRGB encoded
+     *
+     * @param format Compressed format
+     */
+    static bool isSRGB(IGraphicsAPI::CompressedFormat format);
+
+    /**
+     * @brief Get the size in bytes of a 4x4 block of a format
+     *
+     * @param format Compressed format
+     */
+    static size_t getBlockSize(IGraphicsAPI::CompressedFormat format);
+
+    /** Get the compressed format of the levels */
+    IGraphicsAPI::CompressedFormat getFormat() const;
+
+    /** Get the width of the base level in texels */
+    unsigned int getWidth() const;
+
+    /** Get the height of the base level in texels */
+    unsigned int getHeight() const;
+
+    /** Get the mip levels, base level first */
+    const std::vector<Level>& getLevels() const;
+
+    /**
+     * @brief Get the compressed blocks of a level
+     *
+     * @param level Mip level
+     */
+    const unsigned char* getLevelData(size_t level) const;
+
+    /**
+     * @brief Decode a level to RGBA8 texels. Single and two channel formats fill the missing color
+     * channels with 0, as sampling them would. Throws if the format cannot be decoded
+     *
+     * @param level Mip level
+     * @return Tightly packed RGBA8 texels, in the row order of the blocks
+     */
+    std::vector<unsigned char> decodeLevel(size_t level) const;
+
+private:
+    /** Constructor. Use parseKtx2 */
+    CompressedImage() = default;
+
+    /** Loaded file */
+    utils::FileData mFileData_;
+    /** Format of the levels */
+    IGraphicsAPI::CompressedFormat mFormat_ = IGraphicsAPI::CompressedFormat::BC1_RGB;
+    /** Width of the base level */
+    unsigned int mWidth_ = 0;
+    /** Height of the base level */
+    unsigned int mHeight_ = 0;
+    /** Mip levels, base level first */
+    std::vector<Level> mLevels_;
+};
+
+} // namespace clay
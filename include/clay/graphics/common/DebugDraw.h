@@ -0,0 +1,202 @@
+#pragma once
+// standard lib
+#include <array>
+#include <cstdint>
+#include <vector>
+// third party
+#include <glm/glm.hpp>
+// project
+#include "clay/graphics/common/BoundingVolume.h"
+#include "clay/graphics/common/DynamicRingBuffer.h"
+#include "clay/graphics/common/IGraphicsAPI.h"
+#include "clay/graphics/common/ShaderProgram.h"
+
+namespace clay {
+
+/**
+ * @brief Immediate mode debug shapes accumulated on the CPU during the frame and drawn in one draw per
+ * primitive type and layer on flush.
+ *
+ * Lines, rects, circles and boxes are all expanded to colored line segments. Lines with a thickness are
+ * drawn as screen aligned quads, one instance per line.
+ */
+class DebugDraw {
+public:
+    /** Depth handling of a shape */
+    enum class Layer : uint8_t {
+        /** Hidden behind scene geometry */
+        DEPTH_TESTED,
+        /** Drawn on top of everything */
+        OVERLAY
+    };
+
+    /** Number of segments of circles with no segment count given */
+    static constexpr unsigned int DEFAULT_CIRCLE_SEGMENTS = 32;
+
+    /**
+     * @brief Constructor
+     *
+     * @param graphicsAPI Graphics API to draw with
+     * @param streamBuffer Per frame buffer the vertices are written to on flush
+     * @param lineShader Shader for colored line segments
+     * @param thickLineShader Shader for expanding thick line instances to quads
+     */
+    DebugDraw(IGraphicsAPI& graphicsAPI, DynamicRingBuffer& streamBuffer, ShaderProgram& lineShader, ShaderProgram& thickLineShader);
+
+    /** Destructor */
+    ~DebugDraw();
+
+    DebugDraw(const DebugDraw&) = delete;
+    DebugDraw& operator=(const DebugDraw&) = delete;
+
+    /**
+     * @brief Add a line
+     *
+     * @param start Start position
+     * @param end End position
+     * @param color Line color
+     * @param layer Depth handling
+     */
+    void addLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color, Layer layer = Layer::DEPTH_TESTED);
+
+    /**
+     * @brief Add a line with a thickness in pixels
+     *
+     * @param start Start position
+     * @param end End position
+     * @param color Line color
+     * @param thickness Line width in pixels
+     * @param layer Depth handling
+     */
+    void addThickLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color, float thickness, Layer layer = Layer::DEPTH_TESTED);
+
+    /**
+     * @brief Add the outline of the unit rect centered on the origin in the xy plane
+     *
+     * @param modelMat Transform of the rect
+     * @param color Outline color
+     * @param layer Depth handling
+     */
+    void addRect(const glm::mat4& modelMat, const glm::vec4& color, Layer layer = Layer::DEPTH_TESTED);
+
+    /**
+     * @brief Add the outline of an axis aligned rect in the xy plane
+     *
+     * @param center Center of the rect
+     * @param size Width and height
+     * @param color Outline color
+     * @param layer Depth handling
+     */
+    void addRect(const glm::vec3& center, const glm::vec2& size, const glm::vec4& color, Layer layer = Layer::DEPTH_TESTED);
+
+    /**
+     * @brief Add the outline of a circle in the xy plane
+     *
+     * @param center Center of the circle
+     * @param radius Radius of the circle
+     * @param color Outline color
+     * @param segments Number of line segments
+     * @param layer Depth handling
+     */
+    void addCircle(const glm::vec3& center, float radius, const glm::vec4& color, unsigned int segments = DEFAULT_CIRCLE_SEGMENTS, Layer layer = Layer::DEPTH_TESTED);
+
+    /**
+     * @brief Add the edges of a box
+     *
+     * @param box Box to outline
+     * @param color Edge color
+     * @param layer Depth handling
+     */
+    void addAABB(const AABB& box, const glm::vec4& color, Layer layer = Layer::DEPTH_TESTED);
+
+    /**
+     * @brief Draw everything added since the last flush with the current camera and clear it. The depth
+     * test state is restored after the overlay layer
+     *
+     * @param viewportSize Size of the target in pixels, used to size thick lines
+     */
+    void flush(const glm::vec2& viewportSize);
+
+    /** Discard everything added since the last flush */
+    void clear();
+
+    /** If nothing was added since the last flush */
+    bool isEmpty() const;
+
+private:
+    static constexpr size_t LAYER_COUNT = 2;
+
+    /** Line segment vertex */
+    struct Vertex {
+        glm::vec3 position;
+        /** RGBA8 color */
+        uint32_t color;
+    };
+
+    /** Per instance data of a thick line */
+    struct ThickLine {
+        glm::vec3 start;
+        /** RGBA8 color */
+        uint32_t color;
+        glm::vec3 end;
+        /** Width in pixels */
+        float thickness;
+    };
+
+    /**
+     * @brief Pack a color to RGBA8
+     *
+     * @param color Color to pack
+     */
+    static uint32_t packColor(const glm::vec4& color);
+
+    /**
+     * @brief Add a segment of an outline
+     *
+     * @param start Start position
+     * @param end End position
+     * @param color RGBA8 color
+     * @param layer Depth handling
+     */
+    void addSegment(const glm::vec3& start, const glm::vec3& end, uint32_t color, Layer layer);
+
+    /**
+     * @brief Draw the line segments of a layer
+     *
+     * @param vertices Vertices of the segments
+     */
+    void drawLines(const std::vector<Vertex>& vertices);
+
+    /**
+     * @brief Draw the thick lines of a layer
+     *
+     * @param lines Thick line instances
+     * @param viewportSize Size of the target in pixels
+     */
+    void drawThickLines(const std::vector<ThickLine>& lines, const glm::vec2& viewportSize);
+
+    /** Graphics API */
+    IGraphicsAPI& mGraphicsAPI_;
+    /** Buffer vertices and instances are streamed through */
+    DynamicRingBuffer& mStreamBuffer_;
+    /** Shader for line segments */
+    const ShaderProgram& mLineShader_;
+    /** Shader for thick line quads */
+    const ShaderProgram& mThickLineShader_;
+    /** Viewport size uniform of the thick line shader */
+    ShaderProgram::Uniform<glm::vec2> mViewportSizeUniform_;
+    /** VAO of the line segments. Attribute pointers are set per flush */
+    unsigned int mLineVAO_ = 0;
+    /** VAO of the thick line quad and its per instance attributes */
+    unsigned int mThickLineVAO_ = 0;
+    /** Corners of the thick line quad */
+    unsigned int mQuadVBO_ = 0;
+    /** Indices of the thick line quad */
+    unsigned int mQuadEBO_ = 0;
+    /** Line segment vertices per layer */
+    std::array<std::vector<Vertex>, LAYER_COUNT> mLineVertices_;
+    /** Thick lines per layer */
+    std::array<std::vector<ThickLine>, LAYER_COUNT> mThickLines_;
+};
+
+} // namespace clay
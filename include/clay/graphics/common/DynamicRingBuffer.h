@@ -0,0 +1,149 @@
+#pragma once
+// standard lib
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+// project
+#include "clay/graphics/common/IGraphicsAPI.h"
+
+namespace clay {
+
+/**
+ * @brief GPU buffer for data written once per frame (streaming vertices, indices, instance data and
+ * uniforms) that is sub-allocated without waiting on the GPU.
+ *
+ * With buffer storage the buffer is mapped once, persistently, and split into FRAME_COUNT regions. Each
+ * frame writes to the next region after waiting on the fence placed when that region was last used, which
+ * only blocks if the GPU is more than FRAME_COUNT - 1 frames behind. Without buffer storage the buffer
+ * holds one region that is orphaned at the end of each frame and allocations are copied in on flush.
+ */
+class DynamicRingBuffer {
+public:
+    /** Number of frames the CPU can write ahead of the GPU */
+    static constexpr unsigned int FRAME_COUNT = 3;
+    /** Alignment that satisfies the uniform buffer offset alignment of common hardware */
+    static constexpr size_t UNIFORM_ALIGNMENT = 256;
+
+    /** Range of the buffer handed out by allocate */
+    struct Allocation {
+        /** Where to write the data. Valid until the end of the frame */
+        void* data = nullptr;
+        /** Buffer holding the range. Stays alive until the GPU is done with the frame */
+        unsigned int buffer = 0;
+        /** Offset in the buffer, for attribute pointers, draw offsets and bindBufferRange */
+        size_t offset = 0;
+        /** Size in bytes */
+        size_t size = 0;
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param graphicsAPI Graphics API to create the buffer with
+     * @param frameSize Initial bytes available per frame. Grows if a frame needs more. Allocations after
+     * the growth come from a new buffer, the old one is deleted once the GPU is done with the frame
+     */
+    DynamicRingBuffer(IGraphicsAPI& graphicsAPI, size_t frameSize);
+
+    /** Destructor */
+    ~DynamicRingBuffer();
+
+    DynamicRingBuffer(const DynamicRingBuffer&) = delete;
+    DynamicRingBuffer& operator=(const DynamicRingBuffer&) = delete;
+
+    /**
+     * @brief Call once per frame after the last draw reading the buffer. Fences the current frame region
+     * so it is not reused before the GPU is done with it and moves on to the next one. Deletes the buffers
+     * replaced by growth once their fence is signaled
+     */
+    void endFrame();
+
+    /**
+     * @brief Reserve space in the current frame region. Write the data then call flush before the next
+     * allocate, growing the buffer invalidates the data pointer of earlier allocations
+     *
+     * @param size Size in bytes
+     * @param alignment Alignment of the offset. Does not need to be a power of two
+     */
+    Allocation allocate(size_t size, size_t alignment = 16);
+
+    /**
+     * @brief Make the data written to an allocation visible to the GPU. Call before the draw using it
+     *
+     * @param allocation Written allocation
+     */
+    void flush(const Allocation& allocation);
+
+    /**
+     * @brief Allocate, copy and flush in one call
+     *
+     * @param data Data to copy
+     * @param size Size in bytes
+     * @param alignment Alignment of the offset
+     */
+    Allocation upload(const void* data, size_t size, size_t alignment = 16);
+
+    /** Get the buffer id of the latest allocation. Can change when the buffer grows, prefer Allocation::buffer */
+    unsigned int getBuffer() const;
+
+    /** If the buffer is persistently mapped */
+    bool isPersistent() const;
+
+private:
+    /**
+     * @brief Create the buffer
+     *
+     * @param frameSize Bytes per frame region
+     */
+    void create(size_t frameSize);
+
+    /** Replace the storage of the fallback buffer without waiting on draws reading the old one */
+    void orphan();
+
+    /** Delete the buffer and fences */
+    void destroy();
+
+    /**
+     * @brief Unmap and delete a buffer
+     *
+     * @param buffer Buffer id
+     * @param mapped If the buffer is persistently mapped
+     */
+    void deleteBuffer(unsigned int buffer, bool mapped);
+
+    /** Keep the current buffer alive until the GPU is done with this frame, then create a larger one */
+    void grow(size_t frameSize);
+
+    /** Buffer replaced by growth while draws of the frame may still read it */
+    struct RetiredBuffer {
+        unsigned int buffer;
+        /** If the buffer is still persistently mapped */
+        bool mapped;
+        /** Fence placed at the end of the frame the buffer was replaced in */
+        void* fence;
+    };
+
+    /** Graphics API */
+    IGraphicsAPI& mGraphicsAPI_;
+    /** Buffer id */
+    unsigned int mBuffer_ = 0;
+    /** Bytes per frame region */
+    size_t mFrameSize_ = 0;
+    /** If persistent mapping is used */
+    bool mPersistent_ = false;
+    /** Persistently mapped buffer, null for the fallback */
+    uint8_t* mMappedData_ = nullptr;
+    /** CPU copy of the frame region for the fallback */
+    std::vector<uint8_t> mStaging_;
+    /** Current frame region */
+    unsigned int mFrameIndex_ = 0;
+    /** Bytes used in the current frame region */
+    size_t mFrameUsed_ = 0;
+    /** Fence of the last frame that used each region */
+    std::array<void*, FRAME_COUNT> mFences_{};
+    /** Buffers replaced by growth, waiting on their fence to be deleted */
+    std::vector<RetiredBuffer> mRetiredBuffers_;
+};
+
+} // namespace clay
@@ -2,6 +2,7 @@
 // standard lib
 #include <filesystem>
 #include <unordered_map>
+#include <vector>
 // third party
 #include <glm/vec2.hpp>
 // project
@@ -16,8 +17,12 @@ public:
      * Holds texture information for this font's character
      */
     struct Character {
-         // ID handle of the glyph texture
+         // ID handle of the glyph texture (the font atlas)
         unsigned int textureId;
+        // Normalized top left of the glyph in the atlas
+        glm::vec2 uvTopLeft;
+        // Normalized bottom right of the glyph in the atlas
+        glm::vec2 uvBottomRight;
         // Size of glyph
         glm::ivec2 size;
         // Offset from baseline to left/top of glyph
@@ -26,17 +31,44 @@ public:
         unsigned int advance;
     };
 
+    /** Glyphs rasterized and packed into an atlas image before it is uploaded */
+    struct Atlas {
+        /** Atlas size in pixels */
+        glm::ivec2 size = {0, 0};
+        /** Single channel atlas pixels */
+        std::vector<unsigned char> pixels;
+        /** Character information, without the texture id */
+        std::unordered_map<char, Character> characters;
+    };
+
     IGraphicsAPI& mGraphicsAPI_;
 
-    /* VAO for a text rendering **/
-    unsigned int mTextVAO_;
-    /* VBO for a text rendering **/
-    unsigned int mTextVBO_;
+    /** Atlas texture holding all glyphs of this font */
+    unsigned int mAtlasTextureId_ = 0;
+    /** Atlas size in pixels */
+    glm::ivec2 mAtlasSize_ = {0, 0};
     /** Character information from the loaded font */
     std::unordered_map<char, Character> mCharacterFrontInfo_;
 
     Font(IGraphicsAPI& graphicsAPI, utils::FileData& fileData);
 
+    /**
+     * @brief Create the font from glyphs already rasterized by rasterize
+     *
+     * @param graphicsAPI Graphics API to create the atlas texture with
+     * @param atlas Rasterized glyphs
+     */
+    Font(IGraphicsAPI& graphicsAPI, Atlas&& atlas);
+
+    /**
+     * @brief Rasterize the first 128 ASCII glyphs of a font file and pack them into an atlas image.
+     * Safe to call from worker threads
+     *
+     * @param fileData Font file contents
+     * @return Empty atlas if the font could not be read
+     */
+    static Atlas rasterize(utils::FileData& fileData);
+
     ~Font();
 
     /**
@@ -48,14 +80,20 @@ public:
     const Character* getCharInfo(char theChar) const;
 
     /**
-     * Get the VAO for this font
+     * Get the atlas texture holding all glyphs of this font
      */
-    unsigned int getVAO() const;
+    unsigned int getAtlasTextureId() const;
 
     /**
-     * Get VBO for this font
+     * Get the atlas size in pixels
      */
-    unsigned int getVBO() const;
+    glm::ivec2 getAtlasSize() const;
+
+private:
+    /** Width of the glyph atlas in pixels. The height is fit to the glyphs */
+    static constexpr int ATLAS_WIDTH = 512;
+    /** Empty pixels between glyphs in the atlas so linear filtering does not bleed */
+    static constexpr int ATLAS_PADDING = 1;
 
 };
 
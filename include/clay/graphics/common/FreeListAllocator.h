@@ -0,0 +1,75 @@
+#pragma once
+// standard lib
+#include <cstddef>
+#include <limits>
+#include <map>
+
+namespace clay {
+
+/**
+ * @brief Offset allocator over a linear range, such as a GPU buffer. Free ranges are kept sorted by
+ * offset, allocation takes the first range that fits and freed ranges merge with their neighbours.
+ */
+class FreeListAllocator {
+public:
+    /** Returned by allocate when no free range fits */
+    static constexpr size_t INVALID_OFFSET = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief Constructor
+     *
+     * @param capacity Size of the managed range
+     */
+    explicit FreeListAllocator(size_t capacity = 0);
+
+    /** Destructor */
+    ~FreeListAllocator();
+
+    /**
+     * @brief Reserve a range
+     *
+     * @param size Size of the range
+     * @param alignment Alignment of the offset
+     * @return Offset of the range or INVALID_OFFSET if no free range fits
+     */
+    size_t allocate(size_t size, size_t alignment = 1);
+
+    /**
+     * @brief Release a range returned by allocate
+     *
+     * @param offset Offset of the range
+     * @param size Size the range was allocated with
+     */
+    void free(size_t offset, size_t size);
+
+    /**
+     * @brief Extend the managed range. The added space is free
+     *
+     * @param newCapacity New size of the managed range, at least the current one
+     */
+    void grow(size_t newCapacity);
+
+    /** Get the size of the managed range */
+    size_t getCapacity() const;
+
+    /** Get the allocated size, including alignment padding left in free ranges */
+    size_t getUsed() const;
+
+private:
+    /**
+     * @brief Add a free range, merged with adjacent free ranges
+     *
+     * @param offset Offset of the range
+     * @param size Size of the range
+     */
+    void insertFree(size_t offset, size_t size);
+
+    /** Free ranges, offset to size */
+    std::map<size_t, size_t> mFreeRanges_;
+    /** Size of the managed range */
+    size_t mCapacity_ = 0;
+    /** Size of the free ranges */
+    size_t mFree_ = 0;
+};
+
+} // namespace clay
@@ -0,0 +1,79 @@
+#pragma once
+// standard lib
+#include <array>
+#include <cstddef>
+#include <cstdint>
+// third party
+#include <glm/glm.hpp>
+// project
+#include "clay/graphics/common/BoundingVolume.h"
+#include "clay/utils/common/WorkerPool.h"
+
+namespace clay {
+
+/**
+ * @brief View frustum as 6 world space planes. Plane normals point inwards, a point p is inside a plane
+ * if dot(plane.xyz, p) + plane.w >= 0
+ */
+class Frustum {
+public:
+    /** Number of bounding volumes below which cullSpheres does not split the work across threads */
+    static constexpr size_t PARALLEL_CULL_MIN_COUNT = 16384;
+
+    /** Constructor. The default frustum contains everything */
+    Frustum();
+
+    /**
+     * @brief Construct the frustum of a view projection matrix
+     *
+     * @param viewProjection Projection * View matrix
+     */
+    Frustum(const glm::mat4& viewProjection);
+
+    /** Destructor */
+    ~Frustum();
+
+    /**
+     * @brief If the sphere is at least partially inside the frustum
+     *
+     * @param sphere World space sphere
+     */
+    bool intersects(const BoundingSphere& sphere) const;
+
+    /**
+     * @brief If the box is at least partially inside the frustum. Boxes near a frustum corner may pass
+     * without being inside
+     *
+     * @param box World space box
+     */
+    bool intersects(const AABB& box) const;
+
+    /**
+     * @brief Test spheres against the frustum, 4 at a time with SIMD where available. Invalid spheres are
+     * treated as unbounded and always visible
+     *
+     * @param spheres World space spheres
+     * @param count Number of spheres
+     * @param outVisible Set to 1 for each visible sphere and 0 otherwise
+     * @param workerPool Threads to split large inputs across, null to test on the calling thread
+     */
+    void cullSpheres(const BoundingSphere* spheres, size_t count, uint8_t* outVisible, utils::WorkerPool* workerPool = nullptr) const;
+
+    /** Get the planes of the frustum (left, right, bottom, top, near, far) */
+    const std::array<glm::vec4, 6>& getPlanes() const;
+
+private:
+    /**
+     * @brief Test a range of spheres on the calling thread
+     *
+     * @param spheres World space spheres
+     * @param count Number of spheres
+     * @param outVisible Set to 1 for each visible sphere and 0 otherwise
+     */
+    void cullSpheresRange(const BoundingSphere* spheres, size_t count, uint8_t* outVisible) const;
+
+    /** Frustum planes */
+    std::array<glm::vec4, 6> mPlanes_;
+};
+
+} // namespace clay
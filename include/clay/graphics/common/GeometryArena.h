@@ -0,0 +1,136 @@
+#pragma once
+// standard lib
+#include <cstddef>
+#include <memory>
+// project
+#include "clay/graphics/common/FreeListAllocator.h"
+#include "clay/graphics/common/IGraphicsAPI.h"
+#include "clay/graphics/common/VertexLayout.h"
+
+namespace clay {
+
+/**
+ * @brief Shared vertex and index buffers for all meshes with the same vertex layout.
+ *
+ * Each mesh gets a range of vertices and a range of indices out of two large buffers, bound through a
+ * single vertex array. Indices are stored relative to the mesh's first vertex and drawn with base vertex
+ * draws, so 16 bit indices work anywhere in the buffer. The buffers grow by copying to larger ones, which
+ * keeps the offsets of existing ranges.
+ */
+class GeometryArena : public std::enable_shared_from_this<GeometryArena> {
+public:
+    /** Initial vertex capacity */
+    static constexpr size_t INITIAL_VERTEX_CAPACITY = 64 * 1024;
+    /** Initial index buffer size in bytes */
+    static constexpr size_t INITIAL_INDEX_CAPACITY = 1024 * 1024;
+
+    /** Vertices and indices of one mesh in the arena */
+    struct Range {
+        /** Arena the range belongs to */
+        GeometryArena* arena = nullptr;
+        /** Index of the first vertex, added to each index when drawing */
+        size_t baseVertex = 0;
+        /** Number of vertices */
+        size_t vertexCount = 0;
+        /** Byte offset of the first index in the element buffer */
+        size_t indexOffset = 0;
+        /** Number of indices */
+        size_t indexCount = 0;
+        /** Type of the indices, UINT or USHORT */
+        IGraphicsAPI::DataType indexType = IGraphicsAPI::DataType::UINT;
+    };
+
+    /**
+     * @brief Get the arena for a layout, creating it if no mesh uses one. Arenas live while ranges allocated
+     * from them are referenced
+     *
+     * @param graphicsAPI Graphics API the buffers belong to
+     * @param layout Vertex layout of the arena
+     */
+    static std::shared_ptr<GeometryArena> acquire(IGraphicsAPI& graphicsAPI, const VertexLayout& layout);
+
+    /**
+     * @brief Constructor. Use acquire to share arenas between meshes
+     *
+     * @param graphicsAPI Graphics API to create the buffers with
+     * @param layout Vertex layout of the arena
+     */
+    GeometryArena(IGraphicsAPI& graphicsAPI, const VertexLayout& layout);
+
+    /** Destructor */
+    ~GeometryArena();
+
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    /**
+     * @brief Copy a mesh into the arena. The range is freed when the last reference to it is released
+     *
+     * @param vertexData Vertices encoded in the arena layout
+     * @param vertexCount Number of vertices
+     * @param indexData Indices relative to the first vertex
+     * @param indexCount Number of indices
+     * @param indexType Type of the indices, UINT or USHORT
+     */
+    std::shared_ptr<const Range> allocate(const void* vertexData, size_t vertexCount, const void* indexData, size_t indexCount, IGraphicsAPI::DataType indexType);
+
+    /** Bind the vertex array of the arena */
+    void bind() const;
+
+    /** Get the vertex array id */
+    unsigned int getVertexArray() const;
+
+    /** Get the vertex buffer id */
+    unsigned int getVertexBuffer() const;
+
+    /** Get the element buffer id */
+    unsigned int getIndexBuffer() const;
+
+    /** Get the vertex layout */
+    const VertexLayout& getLayout() const;
+
+    /** Get the GPU memory of the buffers in bytes */
+    size_t getCapacityBytes() const;
+
+    /** Get the GPU memory used by ranges in bytes */
+    size_t getUsedBytes() const;
+
+private:
+    /**
+     * @brief Release a range
+     *
+     * @param range Range to release
+     */
+    void free(const Range& range);
+
+    /**
+     * @brief Replace a buffer with a larger one holding the same data
+     *
+     * @param buffer Buffer to replace, set to the new buffer
+     * @param oldSize Size of the buffer
+     * @param newSize Size of the new buffer
+     */
+    void growBuffer(unsigned int& buffer, size_t oldSize, size_t newSize);
+
+    /** Point the vertex array at the current buffers */
+    void bindBuffersToVertexArray();
+
+    /** Graphics API */
+    IGraphicsAPI& mGraphicsAPI_;
+    /** Vertex layout of every mesh in the arena */
+    VertexLayout mLayout_;
+    /** Size of a vertex in bytes */
+    size_t mStride_;
+    /** Vertex array reading the arena buffers */
+    unsigned int mVAO_ = 0;
+    /** Vertex buffer */
+    unsigned int mVBO_ = 0;
+    /** Element buffer */
+    unsigned int mEBO_ = 0;
+    /** Vertex ranges, in vertices */
+    FreeListAllocator mVertexAllocator_;
+    /** Index ranges, in bytes */
+    FreeListAllocator mIndexAllocator_;
+};
+
+} // namespace clay
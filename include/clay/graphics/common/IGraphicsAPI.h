@@ -24,7 +24,8 @@ public:
 
     enum class Capability {
         MULTISAMPLE,
-        FRAMEBUFFER_SRGB
+        FRAMEBUFFER_SRGB,
+        DEPTH_TEST
     };
 
     enum class FrameBufferTarget {
@@ -77,6 +78,9 @@ public:
         UVEC4,
         UBYTE,
         BYTE,
+        SHORT,
+        USHORT,
+        HALF_FLOAT,
     };
 
     enum class PrimitiveTopology : uint8_t {
@@ -95,14 +99,18 @@ public:
         TEXTURE_2D, 
         TEXTURE_2D_ARRAY,
         TEXTURE_2D_MULTISAMPLE,
-        TEXTURE_2D_MULTISAMPLE_ARRAY
+        TEXTURE_2D_MULTISAMPLE_ARRAY,
+        TEXTURE_BUFFER
     };
 
     enum class TextureParameterType : uint8_t {
         TEXTURE_WRAP_S,
         TEXTURE_WRAP_T,
         TEXTURE_MIN_FILTER,
-        TEXTURE_MAG_FILTER
+        TEXTURE_MAG_FILTER,
+        TEXTURE_MAX_ANISOTROPY,
+        TEXTURE_BASE_LEVEL,
+        TEXTURE_MAX_LEVEL
     };
 
     enum class TextureParameterOption : uint8_t {
@@ -111,6 +119,11 @@ public:
         LINEAR,
         CLAMP_TO_EDGE,
         REPEAT,
+        MIRRORED_REPEAT,
+        NEAREST_MIPMAP_NEAREST,
+        LINEAR_MIPMAP_NEAREST,
+        NEAREST_MIPMAP_LINEAR,
+        LINEAR_MIPMAP_LINEAR,
     };
 
     enum class TextureFormat : uint8_t {
@@ -121,6 +134,38 @@ public:
         RED,
         LUMINANCE, // gles only
         RGBA16F,
+        RGBA32F,
+        R16UI,
+        RG32UI,
+    };
+
+    /** Block compressed texture formats. Each block covers 4x4 texels */
+    enum class CompressedFormat : uint8_t {
+        /** BC1 (DXT1) RGB, 8 bytes per block */
+        BC1_RGB,
+        BC1_SRGB,
+        /** BC1 (DXT1) RGB with 1 bit alpha, 8 bytes per block */
+        BC1_RGBA,
+        BC1_SRGB_ALPHA,
+        /** BC3 (DXT5) RGBA, 16 bytes per block */
+        BC3_RGBA,
+        BC3_SRGB_ALPHA,
+        /** BC4 (RGTC1) single channel, 8 bytes per block */
+        BC4_R,
+        /** BC5 (RGTC2) two channels, 16 bytes per block. Used for normal maps */
+        BC5_RG,
+        /** BC7 (BPTC) RGBA, 16 bytes per block */
+        BC7_RGBA,
+        BC7_SRGB_ALPHA,
+        /** ETC2 RGB, 8 bytes per block */
+        ETC2_RGB,
+        ETC2_SRGB,
+        /** ETC2 RGB with EAC alpha, 16 bytes per block */
+        ETC2_RGBA,
+        ETC2_SRGB_ALPHA,
+        /** ASTC 4x4 LDR, 16 bytes per block */
+        ASTC_4x4_RGBA,
+        ASTC_4x4_SRGB_ALPHA,
     };
 
     enum class PixelAlignment {
@@ -160,6 +205,36 @@ public:
         FILL
     };
 
+    enum class BufferAccess : uint8_t {
+        READ,
+        WRITE,
+        PERSISTENT,
+        COHERENT,
+        INVALIDATE_RANGE,
+        UNSYNCHRONIZED
+    };
+
+    enum class BlendFactor : uint8_t {
+        ZERO,
+        ONE,
+        SRC_ALPHA,
+        ONE_MINUS_SRC_ALPHA
+    };
+
+    /** Parameters of one draw of multiDrawElementsIndirect, laid out as read from the indirect buffer */
+    struct DrawElementsIndirectCommand {
+        /** Number of indices */
+        uint32_t count;
+        /** Number of instances */
+        uint32_t instanceCount;
+        /** Index of the first index in the element buffer */
+        uint32_t firstIndex;
+        /** Value added to each index */
+        int32_t baseVertex;
+        /** Added to the instance index when fetching instanced attributes */
+        uint32_t baseInstance;
+    };
+
     virtual ~IGraphicsAPI() = default;
 
     virtual unsigned int createShader(ShaderCreateInfo::Type) = 0;
@@ -175,6 +250,8 @@ public:
     virtual std::string getProgramLog(unsigned int programID) = 0;
 
     virtual unsigned int getUniformLocation(unsigned int programId, const std::string& name) = 0;
+    virtual int getActiveUniformCount(unsigned int programId) = 0;
+    virtual std::string getActiveUniformName(unsigned int programId, unsigned int index) = 0;
     virtual void uniform1i(unsigned int location, int value) = 0;
     virtual void uniform1f(unsigned int location, float value) = 0;
     virtual void uniform2fv(unsigned int location, const float* value) = 0;
@@ -194,6 +271,13 @@ public:
     virtual void enable(Capability capability) = 0;
     virtual void disable(Capability capability) = 0;
 
+    /**
+     * @brief Check if a capability is enabled, to restore it after changing it
+     *
+     * @param capability Capability to check
+     */
+    virtual bool isEnabled(Capability capability) = 0;
+
     virtual void bindVertexArray(unsigned int vao) = 0;
 
     virtual void genBuffer(int size, unsigned int* vaos) = 0;
@@ -210,6 +294,8 @@ public:
 
     virtual void genVertexArrays(unsigned int n, unsigned int* arrays) = 0;
 
+    virtual void deleteVertexArrays(unsigned int n, unsigned int* arrays) = 0;
+
     virtual unsigned int getUniformBlockIndex(unsigned int programId, const char* uniformBlockName) = 0;
 
     virtual void uniformBlockBinding(unsigned int programId, unsigned int uniformBlockIndex, unsigned int uniformBlockBinding) = 0;
@@ -221,6 +307,16 @@ public:
 
     virtual void texParameter(TextureTarget target, TextureParameterType paramName, TextureParameterOption paramOption) = 0;
 
+    /**
+     * @brief Set an integer parameter of the texture bound to the target. TEXTURE_BASE_LEVEL and
+     * TEXTURE_MAX_LEVEL are integer parameters
+     *
+     * @param target Texture target
+     * @param paramName Parameter to set
+     * @param value New value
+     */
+    virtual void texParameteri(TextureTarget target, TextureParameterType paramName, int value) = 0;
+
     virtual void texImage2D(TextureTarget target,
                             unsigned int level,
                             TextureFormat internalFormat,
@@ -231,8 +327,91 @@ public:
                             DataType dataType,
                             const void * data) = 0;
 
+    /**
+     * @brief Replace a rectangle of a level of the texture bound to the target
+     *
+     * @param target Texture target
+     * @param level Mip level
+     * @param xOffset Left texel of the rectangle
+     * @param yOffset First row of the rectangle
+     * @param width Width of the rectangle in texels
+     * @param height Height of the rectangle in texels
+     * @param format Format of the data
+     * @param dataType Type of each channel of the data
+     * @param data Texel data
+     */
+    virtual void texSubImage2D(TextureTarget target,
+                               unsigned int level,
+                               unsigned int xOffset,
+                               unsigned int yOffset,
+                               unsigned int width,
+                               unsigned int height,
+                               TextureFormat format,
+                               DataType dataType,
+                               const void* data) = 0;
+
     virtual void bindTexture(TextureTarget target, unsigned int textureId) = 0;
 
+    /**
+     * @brief Upload a level of block compressed data to the texture bound to the target
+     *
+     * @param target Texture target
+     * @param level Mip level
+     * @param format Compressed format of the data
+     * @param width Width of the level in texels
+     * @param height Height of the level in texels
+     * @param imageSize Size of the data in bytes
+     * @param data Compressed blocks, rows of blocks top to bottom
+     */
+    virtual void compressedTexImage2D(TextureTarget target,
+                                      unsigned int level,
+                                      CompressedFormat format,
+                                      unsigned int width,
+                                      unsigned int height,
+                                      size_t imageSize,
+                                      const void* data) = 0;
+
+    /**
+     * @brief Check if the driver can sample a compressed format
+     *
+     * @param format Compressed format
+     */
+    virtual bool isCompressedFormatSupported(CompressedFormat format) = 0;
+
+    /**
+     * @brief Build the mip chain of the texture bound to the target from its base level
+     *
+     * @param target Texture target
+     */
+    virtual void generateMipmap(TextureTarget target) = 0;
+
+    virtual void genSamplers(unsigned int count, unsigned int* samplers) = 0;
+
+    virtual void deleteSamplers(unsigned int count, unsigned int* samplers) = 0;
+
+    /**
+     * @brief Bind a sampler object to a texture unit. Its state replaces the sampling parameters of the
+     * texture bound to the unit
+     *
+     * @param textureUnit Texture unit
+     * @param sampler Sampler to bind, 0 to use the texture's own parameters
+     */
+    virtual void bindSampler(unsigned int textureUnit, unsigned int sampler) = 0;
+
+    virtual void samplerParameter(unsigned int sampler, TextureParameterType paramName, TextureParameterOption paramOption) = 0;
+
+    /**
+     * @brief Set a float parameter of a sampler. Only TEXTURE_MAX_ANISOTROPY is a float parameter
+     *
+     * @param sampler Sampler to update
+     * @param paramName Parameter to set
+     * @param value New value
+     */
+    virtual void samplerParameterf(unsigned int sampler, TextureParameterType paramName, float value) = 0;
+
+    /** Get the highest supported anisotropy, 1 if anisotropic filtering is not available */
+    virtual float getMaxAnisotropy() = 0;
+
     virtual void pixelStore(PixelAlignment alignment, unsigned int value) = 0;
 
     virtual void activeTexture(unsigned int textureUnit) = 0;
@@ -265,6 +444,117 @@ public:
 
     virtual void drawBuffer(unsigned int bufferId) = 0;
 
+    virtual void vertexAttribDivisor(unsigned int index, unsigned int divisor) = 0;
+
+    virtual void drawElementsInstanced(PrimitiveTopology mode, int count, DataType type, const void* indices, unsigned int instanceCount) = 0;
+
+    virtual void blendFunc(BlendFactor srcFactor, BlendFactor dstFactor) = 0;
+
+    virtual void viewport(int x, int y, int width, int height) = 0;
+
+    /**
+     * @brief Get the current viewport
+     *
+     * @param outViewport Set to x, y, width, height
+     */
+    virtual void getViewport(int* outViewport) = 0;
+
+    /**
+     * @brief Attach a buffer as the storage of the texture bound to TEXTURE_BUFFER
+     *
+     * @param internalFormat Format of the texels in the buffer
+     * @param buffer Buffer to attach
+     */
+    virtual void texBuffer(TextureFormat internalFormat, unsigned int buffer) = 0;
+
+    /** If immutable buffer storage (and persistent mapping) is available */
+    virtual bool isBufferStorageSupported() = 0;
+
+    /**
+     * @brief Allocate immutable storage for the buffer bound to the target
+     *
+     * @param target Buffer target
+     * @param size Size in bytes
+     * @param data Initial data or null
+     * @param access How the storage can be mapped
+     */
+    virtual void bufferStorage(BufferTarget target, size_t size, const void* data, const std::vector<BufferAccess>& access) = 0;
+
+    /**
+     * @brief Map a range of the buffer bound to the target
+     *
+     * @return Pointer to the mapped range, null on failure
+     */
+    virtual void* mapBufferRange(BufferTarget target, size_t offset, size_t size, const std::vector<BufferAccess>& access) = 0;
+
+    virtual void unmapBuffer(BufferTarget target) = 0;
+
+    virtual void deleteBuffer(int size, unsigned int* buffers) = 0;
+
+    /**
+     * @brief Insert a fence after the commands issued so far
+     *
+     * @return Fence handle, delete with deleteSync
+     */
+    virtual void* fenceSync() = 0;
+
+    /**
+     * @brief Wait for a fence to be signaled
+     *
+     * @param sync Fence from fenceSync
+     * @param timeoutNanoseconds Maximum time to wait
+     * @return If the fence was signaled before the timeout
+     */
+    virtual bool clientWaitSync(void* sync, uint64_t timeoutNanoseconds) = 0;
+
+    virtual void deleteSync(void* sync) = 0;
+
+    /**
+     * @brief Draw indexed primitives with a value added to every index before fetching the vertex
+     *
+     * @param mode Primitive topology
+     * @param count Number of indices
+     * @param type Index type
+     * @param indices Byte offset of the first index in the element buffer
+     * @param baseVertex Value added to each index
+     */
+    virtual void drawElementsBaseVertex(PrimitiveTopology mode, int count, DataType type, const void* indices, int baseVertex) = 0;
+
+    /**
+     * @brief Instanced version of drawElementsBaseVertex
+     *
+     * @param mode Primitive topology
+     * @param count Number of indices
+     * @param type Index type
+     * @param indices Byte offset of the first index in the element buffer
+     * @param instanceCount Number of instances
+     * @param baseVertex Value added to each index
+     */
+    virtual void drawElementsInstancedBaseVertex(PrimitiveTopology mode, int count, DataType type, const void* indices, unsigned int instanceCount, int baseVertex) = 0;
+
+    /**
+     * @brief Copy data from the buffer bound to COPY_READ_BUFFER to the buffer bound to COPY_WRITE_BUFFER
+     *
+     * @param readOffset Offset in the source buffer
+     * @param writeOffset Offset in the destination buffer
+     * @param size Size in bytes
+     */
+    virtual void copyBufferSubData(size_t readOffset, size_t writeOffset, size_t size) = 0;
+
+    /** If multiDrawElementsIndirect is available, with commands that can use a non-zero base instance */
+    virtual bool isMultiDrawIndirectSupported() = 0;
+
+    /**
+     * @brief Issue several indexed draws whose parameters are read from the buffer bound to DRAW_INDIRECT_BUFFER
+     *
+     * @param mode Primitive topology
+     * @param type Index type
+     * @param indirect Byte offset of the first DrawElementsIndirectCommand in the indirect buffer
+     * @param drawCount Number of commands
+     * @param stride Distance between commands in bytes, 0 if they are tightly packed
+     */
+    virtual void multiDrawElementsIndirect(PrimitiveTopology mode, DataType type, const void* indirect, unsigned int drawCount, size_t stride) = 0;
+
 };
 
 } // namespace clay
@@ -0,0 +1,140 @@
+#pragma once
+// standard lib
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+// third party
+#include <glm/glm.hpp>
+// project
+#include "clay/graphics/common/BoundingVolume.h"
+
+namespace clay {
+
+/**
+ * @brief Bins point lights into a view space froxel grid for clustered forward shading.
+ *
+ * The view frustum is split into GRID_X * GRID_Y screen tiles and GRID_Z depth slices, exponentially
+ * spaced between the near and far plane. Each cluster gets the range of the light index list holding the
+ * lights whose sphere of influence touches it, so a fragment only iterates the lights of its cluster.
+ */
+class LightClusters {
+public:
+    /** Number of screen tiles along x */
+    static constexpr unsigned int GRID_X = 16;
+    /** Number of screen tiles along y */
+    static constexpr unsigned int GRID_Y = 9;
+    /** Number of depth slices */
+    static constexpr unsigned int GRID_Z = 24;
+    /** Maximum number of lights. Light indices are 16 bit */
+    static constexpr size_t MAX_LIGHTS = std::numeric_limits<uint16_t>::max();
+
+    /** Texture unit of the light data texture buffer in shaders */
+    static constexpr unsigned int LIGHT_DATA_TEXTURE_UNIT = 13;
+    /** Texture unit of the cluster offset/count texture buffer in shaders */
+    static constexpr unsigned int CLUSTER_TEXTURE_UNIT = 14;
+    /** Texture unit of the light index texture buffer in shaders */
+    static constexpr unsigned int LIGHT_INDEX_TEXTURE_UNIT = 15;
+
+    /** Light as stored in the light data buffer, 3 RGBA32F texels */
+    struct Light {
+        /** World space position, 1 / range in w. 0 for lights without a range */
+        glm::vec4 positionInvRange;
+        /** Color in rgb, intensity in w */
+        glm::vec4 colorIntensity;
+        /** Constant, linear and quadratic attenuation */
+        glm::vec4 attenuation;
+    };
+
+    /** Constructor */
+    LightClusters();
+
+    /** Destructor */
+    ~LightClusters();
+
+    /**
+     * @brief Set the projection the grid is built for. Cluster bounds are only recomputed if it changed.
+     * Non perspective projections use a single cluster
+     *
+     * @param projection Camera projection matrix
+     */
+    void setProjection(const glm::mat4& projection);
+
+    /**
+     * @brief Bin the lights into the clusters. Lights without a range are skipped, they are meant to be
+     * applied to every fragment
+     *
+     * @param lights Lights to bin
+     * @param count Number of lights
+     * @param view Camera view matrix
+     */
+    void build(const Light* lights, size_t count, const glm::mat4& view);
+
+    /** Get the number of clusters along each axis */
+    glm::uvec3 getGridSize() const;
+
+    /** Get the number of clusters */
+    size_t getClusterCount() const;
+
+    /** Get the scale of log(view depth) to depth slice */
+    float getSliceScale() const;
+
+    /** Get the bias of log(view depth) to depth slice */
+    float getSliceBias() const;
+
+    /** Get the offset into the light index list and the light count of each cluster */
+    const std::vector<glm::uvec2>& getClusterRanges() const;
+
+    /** Get the light index list */
+    const std::vector<uint16_t>& getLightIndices() const;
+
+private:
+    /**
+     * @brief Get the view space point at a depth along the ray through a NDC position
+     *
+     * @param ndc NDC x, y
+     * @param depth Positive view space depth
+     */
+    glm::vec3 unproject(const glm::vec2& ndc, float depth) const;
+
+    /**
+     * @brief Get the depth slice containing a view space depth
+     *
+     * @param depth Positive view space depth
+     */
+    unsigned int getSlice(float depth) const;
+
+    /** Recompute the view space bounds of every cluster */
+    void computeClusterBounds();
+
+    /** Projection the grid was built for */
+    glm::mat4 mProjection_ = glm::mat4(0.0f);
+    /** Inverse of the projection */
+    glm::mat4 mInverseProjection_ = glm::mat4(1.0f);
+    /** If the projection is perspective */
+    bool mPerspective_ = false;
+    /** Number of clusters along each axis */
+    glm::uvec3 mGridSize_ = {1, 1, 1};
+    /** Near plane distance */
+    float mNear_ = 0.0f;
+    /** Far plane distance */
+    float mFar_ = 0.0f;
+    /** Scale of log(view depth) to depth slice */
+    float mSliceScale_ = 0.0f;
+    /** Bias of log(view depth) to depth slice */
+    float mSliceBias_ = 0.0f;
+    /** View space depth of the start of each slice, and the end of the last one */
+    std::vector<float> mSliceDepths_;
+
+    /** View space bounds of each cluster */
+    std::vector<AABB> mClusterBounds_;
+    /** Offset and count of each cluster */
+    std::vector<glm::uvec2> mClusterRanges_;
+    /** Light indices grouped by cluster */
+    std::vector<uint16_t> mLightIndices_;
+    /** Cluster and light of each light/cluster overlap found during build */
+    std::vector<std::pair<uint32_t, uint16_t>> mAssignments_;
+};
+
+} // namespace clay
@@ -10,6 +10,9 @@ class LightSource {
 public:
     enum class Type { Directional, Point, Spot };
 
+    /** Light level below which a light is treated as not reaching a surface */
+    static constexpr float MIN_LIGHT_LEVEL = 1.0f / 256.0f;
+
     LightSource(Type type);
 
     ~LightSource();
@@ -26,6 +29,10 @@ public:
     glm::vec3 getDirection() const;
     glm::vec4 getColor() const;
     float getIntensity() const;
+    /** Get the constant, linear and quadratic attenuation factors */
+    glm::vec3 getAttenuation() const;
+    /** Distance at which the attenuated light falls below MIN_LIGHT_LEVEL. Infinite without distance attenuation */
+    float getRange() const;
 
 private:
     Type type_;
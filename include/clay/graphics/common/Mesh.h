@@ -1,5 +1,7 @@
 #pragma once
 // standard lib
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <filesystem>
 // third party
@@ -8,23 +10,22 @@
 #include <assimp/postprocess.h>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
 #include <clay/graphics/common/IGraphicsAPI.h>
 // project
+#include "clay/graphics/common/BoundingVolume.h"
+#include "clay/graphics/common/GeometryArena.h"
+#include "clay/graphics/common/MeshOptimizer.h"
 #include "clay/graphics/common/ShaderProgram.h"
+#include "clay/graphics/common/VertexLayout.h"
 #include "clay/utils/common/Utils.h"
 
 namespace clay {
 
 class Mesh {
 public:
-
-    /**
-     * Reads an obj file and populates the given list with the meshes
-     *
-     * @param path obj file path
-     * @param meshList
-     */
-    static void parseMeshes(IGraphicsAPI& graphicsAPI, utils::FileData& fileData, std::vector<Mesh>& meshList);
+    /** GPU storage format of a mesh */
+    using VertexLayout = clay::VertexLayout;
 
     /** Mesh Vertex info*/
     struct Vertex {
@@ -34,6 +35,55 @@ public:
         glm::vec3 tangent;
         glm::vec3 bitangent;
     };
+    /** Vertices and indices of a mesh before they are uploaded */
+    struct Data {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+    };
+
+    /**
+     * Reads an obj file and populates the given list with the meshes
+     *
+     * @param path obj file path
+     * @param meshList
+     * @param layout GPU storage format of the meshes
+     * @param optimization Optimization stages to run on each mesh after import
+     */
+    static void parseMeshes(IGraphicsAPI& graphicsAPI, utils::FileData& fileData, std::vector<Mesh>& meshList, const VertexLayout& layout = VertexLayout(), const MeshOptimizer::Options& optimization = MeshOptimizer::Options());
+
+    /**
+     * @brief Reads an obj file into vertices and indices without uploading them. Safe to call from
+     * worker threads
+     *
+     * @param fileData obj file contents
+     * @param dataList Populated with a Data for each mesh
+     * @param optimization Optimization stages to run on each mesh after import
+     */
+    static void parseMeshData(utils::FileData& fileData, std::vector<Data>& dataList, const MeshOptimizer::Options& optimization = MeshOptimizer::Options());
+
+    /**
+     * @brief Simplify vertices and indices, reordered for the cache and without unused vertices. Safe
+     * to call from worker threads
+     *
+     * @param vertices Vertices of the mesh
+     * @param indices Triangle indices of the mesh
+     * @param triangleRatio Fraction of the triangles to keep
+     */
+    static Data simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, float triangleRatio);
+    /** Per instance data of an instanced draw. Layout matches the instanced Assimp shader attributes */
+    struct Instance {
+        /** Model matrix */
+        glm::mat4 model;
+        /** Color multiplier */
+        glm::vec4 color;
+    };
+    /** First attribute location of the per instance data. The model matrix takes 4 locations, then color */
+    static constexpr unsigned int INSTANCE_ATTRIBUTE_LOCATION = 5;
+    /** Attribute location of octahedral encoded normals */
+    static constexpr unsigned int PACKED_NORMAL_ATTRIBUTE_LOCATION = VertexLayout::PACKED_NORMAL_ATTRIBUTE_LOCATION;
+    /** Attribute location of octahedral encoded tangents with the bitangent sign */
+    static constexpr unsigned int PACKED_TANGENT_ATTRIBUTE_LOCATION = VertexLayout::PACKED_TANGENT_ATTRIBUTE_LOCATION;
+
     /** Mesh Texture info*/
     struct Texture {
         unsigned int id;
@@ -47,15 +97,14 @@ public:
     std::vector<unsigned int> indices;
     /** Textures TODO use this*/
     std::vector<Texture> textures;
-    /** Vertex Array Object for this mesh */
-    unsigned int mVAO;
 
     /**
      * Constructor
      * @param vertices Vertices for this Mesh
      * @param indices Render order of the vertices
+     * @param layout GPU storage format
      */
-    Mesh(IGraphicsAPI& graphicsAPI, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    Mesh(IGraphicsAPI& graphicsAPI, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const VertexLayout& layout = VertexLayout());
 
     /**
      * @brief Destructor
@@ -68,28 +117,84 @@ public:
      */
     void render(const ShaderProgram& theShader) const;
 
+    /**
+     * @brief Render multiple instances of the mesh in one draw call
+     *
+     * @param theShader Instanced shader that will be used to draw
+     * @param instanceBuffer Buffer of Mesh::Instance
+     * @param firstInstance Index of the first instance to draw in the buffer
+     * @param instanceCount Number of instances to draw
+     */
+    void renderInstanced(const ShaderProgram& theShader, unsigned int instanceBuffer, size_t firstInstance, unsigned int instanceCount) const;
+
+    /**
+     * @brief Point the instance attributes of the bound vertex array at a buffer of Mesh::Instance
+     *
+     * @param graphicsAPI Graphics API
+     * @param instanceBuffer Buffer of Mesh::Instance
+     * @param baseOffset Byte offset of instance 0. Instanced draws with a base instance read from this offset
+     */
+    static void bindInstanceAttributes(IGraphicsAPI& graphicsAPI, unsigned int instanceBuffer, size_t baseOffset);
+
+    /**
+     * @brief Create a simplified copy of this mesh with the same vertex layout
+     *
+     * @param triangleRatio Fraction of the triangles to keep
+     */
+    Mesh simplified(float triangleRatio) const;
+
+    /** Get the local space bounding box of the vertices */
+    const AABB& getAABB() const;
+
+    /** Get the local space bounding sphere of the vertices */
+    const BoundingSphere& getBoundingSphere() const;
+
+    /** Get the GPU storage format */
+    const VertexLayout& getVertexLayout() const;
+
+    /** Get the index type of the element buffer, UINT or USHORT */
+    IGraphicsAPI::DataType getIndexType() const;
+
+    /** Get the GPU memory used by the vertices and indices in bytes */
+    size_t getGPUMemorySize() const;
+
+    /** Get the range of the shared geometry buffers holding this mesh */
+    const GeometryArena::Range& getGeometry() const;
+
 private:
     /**
      * Process a node (and child nodes recursively) in a assimp object and add to
      * @param aiNode Assimp node
      * @param aiScene Assimp scene
+     * @param dataList Populated with the meshes of the node
+     * @param optimization Optimization stages to run on each mesh
      */
-    static void processNode(IGraphicsAPI& graphicsAPI, aiNode *node, const aiScene *scene, std::vector<Mesh>& meshList);
+    static void processNode(aiNode *node, const aiScene *scene, std::vector<Data>& dataList, const MeshOptimizer::Options& optimization);
 
     /**
-     * Process an Assimp Mesh and add to list of meshes
+     * Process an Assimp Mesh into vertices and indices
      * @param mesh Child node
      * @param scene Assimp Scene
+     * @param optimization Optimization stages to run on the mesh
      */
-    static Mesh processMesh(IGraphicsAPI& graphicsAPI, aiMesh *mesh, const aiScene *scene);
+    static Data processMesh(aiMesh *mesh, const aiScene *scene, const MeshOptimizer::Options& optimization);
 
-    /** Initializes the OpenGl properties for this mesh*/
+    /** Encode the vertices and copy them with the indices into the geometry arena of the layout */
     void buildOpenGLproperties();
 
-    /** Vertex Buffer Object for this mesh*/
-    unsigned int mVBO_;
-    /** Element Buffer Object for this Mesh */
-    unsigned int mEBO_;
+    /** Compute the bounding box and sphere from the vertices */
+    void computeBounds();
+
+    /** Vertices and indices in the shared buffers. Shared between copies of the mesh */
+    std::shared_ptr<const GeometryArena::Range> mGeometry_;
+    /** GPU storage format */
+    VertexLayout mLayout_;
+    /** Type of the indices in the element buffer */
+    IGraphicsAPI::DataType mIndexType_ = IGraphicsAPI::DataType::UINT;
+    /** Local space bounding box */
+    AABB mAABB_;
+    /** Local space bounding sphere */
+    BoundingSphere mBoundingSphere_;
 
     IGraphicsAPI& mGraphicsAPI_;
 };
@@ -0,0 +1,117 @@
+#pragma once
+// standard lib
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace clay {
+
+/**
+ * @brief Offline optimizations of indexed triangle lists. Vertices are handled as opaque blocks of bytes so
+ * any vertex format can be optimized.
+ *
+ * The stages are meant to run in order: weld duplicate vertices, reorder the triangles for the post
+ * transform vertex cache, then reorder the vertices by first use for fetch locality.
+ */
+class MeshOptimizer {
+public:
+    /** Stages to run */
+    struct Options {
+        /** Merge vertices that are bitwise identical */
+        bool weldVertices = true;
+        /** Reorder the triangles for post transform cache hits (Forsyth) */
+        bool optimizeVertexCache = true;
+        /** Reorder the vertices in the order they are first used and drop unused ones */
+        bool optimizeVertexFetch = true;
+
+        /** If any stage is enabled */
+        bool any() const;
+    };
+
+    /** Vertex cache efficiency of an index buffer */
+    struct Stats {
+        /** Number of vertices */
+        size_t vertexCount = 0;
+        /** Number of indices */
+        size_t indexCount = 0;
+        /** Average cache miss ratio, transformed vertices per triangle. 0.5 is optimal for large grids, 3 is the worst */
+        float acmr = 0.0f;
+        /** Average transformed vertex ratio, transformed vertices per vertex. 1 is optimal */
+        float atvr = 0.0f;
+    };
+
+    /** Size of the FIFO cache simulated for statistics */
+    static constexpr unsigned int STATS_CACHE_SIZE = 16;
+    /** Size of the LRU cache modeled by the vertex cache optimization */
+    static constexpr unsigned int OPTIMIZE_CACHE_SIZE = 32;
+
+    /**
+     * @brief Run the enabled stages on a mesh
+     *
+     * @param vertices Vertices to optimize in place
+     * @param indices Triangle list indices to optimize in place
+     * @param options Stages to run
+     * @param before Set to the statistics of the input if not null
+     * @param after Set to the statistics of the output if not null
+     */
+    template<typename Vertex>
+    static void optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, const Options& options, Stats* before = nullptr, Stats* after = nullptr) {
+        if (before != nullptr) {
+            *before = analyze(indices, vertices.size());
+        }
+        size_t vertexCount = vertices.size();
+        if (options.weldVertices) {
+            vertexCount = weldVertices(vertices.data(), vertexCount, sizeof(Vertex), indices);
+        }
+        if (options.optimizeVertexCache) {
+            optimizeVertexCache(indices, vertexCount);
+        }
+        if (options.optimizeVertexFetch) {
+            vertexCount = optimizeVertexFetch(vertices.data(), vertexCount, sizeof(Vertex), indices);
+        }
+        vertices.resize(vertexCount);
+        if (after != nullptr) {
+            *after = analyze(indices, vertices.size());
+        }
+    }
+
+    /**
+     * @brief Merge bitwise identical vertices. Kept vertices are compacted to the front in their original order
+     *
+     * @param vertices Vertex data
+     * @param vertexCount Number of vertices
+     * @param stride Size of a vertex in bytes
+     * @param indices Indices to remap
+     * @return Number of vertices left
+     */
+    static size_t weldVertices(void* vertices, size_t vertexCount, size_t stride, std::vector<unsigned int>& indices);
+
+    /**
+     * @brief Reorder the triangles so vertices are reused while still in the post transform cache
+     *
+     * @param indices Triangle list indices
+     * @param vertexCount Number of vertices referenced by the indices
+     */
+    static void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount);
+
+    /**
+     * @brief Reorder the vertices in the order the indices first reference them. Unreferenced vertices are removed
+     *
+     * @param vertices Vertex data
+     * @param vertexCount Number of vertices
+     * @param stride Size of a vertex in bytes
+     * @param indices Indices to remap
+     * @return Number of vertices left
+     */
+    static size_t optimizeVertexFetch(void* vertices, size_t vertexCount, size_t stride, std::vector<unsigned int>& indices);
+
+    /**
+     * @brief Simulate a FIFO vertex cache of STATS_CACHE_SIZE entries
+     *
+     * @param indices Triangle list indices
+     * @param vertexCount Number of vertices
+     */
+    static Stats analyze(const std::vector<unsigned int>& indices, size_t vertexCount);
+};
+
+} // namespace clay
@@ -0,0 +1,30 @@
+#pragma once
+// standard lib
+#include <cstddef>
+#include <vector>
+
+namespace clay {
+
+/**
+ * @brief Simplification of indexed triangle lists by quadric error edge collapse (Garland and Heckbert).
+ *
+ * Edges are collapsed into one of their end vertices so no new vertices are created and attributes do not
+ * need to be interpolated. Vertices on open borders and on attribute seams (vertices sharing a position
+ * with different attributes) are never moved, which keeps silhouettes and texture seams intact.
+ */
+class MeshSimplifier {
+public:
+    /**
+     * @brief Simplify a triangle list
+     *
+     * @param vertices Vertex data. The vertex position is read as 3 floats at the start of each vertex
+     * @param vertexCount Number of vertices
+     * @param stride Size of a vertex in bytes
+     * @param indices Triangle list indices
+     * @param targetIndexCount Number of indices to reduce to. Can stay above it if no more edges can collapse
+     * @return Indices of the simplified triangles, referencing the input vertices
+     */
+    static std::vector<unsigned int> simplify(const void* vertices, size_t vertexCount, size_t stride, const std::vector<unsigned int>& indices, size_t targetIndexCount);
+};
+
+} // namespace clay
@@ -16,6 +16,13 @@ namespace clay {
 
 class Model {
 public:
+    /** Fraction of the viewport height a LOD switch size can be crossed by before the level changes */
+    static constexpr float LOD_HYSTERESIS = 0.1f;
+    /** Switch size of a generated level is this times the square root of its triangle ratio */
+    static constexpr float LOD_SCREEN_SIZE_SCALE = 0.5f;
+    /** Triangle ratios of the generated levels of detail */
+    static inline const std::vector<float> DEFAULT_LOD_RATIOS = {0.5f, 0.25f, 0.125f};
+
     /** Constructor */
     Model();
 
@@ -44,11 +51,90 @@ public:
      */
     void render(const ShaderProgram& shader) const;
 
+    /**
+     * Draw the Model meshes of a level of detail
+     * @param shader Shader to render the meshes with
+     * @param lod Level of detail
+     */
+    void render(const ShaderProgram& shader, unsigned int lod) const;
+
+    /** Get the meshes owned by this model */
+    const std::vector<Mesh>& getMeshes() const;
+
+    /**
+     * @brief Get the owned meshes of a level of detail. Level 0 is the full detail meshes
+     *
+     * @param lod Level of detail
+     */
+    const std::vector<Mesh>& getMeshes(unsigned int lod) const;
+
+    /**
+     * @brief Replace the levels of detail with simplified copies of the owned meshes. Shared meshes are
+     * drawn at full detail on every level
+     *
+     * @param triangleRatios Fraction of the triangles kept by each level, from most to least detailed
+     */
+    void generateLods(const std::vector<float>& triangleRatios = DEFAULT_LOD_RATIOS);
+
+    /**
+     * @brief Append a level of detail simplified elsewhere, such as on a loader thread
+     *
+     * @param meshes Simplified copies of the owned meshes
+     * @param triangleRatio Fraction of the triangles kept, sets the switch size like generateLods
+     */
+    void addLod(std::vector<Mesh>&& meshes, float triangleRatio);
+
+    /** Get the number of levels of detail, including the full detail level */
+    unsigned int getLodCount() const;
+
+    /**
+     * @brief Set the projected size below which a level replaces the one before it
+     *
+     * @param lod Level of detail, 1 or above
+     * @param screenSize Fraction of the viewport height covered by the bounding sphere
+     */
+    void setLodScreenSize(unsigned int lod, float screenSize);
+
+    /**
+     * @brief Choose the level of detail for a projected size. A level only changes once the size is
+     * LOD_HYSTERESIS past the switch size so objects near it do not flicker between levels
+     *
+     * @param screenSize Fraction of the viewport height covered by the bounding sphere, see Renderer::getScreenSize
+     * @param currentLod Level used last frame
+     */
+    unsigned int selectLod(float screenSize, unsigned int currentLod) const;
+
+    /** Get the meshes shared with this model */
+    const std::vector<Mesh*>& getSharedMeshes() const;
+
+    /** Get the local space bounding box of all meshes */
+    const AABB& getAABB() const;
+
+    /** Get the local space bounding sphere of all meshes */
+    const BoundingSphere& getBoundingSphere() const;
+
 private:
+    /** Simplified level of detail */
+    struct LodLevel {
+        /** Simplified copies of the owned meshes */
+        std::vector<Mesh> meshes;
+        /** Projected size below which this level replaces the previous one */
+        float screenSize;
+    };
+
+    /** Rebuild the model bounds from the bounds of its meshes */
+    void updateBounds();
+
     /** Meshes this model is made up of and owns*/
     std::vector<Mesh> mMeshes_;
     /** Meshes owned by another object (likely Resource) and can be shared between mutiple objects */
     std::vector<Mesh*> mSharedMeshes_;
+    /** Levels of detail after the full detail meshes */
+    std::vector<LodLevel> mLods_;
+    /** Local space bounding box of all meshes */
+    AABB mAABB_;
+    /** Local space bounding sphere of all meshes */
+    BoundingSphere mBoundingSphere_;
 };
 
 } // namespace clay
\ No newline at end of file
@@ -0,0 +1,173 @@
+#pragma once
+// standard lib
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+// third party
+#include <glm/glm.hpp>
+// project
+#include "clay/graphics/common/BoundingVolume.h"
+#include "clay/graphics/common/Mesh.h"
+#include "clay/graphics/common/Model.h"
+#include "clay/utils/common/WorkerPool.h"
+
+namespace clay {
+
+/**
+ * @brief Software occlusion culling. Designated occluder meshes are rasterized on the CPU into a small
+ * depth buffer, then bounding boxes are tested against it to find objects hidden behind the occluders.
+ *
+ * The depth buffer stores the nearest occluder depth per pixel. It is split into tiles that are
+ * rasterized independently, so the tiles can be spread across threads. Rows are processed 4 pixels at a
+ * time with SIMD where available. Occluder triangles crossing the near plane are dropped, which only makes
+ * the culling less aggressive.
+ */
+class OcclusionCuller {
+public:
+    /** Default depth buffer width */
+    static constexpr uint32_t DEFAULT_WIDTH = 256;
+    /** Default depth buffer height */
+    static constexpr uint32_t DEFAULT_HEIGHT = 128;
+    /** Tile width in pixels. Multiple of the SIMD width */
+    static constexpr uint32_t TILE_WIDTH = 64;
+    /** Tile height in pixels */
+    static constexpr uint32_t TILE_HEIGHT = 32;
+
+    /** Counts of the current frame */
+    struct Stats {
+        uint32_t occluders = 0;
+        uint32_t occluderTriangles = 0;
+        uint32_t tested = 0;
+        uint32_t culled = 0;
+    };
+
+    /**
+     * @brief Constructor. The size is rounded up to whole tiles
+     *
+     * @param width Depth buffer width
+     * @param height Depth buffer height
+     */
+    OcclusionCuller(uint32_t width = DEFAULT_WIDTH, uint32_t height = DEFAULT_HEIGHT);
+
+    /** Destructor */
+    ~OcclusionCuller();
+
+    /**
+     * @brief Clear the occluders, the depth buffer and the stats for a new frame
+     *
+     * @param viewProjection Projection * View matrix of the camera
+     */
+    void beginFrame(const glm::mat4& viewProjection);
+
+    /**
+     * @brief Add the triangles of a mesh as an occluder
+     *
+     * @param mesh Mesh with its vertices and indices on the CPU
+     * @param model World transform of the mesh
+     */
+    void addOccluder(const Mesh& mesh, const glm::mat4& model);
+
+    /**
+     * @brief Add a Model as an occluder. Its coarsest level of detail is rasterized
+     *
+     * @param model Model to add
+     * @param transform World transform of the Model
+     */
+    void addOccluder(const Model& model, const glm::mat4& transform);
+
+    /**
+     * @brief Rasterize the added occluders into the depth buffer. Call after the occluders are added and
+     * before testing
+     *
+     * @param workerPool Threads to split the tiles across, null to rasterize on the calling thread
+     */
+    void rasterize(utils::WorkerPool* workerPool = nullptr);
+
+    /**
+     * @brief Test if a box may be visible. Boxes crossing the near plane or leaving the screen are visible
+     *
+     * @param box World space box
+     * @return false if the box is hidden behind the occluders
+     */
+    bool isVisible(const AABB& box);
+
+    /** Get the counts of the current frame */
+    const Stats& getStats() const;
+
+    /** Get the depth buffer width */
+    uint32_t getWidth() const;
+
+    /** Get the depth buffer height */
+    uint32_t getHeight() const;
+
+    /** Get the depth buffer, rows bottom to top. Depth is 0 at the near plane and 1 at the far plane */
+    const std::vector<float>& getDepthBuffer() const;
+
+private:
+    /** Screen space occluder triangle set up for rasterization */
+    struct Triangle {
+        /** Edge functions a * x + b * y + c, positive inside */
+        glm::vec3 edgeA;
+        glm::vec3 edgeB;
+        glm::vec3 edgeC;
+        /** Depth plane a * x + b * y + c */
+        glm::vec3 depth;
+        /** Pixel bounds, inclusive */
+        int minX;
+        int minY;
+        int maxX;
+        int maxY;
+    };
+
+    /**
+     * @brief Set up a clip space triangle and add it to the bins of the tiles it covers
+     *
+     * @param v0 First vertex in clip space
+     * @param v1 Second vertex in clip space
+     * @param v2 Third vertex in clip space
+     */
+    void addTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2);
+
+    /**
+     * @brief Rasterize a range of tiles on the calling thread
+     *
+     * @param firstTile Index of the first tile
+     * @param tileCount Number of tiles
+     */
+    void rasterizeTiles(size_t firstTile, size_t tileCount);
+
+    /**
+     * @brief Rasterize the part of a triangle inside a tile
+     *
+     * @param triangle Triangle to rasterize
+     * @param tileX Left pixel of the tile
+     * @param tileY Bottom pixel of the tile
+     */
+    void rasterizeTriangle(const Triangle& triangle, int tileX, int tileY);
+
+    /** Smallest clip w of an occluder vertex. Triangles closer to the camera are dropped */
+    static constexpr float MIN_CLIP_W = 1e-4f;
+
+    /** Depth buffer width */
+    uint32_t mWidth_;
+    /** Depth buffer height */
+    uint32_t mHeight_;
+    /** Number of tile columns */
+    uint32_t mTilesX_;
+    /** Number of tile rows */
+    uint32_t mTilesY_;
+    /** Projection * View of the current frame */
+    glm::mat4 mViewProjection_ = glm::mat4(1.0f);
+    /** Nearest occluder depth per pixel */
+    std::vector<float> mDepth_;
+    /** Occluder triangles of the current frame */
+    std::vector<Triangle> mTriangles_;
+    /** Indices of the triangles touching each tile */
+    std::vector<std::vector<uint32_t>> mTileBins_;
+    /** Clip space vertices of the occluder being added */
+    std::vector<glm::vec4> mClipScratch_;
+    /** Counts of the current frame */
+    Stats mStats_;
+};
+
+} // namespace clay
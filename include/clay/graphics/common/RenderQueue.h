@@ -0,0 +1,246 @@
+#pragma once
+// standard lib
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+// third party
+#include <glm/glm.hpp>
+// project
+#include "clay/graphics/common/DynamicRingBuffer.h"
+#include "clay/graphics/common/IGraphicsAPI.h"
+#include "clay/graphics/common/Mesh.h"
+#include "clay/graphics/common/ShaderProgram.h"
+
+namespace clay {
+
+/**
+ * @brief Collects mesh draws for a frame, sorts them by a 64 bit key and executes them while skipping
+ * state changes shared between consecutive draws.
+ *
+ * Consecutive draws of a shader with an instanced variant that share a mesh and textures are drawn with
+ * one instanced draw. When multi draw indirect is available the grouping extends to draws of different
+ * meshes in the same geometry arena: each mesh gets an indirect command whose base instance selects its
+ * instance data, and the group is submitted with one multiDrawElementsIndirect.
+ *
+ * Key layout (most significant first):
+ *  - Opaque/Overlay: pass(2) shader(12) material(16) mesh(16) depth(18), depth front to back
+ *  - Transparent:    pass(2) depth(24) shader(12) material(14) mesh(12), depth back to front
+ */
+class RenderQueue {
+public:
+    /** Pass a draw belongs to. Passes are executed in this order */
+    enum class Pass : uint8_t {
+        OPAQUE = 0,
+        TRANSPARENT = 1,
+        OVERLAY = 2
+    };
+
+    /** Texture bound to a texture unit for a draw */
+    struct TextureBinding {
+        /** Texture unit */
+        unsigned int unit;
+        /** Texture id */
+        unsigned int textureId;
+        /** Sampler uniform of the draw's shader */
+        ShaderProgram::Uniform<int> uniform;
+        /** Sampler uniform of the instanced variant of the draw's shader */
+        ShaderProgram::Uniform<int> instancedUniform;
+        /** Sampler bound to the unit, 0 to use the texture's own parameters */
+        unsigned int samplerId = 0;
+    };
+
+    /** Everything needed to issue one mesh draw */
+    struct DrawPacket {
+        /** Shader to draw with */
+        const ShaderProgram* shader = nullptr;
+        /** Mesh to draw */
+        const Mesh* mesh = nullptr;
+        /** Textures to bind. Must stay valid until the queue is executed */
+        const TextureBinding* textures = nullptr;
+        /** Number of textures */
+        uint32_t textureCount = 0;
+        /** If the wireframe is also drawn */
+        bool wireframe = false;
+        /** Model matrix */
+        glm::mat4 model = glm::mat4(1.0f);
+        /** Color multiplier */
+        glm::vec4 color = {1.0f, 1.0f, 1.0f, 1.0f};
+        /** Normalized sub image to draw (xy top left, zw size) */
+        glm::vec4 subImage = {0.0f, 0.0f, 1.0f, 1.0f};
+    };
+
+    /** Number of state changes done by the last execute */
+    struct Stats {
+        uint32_t draws = 0;
+        uint32_t instancedDraws = 0;
+        uint32_t multiDraws = 0;
+        uint32_t instances = 0;
+        uint32_t shaderChanges = 0;
+        uint32_t materialChanges = 0;
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param graphicsAPI Graphics API to draw with
+     * @param streamBuffer Per frame buffer the instance data is written to
+     */
+    RenderQueue(IGraphicsAPI& graphicsAPI, DynamicRingBuffer& streamBuffer);
+
+    /** Destructor */
+    ~RenderQueue();
+
+    /**
+     * @brief Add a draw to the queue
+     *
+     * @param packet Draw to add
+     * @param pass Pass of the draw
+     * @param depth Distance from the camera. Used to order draws inside their state group
+     */
+    void submit(const DrawPacket& packet, Pass pass, float depth);
+
+    /**
+     * @brief Sort and draw all submitted packets, then clear the queue
+     */
+    void execute();
+
+    /** Remove all submitted packets without drawing them */
+    void clear();
+
+    /** Get the number of submitted packets */
+    size_t size() const;
+
+    /** Get the state change counts of the last execute */
+    const Stats& getStats() const;
+
+private:
+    /** Sort key with the index of its packet */
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    /** Run of sorted packets drawn with one instanced draw or one multi draw indirect */
+    struct InstanceRun {
+        /** Index of the first packet in the sort entries */
+        uint32_t firstEntry;
+        /** Number of packets */
+        uint32_t count;
+        /** Index of the first instance in the instance buffer */
+        uint32_t firstInstance;
+        /** Index of the first indirect command of the run */
+        uint32_t firstCommand;
+        /** Number of indirect commands. 0 if the run is a single instanced draw */
+        uint32_t commandCount;
+    };
+
+    /** Uniforms the queue sets for each draw */
+    struct ShaderUniforms {
+        ShaderProgram::Uniform<glm::mat4> model;
+        ShaderProgram::Uniform<glm::vec4> color;
+        ShaderProgram::Uniform<glm::vec2> subImageTopLeft;
+        ShaderProgram::Uniform<glm::vec2> subImageSize;
+        ShaderProgram::Uniform<bool> wireframeMode;
+    };
+
+    /**
+     * @brief Build the sort key of a draw
+     *
+     * @param pass Pass of the draw
+     * @param shaderId Compact shader id
+     * @param materialId Hash of the bound textures
+     * @param meshId Compact mesh id
+     * @param depth Distance from the camera
+     */
+    static uint64_t makeSortKey(Pass pass, uint32_t shaderId, uint32_t materialId, uint32_t meshId, float depth);
+
+    /**
+     * @brief Quantize a non negative depth to the given number of bits keeping its order
+     *
+     * @param depth Distance from the camera
+     * @param bits Number of bits of the result
+     */
+    static uint32_t quantizeDepth(float depth, uint32_t bits);
+
+    /** Hash the texture bindings of a packet into a material id */
+    static uint32_t hashMaterial(const DrawPacket& packet);
+
+    /** If two packets bind the same textures to the same units */
+    static bool sameMaterial(const DrawPacket& a, const DrawPacket& b);
+
+    /**
+     * @brief Get the frame local id of a pointer, assigning the next free one if it is new
+     *
+     * @param ids Id table
+     * @param ptr Pointer to get the id of
+     */
+    static uint32_t getCompactId(std::unordered_map<const void*, uint32_t>& ids, const void* ptr);
+
+    /** If two packets can be drawn by the same instanced draw */
+    static bool canInstance(const DrawPacket& a, const DrawPacket& b);
+
+    /** If two packets can be drawn by the same multi draw indirect */
+    static bool canDrawIndirect(const DrawPacket& a, const DrawPacket& b);
+
+    /** LSD radix sort the sort entries by key */
+    void sort();
+
+    /** Find the instance runs in the sorted packets and upload their instance data and indirect commands */
+    void buildInstanceRuns();
+
+    /**
+     * @brief Bind the shader if it is not the current one and resolve its per draw uniforms
+     *
+     * @param shader Shader to bind
+     */
+    void bindShader(const ShaderProgram* shader);
+
+    /**
+     * @brief Bind the packet's textures if they differ from the last bound ones
+     *
+     * @param packet Packet with the textures
+     * @param instanced If the textures are bound for the instanced variant of the packet's shader
+     */
+    void bindMaterial(const DrawPacket& packet, bool instanced);
+
+    /** Minimum number of consecutive packets drawn with instancing */
+    static constexpr uint32_t MIN_INSTANCE_RUN = 2;
+
+    IGraphicsAPI& mGraphicsAPI_;
+    /** Submitted packets */
+    std::vector<DrawPacket> mPackets_;
+    /** Keys of the submitted packets */
+    std::vector<SortEntry> mSortEntries_;
+    /** Scratch buffer for the radix sort */
+    std::vector<SortEntry> mSortScratch_;
+    /** Compact ids of the shaders submitted this frame */
+    std::unordered_map<const void*, uint32_t> mShaderIds_;
+    /** Compact ids of the meshes submitted this frame */
+    std::unordered_map<const void*, uint32_t> mMeshIds_;
+    /** Runs of the current execute drawn with instancing */
+    std::vector<InstanceRun> mInstanceRuns_;
+    /** Instance data of all runs, packed for upload */
+    std::vector<Mesh::Instance> mInstanceStaging_;
+    /** Indirect commands of all runs, packed for upload */
+    std::vector<IGraphicsAPI::DrawElementsIndirectCommand> mIndirectStaging_;
+    /** If runs are drawn with multi draw indirect */
+    bool mMultiDrawIndirect_;
+    /** Per frame buffer holding the instance data and indirect commands */
+    DynamicRingBuffer& mStreamBuffer_;
+    /** Stream buffer holding the instances and commands of the current execute */
+    unsigned int mInstanceBuffer_ = 0;
+    /** Index of the first instance of the current execute in the stream buffer */
+    size_t mInstanceBase_ = 0;
+    /** Offset of the first indirect command of the current execute in the stream buffer */
+    size_t mIndirectBase_ = 0;
+    /** Shader bound by the current execute */
+    const ShaderProgram* mCurrentShader_ = nullptr;
+    /** Per draw uniforms of the current shader */
+    ShaderUniforms mCurrentUniforms_;
+    /** Packet whose textures are currently bound. nullptr if unknown */
+    const DrawPacket* mCurrentMaterial_ = nullptr;
+    /** State change counts of the last execute */
+    Stats mStats_;
+};
+
+} // namespace clay
@@ -1,10 +1,18 @@
 #pragma once
+// standard lib
+#include <unordered_map>
+#include <vector>
 // third party
 // project
 #include "clay/graphics/common/Camera.h"
+#include "clay/graphics/common/DebugDraw.h"
+#include "clay/graphics/common/DynamicRingBuffer.h"
 #include "clay/graphics/common/Font.h"
+#include "clay/graphics/common/Frustum.h"
+#include "clay/graphics/common/LightClusters.h"
 #include "clay/graphics/common/LightSource.h"
 #include "clay/graphics/common/Mesh.h"
+#include "clay/graphics/common/RenderQueue.h"
 #include "clay/graphics/common/ShaderProgram.h"
 #include "clay/graphics/common/SpriteSheet.h"
 #include "clay/graphics/common/Texture.h"
@@ -21,13 +29,20 @@ public:
      *
      * @param screenDim Screen dimensions
      * @param spriteShader Shader for rendering spites
+     * @param spriteInstancedShader Shader for rendering batched sprites with instancing
      * @param text2Shader Shader for rendering text
-     * @param mvpShader shader for rendering simple shapes
      * @param rectPlane Mesh for a simple rect shape
+     * @param bloomDownsampleShader Shader for downsampling the bloom mip chain
+     * @param bloomUpsampleShader Shader for upsampling and accumulating the bloom mip chain
+     * @param bloomFinalShader Shader for combining the scene and bloom
+     * @param debugLineShader Shader for batched debug lines
+     * @param debugThickLineShader Shader for batched debug lines with a thickness
      */
-    Renderer(const glm::vec2& screenDim, ShaderProgram& spriteShader,
-        ShaderProgram& text2Shader, ShaderProgram& mvpShader, Mesh& rectPlane,
-        ShaderProgram& frameBufferShader, ShaderProgram& bloomFinalShader, IGraphicsAPI& graphicsAPI);
+    Renderer(const glm::vec2& screenDim, ShaderProgram& spriteShader, ShaderProgram& spriteInstancedShader,
+        ShaderProgram& text2Shader, Mesh& rectPlane,
+        ShaderProgram& bloomDownsampleShader, ShaderProgram& bloomUpsampleShader,
+        ShaderProgram& bloomFinalShader, ShaderProgram& debugLineShader,
+        ShaderProgram& debugThickLineShader, IGraphicsAPI& graphicsAPI);
 
     /** Destructor*/
     ~Renderer();
@@ -39,10 +54,78 @@ public:
      */
     void setCamera(const Camera* camera);
 
+    /**
+     * @brief Get the view frustum of the current camera
+     */
+    const Frustum& getFrustum() const;
+
+    /** Get the Projection * View matrix of the current camera */
+    glm::mat4 getViewProjection() const;
+
+    /**
+     * @brief Get the fraction of the viewport height a sphere covers with the current camera
+     *
+     * @param sphere World space bounding sphere
+     */
+    float getScreenSize(const BoundingSphere& sphere) const;
+
+    /**
+     * @brief Set the lights used by the lit shaders. Lights with a range are binned into the clusters of
+     * the current camera, they are rebinned when the camera changes
+     *
+     * @param lights Lights to render with
+     */
     void setLightSources(const std::vector<std::unique_ptr<LightSource>>& lights) const;
 
     void setLightSources(const std::vector<LightSource*>& lights) const;
 
+    /**
+     * @brief Start collecting sprites into a batch. Until endSpriteBatch is called, renderSprite only
+     * records the sprite and the draw is deferred.
+     */
+    void beginSpriteBatch();
+
+    /**
+     * @brief Draw all sprites collected since beginSpriteBatch. Sprites are grouped by texture and each
+     * group is drawn with a single instanced draw call. Draw order is only preserved within a texture group.
+     */
+    void endSpriteBatch();
+
+    /**
+     * @brief If sprites are currently being collected into a batch
+     */
+    bool isSpriteBatching() const;
+
+    /**
+     * @brief Start collecting mesh draws into the render queue. Until endRenderQueue is called,
+     * renderables submit draw packets instead of drawing.
+     */
+    void beginRenderQueue();
+
+    /**
+     * @brief Sort the draws collected since beginRenderQueue by pass and state and draw them
+     */
+    void endRenderQueue();
+
+    /**
+     * @brief If mesh draws are currently being collected into the render queue
+     */
+    bool isRenderQueueActive() const;
+
+    /**
+     * @brief Add a draw to the render queue. The depth is taken from the model translation and the
+     * current camera position
+     *
+     * @param packet Draw to add
+     * @param pass Pass of the draw
+     */
+    void submit(const RenderQueue::DrawPacket& packet, RenderQueue::Pass pass) const;
+
+    /**
+     * @brief Get the state change counts of the last executed render queue
+     */
+    const RenderQueue::Stats& getRenderQueueStats() const;
+
     /**
      * Render the given Texture with the applied camera and model transforms
      * @param textureId Texture Id to Render
@@ -86,13 +169,34 @@ public:
      */
     void renderTextCentered(const std::string& text, const glm::vec2& position, const Font& font, float scale, const glm::vec4& color);
 
-    // Render line (coords, color, thickness)
-    // Render shapes square/circle/triangle (hollow/color/thickness)
-
+    /**
+     * @brief Add the outline of the unit rect to the debug draw batch
+     *
+     * @param modelMat Transform of the rect
+     * @param theColor Outline color
+     */
     void renderRectangleSimple(const glm::mat4& modelMat, const glm::vec4& theColor) const;
 
+    /**
+     * @brief Add a line to the debug draw batch
+     *
+     * @param startPoint Start position
+     * @param endPoint End position
+     * @param modelMat Transform of the line
+     * @param theColor Line color
+     */
     void renderLineSimple(const glm::vec3& startPoint, const glm::vec3& endPoint, const glm::mat4& modelMat, const glm::vec4& theColor) const;
 
+    /**
+     * @brief Get the debug shape batch. Shapes are drawn on flushDebugDraw with the camera current at that time
+     */
+    DebugDraw& getDebugDraw() const;
+
+    /**
+     * @brief Draw the debug shapes added since the last flush
+     */
+    void flushDebugDraw();
+
     /**
      * @brief Get the ID for the Renderer's HDR Frame Buffer Object
      *
@@ -106,6 +210,11 @@ public:
      */
     void renderHDR();
 
+    /**
+     * @brief Finish the frame's streamed data. Call once per frame after the last draw
+     */
+    void endFrame();
+
     /**
      * @brief Enable/disable bloom rendering
      *
@@ -113,6 +222,20 @@ public:
      */
     void setBloom(bool enable);
 
+    /** If bloom is enabled */
+    bool isBloomEnabled() const;
+
+    /**
+     * @brief Set the radius of the bloom upsample filter in texture coordinates. Larger values spread
+     * the glow further
+     *
+     * @param radius Filter radius
+     */
+    void setBloomRadius(float radius);
+
+    /** Get the radius of the bloom upsample filter */
+    float getBloomRadius() const;
+
     /**
      * @brief Set the Exposure applied when rendering with bloom
      *
@@ -142,41 +265,153 @@ public:
 
     void enableWireFrame(bool enabled) const;
 
+    /** Maximum number of mips in the bloom chain */
+    static constexpr unsigned int BLOOM_MIP_COUNT = 6;
+    /** Initial bytes per frame of the stream buffer lines, text, sprite batches and instances are written to */
+    static constexpr size_t STREAM_BUFFER_FRAME_SIZE = 1024 * 1024;
+
 private:
-    /** Max number of light that can be rendered with */
-    const static int MAX_LIGHTS;
+    /** Level of the bloom mip chain */
+    struct BloomMip {
+        /** Size in pixels */
+        glm::ivec2 size;
+        /** Color texture */
+        unsigned int texture;
+    };
+
+    /** Downsample the bright buffer through the bloom mips and upsample back into the first mip */
+    void renderBloom();
+
+    /** Per instance data of a batched sprite. Layout matches the SpriteInstanced shader attributes */
+    struct SpriteInstance {
+        /** Model matrix */
+        glm::mat4 model;
+        /** Normalized sub image to draw (xy top left, zw size) */
+        glm::vec4 subImage;
+        /** Color multiplier */
+        glm::vec4 color;
+    };
+
+    /**
+     * @brief Add a sprite to the current batch
+     *
+     * @param textureId Texture to draw the sprite with
+     * @param modelMat Model matrix of the sprite
+     * @param subImage Normalized sub image to draw (xy top left, zw size)
+     * @param theColor Color multiplier
+     */
+    void addToSpriteBatch(unsigned int textureId, const glm::mat4& modelMat, const glm::vec4& subImage, const glm::vec4& theColor) const;
+
+    /**
+     * @brief Point the per instance attributes of the sprite batch VAO at the given instance in the instance buffer.
+     * The instance buffer must be bound to ARRAY_BUFFER
+     *
+     * @param baseOffset Byte offset of the first instance to draw in the instance buffer
+     */
+    void setSpriteInstanceAttributes(size_t baseOffset) const;
+
+    /**
+     * @brief Append the glyph quads of the text to the text vertex staging buffer
+     *
+     * @param text Text to layout
+     * @param font Font of the text
+     * @param origin Baseline start of the text, or the baseline center if centered
+     * @param scale Horizontal and vertical glyph scale
+     * @param centered If the text is horizontally centered on the origin
+     */
+    void layoutText(const std::string& text, const Font& font, const glm::vec2& origin, const glm::vec2& scale, bool centered);
+
+    /**
+     * @brief Upload the text vertex staging buffer and draw it with a single draw call
+     *
+     * @param font Font the text was laid out with
+     * @param color Text color
+     * @param modelMat Transformation applied to the text
+     */
+    void drawTextVertices(const Font& font, const glm::vec3& color, const glm::mat4& modelMat);
+
+    /** Bin the current lights for the current camera and upload the light and cluster buffers */
+    void updateLightClusters() const;
+
+    /** Write the current camera matrices to the stream buffer and bind them to the camera uniform block */
+    void uploadCameraData();
 
     /* VAO for a texture quad **/
     unsigned int mTextureQuadVAO_;
-    /** Shader for rendering sprites/textures */
-    const ShaderProgram& mMVPShader_;
     /** Shader used to render sprites */
     const ShaderProgram& mSpriteShader_;
+    /** Shader used to render batched sprites */
+    const ShaderProgram& mSpriteInstancedShader_;
     /** Shader for rendering Texts */
     const ShaderProgram& mTextShader_;
 
     Mesh mRectPlane_;
 
-    unsigned int mRectVAO_;
-
-    unsigned int mLineVAO_;
-    unsigned int mLineVBO_;
 
     glm::mat4 mDefaultProjection_;
-    /** Uniform buffer object to hold camera uniform variables shared by shaders */
-    unsigned int mCameraUBO_;
-    /** Uniform buffer object to hold light uniform variables shared by shaders */
+    /** World position of the current camera */
+    glm::vec3 mCameraPosition_ = {0.0f, 0.0f, 0.0f};
+    /** View frustum of the current camera */
+    Frustum mFrustum_;
+    /** View matrix of the current camera */
+    glm::mat4 mCameraView_ = glm::mat4(1.0f);
+    /** Projection matrix of the current camera */
+    glm::mat4 mCameraProjection_ = glm::mat4(1.0f);
+    /** Screen dimensions in pixels */
+    glm::vec2 mScreenDim_;
+    /** Uniform buffer object to hold the light cluster grid parameters shared by shaders */
     unsigned int mLightUBO_;
+    /** Texture buffer of the packed lights */
+    unsigned int mLightDataBuffer_;
+    unsigned int mLightDataTexture_;
+    /** Texture buffer of the light index list offset and count of each cluster */
+    unsigned int mLightClusterBuffer_;
+    unsigned int mLightClusterTexture_;
+    /** Texture buffer of the light index list */
+    unsigned int mLightIndexBuffer_;
+    unsigned int mLightIndexTexture_;
+    /** Lights of the last setLightSources call. Lights without a range come first */
+    mutable std::vector<LightClusters::Light> mLights_;
+    /** Number of lights without a range, applied to every fragment */
+    mutable size_t mUnboundedLightCount_ = 0;
+    /** Froxel grid the lights are binned into */
+    mutable LightClusters mLightClusters_;
+    /** Reused to forward the owning overload of setLightSources */
+    mutable std::vector<LightSource*> mLightPointers_;
 
     unsigned int mFrameVAO_;
 
+    /** VAO for the batched sprite quad and its per instance attributes */
+    unsigned int mSpriteBatchVAO_;
+    /** If renderSprite calls are currently being batched */
+    mutable bool mSpriteBatching_ = false;
+    /** Batched sprite instances by texture id. Vectors are kept between batches to reuse their allocation */
+    mutable std::unordered_map<unsigned int, std::vector<SpriteInstance>> mSpriteBatch_;
+    /** Texture ids in the order they were first used in the current batch */
+    mutable std::vector<unsigned int> mSpriteBatchOrder_;
+    /** All instances packed by texture group for upload */
+    std::vector<SpriteInstance> mSpriteBatchStaging_;
+
+    /** VAO for text rendering */
+    unsigned int mTextVAO_;
+    /** Glyph quad vertices (xy position, zw uv) waiting to be uploaded */
+    std::vector<glm::vec4> mTextVertices_;
+
     unsigned int hdrFBO_;
     unsigned int colorBuffers_[2];
 
-    unsigned int pingpongFBO_[2];
-    unsigned int pingpongColorbuffers_[2];
+    /** Framebuffer the bloom mips are attached to in turn */
+    unsigned int mBloomFBO_;
+    /** Bloom mip chain, each mip half the size of the previous one starting at half the screen size */
+    std::vector<BloomMip> mBloomMips_;
+    /** If bloom is enabled */
+    bool mBloomEnabled_ = false;
+    /** Radius of the bloom upsample filter in texture coordinates */
+    float mBloomRadius_ = 0.005f;
 
-    const ShaderProgram& mBlurShader_;
+    const ShaderProgram& mBloomDownsampleShader_;
+
+    const ShaderProgram& mBloomUpsampleShader_;
 
     const ShaderProgram& mBloomFinalShader_;
 
@@ -188,6 +423,55 @@ private:
 
     IGraphicsAPI& mGraphicsAPI_;
 
+    /** Per frame buffer for streamed vertices, instances and camera uniforms */
+    mutable DynamicRingBuffer mStreamBuffer_;
+    /** Batched debug shapes */
+    mutable DebugDraw mDebugDraw_;
+    /** Queue of sorted mesh draws */
+    mutable RenderQueue mRenderQueue_;
+    /** If mesh draws are currently being queued */
+    bool mRenderQueueActive_ = false;
+
+    /** Pre-resolved uniforms of the sprite shader */
+    struct {
+        ShaderProgram::Uniform<glm::mat4> model;
+        ShaderProgram::Uniform<int> texture;
+        ShaderProgram::Uniform<glm::vec2> subImageTopLeft;
+        ShaderProgram::Uniform<glm::vec2> subImageSize;
+        ShaderProgram::Uniform<glm::vec4> color;
+    } mSpriteUniforms_;
+
+    /** Pre-resolved uniforms of the instanced sprite shader */
+    struct {
+        ShaderProgram::Uniform<int> texture;
+    } mSpriteInstancedUniforms_;
+
+    /** Pre-resolved uniforms of the text shader */
+    struct {
+        ShaderProgram::Uniform<glm::vec3> textColor;
+        ShaderProgram::Uniform<glm::mat4> model;
+    } mTextUniforms_;
+
+    /** Pre-resolved uniforms of the bloom downsample shader */
+    struct {
+        ShaderProgram::Uniform<int> source;
+    } mBloomDownsampleUniforms_;
+
+    /** Pre-resolved uniforms of the bloom upsample shader */
+    struct {
+        ShaderProgram::Uniform<int> source;
+        ShaderProgram::Uniform<float> filterRadius;
+    } mBloomUpsampleUniforms_;
+
+    /** Pre-resolved uniforms of the bloom final shader */
+    struct {
+        ShaderProgram::Uniform<int> scene;
+        ShaderProgram::Uniform<int> bloomBlur;
+        ShaderProgram::Uniform<bool> gammaCorrect;
+        ShaderProgram::Uniform<bool> bloom;
+        ShaderProgram::Uniform<float> exposure;
+    } mBloomFinalUniforms_;
+
 };
 
 } // namespace clay
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+// standard lib
+#include <cstdint>
+#include <memory>
+// project
+#include "clay/graphics/common/IGraphicsAPI.h"
+
+namespace clay {
+
+/** How a texture is sampled */
+struct SamplerState {
+    /** Filtering between texels and between mip levels */
+    enum class Filter : uint8_t {
+        /** Closest texel */
+        NEAREST,
+        /** Blend of the 4 closest texels */
+        LINEAR,
+        /** LINEAR in the closest mip level */
+        BILINEAR,
+        /** LINEAR in the 2 closest mip levels, blended */
+        TRILINEAR
+    };
+
+    /** Filter of the sampler. BILINEAR and TRILINEAR fall back to LINEAR for textures without mips */
+    Filter filter = Filter::NEAREST;
+    /** Wrap mode of the horizontal texture coordinate */
+    IGraphicsAPI::TextureParameterOption wrapS = IGraphicsAPI::TextureParameterOption::CLAMP_TO_BORDER;
+    /** Wrap mode of the vertical texture coordinate */
+    IGraphicsAPI::TextureParameterOption wrapT = IGraphicsAPI::TextureParameterOption::CLAMP_TO_BORDER;
+    /** Maximum anisotropy. 1 disables anisotropic filtering, values above the supported maximum are clamped */
+    float maxAnisotropy = 1.0f;
+
+    /**
+     * @brief Trilinear filtering with repeating coordinates, for mipmapped surface textures
+     *
+     * @param maxAnisotropy Maximum anisotropy
+     */
+    static SamplerState trilinear(float maxAnisotropy = 8.0f);
+
+    /** If mip levels are read */
+    bool usesMipmaps() const;
+
+    bool operator==(const SamplerState& other) const;
+};
+
+/**
+ * @brief Sampler object holding a SamplerState. Samplers are shared between all textures with the same
+ * state, bind it to the texture unit next to the texture to apply it.
+ */
+class Sampler {
+public:
+    /**
+     * @brief Get the sampler of a state, creating it if no texture uses one. Samplers live while they are
+     * referenced
+     *
+     * @param graphicsAPI Graphics API the sampler belongs to
+     * @param state Sampler state
+     */
+    static std::shared_ptr<const Sampler> acquire(IGraphicsAPI& graphicsAPI, const SamplerState& state);
+
+    /**
+     * @brief Constructor. Use acquire to share samplers between textures
+     *
+     * @param graphicsAPI Graphics API to create the sampler with
+     * @param state Sampler state
+     */
+    Sampler(IGraphicsAPI& graphicsAPI, const SamplerState& state);
+
+    /** Destructor */
+    ~Sampler();
+
+    Sampler(const Sampler&) = delete;
+    Sampler& operator=(const Sampler&) = delete;
+
+    /** Get the sampler id */
+    unsigned int getId() const;
+
+    /** Get the sampler state */
+    const SamplerState& getState() const;
+
+    /**
+     * @brief Get the min filter parameter of a state
+     *
+     * @param state Sampler state
+     */
+    static IGraphicsAPI::TextureParameterOption getMinFilter(const SamplerState& state);
+
+    /**
+     * @brief Get the mag filter parameter of a state
+     *
+     * @param state Sampler state
+     */
+    static IGraphicsAPI::TextureParameterOption getMagFilter(const SamplerState& state);
+
+private:
+    /** Graphics API */
+    IGraphicsAPI& mGraphicsAPI_;
+    /** Sampler state */
+    SamplerState mState_;
+    /** Sampler id */
+    unsigned int mSamplerId_ = 0;
+};
+
+} // namespace clay
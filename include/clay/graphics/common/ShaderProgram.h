@@ -1,8 +1,11 @@
 #pragma once
 // standard lib
+#include <array>
 #include <cstdint>
 #include <string>
 #include <stdexcept>
+#include <unordered_map>
+#include <vector>
 // third party
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -13,19 +16,68 @@ namespace clay {
 
 class ShaderProgram {
 public:
+    /**
+     * @brief Pre-resolved handle to a uniform of this program. Get it once with getUniform and set values
+     * through it to avoid the per call name lookup
+     *
+     * @tparam T Value type of the uniform
+     */
+    template<typename T>
+    struct Uniform {
+        /** Index into the program's uniform table. -1 if unresolved */
+        int index = -1;
+
+        /** If this handle has been resolved */
+        bool isValid() const { return index >= 0; }
+    };
+
     ShaderProgram(IGraphicsAPI& graphicsAPI);
 
     ~ShaderProgram();
 
     void addShader(const ShaderCreateInfo& shaderInfo);
 
+    /**
+     * @brief Link the program and reflect its active uniforms. Handles retrieved before a relink are invalidated
+     */
     void linkProgram();
 
     void bind() const;
 
     bool checkCompileErrors(unsigned int shaderID, ShaderCreateInfo::Type type);
 
-    // utility uniform functions
+    /**
+     * @brief Get a handle for the named uniform. Uniforms that are not active in the program still get a
+     * valid handle, setting them is a no-op
+     *
+     * @tparam T Value type of the uniform
+     * @param name Uniform name
+     */
+    template<typename T>
+    Uniform<T> getUniform(const std::string& name) const;
+
+    // Uniform functions through handles. Values matching the last set value are not sent to the driver
+    void setUniform(Uniform<bool> uniform, bool value) const;
+    void setUniform(Uniform<int> uniform, int value) const;
+    void setUniform(Uniform<float> uniform, float value) const;
+    void setUniform(Uniform<glm::vec2> uniform, const glm::vec2& value) const;
+    void setUniform(Uniform<glm::vec3> uniform, const glm::vec3& value) const;
+    void setUniform(Uniform<glm::vec4> uniform, const glm::vec4& value) const;
+    void setUniform(Uniform<glm::mat2> uniform, const glm::mat2& mat) const;
+    void setUniform(Uniform<glm::mat3> uniform, const glm::mat3& mat) const;
+    void setUniform(Uniform<glm::mat4> uniform, const glm::mat4& mat) const;
+
+    /**
+     * @brief Bind a texture and its sampler to a texture unit and point a sampler uniform at the unit
+     *
+     * @param uniform Sampler uniform
+     * @param textureId Texture to bind
+     * @param textureUnit Texture unit
+     * @param samplerId Sampler to bind to the unit, 0 to use the texture's own parameters
+     */
+    void setTexture(Uniform<int> uniform, unsigned int textureId, unsigned int textureUnit, unsigned int samplerId = 0) const;
+
+    // utility uniform functions. Slower than the handle functions since the name is looked up each call
     void setBool(const std::string& name, bool value) const;
     void setInt(const std::string& name, int value) const;
     void setFloat(const std::string& name, float value) const;
@@ -39,15 +91,61 @@ public:
     void setMat3(const std::string& name, const glm::mat3& mat) const;
     void setMat4(const std::string& name, const glm::mat4& mat) const;
 
-    void setTexture(const std::string& uniformName, unsigned int textureId, unsigned int textureUnit) const;
+    void setTexture(const std::string& uniformName, unsigned int textureId, unsigned int textureUnit, unsigned int samplerId = 0) const;
 
     /** Get the shader program Id*/
     unsigned int getProgramId() const;
 
+    /**
+     * @brief Set the instanced variant of this shader. Queued draws of this shader sharing a mesh and
+     * textures are drawn with the variant in one instanced draw. The variant reads the model matrix and
+     * color from the Mesh::Instance attributes instead of uModel and uColor
+     *
+     * @param variant Instanced shader, or nullptr to disable instancing
+     */
+    void setInstancedVariant(const ShaderProgram* variant);
+
+    /** Get the instanced variant of this shader. nullptr if none */
+    const ShaderProgram* getInstancedVariant() const;
+
 private:
+    /** Uniform location with a shadow copy of the last value sent to the driver */
+    struct UniformSlot {
+        /** Location in the program. -1 if the uniform is not active */
+        int location;
+        /** Last value set, large enough for a mat4 */
+        std::array<unsigned char, sizeof(glm::mat4)> shadowValue;
+        /** If shadowValue holds a value */
+        bool shadowValid;
+    };
+
+    /**
+     * @brief Get the index of the named uniform in the uniform table. Names not found by reflection
+     * (such as array elements) are resolved with the graphics API and added to the table
+     *
+     * @param name Uniform name
+     */
+    int getUniformIndex(const std::string& name) const;
+
+    /**
+     * @brief Compare the value with the uniform's shadow copy and update it
+     *
+     * @param index Uniform table index
+     * @param value Value being set
+     * @param size Size of the value in bytes
+     * @return true if the value needs to be sent to the driver
+     */
+    bool updateShadow(int index, const void* value, size_t size) const;
+
     /** Program Id for this Shader*/
     unsigned int mProgramId_;
     IGraphicsAPI& mGraphicsAPI_;
+    /** Uniform table filled by reflection after linking */
+    mutable std::vector<UniformSlot> mUniforms_;
+    /** Uniform table index by uniform name */
+    mutable std::unordered_map<std::string, int> mUniformIndexByName_;
+    /** Instanced variant of this shader */
+    const ShaderProgram* mpInstancedVariant_ = nullptr;
 };
 
 } // namespace clay
\ No newline at end of file
@@ -1,8 +1,12 @@
 #pragma once
+// standard lib
+#include <string>
 // third party
 #include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 // project
 #include "clay/graphics/common/Texture.h"
+#include "clay/graphics/common/TextureAtlas.h"
 
 namespace clay {
 
@@ -15,6 +19,8 @@ public:
         glm::ivec2 gridIndex;
         /** The size of this sprite. Can be used to draw a sprite consisting of multiple grids */
         glm::ivec2 spriteSize;
+        /** Name of the atlas region of this sprite, for Sprite Sheets built from a TextureAtlas */
+        std::string regionName;
 
         /**
          * Constructor
@@ -30,6 +36,13 @@ public:
          * @param theGridIndex Grid index of the Sprite Sheet
          */
         Sprite(SpriteSheet& theSpriteSheet, const glm::ivec2& theGridIndex);
+
+        /**
+         * Constructor for a sprite in an atlas
+         * @param theSpriteSheet Parent Sprites Sheet, built from a TextureAtlas
+         * @param theRegionName Name the sprite image was added to the atlas with
+         */
+        Sprite(SpriteSheet& theSpriteSheet, const std::string& theRegionName);
     };
 
     /**
@@ -48,6 +61,14 @@ public:
      */
     SpriteSheet(const Texture& texture, const glm::ivec2& defaultSpiteSize);
 
+    /**
+     * @brief Sprite Sheet of the images packed in an atlas. Sprites are looked up by region name and
+     * follow the atlas when it is rebuilt
+     *
+     * @param atlas Texture atlas, must outlive the Sprite Sheet
+     */
+    SpriteSheet(const TextureAtlas& atlas);
+
     /** Destructor */
     ~SpriteSheet();
 
@@ -59,7 +80,18 @@ public:
 
     /** Get the default sprite size for this Sprite Sheet */
     glm::ivec2 getDefaultSpriteSize() const;
+
+    /**
+     * @brief Get the area of a sprite in the texture
+     *
+     * @param sprite Sprite of this Sprite Sheet
+     * @return Top left corner and size in normalized texture coordinates. Empty if an atlas sprite's
+     * region is not built
+     */
+    glm::vec4 getSubImage(const Sprite& sprite) const;
 private:
+    /** Atlas of the sprites, nullptr for grid Sprite Sheets */
+    const TextureAtlas* mpAtlas_ = nullptr;
     /** Texture Id*/
     unsigned int mTextureId_;
     /** Sprite sheet size in pixels*/
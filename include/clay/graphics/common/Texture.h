@@ -1,17 +1,48 @@
 #pragma once
 // standard lib
 #include <filesystem>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 // third party
 #include <glm/vec2.hpp>
 // project
+#include "clay/graphics/common/CompressedImage.h"
 #include "clay/graphics/common/IGraphicsAPI.h"
+#include "clay/graphics/common/Sampler.h"
 #include "clay/utils/common/Utils.h"
 
 namespace clay {
 
 class Texture {
 public:
+    /** How the mip chain of a Texture is built */
+    enum class MipmapMode : uint8_t {
+        /** Only the base level */
+        NONE,
+        /** Generated by the GPU from the base level */
+        GPU,
+        /** Box filtered on the CPU, in linear space for gamma corrected textures */
+        CPU
+    };
+
+    /** How a Texture is created and sampled */
+    struct CreateInfo {
+        /** If the pixels are sRGB encoded */
+        bool gammaCorrect = false;
+        /** How the mip chain is built */
+        MipmapMode mipmaps = MipmapMode::NONE;
+        /** State of the shared sampler of the Texture */
+        SamplerState sampler;
+
+        /**
+         * @brief GPU generated mips with trilinear, anisotropic filtering and repeating coordinates
+         *
+         * @param gammaCorrect If the pixels are sRGB encoded
+         */
+        static CreateInfo mipmapped(bool gammaCorrect = false);
+    };
+
     /**
      * @brief Create a Texture out of given pixel data
      *
@@ -24,6 +55,30 @@ public:
 
     Texture(IGraphicsAPI& graphicsAPI, utils::ImageData& imageData, bool gammaCorrect = false);
 
+    /**
+     * @brief Create a Texture out of given pixel data
+     *
+     * @param textureData Pixel data
+     * @param width width in pixels
+     * @param height height in pixels
+     * @param channels channels per pixel
+     * @param createInfo Mips and sampling of the Texture
+     */
+    Texture(IGraphicsAPI& graphicsAPI, const unsigned char* textureData, int width, int height, int channels, const CreateInfo& createInfo);
+
+    Texture(IGraphicsAPI& graphicsAPI, utils::ImageData& imageData, const CreateInfo& createInfo);
+
+    /**
+     * @brief Create a Texture out of a block compressed mip chain. The levels are uploaded compressed if
+     * the driver supports the format, otherwise they are decoded to RGBA8 on the CPU
+     *
+     * @param image Compressed mip chain
+     * @param sampler State of the shared sampler of the Texture
+     * @param decodedLevels RGBA8 levels already decoded with CompressedImage::decodeLevel, such as on a
+     * loader thread. Used instead of decoding when the driver does not support the format
+     */
+    Texture(IGraphicsAPI& graphicsAPI, const CompressedImage& image, const SamplerState& sampler = SamplerState::trilinear(), const std::vector<std::vector<unsigned char>>& decodedLevels = {});
+
     /**
      * @brief Destructor. Frees the GL texture id
      */
@@ -48,9 +103,28 @@ public:
     /** Get Width x Height in pixels */
     glm::ivec2 getShape() const;
 
+    /** Get the number of mip levels, including the base level */
+    unsigned int getMipLevels() const;
+
+    /** Get the id of the sampler to bind with this Texture */
+    unsigned int getSamplerId() const;
+
+    /** If the Texture is stored block compressed on the GPU */
+    bool isCompressed() const;
+
     std::vector<unsigned char> getPixelData();
 
+    /**
+     * @brief Get the number of levels of a full mip chain
+     *
+     * @param width Width of the base level
+     * @param height Height of the base level
+     */
+    static unsigned int getMipLevelCount(int width, int height);
+
 private:
+    friend class TextureStreamer;
+
     /**
      * @brief Helper method to convert pixel data into a GL texture data
      *
@@ -58,9 +132,44 @@ private:
      * @param width Width in pixels
      * @param height Height in pixels
      * @param channels Channels per pixel
+     * @param createInfo Mips and sampling of the Texture
+     * @param outMipLevels Set to the number of uploaded mip levels
+     * @return Gl Texture Id
+     */
+    static unsigned int genGLTexture(IGraphicsAPI& graphicsAPI, const unsigned char* textureData, int width, int height, int channels, const CreateInfo& createInfo, unsigned int& outMipLevels);
+
+    /**
+     * @brief Helper method to upload a compressed mip chain into a GL texture
+     *
+     * @param image Compressed mip chain
+     * @param sampler Sampler state of the Texture
+     * @param decodedLevels Levels decoded ahead of time, or empty to decode them here if needed
+     * @param outCompressed Set to false if the levels were decoded on the CPU
      * @return Gl Texture Id
      */
-    static unsigned int genGLTexture(IGraphicsAPI& graphicsAPI, const unsigned char* textureData, int width, int height, int channels, bool gammaCorrect = false);
+    static unsigned int genGLCompressedTexture(IGraphicsAPI& graphicsAPI, const CompressedImage& image, const SamplerState& sampler, const std::vector<std::vector<unsigned char>>& decodedLevels, bool& outCompressed);
+
+    /**
+     * @brief Set the texture's own sampling parameters of the bound texture. They apply where it is bound
+     * without its sampler, such as the GUI
+     *
+     * @param sampler Sampler state of the Texture
+     * @param hasMipChain If all mip levels are uploaded
+     */
+    static void setTextureParameters(IGraphicsAPI& graphicsAPI, const SamplerState& sampler, bool hasMipChain);
+
+
+    /**
+     * @brief Box filter pixel data to half its size
+     *
+     * @param pixels Pixel data
+     * @param width Width in pixels
+     * @param height Height in pixels
+     * @param channels Channels per pixel
+     * @param gammaCorrect If the color channels are sRGB encoded
+     * @return Pixels of the next mip level
+     */
+    static std::vector<unsigned char> downsample(const unsigned char* pixels, int width, int height, int channels, bool gammaCorrect);
 
 
     IGraphicsAPI& mGraphicsAPI_;
@@ -72,6 +181,14 @@ private:
     int mHeight_;
     /** Channels per pixel */
     int mChannels_;
+    /** Number of mip levels */
+    unsigned int mMipLevels_ = 1;
+    /** If the texels are stored block compressed */
+    bool mCompressed_ = false;
+    /** Shared sampler with the state the Texture was created with */
+    std::shared_ptr<const Sampler> mSampler_;
+    /** Set for streamed Textures. Expires on destruction to cancel the pending uploads */
+    std::shared_ptr<bool> mLifetime_;
 };
 
 } // namespace clay
\ No newline at end of file
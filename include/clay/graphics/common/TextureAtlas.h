@@ -0,0 +1,178 @@
+#pragma once
+// standard lib
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+// third party
+#include <glm/glm.hpp>
+// project
+#include "clay/graphics/common/IGraphicsAPI.h"
+#include "clay/graphics/common/Texture.h"
+
+namespace clay {
+
+/**
+ * @brief Packs many small images into one Texture so sprites drawn from them share a texture and batch
+ * together. Images are placed with a skyline packer, each surrounded by padding filled with its
+ * extruded edge texels so filtering and the first mip levels do not bleed in neighbouring images.
+ *
+ * Images added after a build are packed around the existing ones and uploaded as sub images. The atlas
+ * is only grown and repacked when they no longer fit, which moves every region.
+ */
+class TextureAtlas {
+public:
+    /** Placement of an image in the atlas */
+    struct Region {
+        /** Top left corner and size in normalized texture coordinates */
+        glm::vec4 uvRect;
+        /** Top left texel of the image */
+        glm::ivec2 position;
+        /** Size of the image in texels */
+        glm::ivec2 size;
+    };
+
+    /** Default padding around each image in texels */
+    static constexpr int DEFAULT_PADDING = 2;
+    /** Default largest atlas width and height */
+    static constexpr int DEFAULT_MAX_SIZE = 4096;
+
+    /**
+     * @brief Constructor
+     *
+     * @param graphicsAPI Graphics API to create the atlas texture with
+     * @param createInfo Mips and sampling of the atlas texture
+     * @param padding Texels of extruded edges around each image
+     * @param maxSize Largest atlas width and height
+     */
+    TextureAtlas(IGraphicsAPI& graphicsAPI, const Texture::CreateInfo& createInfo = {}, int padding = DEFAULT_PADDING, int maxSize = DEFAULT_MAX_SIZE);
+
+    /** Destructor */
+    ~TextureAtlas();
+
+    /**
+     * @brief Add an image to pack on the next build. Adding an existing name replaces its image
+     *
+     * @param name Name to look the region up by
+     * @param pixels Pixel data, rows top to bottom
+     * @param width Width in pixels
+     * @param height Height in pixels
+     * @param channels Channels per pixel, 1 to 4
+     */
+    void add(const std::string& name, const unsigned char* pixels, int width, int height, int channels);
+
+    /**
+     * @brief Add the pixels of a Texture, such as one registered in Resources. The texels are read back
+     * from the GPU
+     *
+     * @param name Name to look the region up by
+     * @param texture Texture to copy
+     */
+    void add(const std::string& name, Texture& texture);
+
+    /**
+     * @brief Pack the images added since the last build and upload them. Call before drawing the added
+     * images
+     */
+    void build();
+
+    /**
+     * @brief Get the region of an image
+     *
+     * @param name Name the image was added with
+     * @return nullptr if the image is not built into the atlas
+     */
+    const Region* getRegion(const std::string& name) const;
+
+    /** Get the atlas texture. Replaced when the atlas grows */
+    const Texture& getTexture() const;
+
+    /** Get the atlas size in texels */
+    glm::ivec2 getSize() const;
+
+    /** Get the number of times the regions were moved by growing the atlas */
+    unsigned int getRepackCount() const;
+
+private:
+    /** Image waiting to be packed or kept for repacking */
+    struct Image {
+        std::string name;
+        /** RGBA8 pixels */
+        std::vector<unsigned char> pixels;
+        int width;
+        int height;
+    };
+
+    /** Top edge of the packed area over a horizontal span */
+    struct SkylineNode {
+        int x;
+        int y;
+        int width;
+    };
+
+    /**
+     * @brief Find space for a rectangle on the skyline and raise the skyline over it
+     *
+     * @param width Width of the rectangle
+     * @param height Height of the rectangle
+     * @param outPosition Set to the top left corner of the rectangle
+     * @return false if the rectangle does not fit
+     */
+    bool insert(int width, int height, glm::ivec2& outPosition);
+
+    /**
+     * @brief Pack all images into an empty atlas of the current size
+     *
+     * @return false if they do not fit
+     */
+    bool repack();
+
+    /**
+     * @brief Copy an image and its padding into the CPU copy of the atlas
+     *
+     * @param image Image to copy
+     * @param position Top left texel of the image
+     */
+    void blit(const Image& image, const glm::ivec2& position);
+
+    /** Recreate the atlas texture from the CPU copy */
+    void createTexture();
+
+    /**
+     * @brief Get the size of the rectangle an image takes up, with its padding
+     *
+     * @param image Image to place
+     */
+    glm::ivec2 getPackedSize(const Image& image) const;
+
+    /** Alignment of the packed rectangles, keeps images on separate texels in the first mip levels */
+    static constexpr int ALIGNMENT = 4;
+    /** Initial atlas width and height */
+    static constexpr int INITIAL_SIZE = 256;
+
+    IGraphicsAPI& mGraphicsAPI_;
+    /** Mips and sampling of the atlas texture */
+    Texture::CreateInfo mCreateInfo_;
+    /** Padding around each image */
+    int mPadding_;
+    /** Largest atlas width and height */
+    int mMaxSize_;
+    /** Atlas size in texels */
+    glm::ivec2 mSize_ = {INITIAL_SIZE, INITIAL_SIZE};
+    /** Skyline of the packed area */
+    std::vector<SkylineNode> mSkyline_;
+    /** RGBA8 copy of the atlas */
+    std::vector<unsigned char> mPixels_;
+    /** Packed images, kept to repack when growing */
+    std::vector<Image> mImages_;
+    /** Images added since the last build */
+    std::vector<Image> mPending_;
+    /** Regions of the packed images */
+    std::unordered_map<std::string, Region> mRegions_;
+    /** Atlas texture */
+    std::unique_ptr<Texture> mTexture_;
+    /** Number of repacks */
+    unsigned int mRepackCount_ = 0;
+};
+
+} // namespace clay
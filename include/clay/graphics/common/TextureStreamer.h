@@ -0,0 +1,184 @@
+#pragma once
+// standard lib
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+// project
+#include "clay/graphics/common/IGraphicsAPI.h"
+#include "clay/graphics/common/Texture.h"
+#include "clay/utils/common/Utils.h"
+
+namespace clay {
+
+/**
+ * @brief Loads textures without stalling the main thread. A requested Texture is returned right away
+ * holding the texel of a placeholder texture. Files are read, decoded and mipmapped on worker threads,
+ * then update uploads the levels through a pool of pixel unpack buffers under a per frame byte budget.
+ *
+ * Levels are uploaded smallest first and the base level of the texture follows the uploads, so the
+ * texture sharpens over a few frames. The Texture id does not change, so it can be bound before it is
+ * loaded.
+ */
+class TextureStreamer {
+public:
+    /** Reads a file into memory */
+    using LoadFunction = std::function<utils::FileData(const std::string&)>;
+    /** Decodes an image file into 8 bit pixels, rows top to bottom. Throws if the file is invalid */
+    using DecodeFunction = std::function<std::vector<unsigned char>(utils::FileData& file, int& outWidth, int& outHeight, int& outChannels)>;
+
+    /** Default number of bytes uploaded per update */
+    static constexpr size_t DEFAULT_UPLOAD_BUDGET = 4 * 1024 * 1024;
+    /** Default number of worker threads */
+    static constexpr unsigned int DEFAULT_WORKER_COUNT = 2;
+
+    /** Counts of the last update */
+    struct Stats {
+        /** Textures waiting for a worker or being decoded */
+        uint32_t decoding = 0;
+        /** Textures with levels left to upload */
+        uint32_t uploading = 0;
+        /** Bytes uploaded by the last update */
+        size_t uploadedBytes = 0;
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param graphicsAPI Graphics API to upload with
+     * @param placeholder Texture shown until a level is loaded, such as a 1x1 blank texture. Its first
+     * texel is read back once
+     * @param loadFile Reads a file, called on worker threads
+     * @param decode Decodes an image, called on worker threads
+     * @param workerCount Number of worker threads
+     * @param uploadBudget Bytes uploaded per update. A row is always uploaded
+     */
+    TextureStreamer(IGraphicsAPI& graphicsAPI,
+                    Texture& placeholder,
+                    LoadFunction loadFile,
+                    DecodeFunction decode,
+                    unsigned int workerCount = DEFAULT_WORKER_COUNT,
+                    size_t uploadBudget = DEFAULT_UPLOAD_BUDGET);
+
+    /** Destructor. Waits for the workers to finish their current file */
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    /**
+     * @brief Start loading a texture. Destroying the Texture before it is loaded cancels the load
+     *
+     * @param path Path of the image file
+     * @param createInfo Mips and sampling of the Texture. GPU mips are built on the workers as well
+     * @return Texture holding the placeholder texel until its levels are uploaded
+     */
+    std::unique_ptr<Texture> request(const std::string& path, const Texture::CreateInfo& createInfo = Texture::CreateInfo::mipmapped());
+
+    /** Upload decoded levels within the budget. Call once per frame on the thread owning the context */
+    void update();
+
+    /** If textures are waiting to be decoded or uploaded */
+    bool isBusy() const;
+
+    /** Get the counts of the last update */
+    const Stats& getStats() const;
+
+private:
+    /** Load of one texture, shared between the main thread and a worker */
+    struct Stream {
+        enum class State : uint8_t {
+            QUEUED,
+            DECODED,
+            FAILED
+        };
+
+        /** Texture being loaded, only accessed on the main thread while lifetime is not expired */
+        Texture* texture;
+        /** Expires when the Texture is destroyed */
+        std::weak_ptr<bool> lifetime;
+        std::string path;
+        Texture::CreateInfo createInfo;
+        /** Set by the worker once the levels are decoded */
+        std::atomic<State> state{State::QUEUED};
+
+        /** Levels built by the worker, base level first */
+        std::vector<std::vector<unsigned char>> levels;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+
+        /** Level being uploaded, counts down to the base level */
+        int nextLevel = -1;
+        /** First row of the level left to upload */
+        int nextRow = 0;
+        /** If the texture storage has the size of the decoded image */
+        bool allocated = false;
+    };
+
+    /** Take queued streams and decode them until stopped */
+    void workerLoop();
+
+    /**
+     * @brief Read, decode and mipmap the image of a stream. Called on a worker
+     *
+     * @param stream Stream to decode
+     */
+    void decode(Stream& stream);
+
+    /**
+     * @brief Upload as much of a stream as fits in the remaining budget
+     *
+     * @param stream Decoded stream
+     * @param remainingBudget Bytes left this update, reduced by the uploaded bytes
+     * @return true if every level is uploaded
+     */
+    bool upload(Stream& stream, size_t& remainingBudget);
+
+    /**
+     * @brief Copy rows through the next pixel unpack buffer of the pool into the bound texture
+     *
+     * @param stream Stream the rows are from
+     * @param level Mip level
+     * @param firstRow First row
+     * @param rowCount Number of rows
+     */
+    void uploadRows(const Stream& stream, int level, int firstRow, int rowCount);
+
+    /** Number of pixel unpack buffers cycled through */
+    static constexpr size_t PIXEL_BUFFER_COUNT = 3;
+
+    IGraphicsAPI& mGraphicsAPI_;
+    /** RGBA texel of the placeholder */
+    unsigned char mPlaceholderTexel_[4] = {255, 255, 255, 255};
+    LoadFunction mLoadFile_;
+    DecodeFunction mDecode_;
+    /** Bytes uploaded per update */
+    size_t mUploadBudget_;
+    /** Pixel unpack buffers */
+    unsigned int mPixelBuffers_[PIXEL_BUFFER_COUNT] = {};
+    /** Next pixel unpack buffer to fill */
+    size_t mNextPixelBuffer_ = 0;
+    /** Streams being decoded or uploaded, main thread only */
+    std::vector<std::shared_ptr<Stream>> mStreams_;
+    /** Streams waiting for a worker */
+    std::deque<std::shared_ptr<Stream>> mQueue_;
+    /** Guards mQueue_ and mStopping_ */
+    std::mutex mQueueMutex_;
+    /** Wakes workers when streams are queued or on shutdown */
+    std::condition_variable mQueueCondition_;
+    /** Set on destruction to end the workers */
+    bool mStopping_ = false;
+    /** Worker threads */
+    std::vector<std::thread> mWorkers_;
+    /** Counts of the last update */
+    Stats mStats_;
+};
+
+} // namespace clay
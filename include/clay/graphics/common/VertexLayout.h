@@ -0,0 +1,79 @@
+#pragma once
+// standard lib
+#include <cstddef>
+#include <cstdint>
+// project
+#include "clay/graphics/common/IGraphicsAPI.h"
+
+namespace clay {
+
+/**
+ * @brief GPU storage format of a mesh. Vertices are kept as Mesh::Vertex on the CPU and encoded on upload.
+ *
+ * Packed normals and tangents are read from their own attribute locations, leaving the float locations
+ * disabled so they read as zero. Shaders that support both check the float normal for zero.
+ */
+struct VertexLayout {
+    /** Attribute location of octahedral encoded normals */
+    static constexpr unsigned int PACKED_NORMAL_ATTRIBUTE_LOCATION = 10;
+    /** Attribute location of octahedral encoded tangents with the bitangent sign */
+    static constexpr unsigned int PACKED_TANGENT_ATTRIBUTE_LOCATION = 11;
+
+    enum class NormalFormat : uint8_t {
+        /** 3 floats at location 1 */
+        FLOAT3,
+        /** Octahedral encoded in 2 x snorm16 at PACKED_NORMAL_ATTRIBUTE_LOCATION */
+        OCTAHEDRAL_SNORM16
+    };
+
+    enum class TangentFormat : uint8_t {
+        /** Tangent and bitangent, 3 floats each at locations 3 and 4 */
+        FLOAT3_BITANGENT,
+        /**
+         * Octahedral encoded tangent in 2 x snorm8 and the bitangent sign in a third snorm8 at
+         * PACKED_TANGENT_ATTRIBUTE_LOCATION. The bitangent is rebuilt as sign * cross(normal, tangent)
+         */
+        OCTAHEDRAL_SNORM8_SIGN
+    };
+
+    enum class TexCoordFormat : uint8_t {
+        /** 2 floats */
+        FLOAT2,
+        /** 2 half floats */
+        HALF2
+    };
+
+    /** Byte offsets of the attributes in a vertex. The position is always 3 floats at 0 */
+    struct Offsets {
+        size_t normal;
+        size_t texCoord;
+        size_t tangent;
+        size_t stride;
+    };
+
+    NormalFormat normal = NormalFormat::FLOAT3;
+    TangentFormat tangent = TangentFormat::FLOAT3_BITANGENT;
+    TexCoordFormat texCoord = TexCoordFormat::FLOAT2;
+    /** Store indices in 16 bits when every vertex can be indexed with them */
+    bool shortIndices = false;
+
+    /** Layout with every attribute packed. 24 bytes per vertex instead of 56 */
+    static VertexLayout compact();
+
+    /** Get the byte offsets of the attributes */
+    Offsets getOffsets() const;
+
+    /** Get the size of one vertex in bytes */
+    size_t getStride() const;
+
+    /**
+     * @brief Enable and point the attributes of the bound vertex array at the bound array buffer
+     *
+     * @param graphicsAPI Graphics API of the vertex array
+     */
+    void bindAttributes(IGraphicsAPI& graphicsAPI) const;
+
+    bool operator==(const VertexLayout& other) const;
+};
+
+} // namespace clay
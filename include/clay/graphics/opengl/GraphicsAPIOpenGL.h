@@ -1,6 +1,8 @@
 #pragma once
 #ifdef CLAY_ENABLE_OPENGL
 // standard lib
+#include <array>
+#include <cstdint>
 #include <stdexcept>
 // third party
 // project
@@ -10,10 +12,30 @@ namespace clay {
 
 class GraphicsAPIOpenGL : public IGraphicsAPI {
 public:
+    /** Number of state changing calls dropped or sent to the driver by the redundant state filter */
+    struct StateFilterStats {
+        /** Calls dropped because they matched the shadowed state */
+        uint64_t filtered = 0;
+        /** Calls sent to the driver */
+        uint64_t forwarded = 0;
+    };
+
     GraphicsAPIOpenGL();
     
     ~GraphicsAPIOpenGL();
 
+    /** Get the redundant state filter counters since construction or the last reset */
+    const StateFilterStats& getStateFilterStats() const;
+
+    /** Reset the redundant state filter counters */
+    void resetStateFilterStats();
+
+    /**
+     * @brief Forget all shadowed state. Must be called after GL state is changed outside of this class
+     * so the next call for each binding is forwarded
+     */
+    void invalidateStateCache();
+
     unsigned int createShader(ShaderCreateInfo::Type type) override;
     void compileShader(unsigned int shaderID, const std::string& source) override;
     void attachShader(unsigned int programID, unsigned int shaderID) override;
@@ -27,6 +49,8 @@ public:
     std::string getProgramLog(unsigned int programID) override;
 
     unsigned int getUniformLocation(unsigned int programId, const std::string& name) override;
+    int getActiveUniformCount(unsigned int programId) override;
+    std::string getActiveUniformName(unsigned int programId, unsigned int index) override;
     void uniform1i(unsigned int location, int value) override;
     void uniform1f(unsigned int location, float value) override;
     void uniform2fv(unsigned int location, const float* value) override;
@@ -45,8 +69,10 @@ public:
 
     void enable(IGraphicsAPI::Capability capability) override;
     void disable(IGraphicsAPI::Capability capability) override;
+    bool isEnabled(IGraphicsAPI::Capability capability) override;
 
     void genVertexArrays(unsigned int n, unsigned int* arrays) override;
+    void deleteVertexArrays(unsigned int n, unsigned int* arrays) override;
     void bindVertexArray(unsigned int vao) override;
 
     void genBuffer(int size, unsigned int* vaos) override;
@@ -72,6 +98,8 @@ public:
 
     void texParameter(TextureTarget target, TextureParameterType paramName, TextureParameterOption paramOption) override;
 
+    void texParameteri(TextureTarget target, TextureParameterType paramName, int value) override;
+
     void texImage2D(TextureTarget target,
                     unsigned int level,
                     TextureFormat internalFormat,
@@ -82,6 +110,16 @@ public:
                     DataType dataType,
                     const void * data) override;
 
+    void texSubImage2D(TextureTarget target,
+                       unsigned int level,
+                       unsigned int xOffset,
+                       unsigned int yOffset,
+                       unsigned int width,
+                       unsigned int height,
+                       TextureFormat format,
+                       DataType dataType,
+                       const void* data) override;
+
     void getTexImage(TextureTarget target, unsigned int level, TextureFormat format, DataType type, void* pixels) override;
 
     void bindTexture(TextureTarget target, unsigned int textureId) override;
@@ -116,6 +154,114 @@ public:
 
     void drawBuffer(unsigned int bufferId) override;
 
+    void vertexAttribDivisor(unsigned int index, unsigned int divisor) override;
+
+    void drawElementsInstanced(PrimitiveTopology mode, int count, DataType type, const void* indices, unsigned int instanceCount) override;
+
+    void blendFunc(BlendFactor srcFactor, BlendFactor dstFactor) override;
+
+    void viewport(int x, int y, int width, int height) override;
+
+    void getViewport(int* outViewport) override;
+
+    void texBuffer(TextureFormat internalFormat, unsigned int buffer) override;
+
+    bool isBufferStorageSupported() override;
+
+    void bufferStorage(BufferTarget target, size_t size, const void* data, const std::vector<BufferAccess>& access) override;
+
+    void* mapBufferRange(BufferTarget target, size_t offset, size_t size, const std::vector<BufferAccess>& access) override;
+
+    void unmapBuffer(BufferTarget target) override;
+
+    void deleteBuffer(int size, unsigned int* buffers) override;
+
+    void* fenceSync() override;
+
+    bool clientWaitSync(void* sync, uint64_t timeoutNanoseconds) override;
+
+    void deleteSync(void* sync) override;
+
+    void drawElementsBaseVertex(PrimitiveTopology mode, int count, DataType type, const void* indices, int baseVertex) override;
+
+    void drawElementsInstancedBaseVertex(PrimitiveTopology mode, int count, DataType type, const void* indices, unsigned int instanceCount, int baseVertex) override;
+
+    void copyBufferSubData(size_t readOffset, size_t writeOffset, size_t size) override;
+
+    bool isMultiDrawIndirectSupported() override;
+
+    void generateMipmap(TextureTarget target) override;
+
+    void genSamplers(unsigned int count, unsigned int* samplers) override;
+
+    void deleteSamplers(unsigned int count, unsigned int* samplers) override;
+
+    void bindSampler(unsigned int textureUnit, unsigned int sampler) override;
+
+    void samplerParameter(unsigned int sampler, TextureParameterType paramName, TextureParameterOption paramOption) override;
+
+    void samplerParameterf(unsigned int sampler, TextureParameterType paramName, float value) override;
+
+    float getMaxAnisotropy() override;
+
+    void compressedTexImage2D(TextureTarget target,
+                              unsigned int level,
+                              CompressedFormat format,
+                              unsigned int width,
+                              unsigned int height,
+                              size_t imageSize,
+                              const void* data) override;
+
+    bool isCompressedFormatSupported(CompressedFormat format) override;
+
+    void multiDrawElementsIndirect(PrimitiveTopology mode, DataType type, const void* indirect, unsigned int drawCount, size_t stride) override;
+
+private:
+    /** Shadowed binding value for state that is not known. Calls are always forwarded while unknown */
+    static constexpr unsigned int UNKNOWN_BINDING = ~0u;
+    /** Number of texture units with shadowed bindings. Binds on higher units are always forwarded */
+    static constexpr unsigned int MAX_SHADOWED_TEXTURE_UNITS = 32;
+    static constexpr size_t BUFFER_TARGET_COUNT = static_cast<size_t>(BufferTarget::UNIFORM_BUFFER) + 1;
+    static constexpr size_t TEXTURE_TARGET_COUNT = static_cast<size_t>(TextureTarget::TEXTURE_BUFFER) + 1;
+    static constexpr size_t CAPABILITY_COUNT = static_cast<size_t>(Capability::DEPTH_TEST) + 1;
+
+    /** Enabled state of a capability */
+    enum class CapabilityState : uint8_t {
+        UNKNOWN,
+        ENABLED,
+        DISABLED
+    };
+
+    /**
+     * @brief Check a call against its shadowed value and update the shadow and counters
+     *
+     * @param shadow Shadowed state
+     * @param value New value
+     * @return true if the call must be forwarded to the driver
+     */
+    template<typename T>
+    bool updateShadow(T& shadow, T value);
+
+    /** Program in use */
+    unsigned int mBoundProgram_ = UNKNOWN_BINDING;
+    /** Bound vertex array */
+    unsigned int mBoundVertexArray_ = UNKNOWN_BINDING;
+    /** Bound buffer per buffer target. ELEMENT_ARRAY_BUFFER is VAO state and is reset when the VAO changes */
+    std::array<unsigned int, BUFFER_TARGET_COUNT> mBoundBuffers_;
+    /** Active texture unit */
+    unsigned int mActiveTextureUnit_ = UNKNOWN_BINDING;
+    /** Bound texture per texture unit and texture target */
+    std::array<std::array<unsigned int, TEXTURE_TARGET_COUNT>, MAX_SHADOWED_TEXTURE_UNITS> mBoundTextures_;
+    /** Bound sampler per texture unit */
+    std::array<unsigned int, MAX_SHADOWED_TEXTURE_UNITS> mBoundSamplers_;
+    /** Bound draw frame buffer */
+    unsigned int mBoundDrawFrameBuffer_ = UNKNOWN_BINDING;
+    /** Bound read frame buffer */
+    unsigned int mBoundReadFrameBuffer_ = UNKNOWN_BINDING;
+    /** Enabled state per capability */
+    std::array<CapabilityState, CAPABILITY_COUNT> mCapabilities_;
+    /** Filter counters */
+    StateFilterStats mStateFilterStats_;
 };
 
 
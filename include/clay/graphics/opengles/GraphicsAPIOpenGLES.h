@@ -784,6 +784,8 @@ public:
     std::string getProgramLog(unsigned int programID) override;
 
     unsigned int getUniformLocation(unsigned int programId, const std::string& name) override;
+    int getActiveUniformCount(unsigned int programId) override;
+    std::string getActiveUniformName(unsigned int programId, unsigned int index) override;
     void uniform1i(unsigned int location, int value) override;
     void uniform1f(unsigned int location, float value) override;
     void uniform2fv(unsigned int location, const float* value) override;
@@ -802,8 +804,10 @@ public:
 
     void enable(IGraphicsAPI::Capability capability) override;
     void disable(IGraphicsAPI::Capability capability) override;
+    bool isEnabled(IGraphicsAPI::Capability capability) override;
 
     void genVertexArrays(unsigned int n, unsigned int* arrays) override;
+    void deleteVertexArrays(unsigned int n, unsigned int* arrays) override;
     void bindVertexArray(unsigned int vao) override;
 
     void genBuffer(int size, unsigned int* vaos) override;
@@ -829,6 +833,8 @@ public:
 
     void texParameter(IGraphicsAPI::TextureTarget target, IGraphicsAPI::TextureParameterType paramName, IGraphicsAPI::TextureParameterOption paramOption) override;
 
+    void texParameteri(IGraphicsAPI::TextureTarget target, IGraphicsAPI::TextureParameterType paramName, int value) override;
+
     void texImage2D(IGraphicsAPI::TextureTarget target,
                     unsigned int level,
                     IGraphicsAPI::TextureFormat internalFormat,
@@ -839,6 +845,16 @@ public:
                     IGraphicsAPI::DataType dataType,
                     const void * data) override;
 
+    void texSubImage2D(IGraphicsAPI::TextureTarget target,
+                       unsigned int level,
+                       unsigned int xOffset,
+                       unsigned int yOffset,
+                       unsigned int width,
+                       unsigned int height,
+                       IGraphicsAPI::TextureFormat format,
+                       IGraphicsAPI::DataType dataType,
+                       const void* data) override;
+
     void getTexImage(IGraphicsAPI::TextureTarget target, unsigned int level, IGraphicsAPI::TextureFormat format, DataType type, void* pixels) override;
 
     void bindTexture(IGraphicsAPI::TextureTarget target, unsigned int textureId) override;
@@ -872,6 +888,68 @@ public:
     void polygonMode(IGraphicsAPI::PolygonModeFace face, IGraphicsAPI::PolygonModeType mode) override;
 
     void drawBuffer(unsigned int bufferId) override;
+
+    void vertexAttribDivisor(unsigned int index, unsigned int divisor) override;
+
+    void drawElementsInstanced(IGraphicsAPI::PrimitiveTopology mode, int count, IGraphicsAPI::DataType type, const void* indices, unsigned int instanceCount) override;
+
+    void blendFunc(IGraphicsAPI::BlendFactor srcFactor, IGraphicsAPI::BlendFactor dstFactor) override;
+
+    void viewport(int x, int y, int width, int height) override;
+
+    void getViewport(int* outViewport) override;
+
+    void texBuffer(IGraphicsAPI::TextureFormat internalFormat, unsigned int buffer) override;
+
+    bool isBufferStorageSupported() override;
+
+    void bufferStorage(IGraphicsAPI::BufferTarget target, size_t size, const void* data, const std::vector<IGraphicsAPI::BufferAccess>& access) override;
+
+    void* mapBufferRange(IGraphicsAPI::BufferTarget target, size_t offset, size_t size, const std::vector<IGraphicsAPI::BufferAccess>& access) override;
+
+    void unmapBuffer(IGraphicsAPI::BufferTarget target) override;
+
+    void deleteBuffer(int size, unsigned int* buffers) override;
+
+    void* fenceSync() override;
+
+    bool clientWaitSync(void* sync, uint64_t timeoutNanoseconds) override;
+
+    void deleteSync(void* sync) override;
+
+    void drawElementsBaseVertex(IGraphicsAPI::PrimitiveTopology mode, int count, IGraphicsAPI::DataType type, const void* indices, int baseVertex) override;
+
+    void drawElementsInstancedBaseVertex(IGraphicsAPI::PrimitiveTopology mode, int count, IGraphicsAPI::DataType type, const void* indices, unsigned int instanceCount, int baseVertex) override;
+
+    void copyBufferSubData(size_t readOffset, size_t writeOffset, size_t size) override;
+
+    bool isMultiDrawIndirectSupported() override;
+
+    void generateMipmap(IGraphicsAPI::TextureTarget target) override;
+
+    void genSamplers(unsigned int count, unsigned int* samplers) override;
+
+    void deleteSamplers(unsigned int count, unsigned int* samplers) override;
+
+    void bindSampler(unsigned int textureUnit, unsigned int sampler) override;
+
+    void samplerParameter(unsigned int sampler, IGraphicsAPI::TextureParameterType paramName, IGraphicsAPI::TextureParameterOption paramOption) override;
+
+    void samplerParameterf(unsigned int sampler, IGraphicsAPI::TextureParameterType paramName, float value) override;
+
+    float getMaxAnisotropy() override;
+
+    void compressedTexImage2D(IGraphicsAPI::TextureTarget target,
+                              unsigned int level,
+                              IGraphicsAPI::CompressedFormat format,
+                              unsigned int width,
+                              unsigned int height,
+                              size_t imageSize,
+                              const void* data) override;
+
+    bool isCompressedFormatSupported(IGraphicsAPI::CompressedFormat format) override;
+
+    void multiDrawElementsIndirect(IGraphicsAPI::PrimitiveTopology mode, IGraphicsAPI::DataType type, const void* indirect, unsigned int drawCount, size_t stride) override;
 };
 
 } // namespace clay
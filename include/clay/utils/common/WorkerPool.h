@@ -0,0 +1,71 @@
+#pragma once
+// standard lib
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace clay::utils {
+
+/**
+ * @brief Threads kept alive to split per frame work such as culling. Each run hands the same job to every
+ * thread with its index and returns once all of them are done, so frames do not pay for creating threads.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param threadCount Number of threads a run is split across, including the calling thread. Starts
+     * threadCount - 1 workers
+     */
+    explicit WorkerPool(unsigned int threadCount);
+
+    /** Destructor. Stops the workers */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Call the job once per thread and wait for all calls to return. Index 0 runs on the calling
+     * thread. Runs from several threads are serialized, a job must not run the same pool
+     *
+     * @param job Called with the thread index, in [0, getThreadCount())
+     */
+    void run(const std::function<void(unsigned int)>& job);
+
+    /** Get the number of threads a run is split across, including the calling thread */
+    unsigned int getThreadCount() const;
+
+private:
+    /**
+     * @brief Wait for runs and call their job until stopped
+     *
+     * @param threadIndex Index passed to the job
+     */
+    void workerLoop(unsigned int threadIndex);
+
+    /** Threads with index 1 and up */
+    std::vector<std::thread> mWorkers_;
+    /** Held for the whole run so runs from several threads do not mix */
+    std::mutex mRunMutex_;
+    /** Guards the job state below */
+    std::mutex mJobMutex_;
+    /** Wakes the workers when a run starts or on shutdown */
+    std::condition_variable mJobCondition_;
+    /** Wakes run when the workers returned from the job */
+    std::condition_variable mJobDoneCondition_;
+    /** Job of the current run */
+    const std::function<void(unsigned int)>* mpJob_ = nullptr;
+    /** Incremented for each run */
+    uint64_t mRun_ = 0;
+    /** Workers that did not return from the job of the current run */
+    size_t mPendingWorkers_ = 0;
+    /** Set on destruction to end the workers */
+    bool mStopping_ = false;
+};
+
+} // namespace clay::utils
@@ -5,6 +5,7 @@
 // standard lib
 #include <fstream>
 #include <stdexcept>
+#include <vector>
 // project
 #include "clay/utils/common/Utils.h"
 
@@ -15,6 +16,16 @@ namespace clay::utils {
 
     clay::utils::ImageData fileDataToImageData(utils::FileData& imageFile);
 
+    /**
+     * @brief Decode an image file into pixels owned by a vector. Safe to call from worker threads
+     *
+     * @param imageFile Loaded image file
+     * @param outWidth Set to the width in pixels
+     * @param outHeight Set to the height in pixels
+     * @param outChannels Set to the channels per pixel
+     */
+    std::vector<unsigned char> decodeImage(utils::FileData& imageFile, int& outWidth, int& outHeight, int& outChannels);
+
 }// namespace clay::utils
 
 #endif
\ No newline at end of file
@@ -0,0 +1,22 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+// Per instance attributes
+layout (location = 5) in mat4 aModel;
+layout (location = 9) in vec4 aColor;
+
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+};
+
+out vec2 TexCoords;
+out vec4 Color;
+
+void main() {
+    TexCoords = aTexCoords;
+    Color = aColor;
+    gl_Position = projection * view * aModel * vec4(aPos, 1.0);
+}
\ No newline at end of file
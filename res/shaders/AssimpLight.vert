@@ -3,6 +3,7 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
+layout (location = 10) in vec2 aPackedNormal;
 
 layout(std140) uniform Camera {
     mat4 view;
@@ -15,6 +16,17 @@ out vec3 Normal;
 
 uniform mat4 uModel;
 
+// Float normals are disabled (read as zero) when the mesh stores octahedral encoded normals
+vec3 decodeNormal() {
+    if (dot(aNormal, aNormal) > 0.0) {
+        return aNormal;
+    }
+    vec3 n = vec3(aPackedNormal, 1.0 - abs(aPackedNormal.x) - abs(aPackedNormal.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
 void main() {
     TexCoords = aTexCoords;
 
@@ -22,7 +34,7 @@ void main() {
     FragPos = vec3(uModel * vec4(aPos, 1.0));
 
     // Pass the normal, transformed to world space
-    Normal = mat3(transpose(inverse(uModel))) * aNormal;
+    Normal = mat3(transpose(inverse(uModel))) * decodeNormal();
 
     gl_Position = projection * view * uModel * vec4(aPos, 1.0);
 }
\ No newline at end of file
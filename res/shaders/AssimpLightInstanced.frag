@@ -0,0 +1,91 @@
+#version 330 core
+layout (location = 0) out vec4 FragColor;
+layout (location = 1) out vec4 BloomColor;
+
+in vec2 TexCoords;
+in vec3 FragPos;
+in vec3 Normal;
+in vec4 Color;
+
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+};
+
+// Clustered lighting, see LightClusters
+layout(std140) uniform LightBuffer {
+    uvec4 uClusterGrid;   // cluster count x, y, z, number of lights without a range
+    vec4 uClusterParams;  // tile width, tile height in pixels, depth slice scale, depth slice bias
+};
+
+// 3 texels per light: position and 1 / range, color and intensity, attenuation
+uniform samplerBuffer uLightData;
+// Offset into uLightIndices and light count of each cluster
+uniform usamplerBuffer uLightClusters;
+uniform usamplerBuffer uLightIndices;
+
+uniform sampler2D texture_diffuse1;
+uniform vec3 viewPos; // Camera/view position
+
+uint clusterIndex() {
+    float depth = -(view * vec4(FragPos, 1.0)).z;
+    uint x = min(uint(gl_FragCoord.x / uClusterParams.x), uClusterGrid.x - 1u);
+    uint y = min(uint(gl_FragCoord.y / uClusterParams.y), uClusterGrid.y - 1u);
+    uint z = uint(clamp(floor(log(max(depth, 1e-4)) * uClusterParams.z + uClusterParams.w), 0.0, float(uClusterGrid.z - 1u)));
+    return x + uClusterGrid.x * (y + uClusterGrid.y * z);
+}
+
+void addLight(int light, vec3 norm, vec3 viewDir, inout vec3 ambient, inout vec3 diffuse, inout vec3 specular) {
+    vec4 positionInvRange = texelFetch(uLightData, light * 3);
+    vec4 colorIntensity = texelFetch(uLightData, light * 3 + 1);
+    vec3 attenuation = texelFetch(uLightData, light * 3 + 2).xyz;
+
+    vec3 toLight = positionInvRange.xyz - FragPos;
+    float dist = length(toLight);
+    // Fade out towards the range so the light does not cut off at the cluster bounds
+    float window = clamp(1.0 - pow(dist * positionInvRange.w, 4.0), 0.0, 1.0);
+    float falloff = colorIntensity.w * window * window / max(attenuation.x + attenuation.y * dist + attenuation.z * dist * dist, 1e-4);
+    vec3 lightColor = colorIntensity.rgb * falloff;
+
+    ambient += 0.1 * lightColor;
+
+    vec3 lightDir = toLight / max(dist, 1e-4);
+    float diff = max(dot(norm, lightDir), 0.0);
+    diffuse += diff * lightColor;
+
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
+    specular += spec * lightColor;
+}
+
+void main() {
+    // Initialize lighting accumulators
+    vec3 ambient = vec3(0.0);
+    vec3 diffuse = vec3(0.0);
+    vec3 specular = vec3(0.0);
+
+    vec3 norm = normalize(Normal);
+    vec3 viewDir = normalize(viewPos - FragPos);
+
+    // Lights without a range reach every fragment
+    for (uint i = 0u; i < uClusterGrid.w; ++i) {
+        addLight(int(i), norm, viewDir, ambient, diffuse, specular);
+    }
+    uvec2 cluster = texelFetch(uLightClusters, int(clusterIndex())).xy;
+    for (uint i = 0u; i < cluster.y; ++i) {
+        addLight(int(texelFetch(uLightIndices, int(cluster.x + i)).x), norm, viewDir, ambient, diffuse, specular);
+    }
+
+    vec3 result = (ambient + diffuse + specular) * vec3(Color);
+    FragColor = vec4(result, 1.0);
+
+    float brightness = dot(FragColor.rgb, vec3(0.2126, 0.7152, 0.0722));
+    if (brightness > 1.0) {
+        BloomColor = vec4(FragColor.rgb, 1.0);
+    } else {
+        BloomColor = vec4(0.0, 0.0, 0.0, 1.0);
+    }
+
+    // Optionally use the texture
+    // FragColor = texture(texture_diffuse1, TexCoords) * vec4(result, 1.0);
+}
\ No newline at end of file
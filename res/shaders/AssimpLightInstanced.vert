@@ -0,0 +1,43 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 10) in vec2 aPackedNormal;
+// Per instance attributes
+layout (location = 5) in mat4 aModel;
+layout (location = 9) in vec4 aColor;
+
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+};
+
+out vec2 TexCoords;
+out vec3 FragPos;
+out vec3 Normal;
+out vec4 Color;
+
+// Float normals are disabled (read as zero) when the mesh stores octahedral encoded normals
+vec3 decodeNormal() {
+    if (dot(aNormal, aNormal) > 0.0) {
+        return aNormal;
+    }
+    vec3 n = vec3(aPackedNormal, 1.0 - abs(aPackedNormal.x) - abs(aPackedNormal.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
+void main() {
+    TexCoords = aTexCoords;
+    Color = aColor;
+
+    // Pass the fragment position in world space
+    FragPos = vec3(aModel * vec4(aPos, 1.0));
+
+    // Pass the normal, transformed to world space
+    Normal = mat3(transpose(inverse(aModel))) * decodeNormal();
+
+    gl_Position = projection * view * aModel * vec4(aPos, 1.0);
+}
\ No newline at end of file
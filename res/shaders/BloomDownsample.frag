@@ -0,0 +1,37 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D uSource;
+
+void main() {
+    // 13 tap downsample. Overlapping 4x4 box filters weighted towards the center avoid the
+    // shimmering of a single 2x2 box
+    vec2 texel = 1.0 / textureSize(uSource, 0);
+    float x = texel.x;
+    float y = texel.y;
+
+    vec3 a = texture(uSource, TexCoords + vec2(-2.0 * x, 2.0 * y)).rgb;
+    vec3 b = texture(uSource, TexCoords + vec2(0.0, 2.0 * y)).rgb;
+    vec3 c = texture(uSource, TexCoords + vec2(2.0 * x, 2.0 * y)).rgb;
+
+    vec3 d = texture(uSource, TexCoords + vec2(-2.0 * x, 0.0)).rgb;
+    vec3 e = texture(uSource, TexCoords).rgb;
+    vec3 f = texture(uSource, TexCoords + vec2(2.0 * x, 0.0)).rgb;
+
+    vec3 g = texture(uSource, TexCoords + vec2(-2.0 * x, -2.0 * y)).rgb;
+    vec3 h = texture(uSource, TexCoords + vec2(0.0, -2.0 * y)).rgb;
+    vec3 i = texture(uSource, TexCoords + vec2(2.0 * x, -2.0 * y)).rgb;
+
+    vec3 j = texture(uSource, TexCoords + vec2(-x, y)).rgb;
+    vec3 k = texture(uSource, TexCoords + vec2(x, y)).rgb;
+    vec3 l = texture(uSource, TexCoords + vec2(-x, -y)).rgb;
+    vec3 m = texture(uSource, TexCoords + vec2(x, -y)).rgb;
+
+    vec3 result = e * 0.125;
+    result += (a + c + g + i) * 0.03125;
+    result += (b + d + f + h) * 0.0625;
+    result += (j + k + l + m) * 0.125;
+    FragColor = vec4(max(result, vec3(0.0001)), 1.0);
+}
\ No newline at end of file
@@ -12,9 +12,8 @@ uniform float exposure;
 void main() {
     const float gamma = 2.2;
     vec3 hdrColor = texture(scene, TexCoords).rgb;
-    vec3 bloomColor = texture(bloomBlur, TexCoords).rgb;
     if (bloom) {
-        hdrColor += bloomColor; // additive blending
+        hdrColor += texture(bloomBlur, TexCoords).rgb; // additive blending
     }
     vec3 result = hdrColor;
     if (uGammaCorrect) {
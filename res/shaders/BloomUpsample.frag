@@ -0,0 +1,31 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D uSource;
+// Radius of the tent filter in texture coordinates
+uniform float uFilterRadius;
+
+void main() {
+    // 3x3 tent filter
+    float x = uFilterRadius;
+    float y = uFilterRadius;
+
+    vec3 a = texture(uSource, TexCoords + vec2(-x, y)).rgb;
+    vec3 b = texture(uSource, TexCoords + vec2(0.0, y)).rgb;
+    vec3 c = texture(uSource, TexCoords + vec2(x, y)).rgb;
+
+    vec3 d = texture(uSource, TexCoords + vec2(-x, 0.0)).rgb;
+    vec3 e = texture(uSource, TexCoords).rgb;
+    vec3 f = texture(uSource, TexCoords + vec2(x, 0.0)).rgb;
+
+    vec3 g = texture(uSource, TexCoords + vec2(-x, -y)).rgb;
+    vec3 h = texture(uSource, TexCoords + vec2(0.0, -y)).rgb;
+    vec3 i = texture(uSource, TexCoords + vec2(x, -y)).rgb;
+
+    vec3 result = e * 4.0;
+    result += (b + d + f + h) * 2.0;
+    result += (a + c + g + i);
+    FragColor = vec4(result * (1.0 / 16.0), 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColor;
+
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+};
+
+out vec4 Color;
+
+void main() {
+    Color = aColor;
+    gl_Position = projection * view * vec4(aPos, 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#version 330 core
+
+layout (location = 0) in vec2 aCorner; // x position along the line, y side
+// Per instance attributes
+layout (location = 1) in vec3 aStart;
+layout (location = 2) in vec4 aColor;
+layout (location = 3) in vec3 aEnd;
+layout (location = 4) in float aThickness;
+
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+};
+
+uniform vec2 uViewportSize;
+
+out vec4 Color;
+
+void main() {
+    vec4 clipStart = projection * view * vec4(aStart, 1.0f);
+    vec4 clipEnd = projection * view * vec4(aEnd, 1.0f);
+
+    // Screen space direction, scaled by the viewport so the quad keeps its width with any aspect ratio
+    vec2 direction = (clipEnd.xy / clipEnd.w - clipStart.xy / clipStart.w) * uViewportSize;
+    direction = length(direction) > 1e-6f ? normalize(direction) : vec2(1.0f, 0.0f);
+    vec2 normal = vec2(-direction.y, direction.x);
+
+    // Half the thickness on each side, converted from pixels to NDC and scaled by w to undo the divide
+    vec4 position = mix(clipStart, clipEnd, aCorner.x);
+    position.xy += normal * aCorner.y * aThickness / uViewportSize * position.w;
+
+    Color = aColor;
+    gl_Position = position;
+}
\ No newline at end of file
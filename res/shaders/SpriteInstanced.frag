@@ -0,0 +1,21 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+in vec4 Color;
+
+uniform sampler2D uTexture;
+
+vec3 magenta1 = vec3(1.0, 0.0, 1.0);
+vec3 magenta2 = vec3(0.60, 0.0, 0.60); //GL_SRGB of (204,0,204)
+float epsilon = 0.01;
+
+void main() {
+    vec4 sampledColor = texture(uTexture, TexCoords);
+
+    if (length(sampledColor.rgb - magenta1) < epsilon || length(sampledColor.rgb - magenta2) < epsilon) {
+        discard; // Discard fragment if spritesheet background color
+    }
+
+    FragColor = sampledColor * Color;
+}
\ No newline at end of file
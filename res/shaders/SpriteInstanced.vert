@@ -0,0 +1,29 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec2 aTexCoords;
+// Per instance attributes
+layout (location = 3) in mat4 aModel;
+layout (location = 7) in vec4 aSubImage; // xy top left, zw size
+layout (location = 8) in vec4 aColor;
+
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+};
+
+out vec2 TexCoords;
+out vec4 Color;
+
+uniform bool uVerticalFlip = true;
+
+void main() {
+    // Adjust texture coordinates for vertical flip
+    vec2 flippedTexCoords = aTexCoords;
+    if (uVerticalFlip) {
+        flippedTexCoords.y = 1.0 - aTexCoords.y;
+    }
+    // Map to the sub image. This is linear so it can be done per vertex
+    TexCoords = flippedTexCoords * aSubImage.zw + aSubImage.xy;
+    Color = aColor;
+    gl_Position = projection * view * aModel * vec4(aPos, 1.0);
+}
\ No newline at end of file
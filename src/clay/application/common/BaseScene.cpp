@@ -56,6 +56,58 @@ Resources& BaseScene::getResources() {
     return mResources_;
 }
 
+TransformHierarchy& BaseScene::getTransformHierarchy() {
+    return mTransformHierarchy_;
+}
+
+void BaseScene::cullEntities(const std::vector<Entity*>& entities, const Frustum& frustum, std::vector<Entity*>& outVisible, utils::WorkerPool* workerPool) {
+    mCullSpheres_.resize(entities.size());
+    mCullVisible_.resize(entities.size());
+    for (size_t i = 0; i < entities.size(); ++i) {
+        mCullSpheres_[i] = entities[i]->getWorldBoundingSphere();
+    }
+
+    frustum.cullSpheres(mCullSpheres_.data(), mCullSpheres_.size(), mCullVisible_.data(), workerPool);
+
+    outVisible.clear();
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (mCullVisible_[i] != 0) {
+            outVisible.push_back(entities[i]);
+        }
+    }
+}
+
+void BaseScene::cullEntities(const std::vector<Entity*>& entities, const Renderer& renderer, OcclusionCuller& occlusionCuller, std::vector<Entity*>& outVisible, utils::WorkerPool* workerPool) {
+    cullEntities(entities, renderer.getFrustum(), outVisible, workerPool);
+
+    occlusionCuller.beginFrame(renderer.getViewProjection());
+    for (Entity* eachEntity : outVisible) {
+        if (!eachEntity->isOccluder()) {
+            continue;
+        }
+        for (const auto& eachRenderable : eachEntity->getRenderableComponents()) {
+            const ModelRenderable* modelRenderable = dynamic_cast<const ModelRenderable*>(eachRenderable.get());
+            if (modelRenderable == nullptr || !modelRenderable->isEnabled() || modelRenderable->getModel() == nullptr) {
+                continue;
+            }
+            occlusionCuller.addOccluder(*modelRenderable->getModel(), eachEntity->getWorldMatrix() * modelRenderable->getLocalModelMatrix());
+        }
+    }
+    occlusionCuller.rasterize(workerPool);
+
+    // Occluders are kept, they would only be tested against themselves
+    size_t visibleCount = 0;
+    for (Entity* eachEntity : outVisible) {
+        AABB worldBounds;
+        if (eachEntity->isOccluder() ||
+            !eachEntity->getWorldBounds(worldBounds) ||
+            occlusionCuller.isVisible(worldBounds)) {
+            outVisible[visibleCount++] = eachEntity;
+        }
+    }
+    outVisible.resize(visibleCount);
+}
+
 void BaseScene::onKeyPress(unsigned int code) {}
 
 void BaseScene::onKeyRelease(unsigned int code) {}
@@ -1,30 +1,145 @@
 // standard lib
+#include <algorithm>
 #include <fstream>
+#include <optional>
 #include <stdexcept>
 // class
 #include "clay/application/common/Resources.h"
 
 namespace clay {
 
+namespace {
+    /** KTX2 image and the levels decoded on the CPU if the driver does not support its format */
+    struct TextureData {
+        std::optional<CompressedImage> image;
+        std::vector<std::vector<unsigned char>> decodedLevels;
+    };
+
+    /** Meshes of a model and their levels of detail */
+    struct ModelData {
+        std::vector<Mesh::Data> meshes;
+        /** Simplified meshes of each of Model::DEFAULT_LOD_RATIOS */
+        std::vector<std::vector<Mesh::Data>> lods;
+    };
+
+    /**
+     * @brief Load the first KTX2 encoding of a texture the driver supports, otherwise the first one
+     * that can be decoded on the CPU
+     *
+     * @param graphicsAPI Graphics API to check the formats with
+     * @param resourcePaths KTX2 encodings of the same texture in order of preference
+     * @param resourceName Name of the texture for errors
+     */
+    CompressedImage loadTextureImage(IGraphicsAPI& graphicsAPI, const std::vector<std::filesystem::path>& resourcePaths, const std::string& resourceName) {
+        std::optional<CompressedImage> fallback;
+        for (const std::filesystem::path& path : resourcePaths) {
+            utils::FileData loadedFile = Resources::loadFileToMemory(path.string());
+            if (!CompressedImage::isKtx2(loadedFile)) {
+                LOG_E("%s is not a KTX2 file", path.string().c_str());
+                throw std::runtime_error("Invalid Texture Resource");
+            }
+            CompressedImage image = CompressedImage::parseKtx2(std::move(loadedFile));
+            if (graphicsAPI.isCompressedFormatSupported(image.getFormat())) {
+                return image;
+            }
+            if (!fallback.has_value() && CompressedImage::canDecode(image.getFormat())) {
+                fallback.emplace(std::move(image));
+            }
+        }
+        if (!fallback.has_value()) {
+            LOG_E("%s has no supported or decodable format", resourceName.c_str());
+            throw std::runtime_error("Invalid Texture Resource");
+        }
+        return std::move(*fallback);
+    }
+
+    /** Upload decoded meshes in the resource vertex layout */
+    std::vector<Mesh> createMeshes(IGraphicsAPI& graphicsAPI, const std::vector<Mesh::Data>& dataList) {
+        std::vector<Mesh> meshes;
+        meshes.reserve(dataList.size());
+        for (const Mesh::Data& data : dataList) {
+            meshes.push_back(Mesh(graphicsAPI, data.vertices, data.indices, Mesh::VertexLayout::compact()));
+        }
+        return meshes;
+    }
+}
+
 std::filesystem::path Resources::RESOURCE_PATH = "";
 
 std::function<utils::FileData(const std::string&)> Resources::loadFileToMemory;
 
+Resources::LoadHandle::Status Resources::LoadHandle::getStatus() const {
+    return mState_ ? mState_->status.load() : Status::FAILED;
+}
+
+bool Resources::LoadHandle::isDone() const {
+    return getStatus() != Status::LOADING;
+}
+
+const std::string& Resources::LoadHandle::getName() const {
+    static const std::string empty;
+    return mState_ ? mState_->name : empty;
+}
+
+const std::string& Resources::LoadHandle::getError() const {
+    static const std::string empty;
+    return mState_ ? mState_->error : empty;
+}
+
+void Resources::LoadBatch::add(LoadHandle handle) {
+    mHandles_.push_back(std::move(handle));
+}
+
+bool Resources::LoadBatch::isDone() const {
+    return std::all_of(mHandles_.begin(), mHandles_.end(), [](const LoadHandle& handle) {
+        return handle.isDone();
+    });
+}
+
+float Resources::LoadBatch::getProgress() const {
+    if (mHandles_.empty()) {
+        return 1.0f;
+    }
+    const auto doneCount = std::count_if(mHandles_.begin(), mHandles_.end(), [](const LoadHandle& handle) {
+        return handle.isDone();
+    });
+    return static_cast<float>(doneCount) / mHandles_.size();
+}
+
+size_t Resources::LoadBatch::getFailedCount() const {
+    return std::count_if(mHandles_.begin(), mHandles_.end(), [](const LoadHandle& handle) {
+        return handle.getStatus() == LoadHandle::Status::FAILED;
+    });
+}
+
+const std::vector<Resources::LoadHandle>& Resources::LoadBatch::getHandles() const {
+    return mHandles_;
+}
+
 Resources::Resources() = default;
 
-Resources::~Resources() = default;
+Resources::~Resources() {
+    {
+        std::lock_guard<std::mutex> lock(mLoadMutex_);
+        mStopping_ = true;
+    }
+    mLoadCondition_.notify_all();
+    for (std::thread& loader : mLoaders_) {
+        loader.join();
+    }
+}
 
 template<typename T>
-void Resources::loadResource(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName) {
+ResourceHandle<T> Resources::loadResource(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName) {
     if constexpr (std::is_same_v<T, Mesh>) {
         utils::FileData loadedFile = loadFileToMemory(resourcePath[0].string());
         
         std::vector<Mesh> loadedMeshes;
-        Mesh::parseMeshes(*mGraphicsAPI_, loadedFile, loadedMeshes);
+        Mesh::parseMeshes(*mGraphicsAPI_, loadedFile, loadedMeshes, Mesh::VertexLayout::compact());
 
         if (loadedMeshes.size() == 1) {
             std::unique_ptr<Mesh> meshPtr = std::make_unique<Mesh>(std::move(loadedMeshes[0]));
-            mMeshes_[resourceName] = std::move(meshPtr);
+            return addResource(std::move(meshPtr), resourceName);
         } else {
             LOG_E("%s contains %ld meshes", resourceName.c_str(), loadedMeshes.size());
             throw std::runtime_error("Invalid number of Meshes in Mesh Resource");
@@ -34,123 +149,225 @@ void Resources::loadResource(const std::vector<std::filesystem::path>& resourceP
         auto pModel = std::make_unique<Model>();
 
         std::vector<Mesh> loadedMeshes;
-        Mesh::parseMeshes(*mGraphicsAPI_, loadedFile, loadedMeshes);
+        Mesh::parseMeshes(*mGraphicsAPI_, loadedFile, loadedMeshes, Mesh::VertexLayout::compact());
         pModel->addMeshes(std::move(loadedMeshes));
-        mModels_[resourceName] = std::move(pModel);
+        pModel->generateLods();
+        return addResource(std::move(pModel), resourceName);
     } else if constexpr(std::is_same_v<T, Texture>) {
-        // Texture
-        // utils::FileData loadedFile = loadFileToMemory(resourcePath[0].string());
-        // mTextures_[resourceName] = std::make_unique<Texture>(*mGraphicsAPI_, loadedFile, true);
+        // The paths are KTX2 encodings of the same texture in order of preference
+        return addResource(std::make_unique<Texture>(*mGraphicsAPI_, loadTextureImage(*mGraphicsAPI_, resourcePath, resourceName)), resourceName);
     } else if constexpr (std::is_same_v<T, ShaderProgram>) {
         // mShaders_[resourceName] = std::make_unique<Shader>(resourcePath[0].c_str(),resourcePath[1].c_str());
     } else if constexpr (std::is_same_v<T, Audio>) {
         utils::FileData loadedFile = loadFileToMemory(resourcePath[0].string());
-        mAudios_[resourceName] = std::make_unique<Audio>(loadedFile);
+        return addResource(std::make_unique<Audio>(loadedFile), resourceName);
     } else if constexpr (std::is_same_v<T, Font>) {
         utils::FileData loadedFile = loadFileToMemory(resourcePath[0].string());
-        mFonts_[resourceName] = std::make_unique<Font>(*mGraphicsAPI_, loadedFile);
+        return addResource(std::make_unique<Font>(*mGraphicsAPI_, loadedFile), resourceName);
     }
+    return {};
 }
 
 template<typename T>
-void Resources::addResource(std::unique_ptr<T> resource, const std::string& resourceName) {
+Resources::LoadHandle Resources::loadResourceAsync(const std::vector<std::filesystem::path>& resourcePaths, const std::string& resourceName) {
+    auto load = std::make_shared<AsyncLoad>();
+    load->state = std::make_shared<LoadHandle::State>();
+    load->state->name = resourceName;
+
+    // Each decode fills data shared with its create, which runs once decode is done
     if constexpr (std::is_same_v<T, Mesh>) {
-        mMeshes_[resourceName] = std::move(resource);
+        auto meshes = std::make_shared<std::vector<Mesh::Data>>();
+        load->decode = [resourcePaths, meshes] {
+            utils::FileData loadedFile = loadFileToMemory(resourcePaths[0].string());
+            Mesh::parseMeshData(loadedFile, *meshes);
+            if (meshes->size() != 1) {
+                throw std::runtime_error("Mesh Resource contains " + std::to_string(meshes->size()) + " meshes");
+            }
+        };
+        load->create = [this, meshes, resourceName] {
+            const Mesh::Data& data = meshes->front();
+            addResource(std::make_unique<Mesh>(*mGraphicsAPI_, data.vertices, data.indices, Mesh::VertexLayout::compact()), resourceName);
+        };
     } else if constexpr (std::is_same_v<T, Model>) {
-        mModels_[resourceName] = std::move(resource);
+        auto model = std::make_shared<ModelData>();
+        load->decode = [resourcePaths, model] {
+            utils::FileData loadedFile = loadFileToMemory(resourcePaths[0].string());
+            Mesh::parseMeshData(loadedFile, model->meshes);
+            for (const float ratio : Model::DEFAULT_LOD_RATIOS) {
+                std::vector<Mesh::Data>& lod = model->lods.emplace_back();
+                for (const Mesh::Data& mesh : model->meshes) {
+                    lod.push_back(Mesh::simplify(mesh.vertices, mesh.indices, ratio));
+                }
+            }
+        };
+        load->create = [this, model, resourceName] {
+            auto pModel = std::make_unique<Model>();
+            pModel->addMeshes(createMeshes(*mGraphicsAPI_, model->meshes));
+            for (size_t i = 0; i < model->lods.size(); ++i) {
+                pModel->addLod(createMeshes(*mGraphicsAPI_, model->lods[i]), Model::DEFAULT_LOD_RATIOS[i]);
+            }
+            addResource(std::move(pModel), resourceName);
+        };
     } else if constexpr (std::is_same_v<T, Texture>) {
-        mTextures_[resourceName] = std::move(resource);
-    } else if constexpr (std::is_same_v<T, ShaderProgram>) {
-        mShaders_[resourceName] = std::move(resource);
+        auto texture = std::make_shared<TextureData>();
+        // Format support is read from the flags of the context, so it can be checked on a loader
+        IGraphicsAPI* graphicsAPI = mGraphicsAPI_;
+        load->decode = [resourcePaths, resourceName, texture, graphicsAPI] {
+            texture->image.emplace(loadTextureImage(*graphicsAPI, resourcePaths, resourceName));
+            if (!graphicsAPI->isCompressedFormatSupported(texture->image->getFormat())) {
+                for (size_t i = 0; i < texture->image->getLevels().size(); ++i) {
+                    texture->decodedLevels.push_back(texture->image->decodeLevel(i));
+                }
+            }
+        };
+        load->create = [this, texture, resourceName] {
+            addResource(std::make_unique<Texture>(*mGraphicsAPI_, *texture->image, SamplerState::trilinear(), texture->decodedLevels), resourceName);
+        };
     } else if constexpr (std::is_same_v<T, Audio>) {
-        mAudios_[resourceName] = std::move(resource);
+        auto samples = std::make_shared<Audio::Samples>();
+        load->decode = [resourcePaths, samples] {
+            utils::FileData loadedFile = loadFileToMemory(resourcePaths[0].string());
+            *samples = Audio::decode(loadedFile);
+        };
+        load->create = [this, samples, resourceName] {
+            addResource(std::make_unique<Audio>(std::move(*samples)), resourceName);
+        };
     } else if constexpr (std::is_same_v<T, Font>) {
-        mFonts_[resourceName] = std::move(resource);
-    } else if constexpr (std::is_same_v<T, SpriteSheet>) {
-        mSpriteSheets[resourceName] = std::move(resource);
+        auto atlas = std::make_shared<Font::Atlas>();
+        load->decode = [resourcePaths, atlas] {
+            utils::FileData loadedFile = loadFileToMemory(resourcePaths[0].string());
+            *atlas = Font::rasterize(loadedFile);
+        };
+        load->create = [this, atlas, resourceName] {
+            addResource(std::make_unique<Font>(*mGraphicsAPI_, std::move(*atlas)), resourceName);
+        };
     }
+
+    LoadHandle handle;
+    handle.mState_ = load->state;
+    enqueue(std::move(load));
+    return handle;
 }
 
-template<typename T>
-T* Resources::getResource(const std::string& resourceName) {
-    if constexpr (std::is_same_v<T, Mesh>) {
-        auto it = mMeshes_.find(resourceName);
-        if (it != mMeshes_.end()) {
-            return it->second.get();
-        }
-    } else if constexpr (std::is_same_v<T, Model>) {
-        auto it = mModels_.find(resourceName);
-        if (it != mModels_.end()) {
-            return it->second.get();
+void Resources::update() {
+    std::vector<std::shared_ptr<AsyncLoad>> decodedLoads;
+    {
+        std::lock_guard<std::mutex> lock(mLoadMutex_);
+        decodedLoads.swap(mDecodedLoads_);
+    }
+    for (const std::shared_ptr<AsyncLoad>& load : decodedLoads) {
+        finishLoad(*load);
+    }
+}
+
+void Resources::finishLoading() {
+    while (mPendingLoadCount_ > 0) {
+        {
+            std::unique_lock<std::mutex> lock(mLoadMutex_);
+            mDecodedCondition_.wait(lock, [this] { return !mDecodedLoads_.empty(); });
         }
-    } else if constexpr(std::is_same_v<T, Texture>) {
-        auto it = mTextures_.find(resourceName);
-        if (it != mTextures_.end()) {
-            return it->second.get();
+        update();
+    }
+}
+
+bool Resources::isLoading() const {
+    return mPendingLoadCount_ > 0;
+}
+
+void Resources::enqueue(std::shared_ptr<AsyncLoad> load) {
+    if (mLoaders_.empty()) {
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        // Leave a core for the render thread
+        const unsigned int loaderCount = std::clamp(hardwareThreads > 1 ? hardwareThreads - 1 : 1u, 1u, MAX_LOADER_COUNT);
+        for (unsigned int i = 0; i < loaderCount; ++i) {
+            mLoaders_.emplace_back(&Resources::loaderLoop, this);
         }
-    } else if constexpr (std::is_same_v<T, ShaderProgram>) {
-        auto it = mShaders_.find(resourceName);
-        if (it != mShaders_.end()) {
-            return it->second.get();
+    }
+    ++mPendingLoadCount_;
+    {
+        std::lock_guard<std::mutex> lock(mLoadMutex_);
+        mLoadQueue_.push_back(std::move(load));
+    }
+    mLoadCondition_.notify_one();
+}
+
+void Resources::loaderLoop() {
+    while (true) {
+        std::shared_ptr<AsyncLoad> load;
+        {
+            std::unique_lock<std::mutex> lock(mLoadMutex_);
+            mLoadCondition_.wait(lock, [this] { return mStopping_ || !mLoadQueue_.empty(); });
+            if (mStopping_) {
+                return;
+            }
+            load = std::move(mLoadQueue_.front());
+            mLoadQueue_.pop_front();
         }
-    } else if constexpr (std::is_same_v<T, Audio>) {
-        auto it = mAudios_.find(resourceName);
-        if (it != mAudios_.end()) {
-            return it->second.get();
+
+        try {
+            load->decode();
+        } catch (const std::exception& e) {
+            load->failed = true;
+            load->state->error = e.what();
+        } catch (...) {
+            load->failed = true;
+            load->state->error = "Unknown error";
         }
-    } else if constexpr (std::is_same_v<T, Font>) {
-        auto it = mFonts_.find(resourceName);
-        if (it != mFonts_.end()) {
-            return it->second.get();
+
+        {
+            std::lock_guard<std::mutex> lock(mLoadMutex_);
+            mDecodedLoads_.push_back(std::move(load));
         }
-    } else if constexpr (std::is_same_v<T, SpriteSheet>) {
-        auto it = mSpriteSheets.find(resourceName);
-        if (it != mSpriteSheets.end()) {
-            return it->second.get();
+        mDecodedCondition_.notify_all();
+    }
+}
+
+void Resources::finishLoad(AsyncLoad& load) {
+    --mPendingLoadCount_;
+    if (!load.failed) {
+        try {
+            load.create();
+            load.state->status = LoadHandle::Status::READY;
+            return;
+        } catch (const std::exception& e) {
+            load.state->error = e.what();
         }
     }
+    LOG_E("Failed to load resource %s: %s", load.state->name.c_str(), load.state->error.c_str());
+    load.state->status = LoadHandle::Status::FAILED;
+}
 
-    // Return nullptr if resource not found or type mismatch
-    return nullptr;
+template<typename T>
+ResourceHandle<T> Resources::addResource(std::unique_ptr<T> resource, const std::string& resourceName) {
+    return getPool<T>().add(std::move(resource), resourceName);
+}
+
+template<typename T>
+ResourceHandle<T> Resources::getHandle(const std::string& resourceName) const {
+    return getPool<T>().find(resourceName);
+}
+
+template<typename T>
+T* Resources::getResource(const std::string& resourceName) {
+    // Return nullptr if resource not found
+    return getPool<T>().get(getHandle<T>(resourceName));
+}
+
+template<typename T>
+T* Resources::getResource(ResourceHandle<T> handle) {
+    return getPool<T>().get(handle);
 }
 
 template<typename T>
 void Resources::release(const std::string& resourceName) {
-    if constexpr (std::is_same_v<T, Mesh>) {
-        auto it = mMeshes_.find(resourceName);
-        if (it != mMeshes_.end()) {
-            mMeshes_.erase(it);
-        }
-    } else if constexpr (std::is_same_v<T, Model>) {
-        auto it = mModels_.find(resourceName);
-        if (it != mModels_.end()) {
-            mModels_.erase(it);
-        }
-    } else if constexpr(std::is_same_v<T, Texture>) {
-        auto it = mTextures_.find(resourceName);
-        if (it != mTextures_.end()) {
-            mTextures_.erase(it);
-        }
-    } else if constexpr (std::is_same_v<T, ShaderProgram>) {
-        auto it = mShaders_.find(resourceName);
-        if (it != mShaders_.end()) {
-            mShaders_.erase(it);
-        }
-    } else if constexpr (std::is_same_v<T, Audio>) {
-        auto it = mAudios_.find(resourceName);
-        if (it != mAudios_.end()) {
-            mAudios_.erase(it);
-        }
-    } else if constexpr (std::is_same_v<T, Font>) {
-        auto it = mFonts_.find(resourceName);
-        if (it != mFonts_.end()) {
-            mFonts_.erase(it);
-        }
-    } else if constexpr (std::is_same_v<T, SpriteSheet>) {
-        auto it = mSpriteSheets.find(resourceName);
-        if (it != mSpriteSheets.end()) {
-            mSpriteSheets.erase(it);
-        }
+    release(getHandle<T>(resourceName));
+}
+
+template<typename T>
+void Resources::release(ResourceHandle<T> handle) {
+    Pool<T>& pool = getPool<T>();
+    if (pool.get(handle) != nullptr) {
+        pool.releaseSlot(handle.getIndex());
     }
 }
 
@@ -161,25 +378,130 @@ void Resources::releaseAll() {
     mShaders_.clear();
     mAudios_.clear();
     mFonts_.clear();
-    mSpriteSheets.clear();
+    mSpriteSheets_.clear();
+}
+
+template<typename T>
+Resources::Pool<T>& Resources::getPool() {
+    return const_cast<Pool<T>&>(static_cast<const Resources*>(this)->getPool<T>());
+}
+
+template<typename T>
+const Resources::Pool<T>& Resources::getPool() const {
+    if constexpr (std::is_same_v<T, Mesh>) {
+        return mMeshes_;
+    } else if constexpr (std::is_same_v<T, Model>) {
+        return mModels_;
+    } else if constexpr (std::is_same_v<T, Texture>) {
+        return mTextures_;
+    } else if constexpr (std::is_same_v<T, ShaderProgram>) {
+        return mShaders_;
+    } else if constexpr (std::is_same_v<T, Audio>) {
+        return mAudios_;
+    } else if constexpr (std::is_same_v<T, Font>) {
+        return mFonts_;
+    } else {
+        static_assert(std::is_same_v<T, SpriteSheet>, "Not a resource type");
+        return mSpriteSheets_;
+    }
+}
+
+template<typename T>
+ResourceHandle<T> Resources::Pool<T>::add(std::unique_ptr<T> resource, const std::string& name) {
+    auto it = names.find(name);
+    if (it != names.end()) {
+        releaseSlot(it->second);
+    }
+
+    uint32_t index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        if (slots.size() > ResourceHandle<T>::MAX_INDEX) {
+            LOG_E("Too many resources to add %s", name.c_str());
+            throw std::runtime_error("Resource slots are full");
+        }
+        index = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+
+    Slot& slot = slots[index];
+    slot.resource = std::move(resource);
+    slot.name = name;
+    names[name] = index;
+    return {index, slot.generation};
+}
+
+template<typename T>
+T* Resources::Pool<T>::get(ResourceHandle<T> handle) const {
+    const uint32_t index = handle.getIndex();
+    if (index < slots.size() && slots[index].generation == handle.getGeneration()) {
+        return slots[index].resource.get();
+    }
+    return nullptr;
+}
+
+template<typename T>
+ResourceHandle<T> Resources::Pool<T>::find(const std::string& name) const {
+    auto it = names.find(name);
+    if (it != names.end()) {
+        return {it->second, slots[it->second].generation};
+    }
+    return {};
+}
+
+template<typename T>
+void Resources::Pool<T>::releaseSlot(uint32_t index) {
+    Slot& slot = slots[index];
+    names.erase(slot.name);
+    slot.resource.reset();
+    slot.name.clear();
+    // Generation 0 is skipped so default handles never match
+    slot.generation = slot.generation == ResourceHandle<T>::MAX_GENERATION ? 1 : slot.generation + 1;
+    freeSlots.push_back(index);
+}
+
+template<typename T>
+void Resources::Pool<T>::clear() {
+    for (uint32_t i = 0; i < slots.size(); ++i) {
+        if (slots[i].resource) {
+            releaseSlot(i);
+        }
+    }
 }
 
 // Explicit instantiate template for expected types
-template void Resources::loadResource<Mesh>(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName);
-template void Resources::loadResource<Model>(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName);
-template void Resources::loadResource<Texture>(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName);
-template void Resources::loadResource<ShaderProgram>(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName);
-template void Resources::loadResource<Audio>(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName);
-template void Resources::loadResource<Font>(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName);
+template ResourceHandle<Mesh> Resources::loadResource<Mesh>(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName);
+template ResourceHandle<Model> Resources::loadResource<Model>(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName);
+template ResourceHandle<Texture> Resources::loadResource<Texture>(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName);
+template ResourceHandle<ShaderProgram> Resources::loadResource<ShaderProgram>(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName);
+template ResourceHandle<Audio> Resources::loadResource<Audio>(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName);
+template ResourceHandle<Font> Resources::loadResource<Font>(const std::vector<std::filesystem::path>& resourcePath, const std::string& resourceName);
 // No load for SpriteSheet
 
-template void Resources::addResource(std::unique_ptr<Mesh> resource, const std::string& resourceName);
-template void Resources::addResource(std::unique_ptr<Model> resource, const std::string& resourceName);
-template void Resources::addResource(std::unique_ptr<Texture> resource, const std::string& resourceName);
-template void Resources::addResource(std::unique_ptr<ShaderProgram> resource, const std::string& resourceName);
-template void Resources::addResource(std::unique_ptr<Audio> resource, const std::string& resourceName);
-template void Resources::addResource(std::unique_ptr<Font> resource, const std::string& resourceName);
-template void Resources::addResource(std::unique_ptr<SpriteSheet> resource, const std::string& resourceName);
+template Resources::LoadHandle Resources::loadResourceAsync<Mesh>(const std::vector<std::filesystem::path>& resourcePaths, const std::string& resourceName);
+template Resources::LoadHandle Resources::loadResourceAsync<Model>(const std::vector<std::filesystem::path>& resourcePaths, const std::string& resourceName);
+template Resources::LoadHandle Resources::loadResourceAsync<Texture>(const std::vector<std::filesystem::path>& resourcePaths, const std::string& resourceName);
+template Resources::LoadHandle Resources::loadResourceAsync<Audio>(const std::vector<std::filesystem::path>& resourcePaths, const std::string& resourceName);
+template Resources::LoadHandle Resources::loadResourceAsync<Font>(const std::vector<std::filesystem::path>& resourcePaths, const std::string& resourceName);
+// No asynchronous load for ShaderProgram or SpriteSheet
+
+template ResourceHandle<Mesh> Resources::addResource(std::unique_ptr<Mesh> resource, const std::string& resourceName);
+template ResourceHandle<Model> Resources::addResource(std::unique_ptr<Model> resource, const std::string& resourceName);
+template ResourceHandle<Texture> Resources::addResource(std::unique_ptr<Texture> resource, const std::string& resourceName);
+template ResourceHandle<ShaderProgram> Resources::addResource(std::unique_ptr<ShaderProgram> resource, const std::string& resourceName);
+template ResourceHandle<Audio> Resources::addResource(std::unique_ptr<Audio> resource, const std::string& resourceName);
+template ResourceHandle<Font> Resources::addResource(std::unique_ptr<Font> resource, const std::string& resourceName);
+template ResourceHandle<SpriteSheet> Resources::addResource(std::unique_ptr<SpriteSheet> resource, const std::string& resourceName);
+
+template ResourceHandle<Mesh> Resources::getHandle(const std::string& resourceName) const;
+template ResourceHandle<Model> Resources::getHandle(const std::string& resourceName) const;
+template ResourceHandle<Texture> Resources::getHandle(const std::string& resourceName) const;
+template ResourceHandle<ShaderProgram> Resources::getHandle(const std::string& resourceName) const;
+template ResourceHandle<Audio> Resources::getHandle(const std::string& resourceName) const;
+template ResourceHandle<Font> Resources::getHandle(const std::string& resourceName) const;
+template ResourceHandle<SpriteSheet> Resources::getHandle(const std::string& resourceName) const;
 
 template Mesh* Resources::getResource(const std::string& resourceName);
 template Model* Resources::getResource(const std::string& resourceName);
@@ -189,6 +511,14 @@ template Audio* Resources::getResource(const std::string& resourceName);
 template Font* Resources::getResource(const std::string& resourceName);
 template SpriteSheet* Resources::getResource(const std::string& resourceName);
 
+template Mesh* Resources::getResource(ResourceHandle<Mesh> handle);
+template Model* Resources::getResource(ResourceHandle<Model> handle);
+template Texture* Resources::getResource(ResourceHandle<Texture> handle);
+template ShaderProgram* Resources::getResource(ResourceHandle<ShaderProgram> handle);
+template Audio* Resources::getResource(ResourceHandle<Audio> handle);
+template Font* Resources::getResource(ResourceHandle<Font> handle);
+template SpriteSheet* Resources::getResource(ResourceHandle<SpriteSheet> handle);
+
 template void Resources::release<Mesh>(const std::string& resourceName);
 template void Resources::release<Model>(const std::string& resourceName);
 template void Resources::release<Texture>(const std::string& resourceName);
@@ -197,4 +527,12 @@ template void Resources::release<Audio>(const std::string& resourceName);
 template void Resources::release<Font>(const std::string& resourceName);
 template void Resources::release<SpriteSheet>(const std::string& resourceName);
 
+template void Resources::release(ResourceHandle<Mesh> handle);
+template void Resources::release(ResourceHandle<Model> handle);
+template void Resources::release(ResourceHandle<Texture> handle);
+template void Resources::release(ResourceHandle<ShaderProgram> handle);
+template void Resources::release(ResourceHandle<Audio> handle);
+template void Resources::release(ResourceHandle<Font> handle);
+template void Resources::release(ResourceHandle<SpriteSheet> handle);
+
 } // namespace clay
\ No newline at end of file
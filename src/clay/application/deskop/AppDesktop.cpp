@@ -18,6 +18,8 @@ bool AppDesktop::sOpenGLInitialized_ = false;
 AppDesktop::AppDesktop() {}
 
 AppDesktop::~AppDesktop() {
+    // Stop the texture workers before the context is gone
+    mpTextureStreamer_.reset();
     // Clean Application resources
     ImGuiComponent::deinitialize();
     glfwTerminate();
@@ -37,11 +39,14 @@ void AppDesktop::initialize() {
     mpRenderer_ = std::make_unique<Renderer>(
         mpWindow_->getDimensions(),
         *(mResources_.getResource<ShaderProgram>("TextureSurface")),
+        *(mResources_.getResource<ShaderProgram>("SpriteInstanced")),
         *(mResources_.getResource<ShaderProgram>("Text")),
-        *(mResources_.getResource<ShaderProgram>("MVPShader")),
         *(mResources_.getResource<Mesh>("RectPlane")),
-        *(mResources_.getResource<ShaderProgram>("Blur")),
+        *(mResources_.getResource<ShaderProgram>("BloomDownsample")),
+        *(mResources_.getResource<ShaderProgram>("BloomUpsample")),
         *(mResources_.getResource<ShaderProgram>("BloomFinal")),
+        *(mResources_.getResource<ShaderProgram>("DebugLine")),
+        *(mResources_.getResource<ShaderProgram>("DebugThickLine")),
         *mGraphicsAPI_
     );
 }
@@ -61,12 +66,16 @@ void AppDesktop::update() {
     mLastTime_ = std::chrono::steady_clock::now();
     // Update application content
     mpWindow_->update(dt.count());
+    mpTextureStreamer_->update();
+    // Create the resources finished loading asynchronously
+    mResources_.update();
     // Update list in reverse order and delete any marked for removal
     for (auto it = mScenes_.rbegin(); it != mScenes_.rend();) {
         if ((*it)->isRemove()) {
             // Erase and update the iterator
             it = decltype(it)(mScenes_.erase(std::next(it).base()));
         } else {
+            (*it)->getResources().update();
             (*it)->update(dt.count());
             ++it;
         }
@@ -121,6 +130,8 @@ void AppDesktop::render() {
     // Render list in reverse order
     for (auto it = mScenes_.rbegin(); it != mScenes_.rend(); ++it) {
        (*it)->render(*mpRenderer_);
+       // Debug shapes use the camera of the scene that added them
+       mpRenderer_->flushDebugDraw();
     }
     mpRenderer_->renderHDR();
 
@@ -130,6 +141,7 @@ void AppDesktop::render() {
        (*it)->renderGUI();
     }
 
+    mpRenderer_->endFrame();
     mpWindow_->render();
 }
 
@@ -208,6 +220,49 @@ void AppDesktop::loadResources() {
         // add to resource
         mResources_.addResource<ShaderProgram>(std::move(shader), "Assimp");
     }
+    {
+        auto vertexShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/AssimpInstanced.vert").string());
+        auto fragmentShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/AssimpInstanced.frag").string());
+        // TODO use size so null string conversion for null terminator is not needed
+        std::unique_ptr<ShaderProgram> shader = std::make_unique<ShaderProgram>(*mGraphicsAPI_);
+        shader->addShader({
+            ShaderCreateInfo::Type::VERTEX,
+            std::string(reinterpret_cast<char*>(vertexShaderFileData.data.get()), vertexShaderFileData.size).c_str(),
+            vertexShaderFileData.size
+        });
+        shader->addShader({
+            ShaderCreateInfo::Type::FRAGMENT,
+            std::string(reinterpret_cast<char*>(fragmentShaderFileData.data.get()), fragmentShaderFileData.size).c_str(),
+            fragmentShaderFileData.size
+        });
+
+        shader->linkProgram();
+        // add to resource
+        mResources_.addResource<ShaderProgram>(std::move(shader), "AssimpInstanced");
+    }
+    {
+        auto vertexShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/AssimpLightInstanced.vert").string());
+        auto fragmentShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/AssimpLightInstanced.frag").string());
+        // TODO use size so null string conversion for null terminator is not needed
+        std::unique_ptr<ShaderProgram> shader = std::make_unique<ShaderProgram>(*mGraphicsAPI_);
+        shader->addShader({
+            ShaderCreateInfo::Type::VERTEX,
+            std::string(reinterpret_cast<char*>(vertexShaderFileData.data.get()), vertexShaderFileData.size).c_str(),
+            vertexShaderFileData.size
+        });
+        shader->addShader({
+            ShaderCreateInfo::Type::FRAGMENT,
+            std::string(reinterpret_cast<char*>(fragmentShaderFileData.data.get()), fragmentShaderFileData.size).c_str(),
+            fragmentShaderFileData.size
+        });
+
+        shader->linkProgram();
+        // add to resource
+        mResources_.addResource<ShaderProgram>(std::move(shader), "AssimpLightInstanced");
+    }
+    // Draws of the Assimp shaders sharing a mesh in the render queue are instanced with these variants
+    mResources_.getResource<ShaderProgram>("Assimp")->setInstancedVariant(mResources_.getResource<ShaderProgram>("AssimpInstanced"));
+    mResources_.getResource<ShaderProgram>("AssimpLight")->setInstancedVariant(mResources_.getResource<ShaderProgram>("AssimpLightInstanced"));
     {
         auto vertexShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/MVPTexShader.vert").string());
         auto fragmentShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/MVPTexShader.frag").string());
@@ -268,6 +323,46 @@ void AppDesktop::loadResources() {
         // add to resource
         mResources_.addResource<ShaderProgram>(std::move(shader), "MVPShader");
     }
+    {
+        auto vertexShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/DebugLine.vert").string());
+        auto fragmentShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/DebugLine.frag").string());
+        // TODO use size so null string conversion for null terminator is not needed
+        std::unique_ptr<ShaderProgram> shader = std::make_unique<ShaderProgram>(*mGraphicsAPI_);
+        shader->addShader({
+            ShaderCreateInfo::Type::VERTEX,
+            std::string(reinterpret_cast<char*>(vertexShaderFileData.data.get()), vertexShaderFileData.size).c_str(),
+            vertexShaderFileData.size
+        });
+        shader->addShader({
+            ShaderCreateInfo::Type::FRAGMENT,
+            std::string(reinterpret_cast<char*>(fragmentShaderFileData.data.get()), fragmentShaderFileData.size).c_str(),
+            fragmentShaderFileData.size
+        });
+
+        shader->linkProgram();
+        // add to resource
+        mResources_.addResource<ShaderProgram>(std::move(shader), "DebugLine");
+    }
+    {
+        auto vertexShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/DebugThickLine.vert").string());
+        auto fragmentShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/DebugLine.frag").string());
+        // TODO use size so null string conversion for null terminator is not needed
+        std::unique_ptr<ShaderProgram> shader = std::make_unique<ShaderProgram>(*mGraphicsAPI_);
+        shader->addShader({
+            ShaderCreateInfo::Type::VERTEX,
+            std::string(reinterpret_cast<char*>(vertexShaderFileData.data.get()), vertexShaderFileData.size).c_str(),
+            vertexShaderFileData.size
+        });
+        shader->addShader({
+            ShaderCreateInfo::Type::FRAGMENT,
+            std::string(reinterpret_cast<char*>(fragmentShaderFileData.data.get()), fragmentShaderFileData.size).c_str(),
+            fragmentShaderFileData.size
+        });
+
+        shader->linkProgram();
+        // add to resource
+        mResources_.addResource<ShaderProgram>(std::move(shader), "DebugThickLine");
+    }
     {
         auto vertexShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/TextureSurface.vert").string());
         auto fragmentShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/TextureSurface.frag").string());
@@ -289,8 +384,8 @@ void AppDesktop::loadResources() {
         mResources_.addResource<ShaderProgram>(std::move(shader), "TextureSurface");
     }
     {
-        auto vertexShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/Blur.vert").string());
-        auto fragmentShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/Blur.frag").string());
+        auto vertexShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/SpriteInstanced.vert").string());
+        auto fragmentShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/SpriteInstanced.frag").string());
         // TODO use size so null string conversion for null terminator is not needed
         std::unique_ptr<ShaderProgram> shader = std::make_unique<ShaderProgram>(*mGraphicsAPI_);
         shader->addShader({
@@ -306,7 +401,47 @@ void AppDesktop::loadResources() {
 
         shader->linkProgram();
         // add to resource
-        mResources_.addResource<ShaderProgram>(std::move(shader), "Blur");
+        mResources_.addResource<ShaderProgram>(std::move(shader), "SpriteInstanced");
+    }
+    {
+        auto vertexShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/BloomDownsample.vert").string());
+        auto fragmentShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/BloomDownsample.frag").string());
+        // TODO use size so null string conversion for null terminator is not needed
+        std::unique_ptr<ShaderProgram> shader = std::make_unique<ShaderProgram>(*mGraphicsAPI_);
+        shader->addShader({
+            ShaderCreateInfo::Type::VERTEX,
+            std::string(reinterpret_cast<char*>(vertexShaderFileData.data.get()), vertexShaderFileData.size).c_str(),
+            vertexShaderFileData.size
+        });
+        shader->addShader({
+            ShaderCreateInfo::Type::FRAGMENT,
+            std::string(reinterpret_cast<char*>(fragmentShaderFileData.data.get()), fragmentShaderFileData.size).c_str(),
+            fragmentShaderFileData.size
+        });
+
+        shader->linkProgram();
+        // add to resource
+        mResources_.addResource<ShaderProgram>(std::move(shader), "BloomDownsample");
+    }
+    {
+        auto vertexShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/BloomUpsample.vert").string());
+        auto fragmentShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/BloomUpsample.frag").string());
+        // TODO use size so null string conversion for null terminator is not needed
+        std::unique_ptr<ShaderProgram> shader = std::make_unique<ShaderProgram>(*mGraphicsAPI_);
+        shader->addShader({
+            ShaderCreateInfo::Type::VERTEX,
+            std::string(reinterpret_cast<char*>(vertexShaderFileData.data.get()), vertexShaderFileData.size).c_str(),
+            vertexShaderFileData.size
+        });
+        shader->addShader({
+            ShaderCreateInfo::Type::FRAGMENT,
+            std::string(reinterpret_cast<char*>(fragmentShaderFileData.data.get()), fragmentShaderFileData.size).c_str(),
+            fragmentShaderFileData.size
+        });
+
+        shader->linkProgram();
+        // add to resource
+        mResources_.addResource<ShaderProgram>(std::move(shader), "BloomUpsample");
     }
     {
         auto vertexShaderFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "shaders/BloomFinal.vert").string());
@@ -334,16 +469,23 @@ void AppDesktop::loadResources() {
         auto imageData = utils::fileDataToImageData(spritesFileData);
         mResources_.addResource(std::move(std::make_unique<Texture>(*mGraphicsAPI_, imageData, true)), "SpriteSheet");
     }
-    {
-        auto vFileData = Resources::loadFileToMemory((Resources::RESOURCE_PATH / "V.png").string());
-        auto imageData = utils::fileDataToImageData(vFileData);
-        mResources_.addResource(std::move(std::make_unique<Texture>(*mGraphicsAPI_, imageData, true)), "SampleTexture");
-    }
 
     // Single white pixel
     std::vector<unsigned char> whitePixel{0xFF, 0xFF, 0xFF};
     mResources_.addResource(std::move(std::make_unique<Texture>(*mGraphicsAPI_, whitePixel.data(), 1, 1, 3)), "Blank");
 
+    // Streamed textures show the blank texture until they are loaded
+    mpTextureStreamer_ = std::make_unique<TextureStreamer>(
+        *mGraphicsAPI_,
+        *mResources_.getResource<Texture>("Blank"),
+        [](const std::string& path) { return Resources::loadFileToMemory(path); },
+        utils::decodeImage
+    );
+    mResources_.addResource(
+        mpTextureStreamer_->request((Resources::RESOURCE_PATH / "V.png").string(), Texture::CreateInfo::mipmapped(true)),
+        "SampleTexture"
+    );
+
     // Mesh
     mResources_.addResource(
         std::move(std::make_unique<Mesh>(
@@ -515,6 +657,10 @@ Renderer& AppDesktop::getRenderer() {
     return *mpRenderer_.get();
 }
 
+TextureStreamer& AppDesktop::getTextureStreamer() {
+    return *mpTextureStreamer_;
+}
+
 IGraphicsAPI* AppDesktop::getGraphicsAPI() {
     return mGraphicsAPI_;
 }
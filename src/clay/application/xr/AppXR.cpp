@@ -797,12 +797,15 @@ bool AppXR::renderLayer(RenderLayerInfo &renderLayerInfo) {
         {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW}
     );
 
+    // Create the resources finished loading asynchronously
+    mResources_.update();
     // update scene before render TODO use real dt and not in a render method
     for (auto it = mScenes_.rbegin(); it != mScenes_.rend();) {
         if ((*it)->isRemove()) {
             // Erase and update the iterator
             it = decltype(it)(mScenes_.erase(std::next(it).base()));
         } else {
+            (*it)->getResources().update();
             (*it)->update(0);
             ++it;
         }
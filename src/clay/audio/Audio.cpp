@@ -57,14 +57,37 @@ sf_count_t vio_write(const void* ptr, sf_count_t count, void* user_data) {
     return 0;
 }
 
-Audio::Audio(utils::FileData& fileData) {
-    ALenum err, format;
+Audio::Audio(utils::FileData& fileData)
+: Audio(decode(fileData)) {}
+
+Audio::Audio(Samples&& samples) {
+    ALenum err;
     ALuint buffer;
+    const ALsizei num_bytes = static_cast<ALsizei>(samples.data.size() * sizeof(short));
+
+    // Buffer the audio data into a new buffer object
+    buffer = 0;
+    alGenBuffers(1, &buffer);
+    alBufferData(buffer, samples.format, samples.data.data(), num_bytes, samples.sampleRate);
+
+    // Check if an error occurred, and clean up if so.
+    err = alGetError();
+    if (err != AL_NO_ERROR) {
+        LOG_E("OpenAL Error: %s\n", alGetString(err));
+        if (buffer && alIsBuffer(buffer)) {
+            alDeleteBuffers(1, &buffer);
+        }
+        throw std::runtime_error("OpenAL error");
+    }
+
+    mId_ = buffer;
+}
+
+Audio::Samples Audio::decode(utils::FileData& fileData) {
+    ALenum format;
     SNDFILE* sndfile;
     SF_INFO sfinfo;
-    short* membuf;
     sf_count_t num_frames;
-    ALsizei num_bytes;
     // Open the audio file and check that it's usable.
     SF_VIRTUAL_IO vio = {
             vio_get_filelen, // Function to get the length of the file
@@ -103,43 +126,26 @@ Audio::Audio(utils::FileData& fileData) {
     }
     if (!format) {
         LOG_E("Unsupported channel count: %d\n", sfinfo.channels);
+        sf_close(sndfile);
         throw std::runtime_error("Unsupported channel count");
     }
 
     // Decode the whole audio file to a buffer.
-    membuf = static_cast<short*>(malloc((size_t)(sfinfo.frames * sfinfo.channels) * sizeof(short)));
+    Samples samples;
+    samples.format = format;
+    samples.sampleRate = sfinfo.samplerate;
+    samples.data.resize(static_cast<size_t>(sfinfo.frames * sfinfo.channels));
 
-    num_frames = sf_readf_short(sndfile, membuf, sfinfo.frames);
+    num_frames = sf_readf_short(sndfile, samples.data.data(), sfinfo.frames);
+    sf_close(sndfile);
     if (num_frames < 1) {
-        free(membuf);
-        sf_close(sndfile);
         throw std::runtime_error("Failed to read sample");
         //return 0;
     }
-    num_bytes = (ALsizei)(num_frames * sfinfo.channels) * (ALsizei)sizeof(short);
-
-    // Buffer the audio data into a new buffer object, then free the data and close the file.
-    buffer = 0;
-    alGenBuffers(1, &buffer);
-    alBufferData(buffer, format, membuf, num_bytes, sfinfo.samplerate);
-
-    free(membuf);
-    sf_close(sndfile);
-
-    // Check if an error occurred, and clean up if so.
-    err = alGetError();
-    if (err != AL_NO_ERROR) {
-        LOG_E("OpenAL Error: %s\n", alGetString(err));
-        if (buffer && alIsBuffer(buffer)) {
-            alDeleteBuffers(1, &buffer);
-        }
-        throw std::runtime_error("OpenAL error");
-    }
-
-    mId_ = buffer;
+    samples.data.resize(static_cast<size_t>(num_frames * sfinfo.channels));
+    return samples;
 }
 
-
 Audio::~Audio() {
     alDeleteBuffers(1, &mId_);
 }
@@ -7,9 +7,13 @@
 namespace clay {
 
 Entity::Entity(BaseScene& scene)
-    : mScene_(scene) {}
+    : mScene_(scene) {
+    mTransformNode_ = mScene_.getTransformHierarchy().addNode(this);
+}
 
-Entity::~Entity() {}
+Entity::~Entity() {
+    mScene_.getTransformHierarchy().removeNode(mTransformNode_);
+}
 
 void Entity::update(float dt) {
     for (auto& pair : mPhysicsComponents_) {
@@ -18,20 +22,14 @@ void Entity::update(float dt) {
         }
     }
 
-    mPosition_ += mVelocity_ * dt;
+    if (mVelocity_ != glm::vec3(0.0f)) {
+        mPosition_ += mVelocity_ * dt;
+        markTransformDirty();
+    }
 }
 
 void Entity::render(const Renderer& theRenderer) const{
-    // translation matrix for position
-    glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), mPosition_);
-    // rotation matrix
-    glm::mat4 rotationMatrix = glm::rotate(glm::mat4(1), glm::radians(mRotation_.x), glm::vec3(1.0f, 0.0f, 0.0f));
-    rotationMatrix = glm::rotate(rotationMatrix, glm::radians(mRotation_.y), glm::vec3(0.0f, 1.0f, 0.0f));
-    rotationMatrix = glm::rotate(rotationMatrix, glm::radians(mRotation_.z), glm::vec3(0.0f, 0.0f, 1.0f));
-    // scale matrix
-    glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), mScale_);
-
-    const glm::mat4 modelMat = translationMatrix * rotationMatrix * scaleMatrix;
+    const glm::mat4& modelMat = getWorldMatrix();
     for (const auto& eachRenderable : mRenderableComponents_) {
         if (eachRenderable->isEnabled()) {
             eachRenderable->render(theRenderer, modelMat);
@@ -75,8 +73,86 @@ glm::vec3 Entity::getVelocity() const {
     return mVelocity_;
 }
 
+const glm::mat4& Entity::getModelMatrix() const {
+    if (!mModelMatrixDirty_) {
+        return mModelMatrix_;
+    }
+    // translation matrix for position
+    glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), mPosition_);
+    // rotation matrix
+    glm::mat4 rotationMatrix = glm::rotate(glm::mat4(1), glm::radians(mRotation_.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    rotationMatrix = glm::rotate(rotationMatrix, glm::radians(mRotation_.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    rotationMatrix = glm::rotate(rotationMatrix, glm::radians(mRotation_.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    // scale matrix
+    glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), mScale_);
+
+    mModelMatrix_ = translationMatrix * rotationMatrix * scaleMatrix;
+    mModelMatrixDirty_ = false;
+    return mModelMatrix_;
+}
+
+const glm::mat4& Entity::getWorldMatrix() const {
+    return mScene_.getTransformHierarchy().getWorldMatrix(mTransformNode_);
+}
+
+void Entity::setParent(const Entity* parent) {
+    mScene_.getTransformHierarchy().setParent(
+        mTransformNode_,
+        parent != nullptr ? parent->mTransformNode_ : TransformHierarchy::INVALID_NODE
+    );
+}
+
+const Entity* Entity::getParent() const {
+    const TransformHierarchy& hierarchy = mScene_.getTransformHierarchy();
+    const TransformHierarchy::NodeId parent = hierarchy.getParent(mTransformNode_);
+    return parent != TransformHierarchy::INVALID_NODE ? hierarchy.getEntity(parent) : nullptr;
+}
+
+uint32_t Entity::getTransformGeneration() const {
+    return mTransformGeneration_;
+}
+
+void Entity::markTransformDirty() {
+    mModelMatrixDirty_ = true;
+    ++mTransformGeneration_;
+    mScene_.getTransformHierarchy().markDirty(mTransformNode_);
+}
+
+BoundingSphere Entity::getWorldBoundingSphere() const {
+    AABB worldBounds;
+    if (!getWorldBounds(worldBounds)) {
+        return {};
+    }
+    return BoundingSphere::fromAABB(worldBounds);
+}
+
+bool Entity::getWorldBounds(AABB& outBounds) const {
+    AABB localBounds;
+    for (const auto& eachRenderable : mRenderableComponents_) {
+        if (!eachRenderable->isEnabled()) {
+            continue;
+        }
+        AABB renderableBounds;
+        if (!eachRenderable->getBounds(renderableBounds)) {
+            return false;
+        }
+        localBounds.expand(renderableBounds);
+    }
+    outBounds = localBounds.transformed(getWorldMatrix());
+    return true;
+}
+
+void Entity::setOccluder(bool occluder) {
+    mIsOccluder_ = occluder;
+}
+
+bool Entity::isOccluder() const {
+    return mIsOccluder_;
+}
+
 void Entity::setPosition(const glm::vec3& newPosition) {
     mPosition_ = newPosition;
+    markTransformDirty();
     if (mCollider_ != nullptr) {
         mCollider_->setPosition(newPosition);
     }
@@ -84,10 +160,12 @@ void Entity::setPosition(const glm::vec3& newPosition) {
 
 void Entity::setRotation(const glm::vec3& newRotation) {
     mRotation_ = newRotation;
+    markTransformDirty();
 }
 
 void Entity::setScale(const glm::vec3& newScale) {
     mScale_ = newScale;
+    markTransformDirty();
 }
 
 void Entity::setVelocity(const glm::vec3& newVelocity) {
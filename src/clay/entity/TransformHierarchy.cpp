@@ -0,0 +1,202 @@
+// standard lib
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+// project
+#include "clay/entity/Entity.h"
+#include "clay/utils/common/Logger.h"
+// class
+#include "clay/entity/TransformHierarchy.h"
+
+namespace clay {
+
+TransformHierarchy::TransformHierarchy() {}
+
+TransformHierarchy::~TransformHierarchy() {}
+
+TransformHierarchy::NodeId TransformHierarchy::addNode(const Entity* entity) {
+    NodeId id;
+    if (!mFreeIds_.empty()) {
+        id = mFreeIds_.back();
+        mFreeIds_.pop_back();
+    } else {
+        id = static_cast<NodeId>(mIndexById_.size());
+        mIndexById_.push_back(std::numeric_limits<uint32_t>::max());
+    }
+
+    // Roots can go anywhere in depth order so the new node is appended
+    mIndexById_[id] = static_cast<uint32_t>(mEntities_.size());
+    mEntities_.push_back(entity);
+    mIds_.push_back(id);
+    mParentIds_.push_back(INVALID_NODE);
+    mParentIndices_.push_back(-1);
+    mWorldMatrices_.push_back(glm::mat4(1.0f));
+    mDirty_.push_back(1);
+    mUpdated_.push_back(0);
+    mAnyDirty_ = true;
+    return id;
+}
+
+void TransformHierarchy::removeNode(NodeId node) {
+    if (mOrderDirty_) {
+        rebuildOrder();
+    }
+    const uint32_t index = getIndex(node);
+
+    // Children become roots
+    for (size_t i = index + 1; i < mEntities_.size(); ++i) {
+        if (mParentIds_[i] == node) {
+            mParentIds_[i] = INVALID_NODE;
+            mDirty_[i] = 1;
+            mAnyDirty_ = true;
+        }
+    }
+
+    mEntities_.erase(mEntities_.begin() + index);
+    mIds_.erase(mIds_.begin() + index);
+    mParentIds_.erase(mParentIds_.begin() + index);
+    mParentIndices_.erase(mParentIndices_.begin() + index);
+    mWorldMatrices_.erase(mWorldMatrices_.begin() + index);
+    mDirty_.erase(mDirty_.begin() + index);
+    mUpdated_.erase(mUpdated_.begin() + index);
+
+    mIndexById_[node] = std::numeric_limits<uint32_t>::max();
+    mFreeIds_.push_back(node);
+
+    // Erasing keeps the depth order, only the positions after the removed node shift
+    for (size_t i = index; i < mEntities_.size(); ++i) {
+        mIndexById_[mIds_[i]] = static_cast<uint32_t>(i);
+        mParentIndices_[i] = mParentIds_[i] == INVALID_NODE ? -1 : static_cast<int32_t>(mIndexById_[mParentIds_[i]]);
+    }
+}
+
+void TransformHierarchy::setParent(NodeId node, NodeId parent) {
+    const uint32_t index = getIndex(node);
+    if (parent != INVALID_NODE) {
+        // Walk up from the new parent to make sure the node is not one of its ancestors
+        for (NodeId ancestor = parent; ancestor != INVALID_NODE; ancestor = mParentIds_[getIndex(ancestor)]) {
+            if (ancestor == node) {
+                LOG_E("Cannot parent transform node %u to its descendant %u", node, parent);
+                throw std::runtime_error("Transform hierarchy cycle");
+            }
+        }
+    }
+
+    mParentIds_[index] = parent;
+    mDirty_[index] = 1;
+    mAnyDirty_ = true;
+
+    if (parent == INVALID_NODE) {
+        mParentIndices_[index] = -1;
+    } else if (!mOrderDirty_ && getIndex(parent) < index) {
+        // Parent is already before the node, and the node's descendants are already after it
+        mParentIndices_[index] = static_cast<int32_t>(getIndex(parent));
+    } else {
+        mOrderDirty_ = true;
+    }
+}
+
+TransformHierarchy::NodeId TransformHierarchy::getParent(NodeId node) const {
+    return mParentIds_[getIndex(node)];
+}
+
+const Entity* TransformHierarchy::getEntity(NodeId node) const {
+    return mEntities_[getIndex(node)];
+}
+
+void TransformHierarchy::markDirty(NodeId node) {
+    mDirty_[getIndex(node)] = 1;
+    mAnyDirty_ = true;
+}
+
+const glm::mat4& TransformHierarchy::getWorldMatrix(NodeId node) const {
+    if (mAnyDirty_ || mOrderDirty_) {
+        update();
+    }
+    return mWorldMatrices_[getIndex(node)];
+}
+
+void TransformHierarchy::update() const {
+    if (mOrderDirty_) {
+        rebuildOrder();
+    }
+    mLastUpdateCount_ = 0;
+    if (!mAnyDirty_) {
+        return;
+    }
+
+    // Parents come first so their world matrices are final when their children are reached
+    const size_t count = mEntities_.size();
+    for (size_t i = 0; i < count; ++i) {
+        const int32_t parentIndex = mParentIndices_[i];
+        const bool needsUpdate = mDirty_[i] != 0 || (parentIndex >= 0 && mUpdated_[parentIndex] != 0);
+        mUpdated_[i] = needsUpdate;
+        if (!needsUpdate) {
+            continue;
+        }
+        const glm::mat4& localMatrix = mEntities_[i]->getModelMatrix();
+        mWorldMatrices_[i] = parentIndex >= 0 ? mWorldMatrices_[parentIndex] * localMatrix : localMatrix;
+        mDirty_[i] = 0;
+        ++mLastUpdateCount_;
+    }
+    mAnyDirty_ = false;
+}
+
+size_t TransformHierarchy::getLastUpdateCount() const {
+    return mLastUpdateCount_;
+}
+
+uint32_t TransformHierarchy::getIndex(NodeId node) const {
+    if (node >= mIndexById_.size() || mIndexById_[node] == std::numeric_limits<uint32_t>::max()) {
+        LOG_E("Invalid transform node %u", node);
+        throw std::runtime_error("Invalid transform node");
+    }
+    return mIndexById_[node];
+}
+
+uint32_t TransformHierarchy::computeDepth(NodeId node) const {
+    uint32_t depth = 0;
+    for (NodeId parent = mParentIds_[mIndexById_[node]]; parent != INVALID_NODE; parent = mParentIds_[mIndexById_[parent]]) {
+        ++depth;
+    }
+    return depth;
+}
+
+void TransformHierarchy::rebuildOrder() const {
+    const size_t count = mEntities_.size();
+
+    std::vector<uint32_t> depths(count);
+    for (size_t i = 0; i < count; ++i) {
+        depths[i] = computeDepth(mIds_[i]);
+    }
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&depths](uint32_t a, uint32_t b) {
+        return depths[a] < depths[b];
+    });
+
+    auto permute = [&order](auto& values) {
+        std::remove_reference_t<decltype(values)> sorted;
+        sorted.reserve(values.size());
+        for (uint32_t index : order) {
+            sorted.push_back(values[index]);
+        }
+        values.swap(sorted);
+    };
+    permute(mEntities_);
+    permute(mIds_);
+    permute(mParentIds_);
+    permute(mWorldMatrices_);
+    permute(mDirty_);
+    permute(mUpdated_);
+
+    for (size_t i = 0; i < count; ++i) {
+        mIndexById_[mIds_[i]] = static_cast<uint32_t>(i);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        mParentIndices_[i] = mParentIds_[i] == INVALID_NODE ? -1 : static_cast<int32_t>(mIndexById_[mParentIds_[i]]);
+    }
+    mOrderDirty_ = false;
+}
+
+} // namespace clay
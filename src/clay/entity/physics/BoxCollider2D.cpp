@@ -16,9 +16,9 @@ void BoxCollider2D::update(float dt) {
 }
 
 void BoxCollider2D::render(const Renderer& theRenderer) {
-    glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), mPosition_);
+    // Batched with every other collider outline and drawn on the next debug draw flush
     // TODO use other matrices
-    theRenderer.renderRectangleSimple(translationMatrix, {1,1,1,1});
+    theRenderer.getDebugDraw().addRect(mPosition_, glm::vec2(1.0f), {1,1,1,1});
 }
 
 bool BoxCollider2D::isColliding(const Collider& other) const {
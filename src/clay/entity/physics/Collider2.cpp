@@ -23,9 +23,8 @@ bool Collider2::isColliding(const Collider2* other) const {
 }
 
 void Collider2::render(const Renderer& theRenderer) {
-    glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), mPosition_);
-
-    theRenderer.renderRectangleSimple(translationMatrix, {1,1,1,1});
+    // Batched with every other collider outline and drawn on the next debug draw flush
+    theRenderer.getDebugDraw().addRect(mPosition_, glm::vec2(1.0f), {1,1,1,1});
 }
 
 std::optional<glm::vec3> Collider2::getCollisionNormal(Collider2* otherCollider) const {
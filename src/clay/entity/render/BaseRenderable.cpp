@@ -3,6 +3,37 @@
 
 namespace clay {
 
+bool BaseRenderable::getBounds(AABB& outBounds) const {
+    return false;
+}
+
+const glm::mat4& BaseRenderable::getLocalModelMatrix() const {
+    if (!mLocalModelMatrixDirty_) {
+        return mLocalModelMatrix_;
+    }
+    // translation matrix for position
+    glm::mat4 translationMat = glm::translate(glm::mat4(1.0f), mPosition_);
+    //rotation matrix
+    glm::mat4 rotationMat = glm::rotate(glm::mat4(1), glm::radians(mRotation_.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    rotationMat = glm::rotate(rotationMat, glm::radians(mRotation_.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    rotationMat = glm::rotate(rotationMat, glm::radians(mRotation_.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    // scale matrix
+    glm::mat4 scaleMat = glm::scale(glm::mat4(1.0f), mScale_);
+
+    mLocalModelMatrix_ = translationMat * rotationMat * scaleMat;
+    mLocalModelMatrixDirty_ = false;
+    return mLocalModelMatrix_;
+}
+
+uint32_t BaseRenderable::getTransformGeneration() const {
+    return mTransformGeneration_;
+}
+
+void BaseRenderable::markTransformDirty() {
+    mLocalModelMatrixDirty_ = true;
+    ++mTransformGeneration_;
+}
+
 void BaseRenderable::setEnabled(const bool isEnabled) {
     mEnabled_ = isEnabled;
 }
@@ -29,14 +60,17 @@ glm::vec4 BaseRenderable::getColor() const {
 
 void BaseRenderable::setPosition(const glm::vec3& newPosition) {
     mPosition_ = newPosition;
+    markTransformDirty();
 }
 
 void BaseRenderable::setRotation(const glm::vec3& newRotation) {
     mRotation_ = newRotation;
+    markTransformDirty();
 }
 
 void BaseRenderable::setScale(const glm::vec3& newScale) {
     mScale_ = newScale;
+    markTransformDirty();
 }
 
 void BaseRenderable::setColor(const glm::vec4& newColor) {
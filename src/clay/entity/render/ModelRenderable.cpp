@@ -1,51 +1,80 @@
+// standard lib
+#include <algorithm>
 // class
 #include "clay/entity/render/ModelRenderable.h"
 
 namespace clay {
 
 ModelRenderable::ModelRenderable(const Model* pModel, const ShaderProgram* pShader)
-    : mpModel_(pModel), mpShader_(pShader) {}
+    : mpModel_(pModel), mpShader_(pShader) {
+    resolveUniforms();
+}
 
 ModelRenderable::~ModelRenderable() {}
 
 void ModelRenderable::render(const Renderer& theRenderer, const glm::mat4& parentModelMat) const {
-    // translation matrix for position
-    glm::mat4 translationMat = glm::translate(glm::mat4(1.0f), mPosition_);
-    //rotation matrix
-    glm::mat4 rotationMat = glm::rotate(glm::mat4(1), glm::radians(mRotation_.x), glm::vec3(1.0f, 0.0f, 0.0f));
-    rotationMat = glm::rotate(rotationMat, glm::radians(mRotation_.y), glm::vec3(0.0f, 1.0f, 0.0f));
-    rotationMat = glm::rotate(rotationMat, glm::radians(mRotation_.z), glm::vec3(0.0f, 0.0f, 1.0f));
-    // scale matrix
-    glm::mat4 scaleMat = glm::scale(glm::mat4(1.0f), mScale_);
-
-    glm::mat4 localModelMat = translationMat * rotationMat * scaleMat;
+    const glm::mat4 localModelMat = getLocalModelMatrix();
+    updateLod(theRenderer, parentModelMat * localModelMat);
+
+    if (theRenderer.isRenderQueueActive()) {
+        RenderQueue::DrawPacket packet;
+        packet.shader = mpShader_;
+        packet.textures = mQueueTextures_.data();
+        packet.textureCount = static_cast<uint32_t>(mQueueTextures_.size());
+        packet.wireframe = renderWireframe_;
+        packet.model = parentModelMat * localModelMat;
+        packet.color = mColor_;
+        packet.subImage = {mSubTextureTopLeft.x, mSubTextureTopLeft.y, mSubTextureSize.x, mSubTextureSize.y};
+
+        const RenderQueue::Pass pass = mColor_.a < 1.0f ? RenderQueue::Pass::TRANSPARENT : RenderQueue::Pass::OPAQUE;
+        for (const Mesh& mesh : mpModel_->getMeshes(mLod_)) {
+            packet.mesh = &mesh;
+            theRenderer.submit(packet, pass);
+        }
+        for (const Mesh* mesh : mpModel_->getSharedMeshes()) {
+            packet.mesh = mesh;
+            theRenderer.submit(packet, pass);
+        }
+        return;
+    }
 
     mpShader_->bind();
 
     // Bind all textures to the Texture Units
-    for (const auto& [slot, texInfo] : mTextureByUnit_) {
-        const auto& [texId, uniformName] = texInfo; // Unpack the pair
-        mpShader_->setTexture(uniformName, texId, slot);
+    for (const auto& [slot, binding] : mTextureByUnit_) {
+        mpShader_->setTexture(binding.uniform, binding.textureId, slot, binding.samplerId);
     }
 
-    mpShader_->setMat4("uModel", parentModelMat * localModelMat);
-    mpShader_->setVec4("uColor", mColor_);
+    mpShader_->setUniform(mUniforms_.model, parentModelMat * localModelMat);
+    mpShader_->setUniform(mUniforms_.color, mColor_);
     // TODO this only applies for some shaders
-    mpShader_->setVec2("uSubImageTopLeft", mSubTextureTopLeft);
-    mpShader_->setVec2("uSubImageSize", mSubTextureSize);
+    mpShader_->setUniform(mUniforms_.subImageTopLeft, mSubTextureTopLeft);
+    mpShader_->setUniform(mUniforms_.subImageSize, mSubTextureSize);
 
     if (renderWireframe_) {
         // Enable wire frame
         theRenderer.enableWireFrame(true);
-        mpShader_->setBool("uWireframeMode",true);
+        mpShader_->setUniform(mUniforms_.wireframeMode, true);
         // Render wire frame
-        mpModel_->render(*mpShader_);
+        mpModel_->render(*mpShader_, mLod_);
 
         theRenderer.enableWireFrame(false);
         // revert back to non-wireframe
-        mpShader_->setBool("uWireframeMode", false);
+        mpShader_->setUniform(mUniforms_.wireframeMode, false);
+    }
+    mpModel_->render(*mpShader_, mLod_);
+}
+
+bool ModelRenderable::getBounds(AABB& outBounds) const {
+    if (mpModel_ == nullptr || !mpModel_->getAABB().isValid()) {
+        return false;
     }
-    mpModel_->render(*mpShader_);
+    outBounds = mpModel_->getAABB().transformed(getLocalModelMatrix());
+    return true;
+}
+
+unsigned int ModelRenderable::getLod() const {
+    return mLod_;
 }
 
 const Model* ModelRenderable::getModel() const {
@@ -58,14 +87,25 @@ const ShaderProgram* ModelRenderable::getShader() const {
 
 void ModelRenderable::setModel(Model* pModel) {
     mpModel_ = pModel;
+    mLod_ = 0;
 }
 
 void ModelRenderable::setShader(ShaderProgram* pShader) {
     mpShader_ = pShader;
+    resolveUniforms();
+}
+
+void ModelRenderable::setTexture(unsigned int textureUnit, unsigned int textureId, const std::string& uniformName, unsigned int samplerId) {
+    ShaderProgram::Uniform<int> uniform;
+    if (mpShader_ != nullptr) {
+        uniform = mpShader_->getUniform<int>(uniformName);
+    }
+    mTextureByUnit_[textureUnit] = {textureId, samplerId, uniformName, uniform};
+    updateQueueTextures();
 }
 
-void ModelRenderable::setTexture(unsigned int textureUnit, unsigned int textureId, const std::string& uniformName) {
-    mTextureByUnit_[textureUnit] = {textureId, uniformName};
+void ModelRenderable::setTexture(unsigned int textureUnit, const Texture& texture, const std::string& uniformName) {
+    setTexture(textureUnit, texture.getId(), uniformName, texture.getSamplerId());
 }
 
 void ModelRenderable::setWireframeRendering(const bool enable) {
@@ -80,4 +120,55 @@ void ModelRenderable::setSubTextureTopLeft(const glm::vec2& pos) {
     mSubTextureTopLeft = pos;
 }
 
+void ModelRenderable::updateLod(const Renderer& theRenderer, const glm::mat4& modelMat) const {
+    if (mpModel_->getLodCount() <= 1 || !mpModel_->getBoundingSphere().isValid()) {
+        mLod_ = 0;
+        return;
+    }
+    const BoundingSphere& localSphere = mpModel_->getBoundingSphere();
+    BoundingSphere worldSphere;
+    worldSphere.center = glm::vec3(modelMat * glm::vec4(localSphere.center, 1.0f));
+    const float maxScale = std::max({
+        glm::length(glm::vec3(modelMat[0])),
+        glm::length(glm::vec3(modelMat[1])),
+        glm::length(glm::vec3(modelMat[2]))
+    });
+    worldSphere.radius = localSphere.radius * maxScale;
+    mLod_ = mpModel_->selectLod(theRenderer.getScreenSize(worldSphere), mLod_);
+}
+
+void ModelRenderable::resolveUniforms() {
+    if (mpShader_ == nullptr) {
+        mUniforms_ = {};
+        updateQueueTextures();
+        return;
+    }
+    mUniforms_.model = mpShader_->getUniform<glm::mat4>("uModel");
+    mUniforms_.color = mpShader_->getUniform<glm::vec4>("uColor");
+    mUniforms_.subImageTopLeft = mpShader_->getUniform<glm::vec2>("uSubImageTopLeft");
+    mUniforms_.subImageSize = mpShader_->getUniform<glm::vec2>("uSubImageSize");
+    mUniforms_.wireframeMode = mpShader_->getUniform<bool>("uWireframeMode");
+
+    for (auto& [slot, binding] : mTextureByUnit_) {
+        binding.uniform = mpShader_->getUniform<int>(binding.uniformName);
+    }
+    updateQueueTextures();
+}
+
+void ModelRenderable::updateQueueTextures() {
+    const ShaderProgram* instancedShader = mpShader_ != nullptr ? mpShader_->getInstancedVariant() : nullptr;
+
+    mQueueTextures_.clear();
+    for (const auto& [slot, binding] : mTextureByUnit_) {
+        ShaderProgram::Uniform<int> instancedUniform;
+        if (instancedShader != nullptr) {
+            instancedUniform = instancedShader->getUniform<int>(binding.uniformName);
+        }
+        mQueueTextures_.push_back({slot, binding.textureId, binding.uniform, instancedUniform, binding.samplerId});
+    }
+    // Same textures on different renderables give the same list so the queue can share the binds
+    std::sort(mQueueTextures_.begin(), mQueueTextures_.end(),
+        [](const RenderQueue::TextureBinding& a, const RenderQueue::TextureBinding& b) { return a.unit < b.unit; });
+}
+
 } // namespace clay
\ No newline at end of file
@@ -0,0 +1,61 @@
+// standard lib
+#include <cmath>
+// class
+#include "clay/graphics/common/BoundingVolume.h"
+
+namespace clay {
+
+bool AABB::isValid() const {
+    return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+}
+
+void AABB::expand(const glm::vec3& point) {
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+}
+
+void AABB::expand(const AABB& other) {
+    if (!other.isValid()) {
+        return;
+    }
+    min = glm::min(min, other.min);
+    max = glm::max(max, other.max);
+}
+
+AABB AABB::transformed(const glm::mat4& transform) const {
+    if (!isValid()) {
+        return *this;
+    }
+    // Arvo's method: transform the center and project the extents onto each axis
+    const glm::vec3 center = (min + max) * 0.5f;
+    const glm::vec3 extent = (max - min) * 0.5f;
+
+    const glm::vec3 newCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+    glm::vec3 newExtent;
+    for (int row = 0; row < 3; ++row) {
+        newExtent[row] =
+            std::abs(transform[0][row]) * extent.x +
+            std::abs(transform[1][row]) * extent.y +
+            std::abs(transform[2][row]) * extent.z;
+    }
+
+    AABB result;
+    result.min = newCenter - newExtent;
+    result.max = newCenter + newExtent;
+    return result;
+}
+
+bool BoundingSphere::isValid() const {
+    return radius >= 0.0f;
+}
+
+BoundingSphere BoundingSphere::fromAABB(const AABB& box) {
+    BoundingSphere sphere;
+    if (box.isValid()) {
+        sphere.center = (box.min + box.max) * 0.5f;
+        sphere.radius = glm::length(box.max - sphere.center);
+    }
+    return sphere;
+}
+
+} // namespace clay
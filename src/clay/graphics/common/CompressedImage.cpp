@@ -0,0 +1,637 @@
+// standard lib
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+// project
+#include "clay/graphics/common/Texture.h"
+#include "clay/utils/common/Logger.h"
+// class
+#include "clay/graphics/common/CompressedImage.h"
+
+namespace clay {
+
+namespace {
+    /** File identifier of KTX2 files */
+    constexpr std::array<unsigned char, 12> KTX2_IDENTIFIER = {
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+    };
+    /** Size of the header and index before the level index */
+    constexpr size_t KTX2_HEADER_SIZE = 80;
+    /** Size of a level index entry */
+    constexpr size_t KTX2_LEVEL_ENTRY_SIZE = 24;
+    /** Largest width or height accepted, the maximum texture size of current hardware */
+    constexpr uint32_t KTX2_MAX_DIMENSION = 16384;
+
+    /** VkFormat values of the supported formats */
+    enum VkFormat : uint32_t {
+        VK_FORMAT_BC1_RGB_UNORM_BLOCK = 131,
+        VK_FORMAT_BC1_RGB_SRGB_BLOCK = 132,
+        VK_FORMAT_BC1_RGBA_UNORM_BLOCK = 133,
+        VK_FORMAT_BC1_RGBA_SRGB_BLOCK = 134,
+        VK_FORMAT_BC3_UNORM_BLOCK = 137,
+        VK_FORMAT_BC3_SRGB_BLOCK = 138,
+        VK_FORMAT_BC4_UNORM_BLOCK = 139,
+        VK_FORMAT_BC5_UNORM_BLOCK = 141,
+        VK_FORMAT_BC7_UNORM_BLOCK = 145,
+        VK_FORMAT_BC7_SRGB_BLOCK = 146,
+        VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK = 147,
+        VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK = 148,
+        VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK = 151,
+        VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK = 152,
+        VK_FORMAT_ASTC_4x4_UNORM_BLOCK = 157,
+        VK_FORMAT_ASTC_4x4_SRGB_BLOCK = 158
+    };
+
+    /** ETC1/ETC2 intensity modifiers per table codeword, indexed by the 2 bit texel index */
+    constexpr int ETC_MODIFIERS[8][4] = {
+        {2, 8, -2, -8},
+        {5, 17, -5, -17},
+        {9, 29, -9, -29},
+        {13, 42, -13, -42},
+        {18, 60, -18, -60},
+        {24, 80, -24, -80},
+        {33, 106, -33, -106},
+        {47, 183, -47, -183}
+    };
+
+    /** ETC2 T and H mode distances */
+    constexpr int ETC_DISTANCES[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+    /** EAC alpha modifiers per table index, indexed by the 3 bit texel index */
+    constexpr int EAC_MODIFIERS[16][8] = {
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}
+    };
+
+    uint32_t readU32(const unsigned char* data) {
+        uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    uint64_t readU64(const unsigned char* data) {
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    /** Read 8 bytes as a big endian value, the bit order ETC blocks are specified in */
+    uint64_t readBigEndian64(const unsigned char* data) {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value = (value << 8) | data[i];
+        }
+        return value;
+    }
+
+    /** Get bits [high, low] of a value */
+    uint32_t getBits(uint64_t value, int high, int low) {
+        return static_cast<uint32_t>((value >> low) & ((1ull << (high - low + 1)) - 1));
+    }
+
+    unsigned char clampByte(int value) {
+        return static_cast<unsigned char>(std::clamp(value, 0, 255));
+    }
+
+    /** Extend a 4 bit value to 8 bits */
+    int extend4(uint32_t value) {
+        return static_cast<int>((value << 4) | value);
+    }
+
+    /** Extend a 5 bit value to 8 bits */
+    int extend5(uint32_t value) {
+        return static_cast<int>((value << 3) | (value >> 2));
+    }
+
+    /** Extend a 6 bit value to 8 bits */
+    int extend6(uint32_t value) {
+        return static_cast<int>((value << 2) | (value >> 4));
+    }
+
+    /** Extend a 7 bit value to 8 bits */
+    int extend7(uint32_t value) {
+        return static_cast<int>((value << 1) | (value >> 6));
+    }
+
+    bool getVkFormat(uint32_t vkFormat, IGraphicsAPI::CompressedFormat& outFormat) {
+        switch (vkFormat) {
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::BC1_RGB;
+                return true;
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::BC1_SRGB;
+                return true;
+            case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::BC1_RGBA;
+                return true;
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::BC1_SRGB_ALPHA;
+                return true;
+            case VK_FORMAT_BC3_UNORM_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::BC3_RGBA;
+                return true;
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::BC3_SRGB_ALPHA;
+                return true;
+            case VK_FORMAT_BC4_UNORM_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::BC4_R;
+                return true;
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::BC5_RG;
+                return true;
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::BC7_RGBA;
+                return true;
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::BC7_SRGB_ALPHA;
+                return true;
+            case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::ETC2_RGB;
+                return true;
+            case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::ETC2_SRGB;
+                return true;
+            case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::ETC2_RGBA;
+                return true;
+            case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::ETC2_SRGB_ALPHA;
+                return true;
+            case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::ASTC_4x4_RGBA;
+                return true;
+            case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+                outFormat = IGraphicsAPI::CompressedFormat::ASTC_4x4_SRGB_ALPHA;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @brief Decode the color half of a BC1, BC2 or BC3 block
+     *
+     * @param block 8 byte color block
+     * @param hasAlpha If the 3 color mode has a transparent texel. Only BC1 uses the 3 color mode
+     * @param allowThreeColor If the 3 color mode can be used
+     * @param outTexels 16 RGBA texels, row by row
+     */
+    void decodeBC1Block(const unsigned char* block, bool hasAlpha, bool allowThreeColor, unsigned char* outTexels) {
+        const uint32_t color0 = block[0] | (block[1] << 8);
+        const uint32_t color1 = block[2] | (block[3] << 8);
+        const uint32_t indices = readU32(block + 4);
+
+        int palette[4][4];
+        palette[0][0] = extend5(color0 >> 11);
+        palette[0][1] = extend6((color0 >> 5) & 0x3F);
+        palette[0][2] = extend5(color0 & 0x1F);
+        palette[1][0] = extend5(color1 >> 11);
+        palette[1][1] = extend6((color1 >> 5) & 0x3F);
+        palette[1][2] = extend5(color1 & 0x1F);
+        palette[0][3] = palette[1][3] = 255;
+
+        if (color0 > color1 || !allowThreeColor) {
+            for (int c = 0; c < 3; ++c) {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+            palette[2][3] = palette[3][3] = 255;
+        } else {
+            for (int c = 0; c < 3; ++c) {
+                palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                palette[3][c] = 0;
+            }
+            palette[2][3] = 255;
+            palette[3][3] = hasAlpha ? 0 : 255;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            const int* color = palette[(indices >> (2 * i)) & 0x3];
+            for (int c = 0; c < 4; ++c) {
+                outTexels[i * 4 + c] = static_cast<unsigned char>(color[c]);
+            }
+        }
+    }
+
+    /**
+     * @brief Decode a BC4 block, also the alpha half of BC3 and each half of BC5
+     *
+     * @param block 8 byte block
+     * @param outTexels First channel of 16 RGBA texels, row by row
+     */
+    void decodeBC4Block(const unsigned char* block, unsigned char* outTexels) {
+        const int value0 = block[0];
+        const int value1 = block[1];
+        uint64_t indices = 0;
+        for (int i = 0; i < 6; ++i) {
+            indices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+        }
+
+        int palette[8];
+        palette[0] = value0;
+        palette[1] = value1;
+        if (value0 > value1) {
+            for (int i = 1; i < 7; ++i) {
+                palette[i + 1] = ((7 - i) * value0 + i * value1) / 7;
+            }
+        } else {
+            for (int i = 1; i < 5; ++i) {
+                palette[i + 1] = ((5 - i) * value0 + i * value1) / 5;
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            outTexels[i * 4] = static_cast<unsigned char>(palette[(indices >> (3 * i)) & 0x7]);
+        }
+    }
+
+    /**
+     * @brief Decode an ETC2 RGB block. ETC1 blocks are valid ETC2 blocks
+     *
+     * @param block 8 byte block
+     * @param outTexels 16 RGBA texels, row by row. Alpha is left untouched
+     */
+    void decodeETC2Block(const unsigned char* block, unsigned char* outTexels) {
+        const uint64_t bits = readBigEndian64(block);
+        // Texel indices are stored column by column, most significant bits in the upper half
+        auto getIndex = [bits](int x, int y) {
+            const int i = x * 4 + y;
+            return static_cast<int>((((bits >> (16 + i)) & 1) << 1) | ((bits >> i) & 1));
+        };
+        auto writeTexel = [outTexels](int x, int y, int r, int g, int b) {
+            unsigned char* texel = outTexels + (y * 4 + x) * 4;
+            texel[0] = clampByte(r);
+            texel[1] = clampByte(g);
+            texel[2] = clampByte(b);
+        };
+
+        const bool differential = (bits >> 33) & 1;
+        int base[2][3];
+
+        if (differential) {
+            const int r = static_cast<int>(getBits(bits, 63, 59));
+            const int g = static_cast<int>(getBits(bits, 55, 51));
+            const int b = static_cast<int>(getBits(bits, 47, 43));
+            // 3 bit two's complement deltas
+            const int dr = (static_cast<int>(getBits(bits, 58, 56)) ^ 4) - 4;
+            const int dg = (static_cast<int>(getBits(bits, 50, 48)) ^ 4) - 4;
+            const int db = (static_cast<int>(getBits(bits, 42, 40)) ^ 4) - 4;
+
+            // Overflowing deltas select the ETC2 modes
+            if (r + dr < 0 || r + dr > 31) {
+                // T mode
+                const int color1[3] = {
+                    extend4((getBits(bits, 60, 59) << 2) | getBits(bits, 57, 56)),
+                    extend4(getBits(bits, 55, 52)),
+                    extend4(getBits(bits, 51, 48))
+                };
+                const int color2[3] = {extend4(getBits(bits, 47, 44)), extend4(getBits(bits, 43, 40)), extend4(getBits(bits, 39, 36))};
+                const int distance = ETC_DISTANCES[(getBits(bits, 35, 34) << 1) | getBits(bits, 32, 32)];
+                const int paint[4][3] = {
+                    {color1[0], color1[1], color1[2]},
+                    {color2[0] + distance, color2[1] + distance, color2[2] + distance},
+                    {color2[0], color2[1], color2[2]},
+                    {color2[0] - distance, color2[1] - distance, color2[2] - distance}
+                };
+                for (int y = 0; y < 4; ++y) {
+                    for (int x = 0; x < 4; ++x) {
+                        const int* color = paint[getIndex(x, y)];
+                        writeTexel(x, y, color[0], color[1], color[2]);
+                    }
+                }
+                return;
+            }
+            if (g + dg < 0 || g + dg > 31) {
+                // H mode
+                const int color1[3] = {
+                    extend4(getBits(bits, 62, 59)),
+                    extend4((getBits(bits, 58, 56) << 1) | getBits(bits, 52, 52)),
+                    extend4((getBits(bits, 51, 51) << 3) | getBits(bits, 49, 47))
+                };
+                const int color2[3] = {extend4(getBits(bits, 46, 43)), extend4(getBits(bits, 42, 39)), extend4(getBits(bits, 38, 35))};
+                // The order of the colors holds the lowest bit of the distance index
+                const int value1 = (color1[0] << 16) | (color1[1] << 8) | color1[2];
+                const int value2 = (color2[0] << 16) | (color2[1] << 8) | color2[2];
+                const int distance = ETC_DISTANCES[(getBits(bits, 34, 34) << 2) | (getBits(bits, 32, 32) << 1) | (value1 >= value2 ? 1 : 0)];
+                const int paint[4][3] = {
+                    {color1[0] + distance, color1[1] + distance, color1[2] + distance},
+                    {color1[0] - distance, color1[1] - distance, color1[2] - distance},
+                    {color2[0] + distance, color2[1] + distance, color2[2] + distance},
+                    {color2[0] - distance, color2[1] - distance, color2[2] - distance}
+                };
+                for (int y = 0; y < 4; ++y) {
+                    for (int x = 0; x < 4; ++x) {
+                        const int* color = paint[getIndex(x, y)];
+                        writeTexel(x, y, color[0], color[1], color[2]);
+                    }
+                }
+                return;
+            }
+            if (b + db < 0 || b + db > 31) {
+                // Planar mode, a gradient from 3 colors
+                const int origin[3] = {
+                    extend6(getBits(bits, 62, 57)),
+                    extend7((getBits(bits, 56, 56) << 6) | getBits(bits, 54, 49)),
+                    extend6((getBits(bits, 48, 48) << 5) | (getBits(bits, 44, 43) << 3) | getBits(bits, 41, 39))
+                };
+                const int horizontal[3] = {
+                    extend6((getBits(bits, 38, 34) << 1) | getBits(bits, 32, 32)),
+                    extend7(getBits(bits, 31, 25)),
+                    extend6(getBits(bits, 24, 19))
+                };
+                const int vertical[3] = {extend6(getBits(bits, 18, 13)), extend7(getBits(bits, 12, 6)), extend6(getBits(bits, 5, 0))};
+                for (int y = 0; y < 4; ++y) {
+                    for (int x = 0; x < 4; ++x) {
+                        int color[3];
+                        for (int c = 0; c < 3; ++c) {
+                            color[c] = (x * (horizontal[c] - origin[c]) + y * (vertical[c] - origin[c]) + 4 * origin[c] + 2) >> 2;
+                        }
+                        writeTexel(x, y, color[0], color[1], color[2]);
+                    }
+                }
+                return;
+            }
+
+            base[0][0] = extend5(r);
+            base[0][1] = extend5(g);
+            base[0][2] = extend5(b);
+            base[1][0] = extend5(r + dr);
+            base[1][1] = extend5(g + dg);
+            base[1][2] = extend5(b + db);
+        } else {
+            base[0][0] = extend4(getBits(bits, 63, 60));
+            base[1][0] = extend4(getBits(bits, 59, 56));
+            base[0][1] = extend4(getBits(bits, 55, 52));
+            base[1][1] = extend4(getBits(bits, 51, 48));
+            base[0][2] = extend4(getBits(bits, 47, 44));
+            base[1][2] = extend4(getBits(bits, 43, 40));
+        }
+
+        // Two sub-blocks, side by side or stacked when flipped
+        const bool flip = bits & (1ull << 32);
+        const uint32_t tables[2] = {getBits(bits, 39, 37), getBits(bits, 36, 34)};
+        for (int y = 0; y < 4; ++y) {
+            for (int x = 0; x < 4; ++x) {
+                const int subBlock = flip ? (y >= 2) : (x >= 2);
+                const int modifier = ETC_MODIFIERS[tables[subBlock]][getIndex(x, y)];
+                writeTexel(x, y, base[subBlock][0] + modifier, base[subBlock][1] + modifier, base[subBlock][2] + modifier);
+            }
+        }
+    }
+
+    /**
+     * @brief Decode an EAC alpha block
+     *
+     * @param block 8 byte block
+     * @param outTexels Alpha channel of 16 RGBA texels, row by row
+     */
+    void decodeEACBlock(const unsigned char* block, unsigned char* outTexels) {
+        const uint64_t bits = readBigEndian64(block);
+        const int base = static_cast<int>(getBits(bits, 63, 56));
+        const int multiplier = static_cast<int>(getBits(bits, 55, 52));
+        const int* modifiers = EAC_MODIFIERS[getBits(bits, 51, 48)];
+
+        // Texel indices are stored column by column
+        for (int x = 0; x < 4; ++x) {
+            for (int y = 0; y < 4; ++y) {
+                const int i = x * 4 + y;
+                const int index = static_cast<int>(getBits(bits, 47 - 3 * i, 45 - 3 * i));
+                outTexels[(y * 4 + x) * 4 + 3] = clampByte(base + modifiers[index] * multiplier);
+            }
+        }
+    }
+}
+
+bool CompressedImage::isKtx2(const utils::FileData& fileData) {
+    return fileData.data != nullptr &&
+        fileData.size >= KTX2_IDENTIFIER.size() &&
+        std::memcmp(fileData.data.get(), KTX2_IDENTIFIER.data(), KTX2_IDENTIFIER.size()) == 0;
+}
+
+CompressedImage CompressedImage::parseKtx2(utils::FileData&& fileData) {
+    if (!isKtx2(fileData) || fileData.size < KTX2_HEADER_SIZE) {
+        LOG_E("File is not a KTX2 file");
+        throw std::runtime_error("Invalid KTX2 file");
+    }
+    const unsigned char* data = fileData.data.get();
+
+    const uint32_t vkFormat = readU32(data + 12);
+    const uint32_t pixelWidth = readU32(data + 20);
+    const uint32_t pixelHeight = readU32(data + 24);
+    const uint32_t pixelDepth = readU32(data + 28);
+    const uint32_t layerCount = readU32(data + 32);
+    const uint32_t faceCount = readU32(data + 36);
+    const uint32_t levelCount = std::max(readU32(data + 40), 1u);
+    const uint32_t supercompressionScheme = readU32(data + 44);
+
+    CompressedImage image;
+    if (!getVkFormat(vkFormat, image.mFormat_)) {
+        LOG_E("Unsupported KTX2 VkFormat %u", vkFormat);
+        throw std::runtime_error("Invalid KTX2 file");
+    }
+    if (supercompressionScheme != 0) {
+        LOG_E("Unsupported KTX2 supercompression scheme %u", supercompressionScheme);
+        throw std::runtime_error("Invalid KTX2 file");
+    }
+    if (pixelWidth == 0 || pixelHeight == 0 || pixelDepth > 1 || layerCount > 1 || faceCount != 1) {
+        LOG_E("Only 2D KTX2 textures are supported");
+        throw std::runtime_error("Invalid KTX2 file");
+    }
+    if (pixelWidth > KTX2_MAX_DIMENSION || pixelHeight > KTX2_MAX_DIMENSION) {
+        LOG_E("KTX2 is %ux%u, larger than the maximum texture size %u", pixelWidth, pixelHeight, KTX2_MAX_DIMENSION);
+        throw std::runtime_error("Invalid KTX2 file");
+    }
+    if (levelCount > Texture::getMipLevelCount(static_cast<int>(pixelWidth), static_cast<int>(pixelHeight))) {
+        LOG_E("KTX2 has %u levels, more than a full mip chain", levelCount);
+        throw std::runtime_error("Invalid KTX2 file");
+    }
+    if (fileData.size < KTX2_HEADER_SIZE + levelCount * KTX2_LEVEL_ENTRY_SIZE) {
+        LOG_E("KTX2 level index is truncated");
+        throw std::runtime_error("Invalid KTX2 file");
+    }
+
+    const size_t blockSize = getBlockSize(image.mFormat_);
+    image.mWidth_ = pixelWidth;
+    image.mHeight_ = pixelHeight;
+    image.mLevels_.reserve(levelCount);
+    for (uint32_t i = 0; i < levelCount; ++i) {
+        const unsigned char* entry = data + KTX2_HEADER_SIZE + i * KTX2_LEVEL_ENTRY_SIZE;
+        Level level;
+        level.offset = static_cast<size_t>(readU64(entry));
+        level.size = static_cast<size_t>(readU64(entry + 8));
+        level.width = std::max(pixelWidth >> i, 1u);
+        level.height = std::max(pixelHeight >> i, 1u);
+
+        const uint64_t blockCount = ((static_cast<uint64_t>(level.width) + 3) / 4) * ((static_cast<uint64_t>(level.height) + 3) / 4);
+        const uint64_t expectedSize = blockCount * blockSize;
+        if (level.size < expectedSize || level.offset > fileData.size || level.size > fileData.size - level.offset) {
+            LOG_E("KTX2 level %u is truncated", i);
+            throw std::runtime_error("Invalid KTX2 file");
+        }
+        level.size = static_cast<size_t>(expectedSize);
+        image.mLevels_.push_back(level);
+    }
+
+    image.mFileData_ = std::move(fileData);
+    return image;
+}
+
+bool CompressedImage::canDecode(IGraphicsAPI::CompressedFormat format) {
+    switch (format) {
+        case IGraphicsAPI::CompressedFormat::BC7_RGBA:
+        case IGraphicsAPI::CompressedFormat::BC7_SRGB_ALPHA:
+        case IGraphicsAPI::CompressedFormat::ASTC_4x4_RGBA:
+        case IGraphicsAPI::CompressedFormat::ASTC_4x4_SRGB_ALPHA:
+            return false;
+        default:
+            return true;
+    }
+}
+
+bool CompressedImage::isSRGB(IGraphicsAPI::CompressedFormat format) {
+    switch (format) {
+        case IGraphicsAPI::CompressedFormat::BC1_SRGB:
+        case IGraphicsAPI::CompressedFormat::BC1_SRGB_ALPHA:
+        case IGraphicsAPI::CompressedFormat::BC3_SRGB_ALPHA:
+        case IGraphicsAPI::CompressedFormat::BC7_SRGB_ALPHA:
+        case IGraphicsAPI::CompressedFormat::ETC2_SRGB:
+        case IGraphicsAPI::CompressedFormat::ETC2_SRGB_ALPHA:
+        case IGraphicsAPI::CompressedFormat::ASTC_4x4_SRGB_ALPHA:
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t CompressedImage::getBlockSize(IGraphicsAPI::CompressedFormat format) {
+    switch (format) {
+        case IGraphicsAPI::CompressedFormat::BC1_RGB:
+        case IGraphicsAPI::CompressedFormat::BC1_SRGB:
+        case IGraphicsAPI::CompressedFormat::BC1_RGBA:
+        case IGraphicsAPI::CompressedFormat::BC1_SRGB_ALPHA:
+        case IGraphicsAPI::CompressedFormat::BC4_R:
+        case IGraphicsAPI::CompressedFormat::ETC2_RGB:
+        case IGraphicsAPI::CompressedFormat::ETC2_SRGB:
+            return 8;
+        default:
+            return 16;
+    }
+}
+
+IGraphicsAPI::CompressedFormat CompressedImage::getFormat() const {
+    return mFormat_;
+}
+
+unsigned int CompressedImage::getWidth() const {
+    return mWidth_;
+}
+
+unsigned int CompressedImage::getHeight() const {
+    return mHeight_;
+}
+
+const std::vector<CompressedImage::Level>& CompressedImage::getLevels() const {
+    return mLevels_;
+}
+
+const unsigned char* CompressedImage::getLevelData(size_t level) const {
+    return mFileData_.data.get() + mLevels_[level].offset;
+}
+
+std::vector<unsigned char> CompressedImage::decodeLevel(size_t level) const {
+    if (!canDecode(mFormat_)) {
+        LOG_E("No CPU decoder for compressed format %d", static_cast<int>(mFormat_));
+        throw std::runtime_error("Compressed format cannot be decoded");
+    }
+
+    const Level& levelInfo = mLevels_[level];
+    const unsigned int blocksX = (levelInfo.width + 3) / 4;
+    const unsigned int blocksY = (levelInfo.height + 3) / 4;
+    const size_t blockSize = getBlockSize(mFormat_);
+    const unsigned char* blocks = getLevelData(level);
+    std::vector<unsigned char> texels(static_cast<size_t>(levelInfo.width) * levelInfo.height * 4);
+
+    unsigned char blockTexels[16 * 4];
+    for (unsigned int blockY = 0; blockY < blocksY; ++blockY) {
+        for (unsigned int blockX = 0; blockX < blocksX; ++blockX) {
+            const unsigned char* block = blocks + (static_cast<size_t>(blockY) * blocksX + blockX) * blockSize;
+            std::fill(std::begin(blockTexels), std::end(blockTexels), static_cast<unsigned char>(0));
+
+            switch (mFormat_) {
+                case IGraphicsAPI::CompressedFormat::BC1_RGB:
+                case IGraphicsAPI::CompressedFormat::BC1_SRGB:
+                    decodeBC1Block(block, false, true, blockTexels);
+                    break;
+                case IGraphicsAPI::CompressedFormat::BC1_RGBA:
+                case IGraphicsAPI::CompressedFormat::BC1_SRGB_ALPHA:
+                    decodeBC1Block(block, true, true, blockTexels);
+                    break;
+                case IGraphicsAPI::CompressedFormat::BC3_RGBA:
+                case IGraphicsAPI::CompressedFormat::BC3_SRGB_ALPHA:
+                    decodeBC1Block(block + 8, false, false, blockTexels);
+                    decodeBC4Block(block, blockTexels + 3);
+                    break;
+                case IGraphicsAPI::CompressedFormat::BC4_R:
+                    decodeBC4Block(block, blockTexels);
+                    for (int i = 0; i < 16; ++i) {
+                        blockTexels[i * 4 + 3] = 255;
+                    }
+                    break;
+                case IGraphicsAPI::CompressedFormat::BC5_RG:
+                    decodeBC4Block(block, blockTexels);
+                    decodeBC4Block(block + 8, blockTexels + 1);
+                    for (int i = 0; i < 16; ++i) {
+                        blockTexels[i * 4 + 3] = 255;
+                    }
+                    break;
+                case IGraphicsAPI::CompressedFormat::ETC2_RGB:
+                case IGraphicsAPI::CompressedFormat::ETC2_SRGB:
+                    decodeETC2Block(block, blockTexels);
+                    for (int i = 0; i < 16; ++i) {
+                        blockTexels[i * 4 + 3] = 255;
+                    }
+                    break;
+                case IGraphicsAPI::CompressedFormat::ETC2_RGBA:
+                case IGraphicsAPI::CompressedFormat::ETC2_SRGB_ALPHA:
+                    decodeEACBlock(block, blockTexels);
+                    decodeETC2Block(block + 8, blockTexels);
+                    break;
+                default:
+                    throw std::runtime_error("Compressed format cannot be decoded");
+            }
+
+            // Blocks in the last row and column can cover texels outside of the level
+            const unsigned int texelX = blockX * 4;
+            const unsigned int texelY = blockY * 4;
+            const unsigned int copyWidth = std::min(4u, levelInfo.width - texelX);
+            const unsigned int copyHeight = std::min(4u, levelInfo.height - texelY);
+            for (unsigned int y = 0; y < copyHeight; ++y) {
+                std::memcpy(
+                    texels.data() + ((static_cast<size_t>(texelY) + y) * levelInfo.width + texelX) * 4,
+                    blockTexels + y * 16,
+                    copyWidth * 4
+                );
+            }
+        }
+    }
+    return texels;
+}
+
+} // namespace clay
@@ -0,0 +1,247 @@
+// standard lib
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+// third party
+#include <glm/gtc/constants.hpp>
+// class
+#include "clay/graphics/common/DebugDraw.h"
+
+namespace clay {
+
+DebugDraw::DebugDraw(IGraphicsAPI& graphicsAPI, DynamicRingBuffer& streamBuffer, ShaderProgram& lineShader, ShaderProgram& thickLineShader)
+    : mGraphicsAPI_(graphicsAPI),
+    mStreamBuffer_(streamBuffer),
+    mLineShader_(lineShader),
+    mThickLineShader_(thickLineShader) {
+    mViewportSizeUniform_ = mThickLineShader_.getUniform<glm::vec2>("uViewportSize");
+
+    mGraphicsAPI_.genVertexArrays(1, &mLineVAO_);
+    mGraphicsAPI_.bindVertexArray(mLineVAO_);
+    mGraphicsAPI_.enableVertexAttribArray(0);
+    mGraphicsAPI_.enableVertexAttribArray(1);
+
+    // Corners of the thick line quad: x is the position along the line, y the side
+    float quadCorners[] = {
+        0.0f, -1.0f,
+        1.0f, -1.0f,
+        1.0f,  1.0f,
+        0.0f,  1.0f
+    };
+    unsigned int quadIndices[] = {
+        0, 1, 2,
+        2, 3, 0
+    };
+    mGraphicsAPI_.genVertexArrays(1, &mThickLineVAO_);
+    mGraphicsAPI_.genBuffer(1, &mQuadVBO_);
+    mGraphicsAPI_.genBuffer(1, &mQuadEBO_);
+    mGraphicsAPI_.bindVertexArray(mThickLineVAO_);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, mQuadVBO_);
+    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, sizeof(quadCorners), quadCorners, IGraphicsAPI::DataUsage::STATIC_DRAW);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER, mQuadEBO_);
+    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER, sizeof(quadIndices), quadIndices, IGraphicsAPI::DataUsage::STATIC_DRAW);
+    mGraphicsAPI_.vertexAttribPointer(0, 2, IGraphicsAPI::DataType::FLOAT, false, 2 * sizeof(float), (void*)0);
+    mGraphicsAPI_.enableVertexAttribArray(0);
+    // Per instance attributes: start (1), color (2), end (3), thickness (4)
+    for (unsigned int i = 1; i <= 4; ++i) {
+        mGraphicsAPI_.enableVertexAttribArray(i);
+        mGraphicsAPI_.vertexAttribDivisor(i, 1);
+    }
+
+    mGraphicsAPI_.bindVertexArray(0);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0);
+}
+
+DebugDraw::~DebugDraw() {
+    mGraphicsAPI_.deleteBuffer(1, &mQuadVBO_);
+    mGraphicsAPI_.deleteBuffer(1, &mQuadEBO_);
+    mGraphicsAPI_.deleteVertexArrays(1, &mLineVAO_);
+    mGraphicsAPI_.deleteVertexArrays(1, &mThickLineVAO_);
+}
+
+void DebugDraw::addLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color, Layer layer) {
+    addSegment(start, end, packColor(color), layer);
+}
+
+void DebugDraw::addThickLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color, float thickness, Layer layer) {
+    mThickLines_[static_cast<size_t>(layer)].push_back({start, packColor(color), end, thickness});
+}
+
+void DebugDraw::addRect(const glm::mat4& modelMat, const glm::vec4& color, Layer layer) {
+    const uint32_t packedColor = packColor(color);
+    const glm::vec3 corners[4] = {
+        glm::vec3(modelMat * glm::vec4(-0.5f, -0.5f, 0.0f, 1.0f)),
+        glm::vec3(modelMat * glm::vec4(0.5f, -0.5f, 0.0f, 1.0f)),
+        glm::vec3(modelMat * glm::vec4(0.5f, 0.5f, 0.0f, 1.0f)),
+        glm::vec3(modelMat * glm::vec4(-0.5f, 0.5f, 0.0f, 1.0f))
+    };
+    for (unsigned int i = 0; i < 4; ++i) {
+        addSegment(corners[i], corners[(i + 1) % 4], packedColor, layer);
+    }
+}
+
+void DebugDraw::addRect(const glm::vec3& center, const glm::vec2& size, const glm::vec4& color, Layer layer) {
+    const uint32_t packedColor = packColor(color);
+    const glm::vec3 halfSize(size * 0.5f, 0.0f);
+    const glm::vec3 corners[4] = {
+        center + glm::vec3(-halfSize.x, -halfSize.y, 0.0f),
+        center + glm::vec3(halfSize.x, -halfSize.y, 0.0f),
+        center + glm::vec3(halfSize.x, halfSize.y, 0.0f),
+        center + glm::vec3(-halfSize.x, halfSize.y, 0.0f)
+    };
+    for (unsigned int i = 0; i < 4; ++i) {
+        addSegment(corners[i], corners[(i + 1) % 4], packedColor, layer);
+    }
+}
+
+void DebugDraw::addCircle(const glm::vec3& center, float radius, const glm::vec4& color, unsigned int segments, Layer layer) {
+    segments = std::max(segments, 3u);
+    const uint32_t packedColor = packColor(color);
+    const float step = glm::two_pi<float>() / segments;
+
+    std::vector<Vertex>& vertices = mLineVertices_[static_cast<size_t>(layer)];
+    vertices.reserve(vertices.size() + segments * 2);
+    glm::vec3 previous = center + glm::vec3(radius, 0.0f, 0.0f);
+    for (unsigned int i = 1; i <= segments; ++i) {
+        const float angle = step * i;
+        const glm::vec3 current = center + glm::vec3(radius * std::cos(angle), radius * std::sin(angle), 0.0f);
+        vertices.push_back({previous, packedColor});
+        vertices.push_back({current, packedColor});
+        previous = current;
+    }
+}
+
+void DebugDraw::addAABB(const AABB& box, const glm::vec4& color, Layer layer) {
+    if (!box.isValid()) {
+        return;
+    }
+    const uint32_t packedColor = packColor(color);
+    // Corner i has the max x if bit 0 is set, max y for bit 1 and max z for bit 2
+    glm::vec3 corners[8];
+    for (unsigned int i = 0; i < 8; ++i) {
+        corners[i] = {
+            (i & 1) ? box.max.x : box.min.x,
+            (i & 2) ? box.max.y : box.min.y,
+            (i & 4) ? box.max.z : box.min.z
+        };
+    }
+    // Each edge connects two corners that differ in one bit
+    for (unsigned int i = 0; i < 8; ++i) {
+        for (unsigned int bit = 1; bit < 8; bit <<= 1) {
+            if ((i & bit) == 0) {
+                addSegment(corners[i], corners[i | bit], packedColor, layer);
+            }
+        }
+    }
+}
+
+void DebugDraw::flush(const glm::vec2& viewportSize) {
+    if (isEmpty()) {
+        return;
+    }
+    // Restored after the overlay so passes drawn without depth testing keep it off
+    const bool depthTestEnabled = mGraphicsAPI_.isEnabled(IGraphicsAPI::Capability::DEPTH_TEST);
+    for (size_t layer = 0; layer < LAYER_COUNT; ++layer) {
+        if (mLineVertices_[layer].empty() && mThickLines_[layer].empty()) {
+            continue;
+        }
+        const bool overlay = static_cast<Layer>(layer) == Layer::OVERLAY;
+        if (overlay) {
+            mGraphicsAPI_.disable(IGraphicsAPI::Capability::DEPTH_TEST);
+        }
+        if (!mLineVertices_[layer].empty()) {
+            drawLines(mLineVertices_[layer]);
+        }
+        if (!mThickLines_[layer].empty()) {
+            drawThickLines(mThickLines_[layer], viewportSize);
+        }
+        if (overlay && depthTestEnabled) {
+            mGraphicsAPI_.enable(IGraphicsAPI::Capability::DEPTH_TEST);
+        }
+    }
+    mGraphicsAPI_.bindVertexArray(0);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0);
+    clear();
+}
+
+void DebugDraw::clear() {
+    for (size_t layer = 0; layer < LAYER_COUNT; ++layer) {
+        mLineVertices_[layer].clear();
+        mThickLines_[layer].clear();
+    }
+}
+
+bool DebugDraw::isEmpty() const {
+    for (size_t layer = 0; layer < LAYER_COUNT; ++layer) {
+        if (!mLineVertices_[layer].empty() || !mThickLines_[layer].empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t DebugDraw::packColor(const glm::vec4& color) {
+    const glm::vec4 clamped = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+    // Bytes in memory order r, g, b, a
+    return static_cast<uint32_t>(clamped.r)
+        | (static_cast<uint32_t>(clamped.g) << 8)
+        | (static_cast<uint32_t>(clamped.b) << 16)
+        | (static_cast<uint32_t>(clamped.a) << 24);
+}
+
+void DebugDraw::addSegment(const glm::vec3& start, const glm::vec3& end, uint32_t color, Layer layer) {
+    std::vector<Vertex>& vertices = mLineVertices_[static_cast<size_t>(layer)];
+    vertices.push_back({start, color});
+    vertices.push_back({end, color});
+}
+
+void DebugDraw::drawLines(const std::vector<Vertex>& vertices) {
+    const DynamicRingBuffer::Allocation vertexData = mStreamBuffer_.upload(vertices.data(), vertices.size() * sizeof(Vertex));
+
+    mLineShader_.bind();
+    mGraphicsAPI_.bindVertexArray(mLineVAO_);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, vertexData.buffer);
+    mGraphicsAPI_.vertexAttribPointer(
+        0, 3, IGraphicsAPI::DataType::FLOAT, false, sizeof(Vertex),
+        (void*)(vertexData.offset + offsetof(Vertex, position))
+    );
+    mGraphicsAPI_.vertexAttribPointer(
+        1, 4, IGraphicsAPI::DataType::UBYTE, true, sizeof(Vertex),
+        (void*)(vertexData.offset + offsetof(Vertex, color))
+    );
+    mGraphicsAPI_.drawArrays(IGraphicsAPI::PrimitiveTopology::LINE_LIST, 0, static_cast<unsigned int>(vertices.size()));
+}
+
+void DebugDraw::drawThickLines(const std::vector<ThickLine>& lines, const glm::vec2& viewportSize) {
+    const DynamicRingBuffer::Allocation instanceData = mStreamBuffer_.upload(lines.data(), lines.size() * sizeof(ThickLine));
+
+    mThickLineShader_.bind();
+    mThickLineShader_.setUniform(mViewportSizeUniform_, viewportSize);
+    mGraphicsAPI_.bindVertexArray(mThickLineVAO_);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, instanceData.buffer);
+    mGraphicsAPI_.vertexAttribPointer(
+        1, 3, IGraphicsAPI::DataType::FLOAT, false, sizeof(ThickLine),
+        (void*)(instanceData.offset + offsetof(ThickLine, start))
+    );
+    mGraphicsAPI_.vertexAttribPointer(
+        2, 4, IGraphicsAPI::DataType::UBYTE, true, sizeof(ThickLine),
+        (void*)(instanceData.offset + offsetof(ThickLine, color))
+    );
+    mGraphicsAPI_.vertexAttribPointer(
+        3, 3, IGraphicsAPI::DataType::FLOAT, false, sizeof(ThickLine),
+        (void*)(instanceData.offset + offsetof(ThickLine, end))
+    );
+    mGraphicsAPI_.vertexAttribPointer(
+        4, 1, IGraphicsAPI::DataType::FLOAT, false, sizeof(ThickLine),
+        (void*)(instanceData.offset + offsetof(ThickLine, thickness))
+    );
+    mGraphicsAPI_.drawElementsInstanced(
+        IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST,
+        6,
+        IGraphicsAPI::DataType::UINT,
+        0,
+        static_cast<unsigned int>(lines.size())
+    );
+}
+
+} // namespace clay
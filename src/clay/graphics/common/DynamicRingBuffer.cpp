@@ -0,0 +1,198 @@
+// standard lib
+#include <algorithm>
+#include <cstring>
+// project
+#include "clay/utils/common/Logger.h"
+// class
+#include "clay/graphics/common/DynamicRingBuffer.h"
+
+namespace clay {
+
+namespace {
+    /** Time to wait on a frame fence before logging that the GPU is stalling the CPU */
+    constexpr uint64_t FENCE_TIMEOUT_NS = 1000000000;
+}
+
+DynamicRingBuffer::DynamicRingBuffer(IGraphicsAPI& graphicsAPI, size_t frameSize)
+    : mGraphicsAPI_(graphicsAPI) {
+    mPersistent_ = mGraphicsAPI_.isBufferStorageSupported();
+    create(frameSize);
+}
+
+DynamicRingBuffer::~DynamicRingBuffer() {
+    destroy();
+}
+
+void DynamicRingBuffer::endFrame() {
+    mFrameUsed_ = 0;
+
+    // A retired buffer is fenced at the end of the frame it was replaced in, and deleted at a later
+    // endFrame once the fence is signaled and the next frame has bound the new buffer instead
+    for (auto it = mRetiredBuffers_.begin(); it != mRetiredBuffers_.end();) {
+        if (it->fence == nullptr) {
+            it->fence = mGraphicsAPI_.fenceSync();
+            ++it;
+        } else if (mGraphicsAPI_.clientWaitSync(it->fence, 0)) {
+            mGraphicsAPI_.deleteSync(it->fence);
+            deleteBuffer(it->buffer, it->mapped);
+            it = mRetiredBuffers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (!mPersistent_) {
+        orphan();
+        return;
+    }
+
+    // Fence the finished region then move on to the oldest one, which is free once its fence is signaled
+    void*& currentFence = mFences_[mFrameIndex_];
+    if (currentFence != nullptr) {
+        mGraphicsAPI_.deleteSync(currentFence);
+    }
+    currentFence = mGraphicsAPI_.fenceSync();
+
+    mFrameIndex_ = (mFrameIndex_ + 1) % FRAME_COUNT;
+    void*& nextFence = mFences_[mFrameIndex_];
+    if (nextFence != nullptr) {
+        while (!mGraphicsAPI_.clientWaitSync(nextFence, FENCE_TIMEOUT_NS)) {
+            LOG_W("Waiting on the GPU to release a dynamic buffer region");
+        }
+        mGraphicsAPI_.deleteSync(nextFence);
+        nextFence = nullptr;
+    }
+}
+
+DynamicRingBuffer::Allocation DynamicRingBuffer::allocate(size_t size, size_t alignment) {
+    // The offset is aligned in the whole buffer, the regions after the first do not start on a multiple of
+    // every alignment (1 MiB is not a multiple of an 80 byte instance stride)
+    size_t regionOffset = mPersistent_ ? mFrameIndex_ * mFrameSize_ : 0;
+    size_t offset = (regionOffset + mFrameUsed_ + alignment - 1) / alignment * alignment;
+    if (offset + size > regionOffset + mFrameSize_) {
+        // Earlier allocations of this frame keep their buffer, which is only deleted once the GPU is done with it
+        const size_t newFrameSize = std::max(mFrameSize_ * 2, size + alignment);
+        LOG_I("Growing dynamic buffer frame region from %zu to %zu bytes", mFrameSize_, newFrameSize);
+        grow(newFrameSize);
+        regionOffset = mPersistent_ ? mFrameIndex_ * mFrameSize_ : 0;
+        offset = (regionOffset + alignment - 1) / alignment * alignment;
+    }
+    mFrameUsed_ = offset + size - regionOffset;
+
+    Allocation allocation;
+    allocation.buffer = mBuffer_;
+    allocation.offset = offset;
+    allocation.size = size;
+    allocation.data = mPersistent_ ? mMappedData_ + offset : mStaging_.data() + offset;
+    return allocation;
+}
+
+void DynamicRingBuffer::flush(const Allocation& allocation) {
+    if (mPersistent_ || allocation.size == 0) {
+        // Coherent mapping, the writes are already visible
+        return;
+    }
+    // The range was not used since the storage was orphaned so the copy does not wait on the GPU
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, allocation.buffer);
+    mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, allocation.offset, allocation.size, allocation.data);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, 0);
+}
+
+DynamicRingBuffer::Allocation DynamicRingBuffer::upload(const void* data, size_t size, size_t alignment) {
+    Allocation allocation = allocate(size, alignment);
+    std::memcpy(allocation.data, data, size);
+    flush(allocation);
+    return allocation;
+}
+
+unsigned int DynamicRingBuffer::getBuffer() const {
+    return mBuffer_;
+}
+
+bool DynamicRingBuffer::isPersistent() const {
+    return mPersistent_;
+}
+
+void DynamicRingBuffer::orphan() {
+    // Draws of previous frames keep reading the old storage
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, mBuffer_);
+    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, mFrameSize_, NULL, IGraphicsAPI::DataUsage::STREAM_DRAW);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, 0);
+}
+
+void DynamicRingBuffer::create(size_t frameSize) {
+    mFrameSize_ = frameSize;
+    mFrameUsed_ = 0;
+    mFrameIndex_ = 0;
+    mGraphicsAPI_.genBuffer(1, &mBuffer_);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, mBuffer_);
+
+    if (mPersistent_) {
+        const size_t totalSize = mFrameSize_ * FRAME_COUNT;
+        const std::vector<IGraphicsAPI::BufferAccess> access = {
+            IGraphicsAPI::BufferAccess::WRITE,
+            IGraphicsAPI::BufferAccess::PERSISTENT,
+            IGraphicsAPI::BufferAccess::COHERENT
+        };
+        mGraphicsAPI_.bufferStorage(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, totalSize, NULL, access);
+        mMappedData_ = static_cast<uint8_t*>(mGraphicsAPI_.mapBufferRange(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, 0, totalSize, access));
+        if (mMappedData_ == nullptr) {
+            LOG_W("Persistent mapping failed, dynamic buffer falls back to orphaning");
+            mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, 0);
+            mGraphicsAPI_.deleteBuffer(1, &mBuffer_);
+            mPersistent_ = false;
+            create(frameSize);
+            return;
+        }
+    } else {
+        mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, mFrameSize_, NULL, IGraphicsAPI::DataUsage::STREAM_DRAW);
+        mStaging_.resize(mFrameSize_);
+    }
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, 0);
+}
+
+void DynamicRingBuffer::grow(size_t frameSize) {
+    // The region fences only order the GPU work on the old buffer, the retired buffer's fence covers them
+    for (void*& fence : mFences_) {
+        if (fence != nullptr) {
+            mGraphicsAPI_.deleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    mRetiredBuffers_.push_back({mBuffer_, mMappedData_ != nullptr, nullptr});
+    mBuffer_ = 0;
+    mMappedData_ = nullptr;
+    create(frameSize);
+}
+
+void DynamicRingBuffer::destroy() {
+    for (RetiredBuffer& retired : mRetiredBuffers_) {
+        if (retired.fence != nullptr) {
+            mGraphicsAPI_.deleteSync(retired.fence);
+        }
+        deleteBuffer(retired.buffer, retired.mapped);
+    }
+    mRetiredBuffers_.clear();
+    for (void*& fence : mFences_) {
+        if (fence != nullptr) {
+            mGraphicsAPI_.deleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (mBuffer_ != 0) {
+        deleteBuffer(mBuffer_, mMappedData_ != nullptr);
+        mBuffer_ = 0;
+    }
+    mMappedData_ = nullptr;
+}
+
+void DynamicRingBuffer::deleteBuffer(unsigned int buffer, bool mapped) {
+    if (mapped) {
+        mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, buffer);
+        mGraphicsAPI_.unmapBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER);
+        mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, 0);
+    }
+    mGraphicsAPI_.deleteBuffer(1, &buffer);
+}
+
+} // namespace clay
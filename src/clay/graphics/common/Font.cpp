@@ -1,4 +1,7 @@
 // standard lib
+#include <algorithm>
+#include <cstring>
+#include <vector>
 // third party
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -11,12 +14,53 @@
 namespace clay {
 
 Font::Font(IGraphicsAPI& graphicsAPI, utils::FileData& fileData)
+: Font(graphicsAPI, rasterize(fileData)) {}
+
+Font::Font(IGraphicsAPI& graphicsAPI, Atlas&& atlas)
 : mGraphicsAPI_(graphicsAPI) {
+    if (atlas.pixels.empty()) {
+        return;
+    }
+    mAtlasSize_ = atlas.size;
+
+    // disable byte-alignment restriction
+    mGraphicsAPI_.pixelStore(IGraphicsAPI::PixelAlignment::UNPACK_ALIGNMENT, 1);
+
+    // generate atlas texture
+    mGraphicsAPI_.genTextures(1, &mAtlasTextureId_);
+    mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, mAtlasTextureId_);
+    mGraphicsAPI_.texImage2D(
+        IGraphicsAPI::TextureTarget::TEXTURE_2D,
+        0,
+        IGraphicsAPI::TextureFormat::RED, // TODO different for gles
+        mAtlasSize_.x,
+        mAtlasSize_.y,
+        0,
+        IGraphicsAPI::TextureFormat::RED, // TODO different for gles
+        IGraphicsAPI::DataType::UBYTE,
+        atlas.pixels.data()
+    );
+    // set texture options
+    mGraphicsAPI_.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_S, IGraphicsAPI::TextureParameterOption::CLAMP_TO_EDGE);
+    mGraphicsAPI_.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_T, IGraphicsAPI::TextureParameterOption::CLAMP_TO_EDGE);
+    mGraphicsAPI_.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_MIN_FILTER, IGraphicsAPI::TextureParameterOption::LINEAR);
+    mGraphicsAPI_.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_MAG_FILTER, IGraphicsAPI::TextureParameterOption::LINEAR);
+    mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, 0);
+
+    // now store characters for later use
+    mCharacterFrontInfo_ = std::move(atlas.characters);
+    for (auto& [character, info] : mCharacterFrontInfo_) {
+        info.textureId = mAtlasTextureId_;
+    }
+}
+
+Font::Atlas Font::rasterize(utils::FileData& fileData) {
+    Atlas atlas;
     // Initialize the FreeType library
     FT_Library ft;
     if (FT_Init_FreeType(&ft)) {
         LOG_E("ERROR::FREETYPE::Could not init FreeType Library");
-        return;
+        return atlas;
     }
 
     // Create a face object from the memory buffer
@@ -30,13 +74,22 @@ Font::Font(IGraphicsAPI& graphicsAPI, utils::FileData& fileData)
     if (error) {
         LOG_E("ERROR::FREETYPE::Failed to load font from memory. Error code: %d", error);
         FT_Done_FreeType(ft);
-        return;
+        return atlas;
     }
 
     FT_Set_Pixel_Sizes(face, 0, 48);
 
-    // disable byte-alignment restriction
-    mGraphicsAPI_.pixelStore(IGraphicsAPI::PixelAlignment::UNPACK_ALIGNMENT, 1);
+    // Rasterize glyph bitmaps first so they can be packed into one atlas
+    struct GlyphBitmap {
+        char character;
+        glm::ivec2 size;
+        glm::ivec2 bearing;
+        unsigned int advance;
+        std::vector<unsigned char> pixels;
+        glm::ivec2 atlasPosition;
+    };
+    std::vector<GlyphBitmap> glyphs;
+    glyphs.reserve(128);
 
     // load first 128 characters of ASCII set
     for (unsigned char c = 0; c < 128; ++c) {
@@ -45,54 +98,86 @@ Font::Font(IGraphicsAPI& graphicsAPI, utils::FileData& fileData)
             LOG_E("ERROR::FREETYTPE: Failed to load Glyph");
             continue;
         }
-        // generate texture
-        unsigned int texture;
-        mGraphicsAPI_.genTextures(1, &texture);
-        mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, texture);
-        mGraphicsAPI_.texImage2D(
-            IGraphicsAPI::TextureTarget::TEXTURE_2D,
-            0,
-            IGraphicsAPI::TextureFormat::RED, // TODO different for gles
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
-            0,
-            IGraphicsAPI::TextureFormat::RED, // TODO different for gles
-            IGraphicsAPI::DataType::UBYTE,
-            face->glyph->bitmap.buffer
-        );
-        // set texture options
-        graphicsAPI.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_S, IGraphicsAPI::TextureParameterOption::CLAMP_TO_EDGE);
-        graphicsAPI.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_T, IGraphicsAPI::TextureParameterOption::CLAMP_TO_EDGE);
-        graphicsAPI.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_MIN_FILTER, IGraphicsAPI::TextureParameterOption::LINEAR);
-        graphicsAPI.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_MAG_FILTER, IGraphicsAPI::TextureParameterOption::LINEAR);
-        // now store character for later use
-        Character character = {
-            texture,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
+        const FT_Bitmap& bitmap = face->glyph->bitmap;
+        GlyphBitmap glyph = {
+            static_cast<char>(c),
+            glm::ivec2(bitmap.width, bitmap.rows),
             glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-            static_cast<unsigned int>(face->glyph->advance.x)
+            static_cast<unsigned int>(face->glyph->advance.x),
+            {},
+            {0, 0}
         };
-        mCharacterFrontInfo_.insert(std::pair<char, Character>(c, character));
+        // FreeType reuses the glyph slot buffer, so copy the rows (pitch may differ from width)
+        glyph.pixels.resize(bitmap.width * bitmap.rows);
+        for (unsigned int row = 0; row < bitmap.rows; ++row) {
+            std::memcpy(
+                glyph.pixels.data() + row * bitmap.width,
+                bitmap.buffer + row * bitmap.pitch,
+                bitmap.width
+            );
+        }
+        glyphs.push_back(std::move(glyph));
     }
-    graphicsAPI.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, 0);
 
     // destroy FreeType once we're finished
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
 
-    mGraphicsAPI_.genVertexArrays(1, &mTextVAO_);
-    mGraphicsAPI_.genBuffer(1, &mTextVBO_);
-    mGraphicsAPI_.bindVertexArray(mTextVAO_);
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, mTextVBO_);
-    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, IGraphicsAPI::DataUsage::DYNAMIC_DRAW);
-    mGraphicsAPI_.enableVertexAttribArray(0);
-    mGraphicsAPI_.vertexAttribPointer(0, 4, IGraphicsAPI::DataType::FLOAT, false, 4 * sizeof(float), (void*)0);
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0);
-    mGraphicsAPI_.bindVertexArray(0);
+    // Shelf pack the glyphs row by row
+    int penX = ATLAS_PADDING;
+    int penY = ATLAS_PADDING;
+    int shelfHeight = 0;
+    for (GlyphBitmap& glyph : glyphs) {
+        if (glyph.size.x + 2 * ATLAS_PADDING > ATLAS_WIDTH) {
+            LOG_E("Glyph %d is wider than the font atlas", glyph.character);
+            glyph.size = {0, 0};
+            glyph.pixels.clear();
+        }
+        if (penX + glyph.size.x + ATLAS_PADDING > ATLAS_WIDTH) {
+            penX = ATLAS_PADDING;
+            penY += shelfHeight + ATLAS_PADDING;
+            shelfHeight = 0;
+        }
+        glyph.atlasPosition = {penX, penY};
+        penX += glyph.size.x + ATLAS_PADDING;
+        shelfHeight = std::max(shelfHeight, glyph.size.y);
+    }
+    // Round the height up to a power of two
+    const int usedHeight = penY + shelfHeight + ATLAS_PADDING;
+    int atlasHeight = 1;
+    while (atlasHeight < usedHeight) {
+        atlasHeight <<= 1;
+    }
+    atlas.size = {ATLAS_WIDTH, atlasHeight};
+
+    atlas.pixels.assign(atlas.size.x * atlas.size.y, 0);
+    for (const GlyphBitmap& glyph : glyphs) {
+        for (int row = 0; row < glyph.size.y; ++row) {
+            std::memcpy(
+                atlas.pixels.data() + (glyph.atlasPosition.y + row) * atlas.size.x + glyph.atlasPosition.x,
+                glyph.pixels.data() + row * glyph.size.x,
+                glyph.size.x
+            );
+        }
+    }
+
+    const glm::vec2 atlasSize = atlas.size;
+    for (const GlyphBitmap& glyph : glyphs) {
+        Character character = {
+            0,
+            glm::vec2(glyph.atlasPosition) / atlasSize,
+            glm::vec2(glyph.atlasPosition + glyph.size) / atlasSize,
+            glyph.size,
+            glyph.bearing,
+            glyph.advance
+        };
+        atlas.characters.insert(std::pair<char, Character>(glyph.character, character));
+    }
+    return atlas;
 }
 
 Font::~Font() {
-    // TODO release VAO/VBO?
+    mGraphicsAPI_.deleteTexture(1, &mAtlasTextureId_);
 }
 
 const Font::Character* Font::getCharInfo(char theChar) const {
@@ -105,12 +190,12 @@ const Font::Character* Font::getCharInfo(char theChar) const {
     }
 }
 
-unsigned int Font::getVAO() const {
-    return mTextVAO_;
+unsigned int Font::getAtlasTextureId() const {
+    return mAtlasTextureId_;
 }
 
-unsigned int Font::getVBO() const {
-    return mTextVBO_;
+glm::ivec2 Font::getAtlasSize() const {
+    return mAtlasSize_;
 }
 
 } // namespace clay
\ No newline at end of file
@@ -0,0 +1,81 @@
+// standard lib
+#include <iterator>
+// class
+#include "clay/graphics/common/FreeListAllocator.h"
+
+namespace clay {
+
+FreeListAllocator::FreeListAllocator(size_t capacity) {
+    grow(capacity);
+}
+
+FreeListAllocator::~FreeListAllocator() {}
+
+size_t FreeListAllocator::allocate(size_t size, size_t alignment) {
+    if (size == 0) {
+        return INVALID_OFFSET;
+    }
+    for (auto it = mFreeRanges_.begin(); it != mFreeRanges_.end(); ++it) {
+        const size_t rangeOffset = it->first;
+        const size_t rangeEnd = rangeOffset + it->second;
+        const size_t offset = (rangeOffset + alignment - 1) / alignment * alignment;
+        if (offset + size > rangeEnd) {
+            continue;
+        }
+
+        // Split off what is left on either side of the allocation
+        mFreeRanges_.erase(it);
+        if (offset > rangeOffset) {
+            mFreeRanges_.emplace(rangeOffset, offset - rangeOffset);
+        }
+        if (offset + size < rangeEnd) {
+            mFreeRanges_.emplace(offset + size, rangeEnd - offset - size);
+        }
+        mFree_ -= size;
+        return offset;
+    }
+    return INVALID_OFFSET;
+}
+
+void FreeListAllocator::free(size_t offset, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    insertFree(offset, size);
+}
+
+void FreeListAllocator::grow(size_t newCapacity) {
+    if (newCapacity <= mCapacity_) {
+        return;
+    }
+    const size_t oldCapacity = mCapacity_;
+    mCapacity_ = newCapacity;
+    insertFree(oldCapacity, newCapacity - oldCapacity);
+}
+
+size_t FreeListAllocator::getCapacity() const {
+    return mCapacity_;
+}
+
+size_t FreeListAllocator::getUsed() const {
+    return mCapacity_ - mFree_;
+}
+
+void FreeListAllocator::insertFree(size_t offset, size_t size) {
+    mFree_ += size;
+    auto next = mFreeRanges_.lower_bound(offset);
+    if (next != mFreeRanges_.end() && offset + size == next->first) {
+        size += next->second;
+        next = mFreeRanges_.erase(next);
+    }
+    if (next != mFreeRanges_.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset) {
+            previous->second += size;
+            return;
+        }
+    }
+    mFreeRanges_.emplace_hint(next, offset, size);
+}
+
+} // namespace clay
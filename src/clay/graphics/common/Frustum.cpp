@@ -0,0 +1,157 @@
+// standard lib
+#include <algorithm>
+// third party
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+    #include <xmmintrin.h>
+    #define CLAY_FRUSTUM_SSE
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define CLAY_FRUSTUM_NEON
+#endif
+// class
+#include "clay/graphics/common/Frustum.h"
+
+namespace clay {
+
+Frustum::Frustum() {
+    mPlanes_.fill(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+Frustum::Frustum(const glm::mat4& viewProjection) {
+    // Gribb/Hartmann plane extraction. glm is column major so row i is m[0][i], m[1][i], m[2][i], m[3][i]
+    const glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+    const glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+    const glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+    const glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+    mPlanes_[0] = row3 + row0; // left
+    mPlanes_[1] = row3 - row0; // right
+    mPlanes_[2] = row3 + row1; // bottom
+    mPlanes_[3] = row3 - row1; // top
+    mPlanes_[4] = row3 + row2; // near
+    mPlanes_[5] = row3 - row2; // far
+
+    // Normalize so plane distances are in world units and can be compared against radii
+    for (glm::vec4& plane : mPlanes_) {
+        const float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+}
+
+Frustum::~Frustum() {}
+
+bool Frustum::intersects(const BoundingSphere& sphere) const {
+    for (const glm::vec4& plane : mPlanes_) {
+        if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::intersects(const AABB& box) const {
+    for (const glm::vec4& plane : mPlanes_) {
+        // Corner furthest along the plane normal
+        const glm::vec3 positive(
+            plane.x >= 0.0f ? box.max.x : box.min.x,
+            plane.y >= 0.0f ? box.max.y : box.min.y,
+            plane.z >= 0.0f ? box.max.z : box.min.z
+        );
+        if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Frustum::cullSpheres(const BoundingSphere* spheres, size_t count, uint8_t* outVisible, utils::WorkerPool* workerPool) const {
+    if (workerPool == nullptr || workerPool->getThreadCount() <= 1 || count < PARALLEL_CULL_MIN_COUNT) {
+        cullSpheresRange(spheres, count, outVisible);
+        return;
+    }
+
+    // Keep chunks a multiple of 4 so only the last chunk has a scalar tail
+    const unsigned int threadCount = workerPool->getThreadCount();
+    const size_t chunkSize = ((count + threadCount - 1) / threadCount + 3) & ~static_cast<size_t>(3);
+    workerPool->run([this, spheres, count, outVisible, chunkSize](unsigned int threadIndex) {
+        const size_t begin = threadIndex * chunkSize;
+        if (begin < count) {
+            cullSpheresRange(spheres + begin, std::min(chunkSize, count - begin), outVisible + begin);
+        }
+    });
+}
+
+const std::array<glm::vec4, 6>& Frustum::getPlanes() const {
+    return mPlanes_;
+}
+
+void Frustum::cullSpheresRange(const BoundingSphere* spheres, size_t count, uint8_t* outVisible) const {
+    size_t i = 0;
+
+#if defined(CLAY_FRUSTUM_SSE)
+    __m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+    for (size_t p = 0; p < mPlanes_.size(); ++p) {
+        planeX[p] = _mm_set1_ps(mPlanes_[p].x);
+        planeY[p] = _mm_set1_ps(mPlanes_[p].y);
+        planeZ[p] = _mm_set1_ps(mPlanes_[p].z);
+        planeW[p] = _mm_set1_ps(mPlanes_[p].w);
+    }
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4) {
+        // Load 4 spheres and transpose to x, y, z, radius lanes
+        const float* base = reinterpret_cast<const float*>(spheres + i);
+        __m128 x = _mm_loadu_ps(base);
+        __m128 y = _mm_loadu_ps(base + 4);
+        __m128 z = _mm_loadu_ps(base + 8);
+        __m128 r = _mm_loadu_ps(base + 12);
+        _MM_TRANSPOSE4_PS(x, y, z, r);
+
+        __m128 inside = _mm_cmpeq_ps(zero, zero);
+        for (size_t p = 0; p < mPlanes_.size(); ++p) {
+            const __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(x, planeX[p]), _mm_mul_ps(y, planeY[p])),
+                _mm_add_ps(_mm_mul_ps(z, planeZ[p]), planeW[p])
+            );
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, r), zero));
+        }
+        // Unbounded spheres are always visible
+        const int mask = _mm_movemask_ps(_mm_or_ps(inside, _mm_cmplt_ps(r, zero)));
+        for (size_t lane = 0; lane < 4; ++lane) {
+            outVisible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+        }
+    }
+#elif defined(CLAY_FRUSTUM_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        // De-interleaving load gives x, y, z, radius lanes
+        const float32x4x4_t sphere = vld4q_f32(reinterpret_cast<const float*>(spheres + i));
+        const float32x4_t r = sphere.val[3];
+
+        uint32x4_t inside = vdupq_n_u32(~0u);
+        for (const glm::vec4& plane : mPlanes_) {
+            float32x4_t distance = vdupq_n_f32(plane.w);
+            distance = vmlaq_n_f32(distance, sphere.val[0], plane.x);
+            distance = vmlaq_n_f32(distance, sphere.val[1], plane.y);
+            distance = vmlaq_n_f32(distance, sphere.val[2], plane.z);
+            inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(distance, r), zero));
+        }
+        // Unbounded spheres are always visible
+        uint32_t lanes[4];
+        vst1q_u32(lanes, vorrq_u32(inside, vcltq_f32(r, zero)));
+        for (size_t lane = 0; lane < 4; ++lane) {
+            outVisible[i + lane] = static_cast<uint8_t>(lanes[lane] != 0);
+        }
+    }
+#endif
+
+    // Remainder, or everything without SIMD
+    for (; i < count; ++i) {
+        outVisible[i] = static_cast<uint8_t>(!spheres[i].isValid() || intersects(spheres[i]));
+    }
+}
+
+} // namespace clay
@@ -0,0 +1,178 @@
+// standard lib
+#include <algorithm>
+#include <vector>
+// project
+#include "clay/utils/common/Logger.h"
+// class
+#include "clay/graphics/common/GeometryArena.h"
+
+namespace clay {
+
+namespace {
+    /** Arena shared by the meshes of one layout */
+    struct ArenaEntry {
+        IGraphicsAPI* graphicsAPI;
+        VertexLayout layout;
+        std::weak_ptr<GeometryArena> arena;
+    };
+
+    size_t getIndexSize(IGraphicsAPI::DataType indexType) {
+        return indexType == IGraphicsAPI::DataType::USHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+    }
+}
+
+std::shared_ptr<GeometryArena> GeometryArena::acquire(IGraphicsAPI& graphicsAPI, const VertexLayout& layout) {
+    static std::vector<ArenaEntry> arenas;
+
+    for (ArenaEntry& entry : arenas) {
+        if (entry.graphicsAPI == &graphicsAPI && entry.layout == layout) {
+            if (std::shared_ptr<GeometryArena> arena = entry.arena.lock()) {
+                return arena;
+            }
+            std::shared_ptr<GeometryArena> arena = std::make_shared<GeometryArena>(graphicsAPI, layout);
+            entry.arena = arena;
+            return arena;
+        }
+    }
+    std::shared_ptr<GeometryArena> arena = std::make_shared<GeometryArena>(graphicsAPI, layout);
+    arenas.push_back({&graphicsAPI, layout, arena});
+    return arena;
+}
+
+GeometryArena::GeometryArena(IGraphicsAPI& graphicsAPI, const VertexLayout& layout)
+    : mGraphicsAPI_(graphicsAPI),
+    mLayout_(layout),
+    mStride_(layout.getStride()),
+    mVertexAllocator_(INITIAL_VERTEX_CAPACITY),
+    mIndexAllocator_(INITIAL_INDEX_CAPACITY) {
+    mGraphicsAPI_.genVertexArrays(1, &mVAO_);
+    mGraphicsAPI_.genBuffer(1, &mVBO_);
+    mGraphicsAPI_.genBuffer(1, &mEBO_);
+
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, mVBO_);
+    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, INITIAL_VERTEX_CAPACITY * mStride_, NULL, IGraphicsAPI::DataUsage::STATIC_DRAW);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, mEBO_);
+    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, INITIAL_INDEX_CAPACITY, NULL, IGraphicsAPI::DataUsage::STATIC_DRAW);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, 0);
+
+    bindBuffersToVertexArray();
+}
+
+GeometryArena::~GeometryArena() {
+    mGraphicsAPI_.deleteBuffer(1, &mVBO_);
+    mGraphicsAPI_.deleteBuffer(1, &mEBO_);
+    mGraphicsAPI_.deleteVertexArrays(1, &mVAO_);
+}
+
+std::shared_ptr<const GeometryArena::Range> GeometryArena::allocate(const void* vertexData, size_t vertexCount, const void* indexData, size_t indexCount, IGraphicsAPI::DataType indexType) {
+    const size_t indexSize = getIndexSize(indexType);
+    const size_t indexBytes = indexCount * indexSize;
+
+    size_t baseVertex = mVertexAllocator_.allocate(vertexCount);
+    if (baseVertex == FreeListAllocator::INVALID_OFFSET && vertexCount > 0) {
+        const size_t oldCapacity = mVertexAllocator_.getCapacity();
+        const size_t newCapacity = std::max(oldCapacity * 2, oldCapacity + vertexCount);
+        LOG_I("Growing geometry arena vertex buffer from %zu to %zu vertices", oldCapacity, newCapacity);
+        growBuffer(mVBO_, oldCapacity * mStride_, newCapacity * mStride_);
+        mVertexAllocator_.grow(newCapacity);
+        bindBuffersToVertexArray();
+        baseVertex = mVertexAllocator_.allocate(vertexCount);
+    }
+    size_t indexOffset = mIndexAllocator_.allocate(indexBytes, indexSize);
+    if (indexOffset == FreeListAllocator::INVALID_OFFSET && indexBytes > 0) {
+        const size_t oldCapacity = mIndexAllocator_.getCapacity();
+        const size_t newCapacity = std::max(oldCapacity * 2, oldCapacity + indexBytes + indexSize);
+        LOG_I("Growing geometry arena index buffer from %zu to %zu bytes", oldCapacity, newCapacity);
+        growBuffer(mEBO_, oldCapacity, newCapacity);
+        mIndexAllocator_.grow(newCapacity);
+        bindBuffersToVertexArray();
+        indexOffset = mIndexAllocator_.allocate(indexBytes, indexSize);
+    }
+
+    Range* range = new Range();
+    range->arena = this;
+    range->baseVertex = vertexCount > 0 ? baseVertex : 0;
+    range->vertexCount = vertexCount;
+    range->indexOffset = indexBytes > 0 ? indexOffset : 0;
+    range->indexCount = indexCount;
+    range->indexType = indexType;
+
+    // Uploaded through the copy target so the element buffer binding of the bound vertex array is untouched
+    if (vertexCount > 0) {
+        mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, mVBO_);
+        mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, range->baseVertex * mStride_, vertexCount * mStride_, vertexData);
+    }
+    if (indexBytes > 0) {
+        mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, mEBO_);
+        mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, range->indexOffset, indexBytes, indexData);
+    }
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, 0);
+
+    // The range keeps the arena alive and returns its space when released
+    std::shared_ptr<GeometryArena> self = shared_from_this();
+    return std::shared_ptr<const Range>(range, [self](const Range* released) {
+        self->free(*released);
+        delete released;
+    });
+}
+
+void GeometryArena::bind() const {
+    mGraphicsAPI_.bindVertexArray(mVAO_);
+}
+
+unsigned int GeometryArena::getVertexArray() const {
+    return mVAO_;
+}
+
+unsigned int GeometryArena::getVertexBuffer() const {
+    return mVBO_;
+}
+
+unsigned int GeometryArena::getIndexBuffer() const {
+    return mEBO_;
+}
+
+const VertexLayout& GeometryArena::getLayout() const {
+    return mLayout_;
+}
+
+size_t GeometryArena::getCapacityBytes() const {
+    return mVertexAllocator_.getCapacity() * mStride_ + mIndexAllocator_.getCapacity();
+}
+
+size_t GeometryArena::getUsedBytes() const {
+    return mVertexAllocator_.getUsed() * mStride_ + mIndexAllocator_.getUsed();
+}
+
+void GeometryArena::free(const Range& range) {
+    if (range.vertexCount > 0) {
+        mVertexAllocator_.free(range.baseVertex, range.vertexCount);
+    }
+    if (range.indexCount > 0) {
+        mIndexAllocator_.free(range.indexOffset, range.indexCount * getIndexSize(range.indexType));
+    }
+}
+
+void GeometryArena::growBuffer(unsigned int& buffer, size_t oldSize, size_t newSize) {
+    unsigned int newBuffer;
+    mGraphicsAPI_.genBuffer(1, &newBuffer);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, newBuffer);
+    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, newSize, NULL, IGraphicsAPI::DataUsage::STATIC_DRAW);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_READ_BUFFER, buffer);
+    mGraphicsAPI_.copyBufferSubData(0, 0, oldSize);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_READ_BUFFER, 0);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER, 0);
+    mGraphicsAPI_.deleteBuffer(1, &buffer);
+    buffer = newBuffer;
+}
+
+void GeometryArena::bindBuffersToVertexArray() {
+    mGraphicsAPI_.bindVertexArray(mVAO_);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, mVBO_);
+    mLayout_.bindAttributes(mGraphicsAPI_);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER, mEBO_);
+    mGraphicsAPI_.bindVertexArray(0);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0);
+}
+
+} // namespace clay
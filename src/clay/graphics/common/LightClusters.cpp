@@ -0,0 +1,192 @@
+// standard lib
+#include <algorithm>
+#include <cmath>
+// class
+#include "clay/graphics/common/LightClusters.h"
+
+namespace clay {
+
+LightClusters::LightClusters() {
+    setProjection(glm::mat4(1.0f));
+}
+
+LightClusters::~LightClusters() {}
+
+void LightClusters::setProjection(const glm::mat4& projection) {
+    if (projection == mProjection_) {
+        return;
+    }
+    mProjection_ = projection;
+    mInverseProjection_ = glm::inverse(projection);
+    // Perspective projections copy -z into w
+    mPerspective_ = projection[2][3] == -1.0f && projection[3][3] == 0.0f;
+
+    if (mPerspective_) {
+        mGridSize_ = {GRID_X, GRID_Y, GRID_Z};
+        mNear_ = projection[3][2] / (projection[2][2] - 1.0f);
+        mFar_ = projection[3][2] / (projection[2][2] + 1.0f);
+        // slice = log(depth / near) / log(far / near) * GRID_Z
+        const float logRange = std::log(mFar_ / mNear_);
+        mSliceScale_ = GRID_Z / logRange;
+        mSliceBias_ = -GRID_Z * std::log(mNear_) / logRange;
+    } else {
+        // Depth slices and screen tiles do not help without perspective, everything goes in one cluster
+        mGridSize_ = {1, 1, 1};
+        mNear_ = 0.0f;
+        mFar_ = 0.0f;
+        mSliceScale_ = 0.0f;
+        mSliceBias_ = 0.0f;
+    }
+    computeClusterBounds();
+}
+
+void LightClusters::build(const Light* lights, size_t count, const glm::mat4& view) {
+    const size_t clusterCount = getClusterCount();
+    mClusterRanges_.assign(clusterCount, glm::uvec2(0));
+    mAssignments_.clear();
+    count = std::min(count, MAX_LIGHTS);
+
+    const float scaleX = mProjection_[0][0];
+    const float scaleY = mProjection_[1][1];
+    const float offsetX = mProjection_[2][0];
+    const float offsetY = mProjection_[2][1];
+
+    for (size_t i = 0; i < count; ++i) {
+        const Light& light = lights[i];
+        if (light.positionInvRange.w <= 0.0f) {
+            continue;
+        }
+        const uint16_t lightIndex = static_cast<uint16_t>(i);
+        if (!mPerspective_) {
+            mAssignments_.emplace_back(0, lightIndex);
+            continue;
+        }
+
+        const float radius = 1.0f / light.positionInvRange.w;
+        const glm::vec3 center = glm::vec3(view * glm::vec4(glm::vec3(light.positionInvRange), 1.0f));
+        const float minDepth = std::max(-center.z - radius, mNear_);
+        const float maxDepth = std::min(-center.z + radius, mFar_);
+        if (minDepth > maxDepth) {
+            continue;
+        }
+
+        const unsigned int lastSlice = getSlice(maxDepth);
+        for (unsigned int z = getSlice(minDepth); z <= lastSlice; ++z) {
+            // Conservative screen bounds of the sphere's box over the part of the slice it covers
+            const float nearDepth = std::max(minDepth, mSliceDepths_[z]);
+            const float farDepth = std::min(maxDepth, mSliceDepths_[z + 1]);
+            const float minX = center.x - radius;
+            const float maxX = center.x + radius;
+            const float minY = center.y - radius;
+            const float maxY = center.y + radius;
+            const float ndcMinX = scaleX * (minX < 0.0f ? minX / nearDepth : minX / farDepth) - offsetX;
+            const float ndcMaxX = scaleX * (maxX > 0.0f ? maxX / nearDepth : maxX / farDepth) - offsetX;
+            const float ndcMinY = scaleY * (minY < 0.0f ? minY / nearDepth : minY / farDepth) - offsetY;
+            const float ndcMaxY = scaleY * (maxY > 0.0f ? maxY / nearDepth : maxY / farDepth) - offsetY;
+            if (ndcMaxX < -1.0f || ndcMinX > 1.0f || ndcMaxY < -1.0f || ndcMinY > 1.0f) {
+                continue;
+            }
+            const int tileMinX = std::clamp(static_cast<int>((ndcMinX * 0.5f + 0.5f) * GRID_X), 0, static_cast<int>(GRID_X) - 1);
+            const int tileMaxX = std::clamp(static_cast<int>((ndcMaxX * 0.5f + 0.5f) * GRID_X), 0, static_cast<int>(GRID_X) - 1);
+            const int tileMinY = std::clamp(static_cast<int>((ndcMinY * 0.5f + 0.5f) * GRID_Y), 0, static_cast<int>(GRID_Y) - 1);
+            const int tileMaxY = std::clamp(static_cast<int>((ndcMaxY * 0.5f + 0.5f) * GRID_Y), 0, static_cast<int>(GRID_Y) - 1);
+
+            for (int y = tileMinY; y <= tileMaxY; ++y) {
+                for (int x = tileMinX; x <= tileMaxX; ++x) {
+                    const uint32_t cluster = x + GRID_X * (y + GRID_Y * z);
+                    // Exact sphere against cluster box test to drop the corners of the screen bounds
+                    const AABB& bounds = mClusterBounds_[cluster];
+                    const glm::vec3 closest = glm::clamp(center, bounds.min, bounds.max);
+                    const glm::vec3 offset = closest - center;
+                    if (glm::dot(offset, offset) <= radius * radius) {
+                        mAssignments_.emplace_back(cluster, lightIndex);
+                    }
+                }
+            }
+        }
+    }
+
+    // Counting sort of the assignments by cluster
+    for (const auto& assignment : mAssignments_) {
+        ++mClusterRanges_[assignment.first].y;
+    }
+    uint32_t offset = 0;
+    for (glm::uvec2& range : mClusterRanges_) {
+        range.x = offset;
+        offset += range.y;
+        range.y = 0;
+    }
+    mLightIndices_.resize(mAssignments_.size());
+    for (const auto& assignment : mAssignments_) {
+        glm::uvec2& range = mClusterRanges_[assignment.first];
+        mLightIndices_[range.x + range.y] = assignment.second;
+        ++range.y;
+    }
+}
+
+glm::uvec3 LightClusters::getGridSize() const {
+    return mGridSize_;
+}
+
+size_t LightClusters::getClusterCount() const {
+    return static_cast<size_t>(mGridSize_.x) * mGridSize_.y * mGridSize_.z;
+}
+
+float LightClusters::getSliceScale() const {
+    return mSliceScale_;
+}
+
+float LightClusters::getSliceBias() const {
+    return mSliceBias_;
+}
+
+const std::vector<glm::uvec2>& LightClusters::getClusterRanges() const {
+    return mClusterRanges_;
+}
+
+const std::vector<uint16_t>& LightClusters::getLightIndices() const {
+    return mLightIndices_;
+}
+
+glm::vec3 LightClusters::unproject(const glm::vec2& ndc, float depth) const {
+    const glm::vec4 nearPoint = mInverseProjection_ * glm::vec4(ndc, -1.0f, 1.0f);
+    const glm::vec3 ray = glm::vec3(nearPoint) / nearPoint.w;
+    return ray * (depth / -ray.z);
+}
+
+unsigned int LightClusters::getSlice(float depth) const {
+    const int slice = static_cast<int>(std::floor(std::log(depth) * mSliceScale_ + mSliceBias_));
+    return static_cast<unsigned int>(std::clamp(slice, 0, static_cast<int>(mGridSize_.z) - 1));
+}
+
+void LightClusters::computeClusterBounds() {
+    mClusterBounds_.assign(getClusterCount(), AABB());
+    mSliceDepths_.clear();
+    if (!mPerspective_) {
+        return;
+    }
+
+    mSliceDepths_.resize(GRID_Z + 1);
+    for (unsigned int z = 0; z <= GRID_Z; ++z) {
+        mSliceDepths_[z] = mNear_ * std::pow(mFar_ / mNear_, static_cast<float>(z) / GRID_Z);
+    }
+
+    for (unsigned int z = 0; z < GRID_Z; ++z) {
+        for (unsigned int y = 0; y < GRID_Y; ++y) {
+            for (unsigned int x = 0; x < GRID_X; ++x) {
+                const glm::vec2 ndcMin(-1.0f + 2.0f * x / GRID_X, -1.0f + 2.0f * y / GRID_Y);
+                const glm::vec2 ndcMax(-1.0f + 2.0f * (x + 1) / GRID_X, -1.0f + 2.0f * (y + 1) / GRID_Y);
+
+                AABB& bounds = mClusterBounds_[x + GRID_X * (y + GRID_Y * z)];
+                for (const float depth : {mSliceDepths_[z], mSliceDepths_[z + 1]}) {
+                    bounds.expand(unproject(ndcMin, depth));
+                    bounds.expand(unproject({ndcMax.x, ndcMin.y}, depth));
+                    bounds.expand(unproject({ndcMin.x, ndcMax.y}, depth));
+                    bounds.expand(unproject(ndcMax, depth));
+                }
+            }
+        }
+    }
+}
+
+} // namespace clay
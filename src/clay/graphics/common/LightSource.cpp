@@ -1,3 +1,7 @@
+// standard lib
+#include <algorithm>
+#include <cmath>
+#include <limits>
 // class
 #include "clay/graphics/common/LightSource.h"
 
@@ -66,4 +70,22 @@ float LightSource::getIntensity() const {
     return intensity_;
 }
 
+glm::vec3 LightSource::getAttenuation() const {
+    return {constantAttenuation_, linearAttenuation_, quadraticAttenuation_};
+}
+
+float LightSource::getRange() const {
+    // Solve intensity * maxColor / (c + l*d + q*d^2) = MIN_LIGHT_LEVEL for d
+    const float brightest = intensity_ * std::max({color_.r, color_.g, color_.b});
+    const float c = constantAttenuation_ - brightest / MIN_LIGHT_LEVEL;
+    if (quadraticAttenuation_ > 0.0f) {
+        const float discriminant = linearAttenuation_ * linearAttenuation_ - 4.0f * quadraticAttenuation_ * c;
+        return std::max(0.0f, (-linearAttenuation_ + std::sqrt(std::max(discriminant, 0.0f))) / (2.0f * quadraticAttenuation_));
+    }
+    if (linearAttenuation_ > 0.0f) {
+        return std::max(0.0f, -c / linearAttenuation_);
+    }
+    return std::numeric_limits<float>::infinity();
+}
+
 } // namespace clay
\ No newline at end of file
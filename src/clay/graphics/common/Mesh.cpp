@@ -1,13 +1,47 @@
+// standard lib
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 // third party
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 // project
+#include "clay/graphics/common/MeshSimplifier.h"
 #include "clay/utils/common/Logger.h"
 // class
 #include "clay/graphics/common/Mesh.h"
 
 namespace clay {
 
-void Mesh::parseMeshes(IGraphicsAPI& graphicsAPI, utils::FileData& fileData, std::vector<Mesh>& meshList) {
+namespace {
+    /** Map a direction onto the octahedron unfolded to [-1, 1]^2 */
+    glm::vec2 octahedralEncode(const glm::vec3& direction) {
+        const float l1Norm = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+        if (l1Norm == 0.0f) {
+            return glm::vec2(0.0f);
+        }
+        glm::vec2 encoded = glm::vec2(direction) / l1Norm;
+        if (direction.z < 0.0f) {
+            // Fold the lower hemisphere over the diagonals
+            encoded = glm::vec2(
+                (1.0f - std::abs(encoded.y)) * (encoded.x >= 0.0f ? 1.0f : -1.0f),
+                (1.0f - std::abs(encoded.x)) * (encoded.y >= 0.0f ? 1.0f : -1.0f)
+            );
+        }
+        return encoded;
+    }
+}
+
+void Mesh::parseMeshes(IGraphicsAPI& graphicsAPI, utils::FileData& fileData, std::vector<Mesh>& meshList, const VertexLayout& layout, const MeshOptimizer::Options& optimization) {
+    std::vector<Data> dataList;
+    parseMeshData(fileData, dataList, optimization);
+    for (const Data& data : dataList) {
+        meshList.push_back(Mesh(graphicsAPI, data.vertices, data.indices, layout));
+    }
+}
+
+void Mesh::parseMeshData(utils::FileData& fileData, std::vector<Data>& dataList, const MeshOptimizer::Options& optimization) {
     Assimp::Importer import;
     const aiScene* scene = import.ReadFileFromMemory(
             fileData.data.get(),
@@ -19,23 +53,36 @@ void Mesh::parseMeshes(IGraphicsAPI& graphicsAPI, utils::FileData& fileData, std
         LOG_E("ERROR::ASSIMP::%s", import.GetErrorString());
         return;
     }
-    // Process the Assimp node and add to mMeshes_
-    processNode(graphicsAPI, scene->mRootNode, scene, meshList);
+    // Process the Assimp node and add to dataList
+    processNode(scene->mRootNode, scene, dataList, optimization);
 }
 
-void Mesh::processNode(IGraphicsAPI& graphicsAPI, aiNode *node, const aiScene *scene, std::vector<Mesh>& meshList) {
+Mesh::Data Mesh::simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, float triangleRatio) {
+    const size_t targetIndexCount = static_cast<size_t>(indices.size() / 3 * std::clamp(triangleRatio, 0.0f, 1.0f)) * 3;
+    Data simplifiedData;
+    simplifiedData.indices = MeshSimplifier::simplify(vertices.data(), vertices.size(), sizeof(Vertex), indices, targetIndexCount);
+
+    // Reorder for the cache and drop the vertices no longer used
+    simplifiedData.vertices = vertices;
+    MeshOptimizer::Options options;
+    options.weldVertices = false;
+    MeshOptimizer::optimize(simplifiedData.vertices, simplifiedData.indices, options);
+    return simplifiedData;
+}
+
+void Mesh::processNode(aiNode *node, const aiScene *scene, std::vector<Data>& dataList, const MeshOptimizer::Options& optimization) {
     // process all the node's meshes (if any)
     for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
         aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        meshList.push_back(processMesh(graphicsAPI, mesh, scene));
+        dataList.push_back(processMesh(mesh, scene, optimization));
     }
     // then do the same for each of its children
     for (unsigned int i = 0; i < node->mNumChildren; ++i) {
-        processNode(graphicsAPI, node->mChildren[i], scene, meshList);
+        processNode(node->mChildren[i], scene, dataList, optimization);
     }
 }
 
-Mesh Mesh::processMesh(IGraphicsAPI& graphicsAPI, aiMesh *mesh, const aiScene *scene) {
+Mesh::Data Mesh::processMesh(aiMesh *mesh, const aiScene *scene, const MeshOptimizer::Options& optimization) {
     std::vector<Mesh::Vertex> vertices;
     std::vector<unsigned int> indices;
 
@@ -97,59 +144,178 @@ Mesh Mesh::processMesh(IGraphicsAPI& graphicsAPI, aiMesh *mesh, const aiScene *s
         }
     }
 
+    if (optimization.any()) {
+        MeshOptimizer::Stats before;
+        MeshOptimizer::Stats after;
+        MeshOptimizer::optimize(vertices, indices, optimization, &before, &after);
+        LOG_I(
+            "Optimized mesh %s: %zu -> %zu vertices, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+            mesh->mName.C_Str(),
+            before.vertexCount, after.vertexCount,
+            before.acmr, after.acmr,
+            before.atvr, after.atvr
+        );
+    }
+
     // TODO material/texture logic
 
-    return Mesh(graphicsAPI, vertices, indices);
+    return {std::move(vertices), std::move(indices)};
 }
 
-Mesh::Mesh(IGraphicsAPI& graphicsAPI, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) 
-    : mGraphicsAPI_(graphicsAPI) {
+Mesh::Mesh(IGraphicsAPI& graphicsAPI, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const VertexLayout& layout)
+    : mLayout_(layout),
+    mGraphicsAPI_(graphicsAPI) {
     this->vertices = vertices;
     this->indices = indices;
+    computeBounds();
     buildOpenGLproperties();
 }
 
 Mesh::~Mesh() {}
 
 void Mesh::render(const ShaderProgram& theShader) const {
-    mGraphicsAPI_.bindVertexArray(mVAO);
-    mGraphicsAPI_.drawElements(IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, static_cast<unsigned int>(indices.size()), IGraphicsAPI::DataType::UINT, 0);
-    mGraphicsAPI_.bindVertexArray(0);
+    mGeometry_->arena->bind();
+    mGraphicsAPI_.drawElementsBaseVertex(
+        IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST,
+        static_cast<int>(mGeometry_->indexCount),
+        mGeometry_->indexType,
+        (void*)mGeometry_->indexOffset,
+        static_cast<int>(mGeometry_->baseVertex)
+    );
+    // VAO is left bound so consecutive draws from the same arena do not rebind it
+}
+
+void Mesh::renderInstanced(const ShaderProgram& theShader, unsigned int instanceBuffer, size_t firstInstance, unsigned int instanceCount) const {
+    mGeometry_->arena->bind();
+    bindInstanceAttributes(mGraphicsAPI_, instanceBuffer, firstInstance * sizeof(Instance));
+
+    mGraphicsAPI_.drawElementsInstancedBaseVertex(
+        IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST,
+        static_cast<int>(mGeometry_->indexCount),
+        mGeometry_->indexType,
+        (void*)mGeometry_->indexOffset,
+        instanceCount,
+        static_cast<int>(mGeometry_->baseVertex)
+    );
+}
+
+void Mesh::bindInstanceAttributes(IGraphicsAPI& graphicsAPI, unsigned int instanceBuffer, size_t baseOffset) {
+    graphicsAPI.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, instanceBuffer);
+    // mat4 takes up 4 consecutive vec4 attribute locations
+    for (unsigned int i = 0; i < 4; ++i) {
+        graphicsAPI.enableVertexAttribArray(INSTANCE_ATTRIBUTE_LOCATION + i);
+        graphicsAPI.vertexAttribPointer(
+            INSTANCE_ATTRIBUTE_LOCATION + i, 4, IGraphicsAPI::DataType::FLOAT, false, sizeof(Instance),
+            (void*)(baseOffset + offsetof(Instance, model) + i * sizeof(glm::vec4))
+        );
+        graphicsAPI.vertexAttribDivisor(INSTANCE_ATTRIBUTE_LOCATION + i, 1);
+    }
+    graphicsAPI.enableVertexAttribArray(INSTANCE_ATTRIBUTE_LOCATION + 4);
+    graphicsAPI.vertexAttribPointer(
+        INSTANCE_ATTRIBUTE_LOCATION + 4, 4, IGraphicsAPI::DataType::FLOAT, false, sizeof(Instance),
+        (void*)(baseOffset + offsetof(Instance, color))
+    );
+    graphicsAPI.vertexAttribDivisor(INSTANCE_ATTRIBUTE_LOCATION + 4, 1);
+}
+
+Mesh Mesh::simplified(float triangleRatio) const {
+    const Data simplifiedData = simplify(vertices, indices, triangleRatio);
+    return Mesh(mGraphicsAPI_, simplifiedData.vertices, simplifiedData.indices, mLayout_);
+}
+
+const AABB& Mesh::getAABB() const {
+    return mAABB_;
+}
+
+const BoundingSphere& Mesh::getBoundingSphere() const {
+    return mBoundingSphere_;
+}
+
+const Mesh::VertexLayout& Mesh::getVertexLayout() const {
+    return mLayout_;
+}
+
+IGraphicsAPI::DataType Mesh::getIndexType() const {
+    return mIndexType_;
+}
+
+const GeometryArena::Range& Mesh::getGeometry() const {
+    return *mGeometry_;
+}
+
+size_t Mesh::getGPUMemorySize() const {
+    const size_t indexSize = mIndexType_ == IGraphicsAPI::DataType::USHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+    return vertices.size() * mLayout_.getStride() + indices.size() * indexSize;
+}
+
+void Mesh::computeBounds() {
+    mAABB_ = {};
+    for (const Vertex& vertex : vertices) {
+        mAABB_.expand(vertex.position);
+    }
+    mBoundingSphere_ = {};
+    if (!mAABB_.isValid()) {
+        return;
+    }
+
+    // Centered on the box, radius from the furthest vertex. Tighter than the sphere around the box corners
+    mBoundingSphere_.center = (mAABB_.min + mAABB_.max) * 0.5f;
+    float maxDistanceSq = 0.0f;
+    for (const Vertex& vertex : vertices) {
+        const glm::vec3 offset = vertex.position - mBoundingSphere_.center;
+        maxDistanceSq = std::max(maxDistanceSq, glm::dot(offset, offset));
+    }
+    mBoundingSphere_.radius = std::sqrt(maxDistanceSq);
 }
 
 void Mesh::buildOpenGLproperties() {
-    // create buffers/arrays
-    mGraphicsAPI_.genVertexArrays(1, &mVAO);
-    mGraphicsAPI_.genBuffer(1, &mVBO_);
-    mGraphicsAPI_.genBuffer(1, &mEBO_);
-
-    mGraphicsAPI_.bindVertexArray(mVAO);
-    // load data into vertex buffers
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, mVBO_);
-    // bind vertices
-    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], IGraphicsAPI::DataUsage::STATIC_DRAW);
-
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER, mEBO_);
-    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], IGraphicsAPI::DataUsage::STATIC_DRAW);
-
-    // set the vertex attribute pointers
-    // vertex Positions
-    mGraphicsAPI_.enableVertexAttribArray(0);
-    mGraphicsAPI_.vertexAttribPointer(0, 3, IGraphicsAPI::DataType::FLOAT, false, sizeof(Vertex), (void*)0);
-    // vertex normals
-    mGraphicsAPI_.enableVertexAttribArray(1);
-    mGraphicsAPI_.vertexAttribPointer(1, 3, IGraphicsAPI::DataType::FLOAT, false, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-    // vertex texture coords
-    mGraphicsAPI_.enableVertexAttribArray(2);
-    mGraphicsAPI_.vertexAttribPointer(2, 2, IGraphicsAPI::DataType::FLOAT, false, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
-    // vertex tangent
-    mGraphicsAPI_.enableVertexAttribArray(3);
-    mGraphicsAPI_.vertexAttribPointer(3, 3, IGraphicsAPI::DataType::FLOAT, false, sizeof(Vertex), (void*)offsetof(Vertex, tangent));
-    // vertex bitangent
-    mGraphicsAPI_.enableVertexAttribArray(4);
-    mGraphicsAPI_.vertexAttribPointer(4, 3, IGraphicsAPI::DataType::FLOAT, false, sizeof(Vertex), (void*)offsetof(Vertex, bitangent));
-
-    mGraphicsAPI_.bindVertexArray(0);
+    const VertexLayout::Offsets offsets = mLayout_.getOffsets();
+
+    // Encode the vertices into the layout
+    std::vector<uint8_t> vertexData(vertices.size() * offsets.stride);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex& vertex = vertices[i];
+        uint8_t* dest = vertexData.data() + i * offsets.stride;
+        std::memcpy(dest, &vertex.position, sizeof(glm::vec3));
+
+        if (mLayout_.normal == VertexLayout::NormalFormat::FLOAT3) {
+            std::memcpy(dest + offsets.normal, &vertex.normal, sizeof(glm::vec3));
+        } else {
+            const uint32_t packed = glm::packSnorm2x16(octahedralEncode(vertex.normal));
+            std::memcpy(dest + offsets.normal, &packed, sizeof(packed));
+        }
+
+        if (mLayout_.texCoord == VertexLayout::TexCoordFormat::FLOAT2) {
+            std::memcpy(dest + offsets.texCoord, &vertex.texCoord, sizeof(glm::vec2));
+        } else {
+            const uint32_t packed = glm::packHalf2x16(vertex.texCoord);
+            std::memcpy(dest + offsets.texCoord, &packed, sizeof(packed));
+        }
+
+        if (mLayout_.tangent == VertexLayout::TangentFormat::FLOAT3_BITANGENT) {
+            std::memcpy(dest + offsets.tangent, &vertex.tangent, sizeof(glm::vec3));
+            std::memcpy(dest + offsets.tangent + sizeof(glm::vec3), &vertex.bitangent, sizeof(glm::vec3));
+        } else {
+            // Handedness of the tangent frame, the bitangent itself is rebuilt from the normal and tangent
+            const float sign = glm::dot(glm::cross(vertex.normal, vertex.tangent), vertex.bitangent) < 0.0f ? -1.0f : 1.0f;
+            const uint32_t packed = glm::packSnorm4x8(glm::vec4(octahedralEncode(vertex.tangent), sign, 0.0f));
+            std::memcpy(dest + offsets.tangent, &packed, sizeof(packed));
+        }
+    }
+
+    // 16 bit indices when every vertex can be addressed
+    mIndexType_ = IGraphicsAPI::DataType::UINT;
+    if (mLayout_.shortIndices && vertices.size() <= std::numeric_limits<uint16_t>::max() + size_t(1)) {
+        mIndexType_ = IGraphicsAPI::DataType::USHORT;
+    }
+
+    std::shared_ptr<GeometryArena> arena = GeometryArena::acquire(mGraphicsAPI_, mLayout_);
+    if (mIndexType_ == IGraphicsAPI::DataType::USHORT) {
+        const std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+        mGeometry_ = arena->allocate(vertexData.data(), vertices.size(), shortIndices.data(), shortIndices.size(), mIndexType_);
+    } else {
+        mGeometry_ = arena->allocate(vertexData.data(), vertices.size(), indices.data(), indices.size(), mIndexType_);
+    }
 }
 
 } // namespace clay
\ No newline at end of file
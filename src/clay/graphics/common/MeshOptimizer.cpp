@@ -0,0 +1,240 @@
+// standard lib
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+// class
+#include "clay/graphics/common/MeshOptimizer.h"
+
+namespace clay {
+
+namespace {
+    constexpr unsigned int INVALID_INDEX = std::numeric_limits<unsigned int>::max();
+
+    /** FNV-1a hash of a vertex */
+    uint64_t hashVertex(const uint8_t* vertex, size_t stride) {
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < stride; ++i) {
+            hash = (hash ^ vertex[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Forsyth's scoring constants
+    constexpr float CACHE_DECAY_POWER = 1.5f;
+    constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+    constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+    /**
+     * @brief Score of a vertex, higher is better to draw next
+     *
+     * @param cachePosition Position in the LRU cache, -1 if not cached
+     * @param liveTriangles Number of triangles using the vertex that are not drawn yet
+     */
+    float scoreVertex(int cachePosition, unsigned int liveTriangles) {
+        if (liveTriangles == 0) {
+            // Nothing left to draw with this vertex
+            return -1.0f;
+        }
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                // Used by the last triangle. Scored lower to avoid strips of triangles that only share an edge
+                score = LAST_TRIANGLE_SCORE;
+            } else {
+                const float scale = 1.0f / (MeshOptimizer::OPTIMIZE_CACHE_SIZE - 3);
+                score = std::pow(1.0f - (cachePosition - 3) * scale, CACHE_DECAY_POWER);
+            }
+        }
+        // Favour vertices with few triangles left so they are finished off instead of left stranded
+        score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(liveTriangles), -VALENCE_BOOST_POWER);
+        return score;
+    }
+}
+
+bool MeshOptimizer::Options::any() const {
+    return weldVertices || optimizeVertexCache || optimizeVertexFetch;
+}
+
+size_t MeshOptimizer::weldVertices(void* vertices, size_t vertexCount, size_t stride, std::vector<unsigned int>& indices) {
+    uint8_t* data = static_cast<uint8_t*>(vertices);
+
+    // Open addressing table of kept vertex indices, at most half full
+    size_t tableSize = 1;
+    while (tableSize < vertexCount * 2) {
+        tableSize <<= 1;
+    }
+    std::vector<unsigned int> table(tableSize, INVALID_INDEX);
+    std::vector<unsigned int> remap(vertexCount);
+
+    size_t keptCount = 0;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const uint8_t* vertex = data + i * stride;
+        size_t slot = hashVertex(vertex, stride) & (tableSize - 1);
+        while (table[slot] != INVALID_INDEX && std::memcmp(data + table[slot] * stride, vertex, stride) != 0) {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+        if (table[slot] == INVALID_INDEX) {
+            // Kept vertices only move down, so the vertex is read before anything overwrites it
+            std::memmove(data + keptCount * stride, vertex, stride);
+            table[slot] = static_cast<unsigned int>(keptCount);
+            ++keptCount;
+        }
+        remap[i] = table[slot];
+    }
+
+    for (unsigned int& index : indices) {
+        index = remap[index];
+    }
+    return keptCount;
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // Triangles of each vertex, packed per vertex
+    std::vector<unsigned int> liveTriangles(vertexCount, 0);
+    for (const unsigned int index : indices) {
+        ++liveTriangles[index];
+    }
+    std::vector<unsigned int> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+    }
+    std::vector<unsigned int> adjacency(indices.size());
+    {
+        std::vector<unsigned int> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+    }
+
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        vertexScores[v] = scoreVertex(-1, liveTriangles[v]);
+    }
+    std::vector<float> triangleScores(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+    }
+    std::vector<bool> emitted(triangleCount, false);
+
+    std::vector<unsigned int> output;
+    output.reserve(indices.size());
+    // The cache can briefly hold 3 more entries than its size while a triangle is added
+    std::vector<unsigned int> cache;
+    std::vector<unsigned int> newCache;
+    cache.reserve(OPTIMIZE_CACHE_SIZE + 3);
+    newCache.reserve(OPTIMIZE_CACHE_SIZE + 3);
+
+    size_t scanCursor = 0;
+    unsigned int bestTriangle = INVALID_INDEX;
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (bestTriangle == INVALID_INDEX) {
+            // No cached vertex has triangles left, start over from the next undrawn triangle
+            while (emitted[scanCursor]) {
+                ++scanCursor;
+            }
+            bestTriangle = static_cast<unsigned int>(scanCursor);
+        }
+
+        const unsigned int* triangle = &indices[bestTriangle * 3];
+        emitted[bestTriangle] = true;
+        output.insert(output.end(), triangle, triangle + 3);
+
+        // Move the triangle's vertices to the front of the cache and drop the triangle from their adjacency
+        newCache.assign(triangle, triangle + 3);
+        for (unsigned int i = 0; i < 3; ++i) {
+            const unsigned int v = triangle[i];
+            unsigned int* first = &adjacency[adjacencyOffsets[v]];
+            unsigned int* last = first + liveTriangles[v];
+            std::iter_swap(std::find(first, last, bestTriangle), last - 1);
+            --liveTriangles[v];
+        }
+        for (const unsigned int v : cache) {
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                newCache.push_back(v);
+            }
+        }
+        std::swap(cache, newCache);
+
+        // Rescore the cached vertices, and the evicted ones which are no longer cached
+        for (size_t i = 0; i < cache.size(); ++i) {
+            const unsigned int v = cache[i];
+            cachePositions[v] = i < OPTIMIZE_CACHE_SIZE ? static_cast<int>(i) : -1;
+            const float newScore = scoreVertex(cachePositions[v], liveTriangles[v]);
+            const float delta = newScore - vertexScores[v];
+            vertexScores[v] = newScore;
+            for (unsigned int a = 0; a < liveTriangles[v]; ++a) {
+                triangleScores[adjacency[adjacencyOffsets[v] + a]] += delta;
+            }
+        }
+        if (cache.size() > OPTIMIZE_CACHE_SIZE) {
+            cache.resize(OPTIMIZE_CACHE_SIZE);
+        }
+
+        // The next triangle is the best scored one using a cached vertex
+        bestTriangle = INVALID_INDEX;
+        float bestScore = -std::numeric_limits<float>::max();
+        for (const unsigned int v : cache) {
+            for (unsigned int a = 0; a < liveTriangles[v]; ++a) {
+                const unsigned int t = adjacency[adjacencyOffsets[v] + a];
+                if (triangleScores[t] > bestScore) {
+                    bestScore = triangleScores[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+    }
+
+    indices = std::move(output);
+}
+
+size_t MeshOptimizer::optimizeVertexFetch(void* vertices, size_t vertexCount, size_t stride, std::vector<unsigned int>& indices) {
+    std::vector<unsigned int> remap(vertexCount, INVALID_INDEX);
+    unsigned int usedCount = 0;
+    for (unsigned int& index : indices) {
+        if (remap[index] == INVALID_INDEX) {
+            remap[index] = usedCount++;
+        }
+        index = remap[index];
+    }
+
+    uint8_t* data = static_cast<uint8_t*>(vertices);
+    std::vector<uint8_t> reordered(static_cast<size_t>(usedCount) * stride);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        if (remap[v] != INVALID_INDEX) {
+            std::memcpy(reordered.data() + remap[v] * stride, data + v * stride, stride);
+        }
+    }
+    std::memcpy(data, reordered.data(), reordered.size());
+    return usedCount;
+}
+
+MeshOptimizer::Stats MeshOptimizer::analyze(const std::vector<unsigned int>& indices, size_t vertexCount) {
+    Stats stats;
+    stats.vertexCount = vertexCount;
+    stats.indexCount = indices.size();
+
+    // Each vertex stores the miss count when it entered the cache, it is cached while fewer than the cache size misses followed
+    std::vector<size_t> cacheTimestamps(vertexCount, 0);
+    size_t misses = 0;
+    for (const unsigned int index : indices) {
+        if (cacheTimestamps[index] == 0 || misses - cacheTimestamps[index] + 1 > STATS_CACHE_SIZE) {
+            ++misses;
+            cacheTimestamps[index] = misses;
+        }
+    }
+
+    const size_t triangleCount = indices.size() / 3;
+    stats.acmr = triangleCount > 0 ? static_cast<float>(misses) / triangleCount : 0.0f;
+    stats.atvr = vertexCount > 0 ? static_cast<float>(misses) / vertexCount : 0.0f;
+    return stats;
+}
+
+} // namespace clay
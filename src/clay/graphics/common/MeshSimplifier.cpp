@@ -0,0 +1,285 @@
+// standard lib
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+// third party
+#include <glm/glm.hpp>
+// class
+#include "clay/graphics/common/MeshSimplifier.h"
+
+namespace clay {
+
+namespace {
+    constexpr unsigned int INVALID_INDEX = std::numeric_limits<unsigned int>::max();
+
+    /** Symmetric 4x4 error quadric, sum of squared distances to a set of planes */
+    struct Quadric {
+        double xx = 0, xy = 0, xz = 0, xw = 0;
+        double yy = 0, yz = 0, yw = 0;
+        double zz = 0, zw = 0;
+        double ww = 0;
+
+        /** Quadric of the plane through point with the unit normal, scaled by weight */
+        static Quadric fromPlane(const glm::vec3& normal, const glm::vec3& point, double weight) {
+            const double a = normal.x;
+            const double b = normal.y;
+            const double c = normal.z;
+            const double d = -glm::dot(normal, point);
+            Quadric q;
+            q.xx = a * a * weight; q.xy = a * b * weight; q.xz = a * c * weight; q.xw = a * d * weight;
+            q.yy = b * b * weight; q.yz = b * c * weight; q.yw = b * d * weight;
+            q.zz = c * c * weight; q.zw = c * d * weight;
+            q.ww = d * d * weight;
+            return q;
+        }
+
+        Quadric& operator+=(const Quadric& o) {
+            xx += o.xx; xy += o.xy; xz += o.xz; xw += o.xw;
+            yy += o.yy; yz += o.yz; yw += o.yw;
+            zz += o.zz; zw += o.zw;
+            ww += o.ww;
+            return *this;
+        }
+
+        /** Weighted squared distance of the point to the planes */
+        double error(const glm::vec3& p) const {
+            const double x = p.x;
+            const double y = p.y;
+            const double z = p.z;
+            const double e = xx * x * x + 2 * xy * x * y + 2 * xz * x * z + 2 * xw * x
+                + yy * y * y + 2 * yz * y * z + 2 * yw * y
+                + zz * z * z + 2 * zw * z
+                + ww;
+            return std::max(e, 0.0);
+        }
+    };
+
+    /** Collapse of every vertex at a position into a vertex at another position */
+    struct Collapse {
+        double cost;
+        /** Position group that is removed */
+        unsigned int from;
+        /** Vertex the indices of the removed group are replaced with */
+        unsigned int to;
+    };
+
+    uint64_t edgeKey(unsigned int a, unsigned int b) {
+        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+    }
+}
+
+std::vector<unsigned int> MeshSimplifier::simplify(const void* vertices, size_t vertexCount, size_t stride, const std::vector<unsigned int>& indices, size_t targetIndexCount) {
+    std::vector<unsigned int> result = indices;
+    if (result.size() <= targetIndexCount || vertexCount == 0) {
+        return result;
+    }
+
+    const uint8_t* data = static_cast<const uint8_t*>(vertices);
+    std::vector<glm::vec3> positions(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        std::memcpy(&positions[i], data + i * stride, sizeof(glm::vec3));
+    }
+
+    // Group vertices by position, each group is represented by its first vertex
+    std::vector<unsigned int> groups(vertexCount);
+    std::vector<unsigned int> groupSizes(vertexCount, 0);
+    {
+        struct PositionHash {
+            size_t operator()(const glm::vec3& p) const {
+                uint32_t bits[3];
+                std::memcpy(bits, &p, sizeof(bits));
+                return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+            }
+        };
+        std::unordered_map<glm::vec3, unsigned int, PositionHash> firstByPosition;
+        firstByPosition.reserve(vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            const unsigned int group = firstByPosition.emplace(positions[i], static_cast<unsigned int>(i)).first->second;
+            groups[i] = group;
+            ++groupSizes[group];
+        }
+    }
+
+    // Sum the planes of the triangles around each group, weighted by area
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t t = 0; t + 2 < result.size(); t += 3) {
+        const glm::vec3& p0 = positions[result[t]];
+        const glm::vec3 normal = glm::cross(positions[result[t + 1]] - p0, positions[result[t + 2]] - p0);
+        const float length = glm::length(normal);
+        if (length == 0.0f) {
+            continue;
+        }
+        const Quadric plane = Quadric::fromPlane(normal / length, p0, length * 0.5);
+        for (unsigned int i = 0; i < 3; ++i) {
+            quadrics[groups[result[t + i]]] += plane;
+        }
+    }
+
+    // Seams and the ends of border or non-manifold edges stay where they are
+    std::vector<bool> locked(vertexCount, false);
+    {
+        std::unordered_map<uint64_t, unsigned int> edgeUses;
+        edgeUses.reserve(result.size());
+        for (size_t t = 0; t + 2 < result.size(); t += 3) {
+            for (unsigned int e = 0; e < 3; ++e) {
+                ++edgeUses[edgeKey(groups[result[t + e]], groups[result[t + (e + 1) % 3]])];
+            }
+        }
+        for (const auto& [key, uses] : edgeUses) {
+            if (uses != 2) {
+                locked[static_cast<unsigned int>(key >> 32)] = true;
+                locked[static_cast<unsigned int>(key & 0xFFFFFFFFu)] = true;
+            }
+        }
+        for (size_t i = 0; i < vertexCount; ++i) {
+            if (groupSizes[groups[i]] > 1) {
+                locked[groups[i]] = true;
+            }
+        }
+    }
+
+    std::vector<unsigned int> adjacencyOffsets(vertexCount + 1);
+    std::vector<unsigned int> adjacency;
+    std::vector<Collapse> collapses;
+    std::vector<bool> touched(vertexCount);
+    std::vector<unsigned int> collapseTargets(vertexCount);
+
+    // Each pass collapses a set of edges that do not share triangles, cheapest first
+    while (result.size() > targetIndexCount) {
+        const size_t triangleCount = result.size() / 3;
+
+        // Triangles around each group
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+        for (const unsigned int index : result) {
+            ++adjacencyOffsets[groups[index] + 1];
+        }
+        for (size_t i = 0; i < vertexCount; ++i) {
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+        }
+        adjacency.resize(result.size());
+        {
+            std::vector<unsigned int> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t i = 0; i < result.size(); ++i) {
+                adjacency[fill[groups[result[i]]]++] = static_cast<unsigned int>(i / 3);
+            }
+        }
+
+        // Cheapest direction of every edge that can collapse
+        collapses.clear();
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (unsigned int e = 0; e < 3; ++e) {
+                const unsigned int a = result[t * 3 + e];
+                const unsigned int b = result[t * 3 + (e + 1) % 3];
+                const unsigned int groupA = groups[a];
+                const unsigned int groupB = groups[b];
+                // Each interior edge is seen from both triangles, keep one
+                if (groupA > groupB) {
+                    continue;
+                }
+                Quadric combined = quadrics[groupA];
+                combined += quadrics[groupB];
+                Collapse collapse = {std::numeric_limits<double>::max(), INVALID_INDEX, INVALID_INDEX};
+                if (!locked[groupA]) {
+                    collapse = {combined.error(positions[b]), groupA, b};
+                }
+                if (!locked[groupB]) {
+                    const double cost = combined.error(positions[a]);
+                    if (cost < collapse.cost) {
+                        collapse = {cost, groupB, a};
+                    }
+                }
+                if (collapse.from != INVALID_INDEX) {
+                    collapses.push_back(collapse);
+                }
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& lhs, const Collapse& rhs) {
+            return lhs.cost < rhs.cost;
+        });
+
+        // An interior collapse removes two triangles
+        const size_t trianglesToRemove = (result.size() - targetIndexCount + 2) / 3;
+        size_t removedEstimate = 0;
+        size_t collapseCount = 0;
+        std::fill(touched.begin(), touched.end(), false);
+        std::fill(collapseTargets.begin(), collapseTargets.end(), INVALID_INDEX);
+
+        for (const Collapse& collapse : collapses) {
+            if (removedEstimate >= trianglesToRemove) {
+                break;
+            }
+            const unsigned int toGroup = groups[collapse.to];
+            if (touched[collapse.from] || touched[toGroup]) {
+                continue;
+            }
+
+            // Reject collapses that flip a remaining triangle
+            const glm::vec3& target = positions[collapse.to];
+            bool flips = false;
+            for (unsigned int a = adjacencyOffsets[collapse.from]; a < adjacencyOffsets[collapse.from + 1] && !flips; ++a) {
+                const unsigned int* triangle = &result[adjacency[a] * 3];
+                glm::vec3 corners[3];
+                bool removed = false;
+                for (unsigned int i = 0; i < 3; ++i) {
+                    corners[i] = positions[triangle[i]];
+                    removed |= groups[triangle[i]] == toGroup;
+                }
+                if (removed) {
+                    continue;
+                }
+                const glm::vec3 before = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+                for (unsigned int i = 0; i < 3; ++i) {
+                    if (groups[triangle[i]] == collapse.from) {
+                        corners[i] = target;
+                    }
+                }
+                const glm::vec3 after = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+                flips = glm::dot(before, after) <= 0.0f;
+            }
+            if (flips) {
+                continue;
+            }
+
+            // The neighbourhood changes shape, later collapses in it would be tested against stale positions
+            for (unsigned int a = adjacencyOffsets[collapse.from]; a < adjacencyOffsets[collapse.from + 1]; ++a) {
+                for (unsigned int i = 0; i < 3; ++i) {
+                    touched[groups[result[adjacency[a] * 3 + i]]] = true;
+                }
+            }
+            collapseTargets[collapse.from] = collapse.to;
+            quadrics[toGroup] += quadrics[collapse.from];
+            removedEstimate += 2;
+            ++collapseCount;
+        }
+        if (collapseCount == 0) {
+            break;
+        }
+
+        // Apply the collapses and drop the triangles that became degenerate
+        size_t writeIndex = 0;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            unsigned int triangle[3];
+            for (unsigned int i = 0; i < 3; ++i) {
+                const unsigned int index = result[t * 3 + i];
+                const unsigned int target = collapseTargets[groups[index]];
+                triangle[i] = target != INVALID_INDEX ? target : index;
+            }
+            const unsigned int g0 = groups[triangle[0]];
+            const unsigned int g1 = groups[triangle[1]];
+            const unsigned int g2 = groups[triangle[2]];
+            if (g0 == g1 || g1 == g2 || g0 == g2) {
+                continue;
+            }
+            result[writeIndex++] = triangle[0];
+            result[writeIndex++] = triangle[1];
+            result[writeIndex++] = triangle[2];
+        }
+        result.resize(writeIndex);
+    }
+
+    return result;
+}
+
+} // namespace clay
@@ -1,3 +1,6 @@
+// standard lib
+#include <algorithm>
+#include <cmath>
 // class
 #include "clay/graphics/common/Model.h"
 
@@ -9,14 +12,19 @@ Model::~Model() {}
 
 void Model::addMesh(const Mesh& newMesh){
     mMeshes_.push_back(newMesh);
+    mLods_.clear();
+    updateBounds();
 }
 
 void Model::addSharedMesh(Mesh* newMesh) {
     mSharedMeshes_.push_back(newMesh);
+    updateBounds();
 }
 
 void Model::addMeshes(std::vector<Mesh>&& meshes) {
     mMeshes_ = std::move(meshes);
+    mLods_.clear();
+    updateBounds();
 }
 
 void Model::loadMesh(const std::filesystem::path& meshPath) {
@@ -24,7 +32,11 @@ void Model::loadMesh(const std::filesystem::path& meshPath) {
 }
 
 void Model::render(const ShaderProgram& shader) const {
-    for (auto& each: mMeshes_) {
+    render(shader, 0);
+}
+
+void Model::render(const ShaderProgram& shader, unsigned int lod) const {
+    for (auto& each: getMeshes(lod)) {
         each.render(shader);
     }
 
@@ -33,4 +45,97 @@ void Model::render(const ShaderProgram& shader) const {
     }
 }
 
+const std::vector<Mesh>& Model::getMeshes() const {
+    return mMeshes_;
+}
+
+const std::vector<Mesh>& Model::getMeshes(unsigned int lod) const {
+    if (lod == 0 || mLods_.empty()) {
+        return mMeshes_;
+    }
+    return mLods_[std::min<size_t>(lod, mLods_.size()) - 1].meshes;
+}
+
+void Model::generateLods(const std::vector<float>& triangleRatios) {
+    mLods_.clear();
+    for (const float ratio : triangleRatios) {
+        std::vector<Mesh> meshes;
+        for (const Mesh& mesh : mMeshes_) {
+            meshes.push_back(mesh.simplified(ratio));
+        }
+        addLod(std::move(meshes), ratio);
+    }
+}
+
+void Model::addLod(std::vector<Mesh>&& meshes, float triangleRatio) {
+    LodLevel level;
+    level.meshes = std::move(meshes);
+    level.screenSize = LOD_SCREEN_SIZE_SCALE * std::sqrt(triangleRatio);
+    mLods_.push_back(std::move(level));
+}
+
+unsigned int Model::getLodCount() const {
+    return static_cast<unsigned int>(mLods_.size()) + 1;
+}
+
+void Model::setLodScreenSize(unsigned int lod, float screenSize) {
+    if (lod == 0 || lod > mLods_.size()) {
+        LOG_W("Model has no level of detail %u", lod);
+        return;
+    }
+    mLods_[lod - 1].screenSize = screenSize;
+}
+
+unsigned int Model::selectLod(float screenSize, unsigned int currentLod) const {
+    const unsigned int lodCount = getLodCount();
+    unsigned int lod = std::min(currentLod, lodCount - 1);
+    // Level i is used below the switch size of mLods_[i - 1]
+    while (lod + 1 < lodCount && screenSize < mLods_[lod].screenSize * (1.0f - LOD_HYSTERESIS)) {
+        ++lod;
+    }
+    while (lod > 0 && screenSize > mLods_[lod - 1].screenSize * (1.0f + LOD_HYSTERESIS)) {
+        --lod;
+    }
+    return lod;
+}
+
+const std::vector<Mesh*>& Model::getSharedMeshes() const {
+    return mSharedMeshes_;
+}
+
+const AABB& Model::getAABB() const {
+    return mAABB_;
+}
+
+const BoundingSphere& Model::getBoundingSphere() const {
+    return mBoundingSphere_;
+}
+
+void Model::updateBounds() {
+    mAABB_ = {};
+    for (const Mesh& mesh : mMeshes_) {
+        mAABB_.expand(mesh.getAABB());
+    }
+    for (const Mesh* mesh : mSharedMeshes_) {
+        mAABB_.expand(mesh->getAABB());
+    }
+    mBoundingSphere_ = BoundingSphere::fromAABB(mAABB_);
+    if (!mBoundingSphere_.isValid()) {
+        return;
+    }
+
+    // Enclose the mesh spheres around the box center if that is tighter than the box corners
+    float radius = 0.0f;
+    auto encloseSphere = [&](const BoundingSphere& meshSphere) {
+        radius = std::max(radius, glm::length(meshSphere.center - mBoundingSphere_.center) + meshSphere.radius);
+    };
+    for (const Mesh& mesh : mMeshes_) {
+        encloseSphere(mesh.getBoundingSphere());
+    }
+    for (const Mesh* mesh : mSharedMeshes_) {
+        encloseSphere(mesh->getBoundingSphere());
+    }
+    mBoundingSphere_.radius = std::min(mBoundingSphere_.radius, radius);
+}
+
 } // namespace clay
\ No newline at end of file
@@ -0,0 +1,320 @@
+// standard lib
+#include <algorithm>
+#include <cmath>
+#include <limits>
+// third party
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+    #include <xmmintrin.h>
+    #define CLAY_OCCLUSION_SSE
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define CLAY_OCCLUSION_NEON
+#endif
+// class
+#include "clay/graphics/common/OcclusionCuller.h"
+
+namespace clay {
+
+OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height)
+    : mTilesX_((std::max(width, 1u) + TILE_WIDTH - 1) / TILE_WIDTH),
+    mTilesY_((std::max(height, 1u) + TILE_HEIGHT - 1) / TILE_HEIGHT) {
+    mWidth_ = mTilesX_ * TILE_WIDTH;
+    mHeight_ = mTilesY_ * TILE_HEIGHT;
+    mDepth_.assign(static_cast<size_t>(mWidth_) * mHeight_, 1.0f);
+    mTileBins_.resize(static_cast<size_t>(mTilesX_) * mTilesY_);
+}
+
+OcclusionCuller::~OcclusionCuller() {}
+
+void OcclusionCuller::beginFrame(const glm::mat4& viewProjection) {
+    mViewProjection_ = viewProjection;
+    std::fill(mDepth_.begin(), mDepth_.end(), 1.0f);
+    mTriangles_.clear();
+    for (std::vector<uint32_t>& bin : mTileBins_) {
+        bin.clear();
+    }
+    mStats_ = {};
+}
+
+void OcclusionCuller::addOccluder(const Mesh& mesh, const glm::mat4& model) {
+    const glm::mat4 modelViewProjection = mViewProjection_ * model;
+    mClipScratch_.resize(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        mClipScratch_[i] = modelViewProjection * glm::vec4(mesh.vertices[i].position, 1.0f);
+    }
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        addTriangle(mClipScratch_[mesh.indices[i]], mClipScratch_[mesh.indices[i + 1]], mClipScratch_[mesh.indices[i + 2]]);
+    }
+    ++mStats_.occluders;
+}
+
+void OcclusionCuller::addOccluder(const Model& model, const glm::mat4& transform) {
+    // The coarsest level keeps the silhouette at a fraction of the triangles
+    const unsigned int lod = model.getLodCount() > 0 ? model.getLodCount() - 1 : 0;
+    for (const Mesh& mesh : model.getMeshes(lod)) {
+        addOccluder(mesh, transform);
+    }
+}
+
+void OcclusionCuller::rasterize(utils::WorkerPool* workerPool) {
+    const size_t tileCount = mTileBins_.size();
+    if (workerPool == nullptr || workerPool->getThreadCount() <= 1 || mTriangles_.empty()) {
+        rasterizeTiles(0, tileCount);
+        return;
+    }
+
+    // Tiles do not share pixels so each thread writes its own part of the depth buffer
+    const size_t chunkSize = (tileCount + workerPool->getThreadCount() - 1) / workerPool->getThreadCount();
+    workerPool->run([this, chunkSize, tileCount](unsigned int threadIndex) {
+        const size_t firstTile = threadIndex * chunkSize;
+        if (firstTile < tileCount) {
+            rasterizeTiles(firstTile, std::min(chunkSize, tileCount - firstTile));
+        }
+    });
+}
+
+bool OcclusionCuller::isVisible(const AABB& box) {
+    ++mStats_.tested;
+    if (!box.isValid() || mTriangles_.empty()) {
+        return true;
+    }
+
+    glm::vec2 screenMin(std::numeric_limits<float>::max());
+    glm::vec2 screenMax(-std::numeric_limits<float>::max());
+    float minDepth = std::numeric_limits<float>::max();
+    for (int corner = 0; corner < 8; ++corner) {
+        const glm::vec4 clip = mViewProjection_ * glm::vec4(
+            (corner & 1) ? box.max.x : box.min.x,
+            (corner & 2) ? box.max.y : box.min.y,
+            (corner & 4) ? box.max.z : box.min.z,
+            1.0f
+        );
+        // Crosses the near plane, the projected bounds are not reliable
+        if (clip.w <= MIN_CLIP_W) {
+            return true;
+        }
+        const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        screenMin = glm::min(screenMin, glm::vec2(ndc));
+        screenMax = glm::max(screenMax, glm::vec2(ndc));
+        minDepth = std::min(minDepth, ndc.z * 0.5f + 0.5f);
+    }
+
+    const int minX = std::max(static_cast<int>(std::floor((screenMin.x * 0.5f + 0.5f) * mWidth_)), 0);
+    const int minY = std::max(static_cast<int>(std::floor((screenMin.y * 0.5f + 0.5f) * mHeight_)), 0);
+    const int maxX = std::min(static_cast<int>(std::floor((screenMax.x * 0.5f + 0.5f) * mWidth_)), static_cast<int>(mWidth_) - 1);
+    const int maxY = std::min(static_cast<int>(std::floor((screenMax.y * 0.5f + 0.5f) * mHeight_)), static_cast<int>(mHeight_) - 1);
+    // Off screen boxes are left to the frustum test
+    if (minX > maxX || minY > maxY) {
+        return true;
+    }
+
+    // Visible if the nearest point of the box is in front of the occluders at any covered pixel. Columns
+    // start on a multiple of 4, testing a few extra pixels only makes the result more conservative
+    const int startX = minX & ~3;
+    for (int y = minY; y <= maxY; ++y) {
+        const float* row = mDepth_.data() + static_cast<size_t>(y) * mWidth_;
+        int x = startX;
+#if defined(CLAY_OCCLUSION_SSE)
+        const __m128 boxDepth = _mm_set1_ps(minDepth);
+        for (; x <= maxX; x += 4) {
+            if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), boxDepth)) != 0) {
+                return true;
+            }
+        }
+#elif defined(CLAY_OCCLUSION_NEON)
+        const float32x4_t boxDepth = vdupq_n_f32(minDepth);
+        for (; x <= maxX; x += 4) {
+            if (vmaxvq_u32(vcgeq_f32(vld1q_f32(row + x), boxDepth)) != 0) {
+                return true;
+            }
+        }
+#endif
+        // Remainder, or everything without SIMD
+        for (; x <= maxX; ++x) {
+            if (row[x] >= minDepth) {
+                return true;
+            }
+        }
+    }
+
+    ++mStats_.culled;
+    return false;
+}
+
+const OcclusionCuller::Stats& OcclusionCuller::getStats() const {
+    return mStats_;
+}
+
+uint32_t OcclusionCuller::getWidth() const {
+    return mWidth_;
+}
+
+uint32_t OcclusionCuller::getHeight() const {
+    return mHeight_;
+}
+
+const std::vector<float>& OcclusionCuller::getDepthBuffer() const {
+    return mDepth_;
+}
+
+void OcclusionCuller::addTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2) {
+    if (v0.w <= MIN_CLIP_W || v1.w <= MIN_CLIP_W || v2.w <= MIN_CLIP_W) {
+        return;
+    }
+
+    // Screen space, x and y in pixels and depth in [0, 1]
+    const auto toScreen = [this](const glm::vec4& clip) {
+        const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        return glm::vec3((ndc.x * 0.5f + 0.5f) * mWidth_, (ndc.y * 0.5f + 0.5f) * mHeight_, ndc.z * 0.5f + 0.5f);
+    };
+    glm::vec3 a = toScreen(v0);
+    glm::vec3 b = toScreen(v1);
+    glm::vec3 c = toScreen(v2);
+
+    // Both windings occlude, flip to counter clockwise so the edge functions are positive inside
+    float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (std::abs(area) < 1e-6f) {
+        return;
+    }
+    if (area < 0.0f) {
+        std::swap(b, c);
+        area = -area;
+    }
+
+    // Pixels whose center is covered
+    Triangle triangle;
+    triangle.minX = std::max(static_cast<int>(std::ceil(std::min({a.x, b.x, c.x}) - 0.5f)), 0);
+    triangle.minY = std::max(static_cast<int>(std::ceil(std::min({a.y, b.y, c.y}) - 0.5f)), 0);
+    triangle.maxX = std::min(static_cast<int>(std::floor(std::max({a.x, b.x, c.x}) - 0.5f)), static_cast<int>(mWidth_) - 1);
+    triangle.maxY = std::min(static_cast<int>(std::floor(std::max({a.y, b.y, c.y}) - 0.5f)), static_cast<int>(mHeight_) - 1);
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+        return;
+    }
+
+    // Edge a->b, b->c and c->a as a * x + b * y + c
+    const glm::vec3 from[3] = {a, b, c};
+    const glm::vec3 to[3] = {b, c, a};
+    for (int edge = 0; edge < 3; ++edge) {
+        triangle.edgeA[edge] = from[edge].y - to[edge].y;
+        triangle.edgeB[edge] = to[edge].x - from[edge].x;
+        triangle.edgeC[edge] = -(triangle.edgeA[edge] * from[edge].x + triangle.edgeB[edge] * from[edge].y);
+    }
+    // Depth after the perspective divide is linear in screen space
+    const float depthX = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+    const float depthY = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+    triangle.depth = glm::vec3(depthX, depthY, a.z - depthX * a.x - depthY * a.y);
+
+    const uint32_t index = static_cast<uint32_t>(mTriangles_.size());
+    mTriangles_.push_back(triangle);
+    ++mStats_.occluderTriangles;
+
+    const int tileMinX = triangle.minX / static_cast<int>(TILE_WIDTH);
+    const int tileMinY = triangle.minY / static_cast<int>(TILE_HEIGHT);
+    const int tileMaxX = triangle.maxX / static_cast<int>(TILE_WIDTH);
+    const int tileMaxY = triangle.maxY / static_cast<int>(TILE_HEIGHT);
+    for (int tileY = tileMinY; tileY <= tileMaxY; ++tileY) {
+        for (int tileX = tileMinX; tileX <= tileMaxX; ++tileX) {
+            mTileBins_[static_cast<size_t>(tileY) * mTilesX_ + tileX].push_back(index);
+        }
+    }
+}
+
+void OcclusionCuller::rasterizeTiles(size_t firstTile, size_t tileCount) {
+    for (size_t tile = firstTile; tile < firstTile + tileCount; ++tile) {
+        const int tileX = static_cast<int>(tile % mTilesX_) * static_cast<int>(TILE_WIDTH);
+        const int tileY = static_cast<int>(tile / mTilesX_) * static_cast<int>(TILE_HEIGHT);
+        for (uint32_t index : mTileBins_[tile]) {
+            rasterizeTriangle(mTriangles_[index], tileX, tileY);
+        }
+    }
+}
+
+void OcclusionCuller::rasterizeTriangle(const Triangle& triangle, int tileX, int tileY) {
+    // Columns start on a multiple of 4 and tiles are a multiple of 4 wide, so SIMD rows stay in the tile
+    const int minX = std::max(triangle.minX, tileX) & ~3;
+    const int maxX = std::min(triangle.maxX, tileX + static_cast<int>(TILE_WIDTH) - 1);
+    const int minY = std::max(triangle.minY, tileY);
+    const int maxY = std::min(triangle.maxY, tileY + static_cast<int>(TILE_HEIGHT) - 1);
+
+#if defined(CLAY_OCCLUSION_SSE)
+    const __m128 laneX = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 edgeA[3], edgeB[3], edgeC[3];
+    for (int edge = 0; edge < 3; ++edge) {
+        edgeA[edge] = _mm_set1_ps(triangle.edgeA[edge]);
+        edgeB[edge] = _mm_set1_ps(triangle.edgeB[edge]);
+        edgeC[edge] = _mm_set1_ps(triangle.edgeC[edge]);
+    }
+    const __m128 depthA = _mm_set1_ps(triangle.depth.x);
+    const __m128 depthB = _mm_set1_ps(triangle.depth.y);
+    const __m128 depthC = _mm_set1_ps(triangle.depth.z);
+
+    for (int y = minY; y <= maxY; ++y) {
+        float* row = mDepth_.data() + static_cast<size_t>(y) * mWidth_;
+        const __m128 pixelY = _mm_set1_ps(y + 0.5f);
+        for (int x = minX; x <= maxX; x += 4) {
+            const __m128 pixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneX);
+            __m128 inside = _mm_cmpeq_ps(zero, zero);
+            for (int edge = 0; edge < 3; ++edge) {
+                const __m128 value = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(edgeA[edge], pixelX), _mm_mul_ps(edgeB[edge], pixelY)),
+                    edgeC[edge]
+                );
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(value, zero));
+            }
+            if (_mm_movemask_ps(inside) == 0) {
+                continue;
+            }
+            const __m128 depth = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(depthA, pixelX), _mm_mul_ps(depthB, pixelY)),
+                depthC
+            );
+            const __m128 stored = _mm_loadu_ps(row + x);
+            const __m128 nearest = _mm_min_ps(stored, depth);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, stored)));
+        }
+    }
+#elif defined(CLAY_OCCLUSION_NEON)
+    const float laneOffsets[4] = {0.5f, 1.5f, 2.5f, 3.5f};
+    const float32x4_t laneX = vld1q_f32(laneOffsets);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    for (int y = minY; y <= maxY; ++y) {
+        float* row = mDepth_.data() + static_cast<size_t>(y) * mWidth_;
+        const float pixelY = y + 0.5f;
+        for (int x = minX; x <= maxX; x += 4) {
+            const float32x4_t pixelX = vaddq_f32(vdupq_n_f32(static_cast<float>(x)), laneX);
+            uint32x4_t inside = vdupq_n_u32(~0u);
+            for (int edge = 0; edge < 3; ++edge) {
+                float32x4_t value = vdupq_n_f32(triangle.edgeB[edge] * pixelY + triangle.edgeC[edge]);
+                value = vmlaq_n_f32(value, pixelX, triangle.edgeA[edge]);
+                inside = vandq_u32(inside, vcgeq_f32(value, zero));
+            }
+            if (vmaxvq_u32(inside) == 0) {
+                continue;
+            }
+            float32x4_t depth = vdupq_n_f32(triangle.depth.y * pixelY + triangle.depth.z);
+            depth = vmlaq_n_f32(depth, pixelX, triangle.depth.x);
+            const float32x4_t stored = vld1q_f32(row + x);
+            vst1q_f32(row + x, vbslq_f32(inside, vminq_f32(stored, depth), stored));
+        }
+    }
+#else
+    for (int y = minY; y <= maxY; ++y) {
+        float* row = mDepth_.data() + static_cast<size_t>(y) * mWidth_;
+        const float pixelY = y + 0.5f;
+        for (int x = minX; x <= maxX; ++x) {
+            const float pixelX = x + 0.5f;
+            bool inside = true;
+            for (int edge = 0; edge < 3; ++edge) {
+                inside = inside && triangle.edgeA[edge] * pixelX + triangle.edgeB[edge] * pixelY + triangle.edgeC[edge] >= 0.0f;
+            }
+            if (inside) {
+                row[x] = std::min(row[x], triangle.depth.x * pixelX + triangle.depth.y * pixelY + triangle.depth.z);
+            }
+        }
+    }
+#endif
+}
+
+} // namespace clay
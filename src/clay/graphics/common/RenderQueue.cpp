@@ -0,0 +1,335 @@
+// standard lib
+#include <algorithm>
+#include <cstring>
+// class
+#include "clay/graphics/common/RenderQueue.h"
+
+namespace clay {
+
+RenderQueue::RenderQueue(IGraphicsAPI& graphicsAPI, DynamicRingBuffer& streamBuffer)
+    : mGraphicsAPI_(graphicsAPI),
+    mMultiDrawIndirect_(graphicsAPI.isMultiDrawIndirectSupported()),
+    mStreamBuffer_(streamBuffer) {}
+
+RenderQueue::~RenderQueue() {}
+
+void RenderQueue::submit(const DrawPacket& packet, Pass pass, float depth) {
+    if (packet.shader == nullptr || packet.mesh == nullptr) {
+        return;
+    }
+    const uint32_t shaderId = getCompactId(mShaderIds_, packet.shader);
+    const uint32_t meshId = getCompactId(mMeshIds_, packet.mesh);
+    const uint64_t key = makeSortKey(pass, shaderId, hashMaterial(packet), meshId, depth);
+
+    mSortEntries_.push_back({key, static_cast<uint32_t>(mPackets_.size())});
+    mPackets_.push_back(packet);
+}
+
+void RenderQueue::execute() {
+    mStats_ = {};
+    if (mPackets_.empty()) {
+        return;
+    }
+    sort();
+    buildInstanceRuns();
+
+    mCurrentShader_ = nullptr;
+    mCurrentMaterial_ = nullptr;
+
+    size_t nextRun = 0;
+    for (size_t i = 0; i < mSortEntries_.size();) {
+        const DrawPacket& packet = mPackets_[mSortEntries_[i].index];
+
+        if (nextRun < mInstanceRuns_.size() && mInstanceRuns_[nextRun].firstEntry == i) {
+            const InstanceRun& run = mInstanceRuns_[nextRun++];
+            bindShader(packet.shader->getInstancedVariant());
+            bindMaterial(packet, true);
+            // Model and color come from the instance attributes
+            mCurrentShader_->setUniform(mCurrentUniforms_.subImageTopLeft, glm::vec2(packet.subImage.x, packet.subImage.y));
+            mCurrentShader_->setUniform(mCurrentUniforms_.subImageSize, glm::vec2(packet.subImage.z, packet.subImage.w));
+            if (run.commandCount > 0) {
+                // Instance attributes start at the buffer start, each command's base instance selects its data
+                const GeometryArena::Range& geometry = packet.mesh->getGeometry();
+                geometry.arena->bind();
+                Mesh::bindInstanceAttributes(mGraphicsAPI_, mInstanceBuffer_, 0);
+                mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::DRAW_INDIRECT_BUFFER, mInstanceBuffer_);
+                mGraphicsAPI_.multiDrawElementsIndirect(
+                    IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST,
+                    geometry.indexType,
+                    (void*)(mIndirectBase_ + run.firstCommand * sizeof(IGraphicsAPI::DrawElementsIndirectCommand)),
+                    run.commandCount,
+                    0
+                );
+                ++mStats_.multiDraws;
+            } else {
+                packet.mesh->renderInstanced(*mCurrentShader_, mInstanceBuffer_, mInstanceBase_ + run.firstInstance, run.count);
+                ++mStats_.instancedDraws;
+            }
+            ++mStats_.draws;
+            mStats_.instances += run.count;
+            i += run.count;
+            continue;
+        }
+
+        bindShader(packet.shader);
+        bindMaterial(packet, false);
+
+        // Values equal to the last draw are filtered by the shader's uniform cache
+        mCurrentShader_->setUniform(mCurrentUniforms_.model, packet.model);
+        mCurrentShader_->setUniform(mCurrentUniforms_.color, packet.color);
+        mCurrentShader_->setUniform(mCurrentUniforms_.subImageTopLeft, glm::vec2(packet.subImage.x, packet.subImage.y));
+        mCurrentShader_->setUniform(mCurrentUniforms_.subImageSize, glm::vec2(packet.subImage.z, packet.subImage.w));
+
+        if (packet.wireframe) {
+            mGraphicsAPI_.polygonMode(IGraphicsAPI::PolygonModeFace::FRONT_AND_BACK, IGraphicsAPI::PolygonModeType::LINE);
+            mCurrentShader_->setUniform(mCurrentUniforms_.wireframeMode, true);
+            packet.mesh->render(*mCurrentShader_);
+            mGraphicsAPI_.polygonMode(IGraphicsAPI::PolygonModeFace::FRONT_AND_BACK, IGraphicsAPI::PolygonModeType::FILL);
+            mCurrentShader_->setUniform(mCurrentUniforms_.wireframeMode, false);
+            ++mStats_.draws;
+        }
+        packet.mesh->render(*mCurrentShader_);
+        ++mStats_.draws;
+        ++i;
+    }
+
+    clear();
+}
+
+void RenderQueue::clear() {
+    mPackets_.clear();
+    mInstanceRuns_.clear();
+    mSortEntries_.clear();
+    mShaderIds_.clear();
+    mMeshIds_.clear();
+}
+
+size_t RenderQueue::size() const {
+    return mPackets_.size();
+}
+
+const RenderQueue::Stats& RenderQueue::getStats() const {
+    return mStats_;
+}
+
+uint64_t RenderQueue::makeSortKey(Pass pass, uint32_t shaderId, uint32_t materialId, uint32_t meshId, float depth) {
+    uint64_t key = static_cast<uint64_t>(pass) << 62;
+
+    if (pass == Pass::TRANSPARENT) {
+        // Back to front so blending is correct, state grouping only breaks ties
+        const uint64_t invDepth = 0xFFFFFFu - quantizeDepth(depth, 24);
+        key |= invDepth << 38;
+        key |= static_cast<uint64_t>(shaderId & 0xFFFu) << 26;
+        key |= static_cast<uint64_t>(materialId & 0x3FFFu) << 12;
+        key |= static_cast<uint64_t>(meshId & 0xFFFu);
+    } else {
+        key |= static_cast<uint64_t>(shaderId & 0xFFFu) << 50;
+        key |= static_cast<uint64_t>(materialId & 0xFFFFu) << 34;
+        key |= static_cast<uint64_t>(meshId & 0xFFFFu) << 18;
+        key |= static_cast<uint64_t>(quantizeDepth(depth, 18));
+    }
+    return key;
+}
+
+uint32_t RenderQueue::quantizeDepth(float depth, uint32_t bits) {
+    // Bits of a positive float sort the same as its value. Drop the sign bit and keep the top bits
+    depth = std::max(depth, 0.0f);
+    uint32_t depthBits;
+    std::memcpy(&depthBits, &depth, sizeof(depthBits));
+    return depthBits >> (31 - bits);
+}
+
+uint32_t RenderQueue::hashMaterial(const DrawPacket& packet) {
+    // FNV-1a over the unit/texture pairs
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < packet.textureCount; ++i) {
+        hash = (hash ^ packet.textures[i].unit) * 16777619u;
+        hash = (hash ^ packet.textures[i].textureId) * 16777619u;
+        hash = (hash ^ packet.textures[i].samplerId) * 16777619u;
+    }
+    // Fold so the truncated key bits still see every input bit
+    return hash ^ (hash >> 16);
+}
+
+bool RenderQueue::sameMaterial(const DrawPacket& a, const DrawPacket& b) {
+    if (a.textures == b.textures && a.textureCount == b.textureCount) {
+        return true;
+    }
+    if (a.textureCount != b.textureCount) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.textureCount; ++i) {
+        if (a.textures[i].unit != b.textures[i].unit ||
+            a.textures[i].textureId != b.textures[i].textureId ||
+            a.textures[i].samplerId != b.textures[i].samplerId ||
+            a.textures[i].uniform.index != b.textures[i].uniform.index) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t RenderQueue::getCompactId(std::unordered_map<const void*, uint32_t>& ids, const void* ptr) {
+    auto [it, inserted] = ids.try_emplace(ptr, static_cast<uint32_t>(ids.size()));
+    return it->second;
+}
+
+bool RenderQueue::canInstance(const DrawPacket& a, const DrawPacket& b) {
+    return a.shader == b.shader &&
+        a.shader->getInstancedVariant() != nullptr &&
+        a.mesh == b.mesh &&
+        !a.wireframe && !b.wireframe &&
+        a.subImage == b.subImage &&
+        sameMaterial(a, b);
+}
+
+bool RenderQueue::canDrawIndirect(const DrawPacket& a, const DrawPacket& b) {
+    return a.shader == b.shader &&
+        a.shader->getInstancedVariant() != nullptr &&
+        a.mesh->getGeometry().arena == b.mesh->getGeometry().arena &&
+        a.mesh->getGeometry().indexType == b.mesh->getGeometry().indexType &&
+        !a.wireframe && !b.wireframe &&
+        a.subImage == b.subImage &&
+        sameMaterial(a, b);
+}
+
+void RenderQueue::sort() {
+    const size_t count = mSortEntries_.size();
+    mSortScratch_.resize(count);
+
+    for (uint32_t shift = 0; shift < 64; shift += 8) {
+        size_t histogram[256] = {};
+        for (const SortEntry& entry : mSortEntries_) {
+            ++histogram[(entry.key >> shift) & 0xFF];
+        }
+        // All keys share this digit, the pass would not change the order
+        if (histogram[(mSortEntries_[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t& bucket : histogram) {
+            const size_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+        for (const SortEntry& entry : mSortEntries_) {
+            mSortScratch_[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+        }
+        mSortEntries_.swap(mSortScratch_);
+    }
+}
+
+void RenderQueue::buildInstanceRuns() {
+    mInstanceRuns_.clear();
+    mInstanceStaging_.clear();
+    mIndirectStaging_.clear();
+
+    // Sorting groups packets by shader, material and mesh so instanceable packets are adjacent
+    const size_t count = mSortEntries_.size();
+    for (size_t first = 0; first < count;) {
+        const DrawPacket& firstPacket = mPackets_[mSortEntries_[first].index];
+        size_t last = first + 1;
+        while (last < count && (mMultiDrawIndirect_
+            ? canDrawIndirect(firstPacket, mPackets_[mSortEntries_[last].index])
+            : canInstance(firstPacket, mPackets_[mSortEntries_[last].index]))) {
+            ++last;
+        }
+
+        const size_t runCount = last - first;
+        if (runCount < MIN_INSTANCE_RUN) {
+            first = last;
+            continue;
+        }
+
+        InstanceRun run = {
+            static_cast<uint32_t>(first),
+            static_cast<uint32_t>(runCount),
+            static_cast<uint32_t>(mInstanceStaging_.size()),
+            static_cast<uint32_t>(mIndirectStaging_.size()),
+            0
+        };
+        const Mesh* commandMesh = nullptr;
+        for (size_t i = first; i < last; ++i) {
+            const DrawPacket& packet = mPackets_[mSortEntries_[i].index];
+            if (mMultiDrawIndirect_) {
+                // Packets of the same mesh are adjacent and share one command. The base instance is made
+                // absolute once the instance data has its place in the stream buffer
+                if (packet.mesh != commandMesh) {
+                    const GeometryArena::Range& geometry = packet.mesh->getGeometry();
+                    const size_t indexSize = geometry.indexType == IGraphicsAPI::DataType::USHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+                    mIndirectStaging_.push_back({
+                        static_cast<uint32_t>(geometry.indexCount),
+                        0,
+                        static_cast<uint32_t>(geometry.indexOffset / indexSize),
+                        static_cast<int32_t>(geometry.baseVertex),
+                        static_cast<uint32_t>(mInstanceStaging_.size())
+                    });
+                    commandMesh = packet.mesh;
+                }
+                ++mIndirectStaging_.back().instanceCount;
+            }
+            mInstanceStaging_.push_back({packet.model, packet.color});
+        }
+        run.commandCount = static_cast<uint32_t>(mIndirectStaging_.size()) - run.firstCommand;
+        // A single mesh is drawn with a plain instanced draw
+        if (run.commandCount == 1) {
+            mIndirectStaging_.pop_back();
+            run.commandCount = 0;
+        }
+        mInstanceRuns_.push_back(run);
+        first = last;
+    }
+
+    if (mInstanceStaging_.empty()) {
+        return;
+    }
+
+    // Instances and commands share one allocation so the buffer cannot grow between them.
+    // Aligned to the instance size so the offset can be expressed as a first instance
+    const size_t instanceBytes = mInstanceStaging_.size() * sizeof(Mesh::Instance);
+    const size_t indirectBytes = mIndirectStaging_.size() * sizeof(IGraphicsAPI::DrawElementsIndirectCommand);
+    const DynamicRingBuffer::Allocation allocation = mStreamBuffer_.allocate(instanceBytes + indirectBytes, sizeof(Mesh::Instance));
+    mInstanceBuffer_ = allocation.buffer;
+    mInstanceBase_ = allocation.offset / sizeof(Mesh::Instance);
+    mIndirectBase_ = allocation.offset + instanceBytes;
+
+    for (IGraphicsAPI::DrawElementsIndirectCommand& command : mIndirectStaging_) {
+        command.baseInstance += static_cast<uint32_t>(mInstanceBase_);
+    }
+    std::memcpy(allocation.data, mInstanceStaging_.data(), instanceBytes);
+    if (indirectBytes > 0) {
+        std::memcpy(static_cast<uint8_t*>(allocation.data) + instanceBytes, mIndirectStaging_.data(), indirectBytes);
+    }
+    mStreamBuffer_.flush(allocation);
+}
+
+void RenderQueue::bindShader(const ShaderProgram* shader) {
+    if (shader == mCurrentShader_) {
+        return;
+    }
+    mCurrentShader_ = shader;
+    mCurrentShader_->bind();
+    mCurrentUniforms_.model = mCurrentShader_->getUniform<glm::mat4>("uModel");
+    mCurrentUniforms_.color = mCurrentShader_->getUniform<glm::vec4>("uColor");
+    mCurrentUniforms_.subImageTopLeft = mCurrentShader_->getUniform<glm::vec2>("uSubImageTopLeft");
+    mCurrentUniforms_.subImageSize = mCurrentShader_->getUniform<glm::vec2>("uSubImageSize");
+    mCurrentUniforms_.wireframeMode = mCurrentShader_->getUniform<bool>("uWireframeMode");
+    // Sampler uniforms belong to the program so textures are rebound for the new shader
+    mCurrentMaterial_ = nullptr;
+    ++mStats_.shaderChanges;
+}
+
+void RenderQueue::bindMaterial(const DrawPacket& packet, bool instanced) {
+    if (mCurrentMaterial_ != nullptr && sameMaterial(*mCurrentMaterial_, packet)) {
+        return;
+    }
+    for (uint32_t i = 0; i < packet.textureCount; ++i) {
+        const TextureBinding& binding = packet.textures[i];
+        mCurrentShader_->setTexture(instanced ? binding.instancedUniform : binding.uniform, binding.textureId, binding.unit, binding.samplerId);
+    }
+    mCurrentMaterial_ = &packet;
+    ++mStats_.materialChanges;
+}
+
+} // namespace clay
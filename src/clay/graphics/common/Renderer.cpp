@@ -1,57 +1,58 @@
 // standard lib
+#include <algorithm>
+#include <cstddef>
+#include <limits>
 // third party
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/string_cast.hpp>
 // project
+#include "clay/utils/common/Logger.h"
 // class
 #include "clay/graphics/common/Renderer.h"
 
 namespace clay {
 
-const int Renderer::MAX_LIGHTS = 16;
-
-Renderer::Renderer(const glm::vec2& screenDim, ShaderProgram& spriteShader, ShaderProgram& text2Shader,
-                   ShaderProgram& mvpShader, Mesh& rectPlane, ShaderProgram& frameBufferShader, 
-                   ShaderProgram& bloomFinalShader, IGraphicsAPI& graphicsAPI)
+Renderer::Renderer(const glm::vec2& screenDim, ShaderProgram& spriteShader, ShaderProgram& spriteInstancedShader, ShaderProgram& text2Shader,
+                   Mesh& rectPlane, ShaderProgram& bloomDownsampleShader,
+                   ShaderProgram& bloomUpsampleShader, ShaderProgram& bloomFinalShader, ShaderProgram& debugLineShader,
+                   ShaderProgram& debugThickLineShader, IGraphicsAPI& graphicsAPI)
     : mSpriteShader_(spriteShader),
-    mMVPShader_(mvpShader),
+    mSpriteInstancedShader_(spriteInstancedShader),
     mTextShader_(text2Shader),
     mRectPlane_(rectPlane),
-    mBlurShader_(frameBufferShader),
+    mBloomDownsampleShader_(bloomDownsampleShader),
+    mBloomUpsampleShader_(bloomUpsampleShader),
     mBloomFinalShader_(bloomFinalShader),
     mAttachments_{0, 1},
-    mGraphicsAPI_(graphicsAPI) {
+    mGraphicsAPI_(graphicsAPI),
+    mStreamBuffer_(graphicsAPI, STREAM_BUFFER_FRAME_SIZE),
+    mDebugDraw_(graphicsAPI, mStreamBuffer_, debugLineShader, debugThickLineShader),
+    mRenderQueue_(graphicsAPI, mStreamBuffer_) {
     mDefaultProjection_ = glm::ortho(0.0f, screenDim.x, 0.0f, screenDim.y);
+    mScreenDim_ = screenDim;
 
-    // Rect
-    float verticesRect[] = {
-        -0.5f, -0.5f, 0.0f,
-        0.5f, -0.5f, 0.0f,
-        0.5f,  0.5f, 0.0f,
-        -0.5f,  0.5f, 0.0f
-    };
-    // todo use this
-    unsigned int indicesRect[] = {
-        2, 1, 0,
-        0, 3, 2
-    };
+    // Resolve the uniforms used per draw
+    mSpriteUniforms_.model = mSpriteShader_.getUniform<glm::mat4>("uModel");
+    mSpriteUniforms_.texture = mSpriteShader_.getUniform<int>("uTexture");
+    mSpriteUniforms_.subImageTopLeft = mSpriteShader_.getUniform<glm::vec2>("uSubImageTopLeft");
+    mSpriteUniforms_.subImageSize = mSpriteShader_.getUniform<glm::vec2>("uSubImageSize");
+    mSpriteUniforms_.color = mSpriteShader_.getUniform<glm::vec4>("uColor");
 
-    unsigned int VBORect, EBORect;
+    mSpriteInstancedUniforms_.texture = mSpriteInstancedShader_.getUniform<int>("uTexture");
 
-    mGraphicsAPI_.genVertexArrays(1, &mRectVAO_);
-    mGraphicsAPI_.genBuffer(1, &VBORect);
-    mGraphicsAPI_.genBuffer(1, &EBORect);
+    mTextUniforms_.textColor = mTextShader_.getUniform<glm::vec3>("textColor");
+    mTextUniforms_.model = mTextShader_.getUniform<glm::mat4>("uModel");
 
-    mGraphicsAPI_.bindVertexArray(mRectVAO_);
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, VBORect);
-    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::ARRAY_BUFFER,  sizeof(verticesRect),verticesRect, IGraphicsAPI::DataUsage::STATIC_DRAW);
+    mBloomDownsampleUniforms_.source = mBloomDownsampleShader_.getUniform<int>("uSource");
 
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, EBORect);
-    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::ARRAY_BUFFER,  sizeof(indicesRect), indicesRect, IGraphicsAPI::DataUsage::STATIC_DRAW);
+    mBloomUpsampleUniforms_.source = mBloomUpsampleShader_.getUniform<int>("uSource");
+    mBloomUpsampleUniforms_.filterRadius = mBloomUpsampleShader_.getUniform<float>("uFilterRadius");
 
-    // Set the vertex attribute pointers
-    mGraphicsAPI_.vertexAttribPointer(0, 3, IGraphicsAPI::DataType::FLOAT, false, 3 * sizeof(float), (void*)0);
-    mGraphicsAPI_.enableVertexAttribArray(0);
+    mBloomFinalUniforms_.scene = mBloomFinalShader_.getUniform<int>("scene");
+    mBloomFinalUniforms_.bloomBlur = mBloomFinalShader_.getUniform<int>("bloomBlur");
+    mBloomFinalUniforms_.gammaCorrect = mBloomFinalShader_.getUniform<bool>("uGammaCorrect");
+    mBloomFinalUniforms_.bloom = mBloomFinalShader_.getUniform<bool>("bloom");
+    mBloomFinalUniforms_.exposure = mBloomFinalShader_.getUniform<float>("exposure");
 
     // quad for frame buffer texture
     {
@@ -90,44 +91,86 @@ Renderer::Renderer(const glm::vec2& screenDim, ShaderProgram& spriteShader, Shad
         mGraphicsAPI_.enableVertexAttribArray(1);
     }
 
-    // Set up Line properties
-    float lineVertices[] = {
-        0,0,0,
-        0,0,0,
-    };
+    // Set up sprite batch quad and per instance buffer
+    {
+        float verticesSprite[] = {
+            // Positions         // Texture Coords
+            -0.5f, -0.5f, 0.0f,  0.0f, 0.0f,
+            0.5f, -0.5f, 0.0f,  1.0f, 0.0f,
+            0.5f,  0.5f, 0.0f,  1.0f, 1.0f,
+            -0.5f,  0.5f, 0.0f,  0.0f, 1.0f
+        };
+
+        unsigned int indicesSprite[] = {
+            0, 1, 2,
+            2, 3, 0
+        };
 
-    mGraphicsAPI_.genVertexArrays(1, &mLineVAO_);
-    mGraphicsAPI_.genBuffer(1, &mLineVBO_);
+        unsigned int VBOSprite, EBOSprite;
 
-    mGraphicsAPI_.bindVertexArray(mLineVAO_);
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, mLineVBO_);
-    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::ARRAY_BUFFER,  sizeof(lineVertices), lineVertices, IGraphicsAPI::DataUsage::STATIC_DRAW);
+        mGraphicsAPI_.genVertexArrays(1, &mSpriteBatchVAO_);
+        mGraphicsAPI_.genBuffer(1, &VBOSprite);
+        mGraphicsAPI_.genBuffer(1, &EBOSprite);
 
-    // Set the vertex attribute pointers
-    mGraphicsAPI_.vertexAttribPointer(0, 3, IGraphicsAPI::DataType::FLOAT, false, 3 * sizeof(float), (void*)0);
+        mGraphicsAPI_.bindVertexArray(mSpriteBatchVAO_);
+        mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, VBOSprite);
+        mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, sizeof(verticesSprite), verticesSprite, IGraphicsAPI::DataUsage::STATIC_DRAW);
+
+        mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER, EBOSprite);
+        mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER, sizeof(indicesSprite), indicesSprite, IGraphicsAPI::DataUsage::STATIC_DRAW);
+
+        // Position attribute
+        mGraphicsAPI_.vertexAttribPointer(0, 3, IGraphicsAPI::DataType::FLOAT, false, 5 * sizeof(float), (void*)0);
+        mGraphicsAPI_.enableVertexAttribArray(0);
+        // Texture coordinate attribute (same location as Mesh)
+        mGraphicsAPI_.vertexAttribPointer(2, 2, IGraphicsAPI::DataType::FLOAT, false, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+        mGraphicsAPI_.enableVertexAttribArray(2);
+
+        // Per instance attributes: model matrix (3-6), sub image (7), color (8). Pointers are set per batch
+        for (unsigned int i = 3; i <= 8; ++i) {
+            mGraphicsAPI_.enableVertexAttribArray(i);
+            mGraphicsAPI_.vertexAttribDivisor(i, 1);
+        }
+
+        mGraphicsAPI_.bindVertexArray(0);
+        mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0);
+    }
+
+    // Set up text VAO. Glyph quads are streamed, the attribute pointer is set per draw
+    mGraphicsAPI_.genVertexArrays(1, &mTextVAO_);
+    mGraphicsAPI_.bindVertexArray(mTextVAO_);
     mGraphicsAPI_.enableVertexAttribArray(0);
+    mGraphicsAPI_.bindVertexArray(0);
 
-    // Create Camera UBO to hold View and Projection matrix
-    mGraphicsAPI_.genBuffer(1, &mCameraUBO_);
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, mCameraUBO_);
-    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, sizeof(glm::mat4) * 2, NULL, IGraphicsAPI::DataUsage::STATIC_DRAW);
-    // define the range of the buffer that links to a uniform binding point
-    mGraphicsAPI_.bindBufferRange(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 0, mCameraUBO_, 0, 2 * sizeof(glm::mat4));
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 0);
+    // Camera View and Projection matrices are written to the stream buffer by setCamera and endFrame
 
-    // Create Light UBO to hold light data
+    // Create Light UBO to hold the cluster grid parameters
     mGraphicsAPI_.genBuffer(1, &mLightUBO_);
     mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, mLightUBO_);
-    // Calculate the size of the light buffer data with padding
-    size_t lightBufferSize = sizeof(glm::vec4)                // numLights
-                            + MAX_LIGHTS * sizeof(glm::vec4)  // lightPositions
-                            + MAX_LIGHTS * sizeof(glm::vec4); // lightColors
+    size_t lightBufferSize = sizeof(glm::uvec4)  // grid size, number of unbounded lights
+                            + sizeof(glm::vec4); // tile size, depth slice scale and bias
 
     mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, lightBufferSize, NULL, IGraphicsAPI::DataUsage::STATIC_DRAW);
     // Bind the buffer to the uniform binding point 1 (as an example)
     mGraphicsAPI_.bindBufferRange(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 1, mLightUBO_, 0, lightBufferSize);
     mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 0);
 
+    // Lights, cluster ranges and light indices are read through texture buffers bound to fixed units
+    auto createTextureBuffer = [this](unsigned int& buffer, unsigned int& texture, IGraphicsAPI::TextureFormat format, unsigned int unit) {
+        mGraphicsAPI_.genBuffer(1, &buffer);
+        mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::TEXTURE_BUFFER, buffer);
+        mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::TEXTURE_BUFFER, sizeof(glm::vec4), NULL, IGraphicsAPI::DataUsage::STREAM_DRAW);
+        mGraphicsAPI_.genTextures(1, &texture);
+        mGraphicsAPI_.activeTexture(unit);
+        mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_BUFFER, texture);
+        mGraphicsAPI_.texBuffer(format, buffer);
+    };
+    createTextureBuffer(mLightDataBuffer_, mLightDataTexture_, IGraphicsAPI::TextureFormat::RGBA32F, LightClusters::LIGHT_DATA_TEXTURE_UNIT);
+    createTextureBuffer(mLightClusterBuffer_, mLightClusterTexture_, IGraphicsAPI::TextureFormat::RG32UI, LightClusters::CLUSTER_TEXTURE_UNIT);
+    createTextureBuffer(mLightIndexBuffer_, mLightIndexTexture_, IGraphicsAPI::TextureFormat::R16UI, LightClusters::LIGHT_INDEX_TEXTURE_UNIT);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::TEXTURE_BUFFER, 0);
+    mGraphicsAPI_.activeTexture(0);
+
     {
         // set up floating point framebuffer to render scene to
         mGraphicsAPI_.genFrameBuffers(1, &hdrFBO_);
@@ -166,18 +209,25 @@ Renderer::Renderer(const glm::vec2& screenDim, ShaderProgram& spriteShader, Shad
         mGraphicsAPI_.drawBuffers(2, mAttachments_);
         mGraphicsAPI_.bindFrameBuffer(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, 0);
 
-        // ping-pong-framebuffer for blurring
-        mGraphicsAPI_.genFrameBuffers(2, pingpongFBO_);
-        mGraphicsAPI_.genFrameBuffers(2, pingpongColorbuffers_);
-        for (unsigned int i = 0; i < 2; i++) {
-            mGraphicsAPI_.bindFrameBuffer(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, pingpongFBO_[i]);
-            mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, pingpongColorbuffers_[i]);
+        // bloom mip chain. Only one framebuffer, each pass attaches the mip it renders to
+        mGraphicsAPI_.genFrameBuffers(1, &mBloomFBO_);
+        mGraphicsAPI_.bindFrameBuffer(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, mBloomFBO_);
+        glm::ivec2 mipSize(screenDim);
+        for (unsigned int i = 0; i < BLOOM_MIP_COUNT; ++i) {
+            mipSize /= 2;
+            if (mipSize.x < 1 || mipSize.y < 1) {
+                break;
+            }
+            BloomMip mip;
+            mip.size = mipSize;
+            mGraphicsAPI_.genTextures(1, &mip.texture);
+            mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, mip.texture);
             mGraphicsAPI_.texImage2D(
                 IGraphicsAPI::TextureTarget::TEXTURE_2D,
                 0,
                 IGraphicsAPI::TextureFormat::RGBA16F,
-                screenDim.x,
-                screenDim.y,
+                mip.size.x,
+                mip.size.y,
                 0,
                 IGraphicsAPI::TextureFormat::RGBA,
                 IGraphicsAPI::DataType::FLOAT,
@@ -185,321 +235,402 @@ Renderer::Renderer(const glm::vec2& screenDim, ShaderProgram& spriteShader, Shad
             );
             mGraphicsAPI_.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_MIN_FILTER, IGraphicsAPI::TextureParameterOption::LINEAR);
             mGraphicsAPI_.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_MAG_FILTER, IGraphicsAPI::TextureParameterOption::LINEAR);
-            // we clamp to the edge as the blur filter would otherwise sample repeated texture values!
+            // we clamp to the edge as the filters would otherwise sample repeated texture values!
             mGraphicsAPI_.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_S, IGraphicsAPI::TextureParameterOption::CLAMP_TO_EDGE);
             mGraphicsAPI_.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_T, IGraphicsAPI::TextureParameterOption::CLAMP_TO_EDGE);
-            mGraphicsAPI_.framebufferTexture2D(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, 0, IGraphicsAPI::FBOTextureTarget::TEXTURE_2D, pingpongColorbuffers_[i], 0);
+            mBloomMips_.push_back(mip);
         }
-
+        if (!mBloomMips_.empty()) {
+            mGraphicsAPI_.framebufferTexture2D(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, 0, IGraphicsAPI::FBOTextureTarget::TEXTURE_2D, mBloomMips_[0].texture, 0);
+        }
+        mGraphicsAPI_.bindFrameBuffer(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, 0);
     }
     // by default, disable bloom
     setBloom(false);
+    setCamera(nullptr);
+    updateLightClusters();
 }
 
 Renderer::~Renderer() {}
 
 void Renderer::setCamera(const Camera* camera) {
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, mCameraUBO_);
-
     if (camera != nullptr) {
-        mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(camera->getViewMatrix()));
-        mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(camera->getProjectionMatrix()));
+        mCameraPosition_ = camera->getPosition();
+        mCameraView_ = camera->getViewMatrix();
+        mCameraProjection_ = camera->getProjectionMatrix();
     } else {
-        mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(glm::mat4(1)));
-        mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(mDefaultProjection_));
+        mCameraPosition_ = {0.0f, 0.0f, 0.0f};
+        mCameraView_ = glm::mat4(1.0f);
+        mCameraProjection_ = mDefaultProjection_;
+    }
+    mFrustum_ = Frustum(mCameraProjection_ * mCameraView_);
+    mLightClusters_.setProjection(mCameraProjection_);
+    uploadCameraData();
+
+    // Light bins depend on the view
+    if (!mLights_.empty()) {
+        updateLightClusters();
     }
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 0);
 }
 
-void Renderer::setLightSources(const std::vector<std::unique_ptr<LightSource>>& lights) const {
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, mLightUBO_);
+const Frustum& Renderer::getFrustum() const {
+    return mFrustum_;
+}
 
-    // Prepare data for the UBO
-    std::vector<glm::vec4> lightPositions(MAX_LIGHTS); // Use vec4 for alignment
-    std::vector<glm::vec4> lightColors(MAX_LIGHTS);    // Use vec4 for alignment
-    int numPointLights = 0;
+glm::mat4 Renderer::getViewProjection() const {
+    return mCameraProjection_ * mCameraView_;
+}
 
+float Renderer::getScreenSize(const BoundingSphere& sphere) const {
+    // Projected diameter over the NDC height of 2
+    const float projectedRadius = sphere.radius * mCameraProjection_[1][1];
+    if (mCameraProjection_[3][3] == 1.0f) {
+        // Orthographic, size does not change with distance
+        return projectedRadius;
+    }
+    const float distance = glm::length(sphere.center - mCameraPosition_);
+    if (distance <= sphere.radius) {
+        return std::numeric_limits<float>::max();
+    }
+    return projectedRadius / distance;
+}
+
+void Renderer::setLightSources(const std::vector<std::unique_ptr<LightSource>>& lights) const {
+    mLightPointers_.clear();
     for (const auto& light : lights) {
-        if (numPointLights < MAX_LIGHTS) {
-            lightPositions[numPointLights] = glm::vec4(light->getPosition(), 0.0f); // Add zero padding
-            lightColors[numPointLights] = light->getColor();
-            numPointLights++;
-        }
+        mLightPointers_.push_back(light.get());
     }
+    setLightSources(mLightPointers_);
+}
 
-    // Fill UBO data
-    glm::vec4 temp = {numPointLights, 0, 0, 0};
-    mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 0, sizeof(glm::vec4), &temp);// numLights
+void Renderer::setLightSources(const std::vector<LightSource*>& lights) const {
+    mLights_.clear();
+    for (const LightSource* light : lights) {
+        const float range = light->getRange();
+        if (range <= 0.0f) {
+            // Never brighter than LightSource::MIN_LIGHT_LEVEL
+            continue;
+        }
+        LightClusters::Light packed;
+        packed.positionInvRange = glm::vec4(light->getPosition(), 1.0f / range); // 0 for infinite range
+        packed.colorIntensity = glm::vec4(glm::vec3(light->getColor()), light->getIntensity());
+        packed.attenuation = glm::vec4(light->getAttenuation(), 0.0f);
+        mLights_.push_back(packed);
+    }
+    if (mLights_.size() > LightClusters::MAX_LIGHTS) {
+        LOG_W("Only the first %zu of %zu lights are rendered", LightClusters::MAX_LIGHTS, mLights_.size());
+        mLights_.resize(LightClusters::MAX_LIGHTS);
+    }
 
-    // Set padding
-    size_t offset = sizeof(glm::vec4); // Offset for padding
-    mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, offset, sizeof(glm::vec4) * MAX_LIGHTS, lightPositions.data()); // lightPositions
+    // Lights without a range go first so shaders can apply them without the cluster lists
+    const auto boundedBegin = std::stable_partition(mLights_.begin(), mLights_.end(), [](const LightClusters::Light& light) {
+        return light.positionInvRange.w == 0.0f;
+    });
+    mUnboundedLightCount_ = static_cast<size_t>(boundedBegin - mLights_.begin());
 
-    // Set light colors
-    offset += sizeof(glm::vec4) * MAX_LIGHTS;
-    mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, offset, sizeof(glm::vec4) * MAX_LIGHTS, lightColors.data()); // lightColors
+    updateLightClusters();
+}
 
+void Renderer::updateLightClusters() const {
+    mLightClusters_.build(mLights_.data(), mLights_.size(), mCameraView_);
+
+    const glm::uvec3 gridSize = mLightClusters_.getGridSize();
+    const glm::uvec4 gridInfo(gridSize.x, gridSize.y, gridSize.z, static_cast<unsigned int>(mUnboundedLightCount_));
+    const glm::vec4 gridParams(
+        mScreenDim_.x / gridSize.x,
+        mScreenDim_.y / gridSize.y,
+        mLightClusters_.getSliceScale(),
+        mLightClusters_.getSliceBias()
+    );
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, mLightUBO_);
+    mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 0, sizeof(glm::uvec4), glm::value_ptr(gridInfo));
+    mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, sizeof(glm::uvec4), sizeof(glm::vec4), glm::value_ptr(gridParams));
     mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 0);
+
+    // Reallocating the storage each frame orphans the previous one instead of waiting on draws still using it
+    auto upload = [this](unsigned int buffer, size_t size, const void* data) {
+        mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::TEXTURE_BUFFER, buffer);
+        if (size == 0) {
+            mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::TEXTURE_BUFFER, sizeof(glm::vec4), NULL, IGraphicsAPI::DataUsage::STREAM_DRAW);
+        } else {
+            mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::TEXTURE_BUFFER, size, const_cast<void*>(data), IGraphicsAPI::DataUsage::STREAM_DRAW);
+        }
+    };
+    const std::vector<glm::uvec2>& clusterRanges = mLightClusters_.getClusterRanges();
+    const std::vector<uint16_t>& lightIndices = mLightClusters_.getLightIndices();
+    upload(mLightDataBuffer_, mLights_.size() * sizeof(LightClusters::Light), mLights_.data());
+    upload(mLightClusterBuffer_, clusterRanges.size() * sizeof(glm::uvec2), clusterRanges.data());
+    upload(mLightIndexBuffer_, lightIndices.size() * sizeof(uint16_t), lightIndices.data());
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::TEXTURE_BUFFER, 0);
 }
 
-void Renderer::setLightSources(const std::vector<LightSource*>& lights) const {
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, mLightUBO_);
+void Renderer::uploadCameraData() {
+    // Each camera change gets its own range so draws already issued with the previous camera are not affected
+    const DynamicRingBuffer::Allocation cameraData = mStreamBuffer_.allocate(2 * sizeof(glm::mat4), DynamicRingBuffer::UNIFORM_ALIGNMENT);
+    glm::mat4* matrices = static_cast<glm::mat4*>(cameraData.data);
+    matrices[0] = mCameraView_;
+    matrices[1] = mCameraProjection_;
+    mStreamBuffer_.flush(cameraData);
+    mGraphicsAPI_.bindBufferRange(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 0, cameraData.buffer, cameraData.offset, cameraData.size);
+}
 
-    // Prepare data for the UBO
-    std::vector<glm::vec4> lightPositions(MAX_LIGHTS); // Use vec4 for alignment
-    std::vector<glm::vec4> lightColors(MAX_LIGHTS);    // Use vec4 for alignment
-    int numPointLights = 0;
+void Renderer::beginSpriteBatch() {
+    mSpriteBatching_ = true;
+}
 
-    for (const auto& light : lights) {
-        if (numPointLights < MAX_LIGHTS) {
-            lightPositions[numPointLights] = glm::vec4(light->getPosition(), 0.0f); // Add zero padding
-            lightColors[numPointLights] = light->getColor();
-            numPointLights++;
-        }
+void Renderer::endSpriteBatch() {
+    mSpriteBatching_ = false;
+
+    if (mSpriteBatchOrder_.empty()) {
+        return;
     }
 
-    // Fill UBO data
-    glm::vec4 temp = {numPointLights, 0, 0, 0};
-    mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 0, sizeof(glm::vec4), &temp);// numLights
+    // Pack the groups back to back so all instances are uploaded with one buffer update
+    mSpriteBatchStaging_.clear();
+    for (unsigned int textureId : mSpriteBatchOrder_) {
+        const std::vector<SpriteInstance>& instances = mSpriteBatch_[textureId];
+        mSpriteBatchStaging_.insert(mSpriteBatchStaging_.end(), instances.begin(), instances.end());
+    }
 
-    // Set padding
-    size_t offset = sizeof(glm::vec4); // Offset for padding
-    mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, offset, sizeof(glm::vec4) * MAX_LIGHTS, lightPositions.data()); // lightPositions
+    const DynamicRingBuffer::Allocation instanceData = mStreamBuffer_.upload(
+        mSpriteBatchStaging_.data(), mSpriteBatchStaging_.size() * sizeof(SpriteInstance)
+    );
 
-    // Set light colors
-    offset += sizeof(glm::vec4) * MAX_LIGHTS;
-    mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, offset, sizeof(glm::vec4) * MAX_LIGHTS, lightColors.data()); // lightColors
+    mSpriteInstancedShader_.bind();
+    mSpriteInstancedShader_.setUniform(mSpriteInstancedUniforms_.texture, 0);
+    mGraphicsAPI_.activeTexture(0);
+    // Sprites use the parameters of their texture
+    mGraphicsAPI_.bindSampler(0, 0);
+    mGraphicsAPI_.bindVertexArray(mSpriteBatchVAO_);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, instanceData.buffer);
+
+    // One instanced draw per texture
+    size_t firstInstance = 0;
+    for (unsigned int textureId : mSpriteBatchOrder_) {
+        std::vector<SpriteInstance>& instances = mSpriteBatch_[textureId];
+
+        mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, textureId);
+        setSpriteInstanceAttributes(instanceData.offset + firstInstance * sizeof(SpriteInstance));
+        mGraphicsAPI_.drawElementsInstanced(
+            IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST,
+            6,
+            IGraphicsAPI::DataType::UINT,
+            0,
+            static_cast<unsigned int>(instances.size())
+        );
+
+        firstInstance += instances.size();
+        instances.clear();
+    }
+    mSpriteBatchOrder_.clear();
 
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::UNIFORM_BUFFER, 0);
+    mGraphicsAPI_.bindVertexArray(0);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0);
+}
+
+bool Renderer::isSpriteBatching() const {
+    return mSpriteBatching_;
+}
+
+void Renderer::beginRenderQueue() {
+    mRenderQueue_.clear();
+    mRenderQueueActive_ = true;
+}
+
+void Renderer::endRenderQueue() {
+    mRenderQueueActive_ = false;
+    mRenderQueue_.execute();
+}
+
+bool Renderer::isRenderQueueActive() const {
+    return mRenderQueueActive_;
+}
+
+void Renderer::submit(const RenderQueue::DrawPacket& packet, RenderQueue::Pass pass) const {
+    const float depth = glm::length(glm::vec3(packet.model[3]) - mCameraPosition_);
+    mRenderQueue_.submit(packet, pass, depth);
+}
+
+const RenderQueue::Stats& Renderer::getRenderQueueStats() const {
+    return mRenderQueue_.getStats();
 }
 
 void Renderer::renderSprite(unsigned int textureId, const glm::mat4& modelMat, const glm::vec4& theColor) const {
+    if (mSpriteBatching_) {
+        addToSpriteBatch(textureId, modelMat, {0.f, 0.f, 1.f, 1.f}, theColor);
+        return;
+    }
+
     mSpriteShader_.bind();
     mGraphicsAPI_.activeTexture(0);
     mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, textureId);
+    mGraphicsAPI_.bindSampler(0, 0);
 
-    mSpriteShader_.setMat4("uModel", modelMat);
+    mSpriteShader_.setUniform(mSpriteUniforms_.model, modelMat);
 
     // Draw the whole texture
-    mSpriteShader_.setInt("uTexture", 0);
-    mSpriteShader_.setVec2("uSubImageTopLeft", {0.f, 0.f});
-    mSpriteShader_.setVec2("uSubImageSize", {1.f, 1.f});
-    mSpriteShader_.setVec4("uColor", theColor);
+    mSpriteShader_.setUniform(mSpriteUniforms_.texture, 0);
+    mSpriteShader_.setUniform(mSpriteUniforms_.subImageTopLeft, {0.f, 0.f});
+    mSpriteShader_.setUniform(mSpriteUniforms_.subImageSize, {1.f, 1.f});
+    mSpriteShader_.setUniform(mSpriteUniforms_.color, theColor);
 
     mRectPlane_.render(mSpriteShader_);
 }
 
 void Renderer::renderSprite(SpriteSheet::Sprite& theSprite, const glm::mat4& modelMat, const glm::vec4& theColor) const {
+    // Sprites of an atlas resolve to their current region
+    const glm::vec4 subImage = theSprite.parentSpriteSheet.getSubImage(theSprite);
+
+    if (mSpriteBatching_) {
+        addToSpriteBatch(theSprite.parentSpriteSheet.getTextureId(), modelMat, subImage, theColor);
+        return;
+    }
+
     mSpriteShader_.bind();
     mGraphicsAPI_.activeTexture(0);
     mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, theSprite.parentSpriteSheet.getTextureId());
+    mGraphicsAPI_.bindSampler(0, 0);
 
-    mSpriteShader_.setMat4("uModel", modelMat);
-    mSpriteShader_.setInt("uTexture", 0);
-
-    float subImageTopLeftX = static_cast<float>(theSprite.gridIndex.x * theSprite.spriteSize.x) / theSprite.parentSpriteSheet.getSheetSize()[0];
-    float subImageTopLeftY = static_cast<float>(theSprite.gridIndex.y * theSprite.spriteSize.y) / theSprite.parentSpriteSheet.getSheetSize()[1];
-    mSpriteShader_.setVec2("uSubImageTopLeft", {subImageTopLeftX, subImageTopLeftY});
-    float normalWidth = (float)theSprite.spriteSize[0] / (float)theSprite.parentSpriteSheet.getSheetSize()[0];
-    float normalHeight = (float)theSprite.spriteSize[1] / (float)theSprite.parentSpriteSheet.getSheetSize()[1];
-    mSpriteShader_.setVec2("uSubImageSize", {normalWidth, normalHeight});
-    mSpriteShader_.setVec4("uColor", theColor);
+    mSpriteShader_.setUniform(mSpriteUniforms_.model, modelMat);
+    mSpriteShader_.setUniform(mSpriteUniforms_.texture, 0);
+    mSpriteShader_.setUniform(mSpriteUniforms_.subImageTopLeft, {subImage.x, subImage.y});
+    mSpriteShader_.setUniform(mSpriteUniforms_.subImageSize, {subImage.z, subImage.w});
+    mSpriteShader_.setUniform(mSpriteUniforms_.color, theColor);
 
     mRectPlane_.render(mSpriteShader_);
 }
 
-void Renderer::renderText(const std::string& text, const glm::vec2& position, const Font& font, float scale, const glm::vec3& color) {
-    float xPos = position.x;	
-    mTextShader_.bind();
-    // TODO alpha color
-    mTextShader_.setVec3("textColor", color);
-    mGraphicsAPI_.activeTexture(0);
-    mGraphicsAPI_.bindVertexArray(font.getVAO());
-
-    for (const char& c : text) {
-        const Font::Character* ch = font.getCharInfo(c);
-        if (ch != nullptr) {
-            float xpos = xPos + ch->bearing.x * scale;
-            float ypos = position.y - (ch->size.y - ch->bearing.y) * scale;
-
-            float w = ch->size.x * scale;
-            float h = ch->size.y * scale;
-            // update VBO for each character
-            float vertices[6][4] = {
-                { xpos,     ypos + h,   0.0f, 0.0f },
-                { xpos,     ypos,       0.0f, 1.0f },
-                { xpos + w, ypos,       1.0f, 1.0f },
-
-                { xpos,     ypos + h,   0.0f, 0.0f },
-                { xpos + w, ypos,       1.0f, 1.0f },
-                { xpos + w, ypos + h,   1.0f, 0.0f }
-            };
-            // render glyph texture over quad
-            mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, ch->textureId);
-            // update content of VBO memory
-            mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, font.getVBO());
-            mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-
-            mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0);
-            // TODO set only once?
-            mTextShader_.setMat4("uModel", glm::mat4(1));
-            // render quad
-            mGraphicsAPI_.drawArrays(IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, 0, 6);
-            // now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-            // bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64 to get amount of pixels))
-            xPos += (ch->advance >> 6) * scale;
-        }
+void Renderer::addToSpriteBatch(unsigned int textureId, const glm::mat4& modelMat, const glm::vec4& subImage, const glm::vec4& theColor) const {
+    std::vector<SpriteInstance>& instances = mSpriteBatch_[textureId];
+    if (instances.empty()) {
+        mSpriteBatchOrder_.push_back(textureId);
     }
+    instances.push_back({modelMat, subImage, theColor});
 }
 
-void Renderer::renderTextCentered(const std::string& text, const glm::vec2& position, const Font& font, float scale, const glm::vec4& color) {
-    // activate corresponding render state	
-    mTextShader_.bind();
-    mTextShader_.setVec3("textColor", color);
-    mGraphicsAPI_.activeTexture(0);
-    mGraphicsAPI_.bindVertexArray(font.getVAO());
-
-     // Calculate the total width of the text
-    float textWidth = 0;
-
-    // Calculate the total width of the text
-    float totalWidth = 0.0f;
-    for (const char& c : text) {
-        const Font::Character* ch = font.getCharInfo(c);
-        if (ch != nullptr) {
-            totalWidth += (ch->advance >> 6) * scale;
-        }
+void Renderer::setSpriteInstanceAttributes(size_t baseOffset) const {
+    // mat4 takes up 4 consecutive vec4 attribute locations
+    for (unsigned int i = 0; i < 4; ++i) {
+        mGraphicsAPI_.vertexAttribPointer(
+            3 + i, 4, IGraphicsAPI::DataType::FLOAT, false, sizeof(SpriteInstance),
+            (void*)(baseOffset + offsetof(SpriteInstance, model) + i * sizeof(glm::vec4))
+        );
     }
+    mGraphicsAPI_.vertexAttribPointer(
+        7, 4, IGraphicsAPI::DataType::FLOAT, false, sizeof(SpriteInstance),
+        (void*)(baseOffset + offsetof(SpriteInstance, subImage))
+    );
+    mGraphicsAPI_.vertexAttribPointer(
+        8, 4, IGraphicsAPI::DataType::FLOAT, false, sizeof(SpriteInstance),
+        (void*)(baseOffset + offsetof(SpriteInstance, color))
+    );
+}
 
-    float startX = position.x - totalWidth / 2.0f;
+void Renderer::renderText(const std::string& text, const glm::vec2& position, const Font& font, float scale, const glm::vec3& color) {
+    // TODO alpha color
+    layoutText(text, font, position, {scale, scale}, false);
+    drawTextVertices(font, color, glm::mat4(1));
+}
 
-    // iterate through all characters
-    for (const char& c : text) {
-        const Font::Character* ch = font.getCharInfo(c);
-        if (ch != nullptr) {
-            float xpos = startX + ch->bearing.x * scale;
-            float ypos = position.y - (ch->size.y - ch->bearing.y) * scale;
-
-            float w = ch->size.x * scale;
-            float h = ch->size.y * scale;
-            // update VBO for each character
-            float vertices[6][4] = {
-                { xpos,     ypos + h,   0.0f, 0.0f },
-                { xpos,     ypos,       0.0f, 1.0f },
-                { xpos + w, ypos,       1.0f, 1.0f },
-
-                { xpos,     ypos + h,   0.0f, 0.0f },
-                { xpos + w, ypos,       1.0f, 1.0f },
-                { xpos + w, ypos + h,   1.0f, 0.0f }
-            };
-            // render glyph texture over quad
-            mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, ch->textureId);
-            // update content of VBO memory
-            mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, font.getVBO());
-            mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-
-            mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0);
-            mTextShader_.setMat4("uModel", glm::mat4(1));
-            // render quad
-            
-            mGraphicsAPI_.drawArrays(IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, 0, 6);
-            // now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-            startX += (ch->advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64 to get amount of pixels))
-        }
-    }
-    
-    mGraphicsAPI_.bindVertexArray(0);
-    mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, 0);
+void Renderer::renderTextCentered(const std::string& text, const glm::vec2& position, const Font& font, float scale, const glm::vec4& color) {
+    layoutText(text, font, position, {scale, scale}, true);
+    drawTextVertices(font, glm::vec3(color), glm::mat4(1));
 }
 
 void Renderer::renderTextNormalized(const std::string& text, const glm::mat4& modelMat, const Font& font, const glm::vec3& scale, const glm::vec3& color) {
-    // activate corresponding render state	
-    mTextShader_.bind();
-    mTextShader_.setVec3("textColor", color);
-    mGraphicsAPI_.activeTexture(0);
-    mGraphicsAPI_.bindVertexArray(font.getVAO());
+    // Center horizontally around the origin
+    layoutText(text, font, {0.0f, 0.0f}, glm::vec2(scale), true);
+    drawTextVertices(font, color, modelMat);
+}
 
-    // Calculate the total width of the text
-    float totalWidth = 0.0f;
-    for (const char& c : text) {
-        const Font::Character* ch = font.getCharInfo(c);
-        if (ch != nullptr) {
-            totalWidth += (ch->advance >> 6) * scale.x;
+void Renderer::layoutText(const std::string& text, const Font& font, const glm::vec2& origin, const glm::vec2& scale, bool centered) {
+    // advance is number of 1/64 pixels, bitshift by 6 to get value in pixels (2^6 = 64)
+    float startX = origin.x;
+    if (centered) {
+        float totalWidth = 0.0f;
+        for (const char& c : text) {
+            const Font::Character* ch = font.getCharInfo(c);
+            if (ch != nullptr) {
+                totalWidth += (ch->advance >> 6) * scale.x;
+            }
         }
+        startX -= totalWidth / 2.0f;
     }
 
-    float startX = -totalWidth / 2.0f; // Center horizontally around the origin
+    mTextVertices_.reserve(mTextVertices_.size() + text.size() * 6);
 
-    // iterate through all characters
     for (const char& c : text) {
         const Font::Character* ch = font.getCharInfo(c);
-
         if (ch != nullptr) {
             float xpos = startX + ch->bearing.x * scale.x;
-            float ypos = - (ch->size.y - ch->bearing.y) * scale.y; // Adjust for Y-axis to center vertically around the origin
+            float ypos = origin.y - (ch->size.y - ch->bearing.y) * scale.y;
 
             float w = ch->size.x * scale.x;
             float h = ch->size.y * scale.y;
-            // update VBO for each character
-            float vertices[6][4] = {
-                { xpos,     ypos + h,   0.0f, 0.0f },
-                { xpos,     ypos,       0.0f, 1.0f },
-                { xpos + w, ypos,       1.0f, 1.0f },
-
-                { xpos,     ypos + h,   0.0f, 0.0f },
-                { xpos + w, ypos,       1.0f, 1.0f },
-                { xpos + w, ypos + h,   1.0f, 0.0f }
-            };
-            // render glyph texture over quad
-            mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, ch->textureId);
-            // update content of VBO memory
-            mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, font.getVBO());
-            mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-
-            mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0);
-            // Apply the model matrix to the shader
-            mTextShader_.setMat4("uModel", modelMat);
-
-            // render quad
-            mGraphicsAPI_.drawArrays(IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, 0, 6);
-            // now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-            startX += (ch->advance >> 6) * scale.x; // bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64 to get amount of pixels))
+
+            const glm::vec2& uv0 = ch->uvTopLeft;
+            const glm::vec2& uv1 = ch->uvBottomRight;
+
+            mTextVertices_.push_back({xpos,     ypos + h, uv0.x, uv0.y});
+            mTextVertices_.push_back({xpos,     ypos,     uv0.x, uv1.y});
+            mTextVertices_.push_back({xpos + w, ypos,     uv1.x, uv1.y});
+
+            mTextVertices_.push_back({xpos,     ypos + h, uv0.x, uv0.y});
+            mTextVertices_.push_back({xpos + w, ypos,     uv1.x, uv1.y});
+            mTextVertices_.push_back({xpos + w, ypos + h, uv1.x, uv0.y});
+
+            startX += (ch->advance >> 6) * scale.x;
         }
     }
+}
+
+void Renderer::drawTextVertices(const Font& font, const glm::vec3& color, const glm::mat4& modelMat) {
+    if (mTextVertices_.empty()) {
+        return;
+    }
+
+    const DynamicRingBuffer::Allocation vertexData = mStreamBuffer_.upload(
+        mTextVertices_.data(), mTextVertices_.size() * sizeof(glm::vec4)
+    );
+
+    // activate corresponding render state
+    mTextShader_.bind();
+    mTextShader_.setUniform(mTextUniforms_.textColor, color);
+    mTextShader_.setUniform(mTextUniforms_.model, modelMat);
+    mGraphicsAPI_.activeTexture(0);
+    mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, font.getAtlasTextureId());
+    mGraphicsAPI_.bindSampler(0, 0);
+    mGraphicsAPI_.bindVertexArray(mTextVAO_);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, vertexData.buffer);
+    mGraphicsAPI_.vertexAttribPointer(0, 4, IGraphicsAPI::DataType::FLOAT, false, 4 * sizeof(float), (void*)vertexData.offset);
+
+    // render all glyph quads at once
+    mGraphicsAPI_.drawArrays(IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, 0, static_cast<unsigned int>(mTextVertices_.size()));
+
     mGraphicsAPI_.bindVertexArray(0);
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0);
     mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, 0);
+    mTextVertices_.clear();
 }
 
 void Renderer::renderRectangleSimple(const glm::mat4& modelMat, const glm::vec4& theColor) const {
-    // TODO fix this
-    mMVPShader_.bind();
-    mMVPShader_.setMat4("uModel", modelMat);
-    mMVPShader_.setVec4("uColor", theColor);
-    mGraphicsAPI_.bindVertexArray(mRectVAO_);
-    mGraphicsAPI_.drawArrays(IGraphicsAPI::PrimitiveTopology::LINE_LOOP, 0, 4);
-    mGraphicsAPI_.bindVertexArray(0);
+    mDebugDraw_.addRect(modelMat, theColor);
 }
 
 void Renderer::renderLineSimple(const glm::vec3& startPoint, const glm::vec3& endPoint, const glm::mat4& modelMat, const glm::vec4& theColor) const {
-    // TODO fix this
-    // Update vertices
-    float vertices[] = {
-        startPoint.x, startPoint.y, startPoint.z,
-        endPoint.x, endPoint.y, endPoint.z
-    };
-
-    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, mLineVBO_);
-    mGraphicsAPI_.bufferSubData(IGraphicsAPI::BufferTarget::ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-
-    // draw line
-    mMVPShader_.bind();
-    mMVPShader_.setMat4("uModel", modelMat);
-    mMVPShader_.setVec4("uColor", theColor);
+    mDebugDraw_.addLine(
+        glm::vec3(modelMat * glm::vec4(startPoint, 1.0f)),
+        glm::vec3(modelMat * glm::vec4(endPoint, 1.0f)),
+        theColor
+    );
+}
 
-    mGraphicsAPI_.bindVertexArray(mLineVAO_);
-    mGraphicsAPI_.drawArrays(IGraphicsAPI::PrimitiveTopology::LINE_LIST, 0, 2);
+DebugDraw& Renderer::getDebugDraw() const {
+    return mDebugDraw_;
+}
 
-    mGraphicsAPI_.bindVertexArray(0);
+void Renderer::flushDebugDraw() {
+    mDebugDraw_.flush(mScreenDim_);
 }
 
 unsigned int Renderer::getHDRFBO() const {
@@ -507,53 +638,85 @@ unsigned int Renderer::getHDRFBO() const {
 }
 
 void Renderer::renderHDR() {
-    mBlurShader_.bind();  // Use the shader to render the quad
-    mBlurShader_.setInt("image", 0); // Texture unit 0
     mGraphicsAPI_.bindVertexArray(mFrameVAO_);
 
-    // blur with ping pong
-    bool horizontal = true, first_iteration = true;
-    const int blurAmount = 10;
-    mGraphicsAPI_.activeTexture(0);
-
-    for (int i = 0; i < blurAmount; ++i) {
-        mGraphicsAPI_.bindFrameBuffer(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, pingpongFBO_[horizontal]);
-        mBlurShader_.setInt("horizontal", horizontal);
-        mGraphicsAPI_.bindTexture(
-            IGraphicsAPI::TextureTarget::TEXTURE_2D,
-            first_iteration ? colorBuffers_[1] : pingpongColorbuffers_[!horizontal]
-        ); // bind texture of other framebuffer (or scene if first iteration)
-        mGraphicsAPI_.drawElements(IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, 6, IGraphicsAPI::DataType::UINT, 0);
-
-        horizontal = !horizontal;
-        if (first_iteration) {
-            first_iteration = false;
-        }
+    // Nothing is written to the bright buffer without bloom so there is nothing to blur
+    const bool bloom = mBloomEnabled_ && !mBloomMips_.empty();
+    if (bloom) {
+        renderBloom();
     }
+
     mGraphicsAPI_.bindFrameBuffer(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, 0);
     // clear the default buffer
     mGraphicsAPI_.clearColor(0.0f, 0.0f, 0.0f, 1.0f);
     mGraphicsAPI_.clearBuffers({IGraphicsAPI::ClearBufferTarget::COLOR, IGraphicsAPI::ClearBufferTarget::DEPTH});
-    bool bloom = true;
 
     mBloomFinalShader_.bind();
-    mBloomFinalShader_.setInt("scene", 0);
-    mBloomFinalShader_.setInt("bloomBlur", 1);
-    mBloomFinalShader_.setInt("uGammaCorrect", mGammaCorrect_);
+    mBloomFinalShader_.setUniform(mBloomFinalUniforms_.scene, 0);
+    mBloomFinalShader_.setUniform(mBloomFinalUniforms_.bloomBlur, 1);
+    mBloomFinalShader_.setUniform(mBloomFinalUniforms_.gammaCorrect, mGammaCorrect_);
 
     mGraphicsAPI_.activeTexture(0);
     mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, colorBuffers_[0]);
-    mGraphicsAPI_.activeTexture(1);
-    mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, pingpongColorbuffers_[!horizontal]);
-    mBloomFinalShader_.setInt("bloom", bloom);
-    mBloomFinalShader_.setFloat("exposure", mExposure_);
+    mGraphicsAPI_.bindSampler(0, 0);
+    if (bloom) {
+        mGraphicsAPI_.activeTexture(1);
+        mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, mBloomMips_[0].texture);
+        mGraphicsAPI_.bindSampler(1, 0);
+    }
+    mBloomFinalShader_.setUniform(mBloomFinalUniforms_.bloom, bloom);
+    mBloomFinalShader_.setUniform(mBloomFinalUniforms_.exposure, mExposure_);
     mGraphicsAPI_.drawElements(IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, 6, IGraphicsAPI::DataType::UINT, 0);
 
     mGraphicsAPI_.bindFrameBuffer(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, 0);
     mGraphicsAPI_.bindVertexArray(0);
 }
 
+void Renderer::endFrame() {
+    // Shapes added after the last flush still belong to this frame
+    flushDebugDraw();
+    mStreamBuffer_.endFrame();
+    // The camera range of the finished frame will be overwritten, carry the camera over to the new frame
+    uploadCameraData();
+}
+
+void Renderer::renderBloom() {
+    int viewport[4];
+    mGraphicsAPI_.getViewport(viewport);
+    mGraphicsAPI_.bindFrameBuffer(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, mBloomFBO_);
+    mGraphicsAPI_.activeTexture(0);
+    mGraphicsAPI_.bindSampler(0, 0);
+
+    // Downsample the bright buffer into each mip from the previous, larger one
+    mBloomDownsampleShader_.bind();
+    mBloomDownsampleShader_.setUniform(mBloomDownsampleUniforms_.source, 0);
+    unsigned int source = colorBuffers_[1];
+    for (const BloomMip& mip : mBloomMips_) {
+        mGraphicsAPI_.viewport(0, 0, mip.size.x, mip.size.y);
+        mGraphicsAPI_.framebufferTexture2D(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, 0, IGraphicsAPI::FBOTextureTarget::TEXTURE_2D, mip.texture, 0);
+        mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, source);
+        mGraphicsAPI_.drawElements(IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, 6, IGraphicsAPI::DataType::UINT, 0);
+        source = mip.texture;
+    }
+
+    // Upsample each mip and add it onto the next larger one so mip 0 ends with the blur of all of them
+    mBloomUpsampleShader_.bind();
+    mBloomUpsampleShader_.setUniform(mBloomUpsampleUniforms_.source, 0);
+    mBloomUpsampleShader_.setUniform(mBloomUpsampleUniforms_.filterRadius, mBloomRadius_);
+    mGraphicsAPI_.blendFunc(IGraphicsAPI::BlendFactor::ONE, IGraphicsAPI::BlendFactor::ONE);
+    for (size_t i = mBloomMips_.size() - 1; i > 0; --i) {
+        const BloomMip& target = mBloomMips_[i - 1];
+        mGraphicsAPI_.viewport(0, 0, target.size.x, target.size.y);
+        mGraphicsAPI_.framebufferTexture2D(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, 0, IGraphicsAPI::FBOTextureTarget::TEXTURE_2D, target.texture, 0);
+        mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, mBloomMips_[i].texture);
+        mGraphicsAPI_.drawElements(IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, 6, IGraphicsAPI::DataType::UINT, 0);
+    }
+    mGraphicsAPI_.blendFunc(IGraphicsAPI::BlendFactor::SRC_ALPHA, IGraphicsAPI::BlendFactor::ONE_MINUS_SRC_ALPHA);
+    mGraphicsAPI_.viewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
 void Renderer::setBloom(bool enable) {
+    mBloomEnabled_ = enable;
     if (enable) {
         mGraphicsAPI_.bindFrameBuffer(IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER, getHDRFBO());
         mGraphicsAPI_.drawBuffers(2, mAttachments_);
@@ -563,6 +726,18 @@ void Renderer::setBloom(bool enable) {
     }
 }
 
+bool Renderer::isBloomEnabled() const {
+    return mBloomEnabled_;
+}
+
+void Renderer::setBloomRadius(float radius) {
+    mBloomRadius_ = radius;
+}
+
+float Renderer::getBloomRadius() const {
+    return mBloomRadius_;
+}
+
 void Renderer::setExposure(float newExposure) {
     mExposure_ = newExposure;
 }
@@ -0,0 +1,106 @@
+// standard lib
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+// class
+#include "clay/graphics/common/Sampler.h"
+
+namespace clay {
+
+namespace {
+    /** Sampler shared by the textures of one state */
+    struct SamplerEntry {
+        IGraphicsAPI* graphicsAPI;
+        SamplerState state;
+        std::weak_ptr<const Sampler> sampler;
+    };
+}
+
+SamplerState SamplerState::trilinear(float maxAnisotropy) {
+    SamplerState state;
+    state.filter = Filter::TRILINEAR;
+    state.wrapS = IGraphicsAPI::TextureParameterOption::REPEAT;
+    state.wrapT = IGraphicsAPI::TextureParameterOption::REPEAT;
+    state.maxAnisotropy = maxAnisotropy;
+    return state;
+}
+
+bool SamplerState::usesMipmaps() const {
+    return filter == Filter::BILINEAR || filter == Filter::TRILINEAR;
+}
+
+bool SamplerState::operator==(const SamplerState& other) const {
+    return filter == other.filter &&
+        wrapS == other.wrapS &&
+        wrapT == other.wrapT &&
+        maxAnisotropy == other.maxAnisotropy;
+}
+
+std::shared_ptr<const Sampler> Sampler::acquire(IGraphicsAPI& graphicsAPI, const SamplerState& state) {
+    static std::vector<SamplerEntry> samplers;
+
+    for (SamplerEntry& entry : samplers) {
+        if (entry.graphicsAPI == &graphicsAPI && entry.state == state) {
+            if (std::shared_ptr<const Sampler> sampler = entry.sampler.lock()) {
+                return sampler;
+            }
+            std::shared_ptr<const Sampler> sampler = std::make_shared<const Sampler>(graphicsAPI, state);
+            entry.sampler = sampler;
+            return sampler;
+        }
+    }
+    std::shared_ptr<const Sampler> sampler = std::make_shared<const Sampler>(graphicsAPI, state);
+    samplers.push_back({&graphicsAPI, state, sampler});
+    return sampler;
+}
+
+Sampler::Sampler(IGraphicsAPI& graphicsAPI, const SamplerState& state)
+    : mGraphicsAPI_(graphicsAPI),
+    mState_(state) {
+    mGraphicsAPI_.genSamplers(1, &mSamplerId_);
+    mGraphicsAPI_.samplerParameter(mSamplerId_, IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_S, state.wrapS);
+    mGraphicsAPI_.samplerParameter(mSamplerId_, IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_T, state.wrapT);
+    mGraphicsAPI_.samplerParameter(mSamplerId_, IGraphicsAPI::TextureParameterType::TEXTURE_MIN_FILTER, getMinFilter(state));
+    mGraphicsAPI_.samplerParameter(mSamplerId_, IGraphicsAPI::TextureParameterType::TEXTURE_MAG_FILTER, getMagFilter(state));
+
+    const float maxAnisotropy = std::min(state.maxAnisotropy, mGraphicsAPI_.getMaxAnisotropy());
+    if (maxAnisotropy > 1.0f) {
+        mGraphicsAPI_.samplerParameterf(mSamplerId_, IGraphicsAPI::TextureParameterType::TEXTURE_MAX_ANISOTROPY, maxAnisotropy);
+    }
+}
+
+Sampler::~Sampler() {
+    mGraphicsAPI_.deleteSamplers(1, &mSamplerId_);
+}
+
+unsigned int Sampler::getId() const {
+    return mSamplerId_;
+}
+
+const SamplerState& Sampler::getState() const {
+    return mState_;
+}
+
+IGraphicsAPI::TextureParameterOption Sampler::getMinFilter(const SamplerState& state) {
+    switch (state.filter) {
+        case SamplerState::Filter::NEAREST:
+            return IGraphicsAPI::TextureParameterOption::NEAREST;
+        case SamplerState::Filter::LINEAR:
+            return IGraphicsAPI::TextureParameterOption::LINEAR;
+        case SamplerState::Filter::BILINEAR:
+            return IGraphicsAPI::TextureParameterOption::LINEAR_MIPMAP_NEAREST;
+        case SamplerState::Filter::TRILINEAR:
+            return IGraphicsAPI::TextureParameterOption::LINEAR_MIPMAP_LINEAR;
+        default:
+            throw std::runtime_error("Invalid Sampler filter");
+    }
+}
+
+IGraphicsAPI::TextureParameterOption Sampler::getMagFilter(const SamplerState& state) {
+    // Magnification never reads mips
+    return state.filter == SamplerState::Filter::NEAREST
+        ? IGraphicsAPI::TextureParameterOption::NEAREST
+        : IGraphicsAPI::TextureParameterOption::LINEAR;
+}
+
+} // namespace clay
@@ -1,6 +1,10 @@
+// standard lib
+#include <cstring>
+#include <utility>
 // class
 #include "clay/graphics/common/ShaderProgram.h"
 // project
+#include "clay/graphics/common/LightClusters.h"
 #include "clay/utils/common/Logger.h"
 
 
@@ -38,6 +42,40 @@ void ShaderProgram::linkProgram() {
     // Bind the LightBuffer UBO
     const unsigned int lightBlockIndex = mGraphicsAPI_.getUniformBlockIndex(mProgramId_, "LightBuffer");
     mGraphicsAPI_.uniformBlockBinding(mProgramId_, lightBlockIndex, 1);
+
+    // Reflect the active uniforms
+    mUniforms_.clear();
+    mUniformIndexByName_.clear();
+    const int uniformCount = mGraphicsAPI_.getActiveUniformCount(mProgramId_);
+    for (int i = 0; i < uniformCount; ++i) {
+        const std::string name = mGraphicsAPI_.getActiveUniformName(mProgramId_, i);
+        const int location = static_cast<int>(mGraphicsAPI_.getUniformLocation(mProgramId_, name));
+        if (location < 0) {
+            // Uniform block member, set through its buffer
+            continue;
+        }
+        const int index = static_cast<int>(mUniforms_.size());
+        mUniforms_.push_back({location, {}, false});
+        mUniformIndexByName_[name] = index;
+        // Arrays are reported as "name[0]", also allow addressing them by "name"
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+            mUniformIndexByName_[name.substr(0, name.size() - 3)] = index;
+        }
+    }
+
+    // Point the clustered lighting samplers at the units the Renderer binds the light buffers to
+    const std::pair<const char*, unsigned int> lightSamplers[] = {
+        {"uLightData", LightClusters::LIGHT_DATA_TEXTURE_UNIT},
+        {"uLightClusters", LightClusters::CLUSTER_TEXTURE_UNIT},
+        {"uLightIndices", LightClusters::LIGHT_INDEX_TEXTURE_UNIT}
+    };
+    for (const auto& [samplerName, textureUnit] : lightSamplers) {
+        auto it = mUniformIndexByName_.find(samplerName);
+        if (it != mUniformIndexByName_.end()) {
+            bind();
+            setUniform(Uniform<int>{it->second}, static_cast<int>(textureUnit));
+        }
+    }
 }
 
 void ShaderProgram::bind() const {
@@ -53,56 +91,161 @@ bool ShaderProgram::checkCompileErrors(unsigned int shaderID, ShaderCreateInfo::
     return true;
 }
 
+template<typename T>
+ShaderProgram::Uniform<T> ShaderProgram::getUniform(const std::string& name) const {
+    return {getUniformIndex(name)};
+}
+
+void ShaderProgram::setUniform(Uniform<bool> uniform, bool value) const {
+    const int intValue = static_cast<int>(value);
+    if (updateShadow(uniform.index, &intValue, sizeof(intValue))) {
+        mGraphicsAPI_.uniform1i(mUniforms_[uniform.index].location, intValue);
+    }
+}
+void ShaderProgram::setUniform(Uniform<int> uniform, int value) const {
+    if (updateShadow(uniform.index, &value, sizeof(value))) {
+        mGraphicsAPI_.uniform1i(mUniforms_[uniform.index].location, value);
+    }
+}
+void ShaderProgram::setUniform(Uniform<float> uniform, float value) const {
+    if (updateShadow(uniform.index, &value, sizeof(value))) {
+        mGraphicsAPI_.uniform1f(mUniforms_[uniform.index].location, value);
+    }
+}
+// ------------------------------------------------------------------------
+void ShaderProgram::setUniform(Uniform<glm::vec2> uniform, const glm::vec2& value) const {
+    if (updateShadow(uniform.index, glm::value_ptr(value), sizeof(value))) {
+        mGraphicsAPI_.uniform2fv(mUniforms_[uniform.index].location, glm::value_ptr(value));
+    }
+}
+void ShaderProgram::setUniform(Uniform<glm::vec3> uniform, const glm::vec3& value) const {
+    if (updateShadow(uniform.index, glm::value_ptr(value), sizeof(value))) {
+        mGraphicsAPI_.uniform3fv(mUniforms_[uniform.index].location, glm::value_ptr(value));
+    }
+}
+void ShaderProgram::setUniform(Uniform<glm::vec4> uniform, const glm::vec4& value) const {
+    if (updateShadow(uniform.index, glm::value_ptr(value), sizeof(value))) {
+        mGraphicsAPI_.uniform4fv(mUniforms_[uniform.index].location, glm::value_ptr(value));
+    }
+}
+// ------------------------------------------------------------------------
+void ShaderProgram::setUniform(Uniform<glm::mat2> uniform, const glm::mat2& mat) const {
+    if (updateShadow(uniform.index, glm::value_ptr(mat), sizeof(mat))) {
+        mGraphicsAPI_.uniformMatrix2fv(mUniforms_[uniform.index].location, glm::value_ptr(mat));
+    }
+}
+void ShaderProgram::setUniform(Uniform<glm::mat3> uniform, const glm::mat3& mat) const {
+    if (updateShadow(uniform.index, glm::value_ptr(mat), sizeof(mat))) {
+        mGraphicsAPI_.uniformMatrix3fv(mUniforms_[uniform.index].location, glm::value_ptr(mat));
+    }
+}
+void ShaderProgram::setUniform(Uniform<glm::mat4> uniform, const glm::mat4& mat) const {
+    if (updateShadow(uniform.index, glm::value_ptr(mat), sizeof(mat))) {
+        mGraphicsAPI_.uniformMatrix4fv(mUniforms_[uniform.index].location, glm::value_ptr(mat));
+    }
+}
+
+void ShaderProgram::setTexture(Uniform<int> uniform, unsigned int textureId, unsigned int textureUnit, unsigned int samplerId) const {
+    mGraphicsAPI_.activeTexture(textureUnit);
+    mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, textureId);
+    mGraphicsAPI_.bindSampler(textureUnit, samplerId);
+    setUniform(uniform, static_cast<int>(textureUnit));
+}
+
 // utility uniform functions
 void ShaderProgram::setBool(const std::string& name, bool value) const {
-    mGraphicsAPI_.uniform1i(mGraphicsAPI_.getUniformLocation(mProgramId_, name), (int)value);
+    setUniform(Uniform<bool>{getUniformIndex(name)}, value);
 }
 void ShaderProgram::setInt(const std::string& name, int value) const {
-    mGraphicsAPI_.uniform1i(mGraphicsAPI_.getUniformLocation(mProgramId_, name), value);
+    setUniform(Uniform<int>{getUniformIndex(name)}, value);
 }
 void ShaderProgram::setFloat(const std::string& name, float value) const {
-    mGraphicsAPI_.uniform1f(mGraphicsAPI_.getUniformLocation(mProgramId_, name), value);
+    setUniform(Uniform<float>{getUniformIndex(name)}, value);
 }
 // ------------------------------------------------------------------------
 void ShaderProgram::setVec2(const std::string& name, const glm::vec2& value) const {
-    mGraphicsAPI_.uniform2fv(mGraphicsAPI_.getUniformLocation(mProgramId_, name), glm::value_ptr(value));
+    setUniform(Uniform<glm::vec2>{getUniformIndex(name)}, value);
 }
 void ShaderProgram::setVec2(const std::string& name, float x, float y) const {
-    mGraphicsAPI_.uniform2f(mGraphicsAPI_.getUniformLocation(mProgramId_, name), x, y);
+    setUniform(Uniform<glm::vec2>{getUniformIndex(name)}, glm::vec2(x, y));
 }
 void ShaderProgram::setVec3(const std::string& name, const glm::vec3& value) const {
-    mGraphicsAPI_.uniform3fv(mGraphicsAPI_.getUniformLocation(mProgramId_, name), glm::value_ptr(value));
+    setUniform(Uniform<glm::vec3>{getUniformIndex(name)}, value);
 }
 void ShaderProgram::setVec3(const std::string& name, float x, float y, float z) const {
-    mGraphicsAPI_.uniform3f(mGraphicsAPI_.getUniformLocation(mProgramId_, name), x, y, z);
+    setUniform(Uniform<glm::vec3>{getUniformIndex(name)}, glm::vec3(x, y, z));
 }
 void ShaderProgram::setVec4(const std::string& name, const glm::vec4& value) const {
-    mGraphicsAPI_.uniform4fv(mGraphicsAPI_.getUniformLocation(mProgramId_, name), glm::value_ptr(value));
+    setUniform(Uniform<glm::vec4>{getUniformIndex(name)}, value);
 }
 void ShaderProgram::setVec4(const std::string& name, float x, float y, float z, float w) const {
-    mGraphicsAPI_.uniform4f(mGraphicsAPI_.getUniformLocation(mProgramId_, name), x, y, z, w);
+    setUniform(Uniform<glm::vec4>{getUniformIndex(name)}, glm::vec4(x, y, z, w));
 }
 // ------------------------------------------------------------------------
 void ShaderProgram::setMat2(const std::string& name, const glm::mat2& mat) const {
-    mGraphicsAPI_.uniformMatrix2fv(mGraphicsAPI_.getUniformLocation(mProgramId_, name), glm::value_ptr(mat));
+    setUniform(Uniform<glm::mat2>{getUniformIndex(name)}, mat);
 }
 // ------------------------------------------------------------------------
 void ShaderProgram::setMat3(const std::string& name, const glm::mat3& mat) const {
-    mGraphicsAPI_.uniformMatrix3fv(mGraphicsAPI_.getUniformLocation(mProgramId_, name), glm::value_ptr(mat));
+    setUniform(Uniform<glm::mat3>{getUniformIndex(name)}, mat);
 }
 void ShaderProgram::setMat4(const std::string& name, const glm::mat4& mat) const {
-    mGraphicsAPI_.uniformMatrix4fv(mGraphicsAPI_.getUniformLocation(mProgramId_, name), glm::value_ptr(mat));
+    setUniform(Uniform<glm::mat4>{getUniformIndex(name)}, mat);
 }
 
-void ShaderProgram::setTexture(const std::string& uniformName, unsigned int textureId, unsigned int textureUnit) const {
-    mGraphicsAPI_.activeTexture(textureUnit);
-    mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, textureId);
-    setInt(uniformName, textureUnit);
+void ShaderProgram::setTexture(const std::string& uniformName, unsigned int textureId, unsigned int textureUnit, unsigned int samplerId) const {
+    setTexture(Uniform<int>{getUniformIndex(uniformName)}, textureId, textureUnit, samplerId);
+}
+
+int ShaderProgram::getUniformIndex(const std::string& name) const {
+    auto it = mUniformIndexByName_.find(name);
+    if (it != mUniformIndexByName_.end()) {
+        return it->second;
+    }
+    // Not reflected (array element or inactive). Resolve once and remember the result
+    const int index = static_cast<int>(mUniforms_.size());
+    mUniforms_.push_back({static_cast<int>(mGraphicsAPI_.getUniformLocation(mProgramId_, name)), {}, false});
+    mUniformIndexByName_[name] = index;
+    return index;
+}
+
+bool ShaderProgram::updateShadow(int index, const void* value, size_t size) const {
+    if (index < 0 || index >= static_cast<int>(mUniforms_.size())) {
+        return false;
+    }
+    UniformSlot& slot = mUniforms_[index];
+    if (slot.location < 0) {
+        return false;
+    }
+    if (slot.shadowValid && std::memcmp(slot.shadowValue.data(), value, size) == 0) {
+        return false;
+    }
+    std::memcpy(slot.shadowValue.data(), value, size);
+    slot.shadowValid = true;
+    return true;
 }
 
 unsigned int ShaderProgram::getProgramId() const {
     return mProgramId_;
 }
 
+void ShaderProgram::setInstancedVariant(const ShaderProgram* variant) {
+    mpInstancedVariant_ = variant;
+}
+
+const ShaderProgram* ShaderProgram::getInstancedVariant() const {
+    return mpInstancedVariant_;
+}
+
+template ShaderProgram::Uniform<bool> ShaderProgram::getUniform(const std::string& name) const;
+template ShaderProgram::Uniform<int> ShaderProgram::getUniform(const std::string& name) const;
+template ShaderProgram::Uniform<float> ShaderProgram::getUniform(const std::string& name) const;
+template ShaderProgram::Uniform<glm::vec2> ShaderProgram::getUniform(const std::string& name) const;
+template ShaderProgram::Uniform<glm::vec3> ShaderProgram::getUniform(const std::string& name) const;
+template ShaderProgram::Uniform<glm::vec4> ShaderProgram::getUniform(const std::string& name) const;
+template ShaderProgram::Uniform<glm::mat2> ShaderProgram::getUniform(const std::string& name) const;
+template ShaderProgram::Uniform<glm::mat3> ShaderProgram::getUniform(const std::string& name) const;
+template ShaderProgram::Uniform<glm::mat4> ShaderProgram::getUniform(const std::string& name) const;
+
 
 } // namespace clay
\ No newline at end of file
@@ -1,3 +1,5 @@
+// project
+#include "clay/utils/common/Logger.h"
 // class
 #include "clay/graphics/common/SpriteSheet.h"
 
@@ -9,19 +11,36 @@ SpriteSheet::Sprite::Sprite(SpriteSheet& theSpriteSheet, const glm::ivec2& theGr
 SpriteSheet::Sprite::Sprite(SpriteSheet& theSpriteSheet, const glm::ivec2& theGridIndex)
     : parentSpriteSheet(theSpriteSheet), gridIndex(theGridIndex), spriteSize(parentSpriteSheet.getDefaultSpriteSize()) {}
 
+SpriteSheet::Sprite::Sprite(SpriteSheet& theSpriteSheet, const std::string& theRegionName)
+    : parentSpriteSheet(theSpriteSheet), gridIndex(0, 0), spriteSize(0, 0), regionName(theRegionName) {
+    if (const TextureAtlas::Region* region = parentSpriteSheet.mpAtlas_ ? parentSpriteSheet.mpAtlas_->getRegion(regionName) : nullptr) {
+        spriteSize = region->size;
+    }
+}
+
 SpriteSheet::SpriteSheet(unsigned int textureId, const glm::ivec2& sheetSize, const glm::ivec2& defaultSpiteSize)
     : mTextureId_(textureId), mSheetSize_(sheetSize), mDefaultSpriteSize_(defaultSpiteSize) {}
 
 SpriteSheet::SpriteSheet(const Texture& texture, const glm::ivec2& defaultSpiteSize)
     : mTextureId_(texture.getId()), mSheetSize_(texture.getShape()), mDefaultSpriteSize_(defaultSpiteSize) {}
 
+SpriteSheet::SpriteSheet(const TextureAtlas& atlas)
+    : mpAtlas_(&atlas), mTextureId_(0), mSheetSize_(atlas.getSize()), mDefaultSpriteSize_(0, 0) {}
+
 SpriteSheet::~SpriteSheet() {}
 
 unsigned int SpriteSheet::getTextureId() const {
+    // The atlas texture is replaced when the atlas grows
+    if (mpAtlas_ != nullptr) {
+        return mpAtlas_->getTexture().getId();
+    }
     return mTextureId_;
 }
 
 glm::ivec2 SpriteSheet::getSheetSize() const {
+    if (mpAtlas_ != nullptr) {
+        return mpAtlas_->getSize();
+    }
     return mSheetSize_;
 }
 
@@ -29,4 +48,21 @@ glm::ivec2 SpriteSheet::getDefaultSpriteSize() const {
     return mDefaultSpriteSize_;
 }
 
+glm::vec4 SpriteSheet::getSubImage(const Sprite& sprite) const {
+    if (mpAtlas_ != nullptr) {
+        if (const TextureAtlas::Region* region = mpAtlas_->getRegion(sprite.regionName)) {
+            return region->uvRect;
+        }
+        LOG_W("Sprite %s is not in the atlas", sprite.regionName.c_str());
+        return glm::vec4(0.0f);
+    }
+    const glm::vec2 sheetSize = mSheetSize_;
+    return {
+        (sprite.gridIndex.x * sprite.spriteSize.x) / sheetSize.x,
+        (sprite.gridIndex.y * sprite.spriteSize.y) / sheetSize.y,
+        sprite.spriteSize.x / sheetSize.x,
+        sprite.spriteSize.y / sheetSize.y
+    };
+}
+
 } // namespace clay
\ No newline at end of file
@@ -1,4 +1,7 @@
 // standard lib
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <vector>
 // third party
 // project
@@ -8,20 +11,40 @@
 
 namespace clay {
 
+Texture::CreateInfo Texture::CreateInfo::mipmapped(bool gammaCorrect) {
+    CreateInfo createInfo;
+    createInfo.gammaCorrect = gammaCorrect;
+    createInfo.mipmaps = MipmapMode::GPU;
+    createInfo.sampler = SamplerState::trilinear();
+    return createInfo;
+}
+
 Texture::Texture(IGraphicsAPI& graphicsAPI, const unsigned char* textureData, int width, int height, int channels, bool gammaCorrect) 
+: Texture(graphicsAPI, textureData, width, height, channels, CreateInfo{gammaCorrect}) {}
+
+Texture::Texture(IGraphicsAPI& graphicsAPI, utils::ImageData& imageData, bool gammaCorrect)
+: Texture(graphicsAPI, imageData.pixels, imageData.width, imageData.height, imageData.channels, CreateInfo{gammaCorrect}) {}
+
+Texture::Texture(IGraphicsAPI& graphicsAPI, const unsigned char* textureData, int width, int height, int channels, const CreateInfo& createInfo)
 : mGraphicsAPI_(graphicsAPI) {
     mWidth_ = width;
     mHeight_ = height;
     mChannels_ = channels;
-    mTextureId_ = genGLTexture(graphicsAPI, textureData, width, height, channels, gammaCorrect);
+    mTextureId_ = genGLTexture(graphicsAPI, textureData, width, height, channels, createInfo, mMipLevels_);
+    mSampler_ = Sampler::acquire(graphicsAPI, createInfo.sampler);
 }
 
-Texture::Texture(IGraphicsAPI& graphicsAPI, utils::ImageData& imageData, bool gammaCorrect)
+Texture::Texture(IGraphicsAPI& graphicsAPI, utils::ImageData& imageData, const CreateInfo& createInfo)
+: Texture(graphicsAPI, imageData.pixels, imageData.width, imageData.height, imageData.channels, createInfo) {}
+
+Texture::Texture(IGraphicsAPI& graphicsAPI, const CompressedImage& image, const SamplerState& sampler, const std::vector<std::vector<unsigned char>>& decodedLevels)
 : mGraphicsAPI_(graphicsAPI) {
-    mWidth_ = imageData.width;
-    mHeight_ = imageData.height;
-    mChannels_ = imageData.channels;
-    mTextureId_ = genGLTexture(graphicsAPI, imageData.pixels, imageData.width, imageData.height, imageData.channels, gammaCorrect);
+    mWidth_ = image.getWidth();
+    mHeight_ = image.getHeight();
+    mChannels_ = 4;
+    mMipLevels_ = static_cast<unsigned int>(image.getLevels().size());
+    mTextureId_ = genGLCompressedTexture(graphicsAPI, image, sampler, decodedLevels, mCompressed_);
+    mSampler_ = Sampler::acquire(graphicsAPI, sampler);
 }
 
 Texture::~Texture() {
@@ -49,6 +72,22 @@ glm::ivec2 Texture::getShape() const {
     return {mWidth_, mHeight_};
 }
 
+unsigned int Texture::getMipLevels() const {
+    return mMipLevels_;
+}
+
+unsigned int Texture::getSamplerId() const {
+    // Mip filters read levels that do not exist without a full mip chain
+    if (mMipLevels_ < getMipLevelCount(mWidth_, mHeight_) && mSampler_->getState().usesMipmaps()) {
+        return 0;
+    }
+    return mSampler_->getId();
+}
+
+bool Texture::isCompressed() const {
+    return mCompressed_;
+}
+
 std::vector<unsigned char> Texture::getPixelData() {
     mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D , mTextureId_);
     size_t dataSize = mWidth_ * mHeight_ * mChannels_;
@@ -66,7 +105,7 @@ std::vector<unsigned char> Texture::getPixelData() {
     return pixels;
 }
 
-unsigned int Texture::genGLTexture(IGraphicsAPI& graphicsAPI, const unsigned char* textureData, int width, int height, int channels, bool gammaCorrect) {
+unsigned int Texture::genGLTexture(IGraphicsAPI& graphicsAPI, const unsigned char* textureData, int width, int height, int channels, const CreateInfo& createInfo, unsigned int& outMipLevels) {
     unsigned int textureId;
 
     if (textureData == nullptr) {
@@ -74,34 +113,102 @@ unsigned int Texture::genGLTexture(IGraphicsAPI& graphicsAPI, const unsigned cha
         throw std::runtime_error("Texture build failed");
     }
 
+    // Use GL_SRGB or GL_SRGB_ALPHA for gamma correction
+    // TODO always use RGBA for internal?
+    const IGraphicsAPI::TextureFormat format = (channels == 3) ? IGraphicsAPI::TextureFormat::RGB : IGraphicsAPI::TextureFormat::RGBA;
+    IGraphicsAPI::TextureFormat internalFormat = format;
+    if (createInfo.gammaCorrect) {
+        internalFormat = (channels == 3) ? IGraphicsAPI::TextureFormat::SRGB : IGraphicsAPI::TextureFormat::SRGB_ALPHA;
+    }
+    outMipLevels = createInfo.mipmaps == MipmapMode::NONE ? 1 : getMipLevelCount(width, height);
+
     // create textures
     graphicsAPI.genTextures(1, &textureId);
     graphicsAPI.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, textureId);
-    graphicsAPI.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_S, IGraphicsAPI::TextureParameterOption::CLAMP_TO_BORDER);
-    graphicsAPI.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_T, IGraphicsAPI::TextureParameterOption::CLAMP_TO_BORDER);
-    graphicsAPI.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_MIN_FILTER, IGraphicsAPI::TextureParameterOption::NEAREST);
-    graphicsAPI.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_MAG_FILTER, IGraphicsAPI::TextureParameterOption::NEAREST);
-    if (gammaCorrect) {
-        // Use GL_SRGB or GL_SRGB_ALPHA for gamma correction
-        // TODO always use RGBA for internal?
-        graphicsAPI.texImage2D(
-            IGraphicsAPI::TextureTarget::TEXTURE_2D, 0,
-            (channels == 3) ? IGraphicsAPI::TextureFormat::SRGB : IGraphicsAPI::TextureFormat::SRGB_ALPHA,
-            width, height, 0,
-            (channels == 3) ? IGraphicsAPI::TextureFormat::RGB : IGraphicsAPI::TextureFormat::RGBA,
-            IGraphicsAPI::DataType::UBYTE,
-            textureData
-        );
+    setTextureParameters(graphicsAPI, createInfo.sampler, outMipLevels > 1);
+
+    // Rows are tightly packed, RGB rows are not 4 byte aligned
+    graphicsAPI.pixelStore(IGraphicsAPI::PixelAlignment::UNPACK_ALIGNMENT, 1);
+    graphicsAPI.texImage2D(
+        IGraphicsAPI::TextureTarget::TEXTURE_2D, 0,
+        internalFormat,
+        width, height, 0,
+        format,
+        IGraphicsAPI::DataType::UBYTE,
+        textureData
+    );
+
+    if (createInfo.mipmaps == MipmapMode::GPU) {
+        graphicsAPI.generateMipmap(IGraphicsAPI::TextureTarget::TEXTURE_2D);
+    } else if (createInfo.mipmaps == MipmapMode::CPU) {
+        std::vector<unsigned char> level(textureData, textureData + static_cast<size_t>(width) * height * channels);
+        int levelWidth = width;
+        int levelHeight = height;
+        for (unsigned int i = 1; i < outMipLevels; ++i) {
+            level = downsample(level.data(), levelWidth, levelHeight, channels, createInfo.gammaCorrect);
+            levelWidth = std::max(levelWidth / 2, 1);
+            levelHeight = std::max(levelHeight / 2, 1);
+            graphicsAPI.texImage2D(
+                IGraphicsAPI::TextureTarget::TEXTURE_2D, i,
+                internalFormat,
+                levelWidth, levelHeight, 0,
+                format,
+                IGraphicsAPI::DataType::UBYTE,
+                level.data()
+            );
+        }
+    }
+    graphicsAPI.pixelStore(IGraphicsAPI::PixelAlignment::UNPACK_ALIGNMENT, 4);
+
+    // Unbind texture
+    graphicsAPI.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, 0);
+    return textureId;
+}
+
+unsigned int Texture::genGLCompressedTexture(IGraphicsAPI& graphicsAPI, const CompressedImage& image, const SamplerState& sampler, const std::vector<std::vector<unsigned char>>& decodedLevels, bool& outCompressed) {
+    const IGraphicsAPI::CompressedFormat format = image.getFormat();
+    const std::vector<CompressedImage::Level>& levels = image.getLevels();
+    outCompressed = graphicsAPI.isCompressedFormatSupported(format);
+
+    if (!outCompressed && !CompressedImage::canDecode(format)) {
+        LOG_E("Compressed format %d is not supported by the driver and cannot be decoded", static_cast<int>(format));
+        throw std::runtime_error("Texture build failed");
+    }
+
+    unsigned int textureId;
+    graphicsAPI.genTextures(1, &textureId);
+    graphicsAPI.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, textureId);
+    setTextureParameters(graphicsAPI, sampler, levels.size() >= getMipLevelCount(image.getWidth(), image.getHeight()));
+
+    if (outCompressed) {
+        for (size_t i = 0; i < levels.size(); ++i) {
+            graphicsAPI.compressedTexImage2D(
+                IGraphicsAPI::TextureTarget::TEXTURE_2D, static_cast<unsigned int>(i),
+                format,
+                levels[i].width, levels[i].height,
+                levels[i].size,
+                image.getLevelData(i)
+            );
+        }
     } else {
-        // Use GL_RGB or GL_RGBA for non-gamma-corrected textures
-        graphicsAPI.texImage2D(
-            IGraphicsAPI::TextureTarget::TEXTURE_2D, 0,
-            (channels == 3) ? IGraphicsAPI::TextureFormat::RGB : IGraphicsAPI::TextureFormat::RGBA,
-            width, height, 0,
-            (channels == 3) ? IGraphicsAPI::TextureFormat::RGB : IGraphicsAPI::TextureFormat::RGBA,
-            IGraphicsAPI::DataType::UBYTE,
-            textureData
-        );
+        const bool predecoded = decodedLevels.size() == levels.size();
+        if (!predecoded) {
+            LOG_I("Compressed format %d is not supported by the driver, decoding %zu levels on the CPU", static_cast<int>(format), levels.size());
+        }
+        const IGraphicsAPI::TextureFormat internalFormat = CompressedImage::isSRGB(format)
+            ? IGraphicsAPI::TextureFormat::SRGB_ALPHA
+            : IGraphicsAPI::TextureFormat::RGBA;
+        for (size_t i = 0; i < levels.size(); ++i) {
+            const std::vector<unsigned char> texels = predecoded ? std::vector<unsigned char>() : image.decodeLevel(i);
+            graphicsAPI.texImage2D(
+                IGraphicsAPI::TextureTarget::TEXTURE_2D, static_cast<unsigned int>(i),
+                internalFormat,
+                levels[i].width, levels[i].height, 0,
+                IGraphicsAPI::TextureFormat::RGBA,
+                IGraphicsAPI::DataType::UBYTE,
+                predecoded ? decodedLevels[i].data() : texels.data()
+            );
+        }
     }
 
     // Unbind texture
@@ -109,4 +216,70 @@ unsigned int Texture::genGLTexture(IGraphicsAPI& graphicsAPI, const unsigned cha
     return textureId;
 }
 
+void Texture::setTextureParameters(IGraphicsAPI& graphicsAPI, const SamplerState& sampler, bool hasMipChain) {
+    SamplerState textureState = sampler;
+    if (!hasMipChain && textureState.usesMipmaps()) {
+        textureState.filter = SamplerState::Filter::LINEAR;
+    }
+    graphicsAPI.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_S, textureState.wrapS);
+    graphicsAPI.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_T, textureState.wrapT);
+    graphicsAPI.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_MIN_FILTER, Sampler::getMinFilter(textureState));
+    graphicsAPI.texParameter(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_MAG_FILTER, Sampler::getMagFilter(textureState));
+}
+
+unsigned int Texture::getMipLevelCount(int width, int height) {
+    unsigned int levels = 1;
+    for (int size = std::max(width, height); size > 1; size /= 2) {
+        ++levels;
+    }
+    return levels;
+}
+
+std::vector<unsigned char> Texture::downsample(const unsigned char* pixels, int width, int height, int channels, bool gammaCorrect) {
+    // sRGB to linear for each 8 bit value. Averaging sRGB values directly darkens the smaller levels
+    static const std::array<float, 256> srgbToLinear = [] {
+        std::array<float, 256> table;
+        for (int i = 0; i < 256; ++i) {
+            const float value = i / 255.0f;
+            table[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+        return table;
+    }();
+
+    const int levelWidth = std::max(width / 2, 1);
+    const int levelHeight = std::max(height / 2, 1);
+    std::vector<unsigned char> level(static_cast<size_t>(levelWidth) * levelHeight * channels);
+
+    for (int y = 0; y < levelHeight; ++y) {
+        // Odd or 1 texel sizes reuse the last row or column
+        const int y0 = std::min(y * 2, height - 1);
+        const int y1 = std::min(y * 2 + 1, height - 1);
+        for (int x = 0; x < levelWidth; ++x) {
+            const int x0 = std::min(x * 2, width - 1);
+            const int x1 = std::min(x * 2 + 1, width - 1);
+            const unsigned char* texels[4] = {
+                pixels + (static_cast<size_t>(y0) * width + x0) * channels,
+                pixels + (static_cast<size_t>(y0) * width + x1) * channels,
+                pixels + (static_cast<size_t>(y1) * width + x0) * channels,
+                pixels + (static_cast<size_t>(y1) * width + x1) * channels
+            };
+            unsigned char* out = level.data() + (static_cast<size_t>(y) * levelWidth + x) * channels;
+            for (int c = 0; c < channels; ++c) {
+                // Alpha is stored linearly
+                const bool isColor = gammaCorrect && (channels < 4 || c < 3);
+                float sum = 0.0f;
+                for (const unsigned char* texel : texels) {
+                    sum += isColor ? srgbToLinear[texel[c]] : texel[c] / 255.0f;
+                }
+                float value = sum * 0.25f;
+                if (isColor) {
+                    value = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+                }
+                out[c] = static_cast<unsigned char>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+        }
+    }
+    return level;
+}
+
 } // namespace clay
\ No newline at end of file
@@ -0,0 +1,287 @@
+// standard lib
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+// project
+#include "clay/utils/common/Logger.h"
+// class
+#include "clay/graphics/common/TextureAtlas.h"
+
+namespace clay {
+
+namespace {
+    int alignUp(int value, int alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+TextureAtlas::TextureAtlas(IGraphicsAPI& graphicsAPI, const Texture::CreateInfo& createInfo, int padding, int maxSize)
+    : mGraphicsAPI_(graphicsAPI),
+    mCreateInfo_(createInfo),
+    mPadding_(padding),
+    mMaxSize_(maxSize) {
+    mSize_ = glm::ivec2(std::min(INITIAL_SIZE, mMaxSize_));
+    repack();
+    createTexture();
+}
+
+TextureAtlas::~TextureAtlas() = default;
+
+void TextureAtlas::add(const std::string& name, const unsigned char* pixels, int width, int height, int channels) {
+    if (pixels == nullptr || width <= 0 || height <= 0 || channels < 1 || channels > 4) {
+        LOG_E("Invalid image %s for the texture atlas", name.c_str());
+        throw std::runtime_error("Invalid atlas image");
+    }
+
+    Image image;
+    image.name = name;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i) {
+        const unsigned char* in = pixels + i * channels;
+        unsigned char* out = image.pixels.data() + i * 4;
+        // 1 and 2 channel images are luminance and luminance alpha
+        out[0] = in[0];
+        out[1] = channels >= 3 ? in[1] : in[0];
+        out[2] = channels >= 3 ? in[2] : in[0];
+        out[3] = channels == 4 ? in[3] : (channels == 2 ? in[1] : 255);
+    }
+
+    // A replaced image keeps its space until the next repack
+    auto isNamed = [&name](const Image& other) { return other.name == name; };
+    mImages_.erase(std::remove_if(mImages_.begin(), mImages_.end(), isNamed), mImages_.end());
+    mPending_.erase(std::remove_if(mPending_.begin(), mPending_.end(), isNamed), mPending_.end());
+    mRegions_.erase(name);
+    mPending_.push_back(std::move(image));
+}
+
+void TextureAtlas::add(const std::string& name, Texture& texture) {
+    const std::vector<unsigned char> pixels = texture.getPixelData();
+    add(name, pixels.data(), texture.getWidth(), texture.getHeight(), texture.getChannels());
+}
+
+void TextureAtlas::build() {
+    if (mPending_.empty()) {
+        return;
+    }
+    // Tallest first packs the skyline tighter
+    std::stable_sort(mPending_.begin(), mPending_.end(), [](const Image& a, const Image& b) {
+        return a.height > b.height;
+    });
+
+    std::vector<glm::ivec2> positions;
+    positions.reserve(mPending_.size());
+    bool fits = true;
+    for (const Image& image : mPending_) {
+        const glm::ivec2 packedSize = getPackedSize(image);
+        glm::ivec2 position;
+        if (!insert(packedSize.x, packedSize.y, position)) {
+            fits = false;
+            break;
+        }
+        positions.push_back(position + glm::ivec2(mPadding_));
+    }
+
+    if (fits) {
+        // Only the new images and their padding are uploaded
+        mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, mTexture_->getId());
+        std::vector<unsigned char> upload;
+        for (size_t i = 0; i < mPending_.size(); ++i) {
+            Image& image = mPending_[i];
+            blit(image, positions[i]);
+
+            const glm::ivec2 origin = positions[i] - glm::ivec2(mPadding_);
+            const glm::ivec2 size = glm::min(getPackedSize(image), mSize_ - origin);
+            upload.resize(static_cast<size_t>(size.x) * size.y * 4);
+            for (int y = 0; y < size.y; ++y) {
+                std::memcpy(
+                    upload.data() + static_cast<size_t>(y) * size.x * 4,
+                    mPixels_.data() + (static_cast<size_t>(origin.y + y) * mSize_.x + origin.x) * 4,
+                    static_cast<size_t>(size.x) * 4
+                );
+            }
+            mGraphicsAPI_.texSubImage2D(
+                IGraphicsAPI::TextureTarget::TEXTURE_2D, 0,
+                origin.x, origin.y,
+                size.x, size.y,
+                IGraphicsAPI::TextureFormat::RGBA,
+                IGraphicsAPI::DataType::UBYTE,
+                upload.data()
+            );
+            mImages_.push_back(std::move(image));
+        }
+        mPending_.clear();
+
+        if (mCreateInfo_.mipmaps == Texture::MipmapMode::GPU) {
+            mGraphicsAPI_.generateMipmap(IGraphicsAPI::TextureTarget::TEXTURE_2D);
+            mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, 0);
+        } else {
+            mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, 0);
+            if (mCreateInfo_.mipmaps == Texture::MipmapMode::CPU) {
+                createTexture();
+            }
+        }
+        return;
+    }
+
+    // Repack everything, growing the atlas until it fits
+    for (Image& image : mPending_) {
+        mImages_.push_back(std::move(image));
+    }
+    mPending_.clear();
+    while (!repack()) {
+        if (mSize_.x >= mMaxSize_ && mSize_.y >= mMaxSize_) {
+            LOG_E("Texture atlas images do not fit in %dx%d", mMaxSize_, mMaxSize_);
+            throw std::runtime_error("Texture atlas is full");
+        }
+        // Grow the shorter side to keep the atlas square or 2:1
+        if (mSize_.x <= mSize_.y) {
+            mSize_.x = std::min(mSize_.x * 2, mMaxSize_);
+        } else {
+            mSize_.y = std::min(mSize_.y * 2, mMaxSize_);
+        }
+        LOG_I("Growing texture atlas to %dx%d", mSize_.x, mSize_.y);
+    }
+    ++mRepackCount_;
+    createTexture();
+}
+
+const TextureAtlas::Region* TextureAtlas::getRegion(const std::string& name) const {
+    auto it = mRegions_.find(name);
+    if (it != mRegions_.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+const Texture& TextureAtlas::getTexture() const {
+    return *mTexture_;
+}
+
+glm::ivec2 TextureAtlas::getSize() const {
+    return mSize_;
+}
+
+unsigned int TextureAtlas::getRepackCount() const {
+    return mRepackCount_;
+}
+
+bool TextureAtlas::insert(int width, int height, glm::ivec2& outPosition) {
+    // Bottom left: the lowest resulting top edge, then the leftmost
+    size_t bestIndex = mSkyline_.size();
+    int bestTop = INT_MAX;
+    int bestY = 0;
+
+    for (size_t i = 0; i < mSkyline_.size(); ++i) {
+        const int x = mSkyline_[i].x;
+        if (x + width > mSize_.x) {
+            break;
+        }
+        // The rectangle rests on the highest node under it
+        int y = 0;
+        int remaining = width;
+        for (size_t j = i; remaining > 0; ++j) {
+            y = std::max(y, mSkyline_[j].y);
+            remaining -= mSkyline_[j].width;
+        }
+        if (y + height <= mSize_.y && y + height < bestTop) {
+            bestIndex = i;
+            bestTop = y + height;
+            bestY = y;
+        }
+    }
+    if (bestIndex == mSkyline_.size()) {
+        return false;
+    }
+
+    outPosition = {mSkyline_[bestIndex].x, bestY};
+    mSkyline_.insert(mSkyline_.begin() + bestIndex, {outPosition.x, bestTop, width});
+
+    // Trim the nodes now under the rectangle
+    const int right = outPosition.x + width;
+    size_t next = bestIndex + 1;
+    while (next < mSkyline_.size() && mSkyline_[next].x < right) {
+        const int overlap = right - mSkyline_[next].x;
+        if (overlap >= mSkyline_[next].width) {
+            mSkyline_.erase(mSkyline_.begin() + next);
+        } else {
+            mSkyline_[next].x += overlap;
+            mSkyline_[next].width -= overlap;
+            break;
+        }
+    }
+
+    // Merge neighbours of the same height
+    for (size_t i = 0; i + 1 < mSkyline_.size();) {
+        if (mSkyline_[i].y == mSkyline_[i + 1].y) {
+            mSkyline_[i].width += mSkyline_[i + 1].width;
+            mSkyline_.erase(mSkyline_.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+    return true;
+}
+
+bool TextureAtlas::repack() {
+    mSkyline_.assign(1, {0, 0, mSize_.x});
+    mPixels_.assign(static_cast<size_t>(mSize_.x) * mSize_.y * 4, 0);
+    mRegions_.clear();
+
+    std::stable_sort(mImages_.begin(), mImages_.end(), [](const Image& a, const Image& b) {
+        return a.height > b.height;
+    });
+    for (const Image& image : mImages_) {
+        const glm::ivec2 packedSize = getPackedSize(image);
+        glm::ivec2 position;
+        if (!insert(packedSize.x, packedSize.y, position)) {
+            return false;
+        }
+        blit(image, position + glm::ivec2(mPadding_));
+    }
+    return true;
+}
+
+void TextureAtlas::blit(const Image& image, const glm::ivec2& position) {
+    // The padding repeats the edge texels so filtering at the edge only reads the image
+    const int firstX = std::max(position.x - mPadding_, 0);
+    const int lastX = std::min(position.x + image.width + mPadding_, mSize_.x);
+    const int firstY = std::max(position.y - mPadding_, 0);
+    const int lastY = std::min(position.y + image.height + mPadding_, mSize_.y);
+    for (int y = firstY; y < lastY; ++y) {
+        const int sourceY = std::clamp(y - position.y, 0, image.height - 1);
+        for (int x = firstX; x < lastX; ++x) {
+            const int sourceX = std::clamp(x - position.x, 0, image.width - 1);
+            std::memcpy(
+                mPixels_.data() + (static_cast<size_t>(y) * mSize_.x + x) * 4,
+                image.pixels.data() + (static_cast<size_t>(sourceY) * image.width + sourceX) * 4,
+                4
+            );
+        }
+    }
+
+    Region& region = mRegions_[image.name];
+    region.position = position;
+    region.size = {image.width, image.height};
+    region.uvRect = {
+        static_cast<float>(position.x) / mSize_.x,
+        static_cast<float>(position.y) / mSize_.y,
+        static_cast<float>(image.width) / mSize_.x,
+        static_cast<float>(image.height) / mSize_.y
+    };
+}
+
+void TextureAtlas::createTexture() {
+    mTexture_ = std::make_unique<Texture>(mGraphicsAPI_, mPixels_.data(), mSize_.x, mSize_.y, 4, mCreateInfo_);
+}
+
+glm::ivec2 TextureAtlas::getPackedSize(const Image& image) const {
+    return {
+        alignUp(image.width + 2 * mPadding_, ALIGNMENT),
+        alignUp(image.height + 2 * mPadding_, ALIGNMENT)
+    };
+}
+
+} // namespace clay
@@ -0,0 +1,279 @@
+// standard lib
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+// project
+#include "clay/utils/common/Logger.h"
+// class
+#include "clay/graphics/common/TextureStreamer.h"
+
+namespace clay {
+
+TextureStreamer::TextureStreamer(IGraphicsAPI& graphicsAPI,
+                                 Texture& placeholder,
+                                 LoadFunction loadFile,
+                                 DecodeFunction decode,
+                                 unsigned int workerCount,
+                                 size_t uploadBudget)
+    : mGraphicsAPI_(graphicsAPI),
+    mLoadFile_(std::move(loadFile)),
+    mDecode_(std::move(decode)),
+    mUploadBudget_(std::max<size_t>(uploadBudget, 1)) {
+    const std::vector<unsigned char> placeholderPixels = placeholder.getPixelData();
+    const unsigned int channels = placeholder.getChannels();
+    if (placeholderPixels.size() >= channels && channels >= 3) {
+        std::memcpy(mPlaceholderTexel_, placeholderPixels.data(), channels);
+    }
+
+    mGraphicsAPI_.genBuffer(PIXEL_BUFFER_COUNT, mPixelBuffers_);
+
+    workerCount = std::max(workerCount, 1u);
+    mWorkers_.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        mWorkers_.emplace_back(&TextureStreamer::workerLoop, this);
+    }
+}
+
+TextureStreamer::~TextureStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(mQueueMutex_);
+        mStopping_ = true;
+    }
+    mQueueCondition_.notify_all();
+    for (std::thread& worker : mWorkers_) {
+        worker.join();
+    }
+    mGraphicsAPI_.deleteBuffer(PIXEL_BUFFER_COUNT, mPixelBuffers_);
+}
+
+std::unique_ptr<Texture> TextureStreamer::request(const std::string& path, const Texture::CreateInfo& createInfo) {
+    // Mips cannot be sampled until the real levels arrive
+    Texture::CreateInfo placeholderInfo = createInfo;
+    placeholderInfo.mipmaps = Texture::MipmapMode::NONE;
+    std::unique_ptr<Texture> texture = std::make_unique<Texture>(mGraphicsAPI_, mPlaceholderTexel_, 1, 1, 4, placeholderInfo);
+    texture->mLifetime_ = std::make_shared<bool>(true);
+
+    std::shared_ptr<Stream> stream = std::make_shared<Stream>();
+    stream->texture = texture.get();
+    stream->lifetime = texture->mLifetime_;
+    stream->path = path;
+    stream->createInfo = createInfo;
+    mStreams_.push_back(stream);
+    {
+        std::lock_guard<std::mutex> lock(mQueueMutex_);
+        mQueue_.push_back(std::move(stream));
+    }
+    mQueueCondition_.notify_one();
+    return texture;
+}
+
+void TextureStreamer::update() {
+    mStats_ = {};
+    size_t remainingBudget = mUploadBudget_;
+
+    for (auto it = mStreams_.begin(); it != mStreams_.end();) {
+        Stream& stream = **it;
+        bool finished = false;
+
+        if (stream.lifetime.expired()) {
+            // The Texture was destroyed, the worker skips or discards the decode
+            finished = true;
+        } else {
+            switch (stream.state.load(std::memory_order_acquire)) {
+                case Stream::State::QUEUED:
+                    ++mStats_.decoding;
+                    break;
+                case Stream::State::FAILED:
+                    LOG_E("Failed to stream texture %s", stream.path.c_str());
+                    finished = true;
+                    break;
+                case Stream::State::DECODED:
+                    if (remainingBudget > 0) {
+                        finished = upload(stream, remainingBudget);
+                    }
+                    if (!finished) {
+                        ++mStats_.uploading;
+                    }
+                    break;
+            }
+        }
+
+        if (finished) {
+            it = mStreams_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    mStats_.uploadedBytes = mUploadBudget_ - remainingBudget;
+}
+
+bool TextureStreamer::isBusy() const {
+    return !mStreams_.empty();
+}
+
+const TextureStreamer::Stats& TextureStreamer::getStats() const {
+    return mStats_;
+}
+
+void TextureStreamer::workerLoop() {
+    while (true) {
+        std::shared_ptr<Stream> stream;
+        {
+            std::unique_lock<std::mutex> lock(mQueueMutex_);
+            mQueueCondition_.wait(lock, [this] { return mStopping_ || !mQueue_.empty(); });
+            if (mStopping_) {
+                return;
+            }
+            stream = std::move(mQueue_.front());
+            mQueue_.pop_front();
+        }
+
+        if (stream->lifetime.expired()) {
+            continue;
+        }
+        try {
+            decode(*stream);
+            stream->state.store(Stream::State::DECODED, std::memory_order_release);
+        } catch (const std::exception& e) {
+            LOG_E("Texture %s could not be decoded: %s", stream->path.c_str(), e.what());
+            stream->state.store(Stream::State::FAILED, std::memory_order_release);
+        }
+    }
+}
+
+void TextureStreamer::decode(Stream& stream) {
+    utils::FileData file = mLoadFile_(stream.path);
+    std::vector<unsigned char> pixels = mDecode_(file, stream.width, stream.height, stream.channels);
+    if (pixels.empty() || stream.width <= 0 || stream.height <= 0) {
+        throw std::runtime_error("Empty image");
+    }
+
+    // Both mip modes are built here, GPU generated mips would need the base level uploaded first
+    const unsigned int levelCount = stream.createInfo.mipmaps == Texture::MipmapMode::NONE
+        ? 1
+        : Texture::getMipLevelCount(stream.width, stream.height);
+    stream.levels.reserve(levelCount);
+    stream.levels.push_back(std::move(pixels));
+    int levelWidth = stream.width;
+    int levelHeight = stream.height;
+    for (unsigned int i = 1; i < levelCount; ++i) {
+        stream.levels.push_back(Texture::downsample(stream.levels.back().data(), levelWidth, levelHeight, stream.channels, stream.createInfo.gammaCorrect));
+        levelWidth = std::max(levelWidth / 2, 1);
+        levelHeight = std::max(levelHeight / 2, 1);
+    }
+    stream.nextLevel = static_cast<int>(levelCount) - 1;
+}
+
+bool TextureStreamer::upload(Stream& stream, size_t& remainingBudget) {
+    Texture& texture = *stream.texture;
+    const int levelCount = static_cast<int>(stream.levels.size());
+    mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, texture.getId());
+    // Rows are tightly packed, RGB rows are not 4 byte aligned
+    mGraphicsAPI_.pixelStore(IGraphicsAPI::PixelAlignment::UNPACK_ALIGNMENT, 1);
+
+    if (!stream.allocated) {
+        // Storage for every level, sampling is limited to the uploaded levels with the base level
+        const IGraphicsAPI::TextureFormat format = (stream.channels == 3) ? IGraphicsAPI::TextureFormat::RGB : IGraphicsAPI::TextureFormat::RGBA;
+        IGraphicsAPI::TextureFormat internalFormat = format;
+        if (stream.createInfo.gammaCorrect) {
+            internalFormat = (stream.channels == 3) ? IGraphicsAPI::TextureFormat::SRGB : IGraphicsAPI::TextureFormat::SRGB_ALPHA;
+        }
+        int levelWidth = stream.width;
+        int levelHeight = stream.height;
+        for (int level = 0; level < levelCount; ++level) {
+            mGraphicsAPI_.texImage2D(
+                IGraphicsAPI::TextureTarget::TEXTURE_2D, level,
+                internalFormat,
+                levelWidth, levelHeight, 0,
+                format,
+                IGraphicsAPI::DataType::UBYTE,
+                nullptr
+            );
+            levelWidth = std::max(levelWidth / 2, 1);
+            levelHeight = std::max(levelHeight / 2, 1);
+        }
+        mGraphicsAPI_.texParameteri(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_MAX_LEVEL, levelCount - 1);
+        Texture::setTextureParameters(mGraphicsAPI_, stream.createInfo.sampler, false);
+        stream.allocated = true;
+        texture.mWidth_ = stream.width;
+        texture.mHeight_ = stream.height;
+        texture.mChannels_ = stream.channels;
+    }
+
+    while (stream.nextLevel >= 0 && remainingBudget > 0) {
+        const int levelWidth = std::max(stream.width >> stream.nextLevel, 1);
+        const int levelHeight = std::max(stream.height >> stream.nextLevel, 1);
+        const size_t rowSize = static_cast<size_t>(levelWidth) * stream.channels;
+
+        // At least one row so large rows still progress
+        const int rowCount = std::clamp(static_cast<int>(remainingBudget / rowSize), 1, levelHeight - stream.nextRow);
+        uploadRows(stream, stream.nextLevel, stream.nextRow, rowCount);
+        remainingBudget -= std::min(remainingBudget, rowCount * rowSize);
+        stream.nextRow += rowCount;
+
+        if (stream.nextRow == levelHeight) {
+            // The finished level becomes the sharpest one sampled
+            mGraphicsAPI_.texParameteri(IGraphicsAPI::TextureTarget::TEXTURE_2D, IGraphicsAPI::TextureParameterType::TEXTURE_BASE_LEVEL, stream.nextLevel);
+            stream.levels[stream.nextLevel].clear();
+            stream.levels[stream.nextLevel].shrink_to_fit();
+            --stream.nextLevel;
+            stream.nextRow = 0;
+        }
+    }
+
+    const bool finished = stream.nextLevel < 0;
+    if (finished) {
+        texture.mMipLevels_ = levelCount;
+        Texture::setTextureParameters(mGraphicsAPI_, stream.createInfo.sampler, levelCount >= static_cast<int>(Texture::getMipLevelCount(stream.width, stream.height)));
+    }
+
+    mGraphicsAPI_.pixelStore(IGraphicsAPI::PixelAlignment::UNPACK_ALIGNMENT, 4);
+    mGraphicsAPI_.bindTexture(IGraphicsAPI::TextureTarget::TEXTURE_2D, 0);
+    return finished;
+}
+
+void TextureStreamer::uploadRows(const Stream& stream, int level, int firstRow, int rowCount) {
+    const int levelWidth = std::max(stream.width >> level, 1);
+    const size_t rowSize = static_cast<size_t>(levelWidth) * stream.channels;
+    const size_t size = rowSize * rowCount;
+
+    // Orphaning the buffer lets the driver keep the previous upload in flight while this one is written
+    const unsigned int pixelBuffer = mPixelBuffers_[mNextPixelBuffer_];
+    mNextPixelBuffer_ = (mNextPixelBuffer_ + 1) % PIXEL_BUFFER_COUNT;
+    mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::PIXEL_UNPACK_BUFFER, pixelBuffer);
+    mGraphicsAPI_.bufferData(IGraphicsAPI::BufferTarget::PIXEL_UNPACK_BUFFER, size, NULL, IGraphicsAPI::DataUsage::STREAM_DRAW);
+    void* mapped = mGraphicsAPI_.mapBufferRange(
+        IGraphicsAPI::BufferTarget::PIXEL_UNPACK_BUFFER, 0, size,
+        {IGraphicsAPI::BufferAccess::WRITE, IGraphicsAPI::BufferAccess::INVALIDATE_RANGE}
+    );
+
+    const unsigned char* rows = stream.levels[level].data() + rowSize * firstRow;
+    const IGraphicsAPI::TextureFormat format = (stream.channels == 3) ? IGraphicsAPI::TextureFormat::RGB : IGraphicsAPI::TextureFormat::RGBA;
+    if (mapped != nullptr) {
+        std::memcpy(mapped, rows, size);
+        mGraphicsAPI_.unmapBuffer(IGraphicsAPI::BufferTarget::PIXEL_UNPACK_BUFFER);
+        // With an unpack buffer bound the data pointer is an offset into it
+        mGraphicsAPI_.texSubImage2D(
+            IGraphicsAPI::TextureTarget::TEXTURE_2D, level,
+            0, firstRow,
+            levelWidth, rowCount,
+            format,
+            IGraphicsAPI::DataType::UBYTE,
+            nullptr
+        );
+        mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::PIXEL_UNPACK_BUFFER, 0);
+    } else {
+        LOG_W("Pixel buffer mapping failed, uploading texture rows directly");
+        mGraphicsAPI_.bindBuffer(IGraphicsAPI::BufferTarget::PIXEL_UNPACK_BUFFER, 0);
+        mGraphicsAPI_.texSubImage2D(
+            IGraphicsAPI::TextureTarget::TEXTURE_2D, level,
+            0, firstRow,
+            levelWidth, rowCount,
+            format,
+            IGraphicsAPI::DataType::UBYTE,
+            rows
+        );
+    }
+}
+
+} // namespace clay
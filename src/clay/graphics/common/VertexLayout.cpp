@@ -0,0 +1,71 @@
+// third party
+#include <glm/glm.hpp>
+// class
+#include "clay/graphics/common/VertexLayout.h"
+
+namespace clay {
+
+VertexLayout VertexLayout::compact() {
+    VertexLayout layout;
+    layout.normal = NormalFormat::OCTAHEDRAL_SNORM16;
+    layout.tangent = TangentFormat::OCTAHEDRAL_SNORM8_SIGN;
+    layout.texCoord = TexCoordFormat::HALF2;
+    layout.shortIndices = true;
+    return layout;
+}
+
+VertexLayout::Offsets VertexLayout::getOffsets() const {
+    Offsets offsets;
+    offsets.normal = sizeof(glm::vec3);
+    offsets.texCoord = offsets.normal + (normal == NormalFormat::FLOAT3 ? sizeof(glm::vec3) : 2 * sizeof(int16_t));
+    offsets.tangent = offsets.texCoord + (texCoord == TexCoordFormat::FLOAT2 ? sizeof(glm::vec2) : 2 * sizeof(uint16_t));
+    offsets.stride = offsets.tangent + (tangent == TangentFormat::FLOAT3_BITANGENT ? 2 * sizeof(glm::vec3) : 4 * sizeof(int8_t));
+    return offsets;
+}
+
+size_t VertexLayout::getStride() const {
+    return getOffsets().stride;
+}
+
+void VertexLayout::bindAttributes(IGraphicsAPI& graphicsAPI) const {
+    const Offsets offsets = getOffsets();
+
+    // vertex Positions
+    graphicsAPI.enableVertexAttribArray(0);
+    graphicsAPI.vertexAttribPointer(0, 3, IGraphicsAPI::DataType::FLOAT, false, offsets.stride, (void*)0);
+    // vertex normals
+    if (normal == NormalFormat::FLOAT3) {
+        graphicsAPI.enableVertexAttribArray(1);
+        graphicsAPI.vertexAttribPointer(1, 3, IGraphicsAPI::DataType::FLOAT, false, offsets.stride, (void*)offsets.normal);
+    } else {
+        graphicsAPI.enableVertexAttribArray(PACKED_NORMAL_ATTRIBUTE_LOCATION);
+        graphicsAPI.vertexAttribPointer(PACKED_NORMAL_ATTRIBUTE_LOCATION, 2, IGraphicsAPI::DataType::SHORT, true, offsets.stride, (void*)offsets.normal);
+    }
+    // vertex texture coords
+    graphicsAPI.enableVertexAttribArray(2);
+    if (texCoord == TexCoordFormat::FLOAT2) {
+        graphicsAPI.vertexAttribPointer(2, 2, IGraphicsAPI::DataType::FLOAT, false, offsets.stride, (void*)offsets.texCoord);
+    } else {
+        graphicsAPI.vertexAttribPointer(2, 2, IGraphicsAPI::DataType::HALF_FLOAT, false, offsets.stride, (void*)offsets.texCoord);
+    }
+    if (tangent == TangentFormat::FLOAT3_BITANGENT) {
+        // vertex tangent
+        graphicsAPI.enableVertexAttribArray(3);
+        graphicsAPI.vertexAttribPointer(3, 3, IGraphicsAPI::DataType::FLOAT, false, offsets.stride, (void*)offsets.tangent);
+        // vertex bitangent
+        graphicsAPI.enableVertexAttribArray(4);
+        graphicsAPI.vertexAttribPointer(4, 3, IGraphicsAPI::DataType::FLOAT, false, offsets.stride, (void*)(offsets.tangent + sizeof(glm::vec3)));
+    } else {
+        graphicsAPI.enableVertexAttribArray(PACKED_TANGENT_ATTRIBUTE_LOCATION);
+        graphicsAPI.vertexAttribPointer(PACKED_TANGENT_ATTRIBUTE_LOCATION, 3, IGraphicsAPI::DataType::BYTE, true, offsets.stride, (void*)offsets.tangent);
+    }
+}
+
+bool VertexLayout::operator==(const VertexLayout& other) const {
+    return normal == other.normal &&
+        tangent == other.tangent &&
+        texCoord == other.texCoord &&
+        shortIndices == other.shortIndices;
+}
+
+} // namespace clay
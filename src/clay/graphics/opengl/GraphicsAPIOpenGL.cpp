@@ -41,10 +41,44 @@ namespace clay {
         glEnable(GL_BLEND); // Needed for text rendering
         glDepthFunc(GL_LEQUAL); // Set Depth test to replace the current fragment if the z is less then OR equal
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Enable alpha drawing
+        invalidateStateCache();
     }
     
     GraphicsAPIOpenGL::~GraphicsAPIOpenGL() {}
 
+    const GraphicsAPIOpenGL::StateFilterStats& GraphicsAPIOpenGL::getStateFilterStats() const {
+        return mStateFilterStats_;
+    }
+
+    void GraphicsAPIOpenGL::resetStateFilterStats() {
+        mStateFilterStats_ = {};
+    }
+
+    void GraphicsAPIOpenGL::invalidateStateCache() {
+        mBoundProgram_ = UNKNOWN_BINDING;
+        mBoundVertexArray_ = UNKNOWN_BINDING;
+        mBoundBuffers_.fill(UNKNOWN_BINDING);
+        mActiveTextureUnit_ = UNKNOWN_BINDING;
+        for (auto& unitTextures : mBoundTextures_) {
+            unitTextures.fill(UNKNOWN_BINDING);
+        }
+        mBoundSamplers_.fill(UNKNOWN_BINDING);
+        mBoundDrawFrameBuffer_ = UNKNOWN_BINDING;
+        mBoundReadFrameBuffer_ = UNKNOWN_BINDING;
+        mCapabilities_.fill(CapabilityState::UNKNOWN);
+    }
+
+    template<typename T>
+    bool GraphicsAPIOpenGL::updateShadow(T& shadow, T value) {
+        if (shadow == value) {
+            ++mStateFilterStats_.filtered;
+            return false;
+        }
+        shadow = value;
+        ++mStateFilterStats_.forwarded;
+        return true;
+    }
+
     unsigned int GraphicsAPIOpenGL::createShader(ShaderCreateInfo::Type type) {
         GLenum glType;
 
@@ -98,7 +132,9 @@ namespace clay {
     }
 
     void GraphicsAPIOpenGL::useProgram(unsigned int programID) {
-        GL_CALL(glUseProgram(programID));
+        if (updateShadow(mBoundProgram_, programID)) {
+            GL_CALL(glUseProgram(programID));
+        }
     }
 
     void GraphicsAPIOpenGL::deleteShader(unsigned int shaderID) {
@@ -108,6 +144,9 @@ namespace clay {
     void GraphicsAPIOpenGL::deleteProgram(unsigned int programID) {
         // TODO fix this. probably need to delete/detach shaders
         GL_CALL(glDeleteProgram(programID));
+        if (mBoundProgram_ == programID) {
+            mBoundProgram_ = UNKNOWN_BINDING;
+        }
     }
 
     std::string GraphicsAPIOpenGL::getShaderLog(unsigned int shaderID) {
@@ -128,6 +167,21 @@ namespace clay {
         return uniformLocation;
     }
 
+    int GraphicsAPIOpenGL::getActiveUniformCount(unsigned int programId) {
+        GLint count = 0;
+        GL_CALL(glGetProgramiv(programId, GL_ACTIVE_UNIFORMS, &count));
+        return count;
+    }
+
+    std::string GraphicsAPIOpenGL::getActiveUniformName(unsigned int programId, unsigned int index) {
+        char name[256];
+        GLsizei length = 0;
+        GLint size;
+        GLenum type;
+        GL_CALL(glGetActiveUniform(programId, index, sizeof(name), &length, &size, &type, name));
+        return std::string(name, length);
+    }
+
     void GraphicsAPIOpenGL::uniform1i(unsigned int location, int value) {
         GL_CALL(glUniform1i(location, value));
     }
@@ -193,7 +247,26 @@ namespace clay {
             throw std::runtime_error("Invalid Frame buffer target");
         }
 
-        GL_CALL(glBindFramebuffer(glTarget, bufferId));
+        bool changed;
+        if (target == IGraphicsAPI::FrameBufferTarget::FRAMEBUFFER) {
+            // Binds both draw and read frame buffers
+            changed = mBoundDrawFrameBuffer_ != bufferId || mBoundReadFrameBuffer_ != bufferId;
+            mBoundDrawFrameBuffer_ = bufferId;
+            mBoundReadFrameBuffer_ = bufferId;
+            if (changed) {
+                ++mStateFilterStats_.forwarded;
+            } else {
+                ++mStateFilterStats_.filtered;
+            }
+        } else if (target == IGraphicsAPI::FrameBufferTarget::DRAW_FRAMEBUFFER) {
+            changed = updateShadow(mBoundDrawFrameBuffer_, bufferId);
+        } else {
+            changed = updateShadow(mBoundReadFrameBuffer_, bufferId);
+        }
+
+        if (changed) {
+            GL_CALL(glBindFramebuffer(glTarget, bufferId));
+        }
    }
 
    void GraphicsAPIOpenGL::enable(IGraphicsAPI::Capability capability) {
@@ -206,11 +279,16 @@ namespace clay {
         case IGraphicsAPI::Capability::FRAMEBUFFER_SRGB:
             glCapability = GL_FRAMEBUFFER_SRGB;
             break;
+        case IGraphicsAPI::Capability::DEPTH_TEST:
+            glCapability = GL_DEPTH_TEST;
+            break;
         default:
             throw std::runtime_error("Invalid capability");
         }
 
-        GL_CALL(glEnable(glCapability));
+        if (updateShadow(mCapabilities_[static_cast<size_t>(capability)], CapabilityState::ENABLED)) {
+            GL_CALL(glEnable(glCapability));
+        }
    }
 
    void GraphicsAPIOpenGL::disable(IGraphicsAPI::Capability capability) {
@@ -223,19 +301,68 @@ namespace clay {
         case IGraphicsAPI::Capability::FRAMEBUFFER_SRGB:
             glCapability = GL_FRAMEBUFFER_SRGB;
             break;
+        case IGraphicsAPI::Capability::DEPTH_TEST:
+            glCapability = GL_DEPTH_TEST;
+            break;
         default:
             throw std::runtime_error("Invalid capability");
         }
 
-        GL_CALL(glDisable(glCapability));
+        if (updateShadow(mCapabilities_[static_cast<size_t>(capability)], CapabilityState::DISABLED)) {
+            GL_CALL(glDisable(glCapability));
+        }
    }
 
+    bool GraphicsAPIOpenGL::isEnabled(IGraphicsAPI::Capability capability) {
+        CapabilityState& state = mCapabilities_[static_cast<size_t>(capability)];
+        if (state != CapabilityState::UNKNOWN) {
+            return state == CapabilityState::ENABLED;
+        }
+
+        GLenum glCapability;
+
+        switch (capability) {
+        case IGraphicsAPI::Capability::MULTISAMPLE:
+            glCapability = GL_MULTISAMPLE;
+            break;
+        case IGraphicsAPI::Capability::FRAMEBUFFER_SRGB:
+            glCapability = GL_FRAMEBUFFER_SRGB;
+            break;
+        case IGraphicsAPI::Capability::DEPTH_TEST:
+            glCapability = GL_DEPTH_TEST;
+            break;
+        default:
+            throw std::runtime_error("Invalid capability");
+        }
+
+        // The queried state fills the shadow so later queries and redundant enables skip the driver
+        GLboolean enabled;
+        GL_CALL(enabled = glIsEnabled(glCapability));
+        state = enabled == GL_TRUE ? CapabilityState::ENABLED : CapabilityState::DISABLED;
+        return enabled == GL_TRUE;
+    }
+
     void GraphicsAPIOpenGL::genVertexArrays(unsigned int n, unsigned int* arrays) {
         GL_CALL(glGenVertexArrays(n, arrays));
     }
 
+    void GraphicsAPIOpenGL::deleteVertexArrays(unsigned int n, unsigned int* arrays) {
+        GL_CALL(glDeleteVertexArrays(n, arrays));
+        // Deleting the bound vertex array reverts the binding to 0, and the name can be handed out again
+        for (unsigned int i = 0; i < n; ++i) {
+            if (mBoundVertexArray_ == arrays[i]) {
+                mBoundVertexArray_ = 0;
+                mBoundBuffers_[static_cast<size_t>(BufferTarget::ELEMENT_ARRAY_BUFFER)] = UNKNOWN_BINDING;
+            }
+        }
+    }
+
     void GraphicsAPIOpenGL::bindVertexArray(unsigned int vao) {
-        GL_CALL(glBindVertexArray(vao));
+        if (updateShadow(mBoundVertexArray_, vao)) {
+            GL_CALL(glBindVertexArray(vao));
+            // The element array buffer binding belongs to the VAO
+            mBoundBuffers_[static_cast<size_t>(BufferTarget::ELEMENT_ARRAY_BUFFER)] = UNKNOWN_BINDING;
+        }
     }
 
     void GraphicsAPIOpenGL::genBuffer(int size, unsigned int* vaos) {
@@ -292,7 +419,9 @@ namespace clay {
             throw std::runtime_error("Invalid buffer target");
         }
 
-        GL_CALL(glBindBuffer(glTarget, bufferId));
+        if (updateShadow(mBoundBuffers_[static_cast<size_t>(target)], bufferId)) {
+            GL_CALL(glBindBuffer(glTarget, bufferId));
+        }
     }
 
     void GraphicsAPIOpenGL::bufferData(IGraphicsAPI::BufferTarget target, size_t size, void* data, IGraphicsAPI::DataUsage usage) {
@@ -397,6 +526,21 @@ namespace clay {
         case IGraphicsAPI::DataType::INT:
             glType = GL_INT;
             break;
+        case IGraphicsAPI::DataType::UBYTE:
+            glType = GL_UNSIGNED_BYTE;
+            break;
+        case IGraphicsAPI::DataType::BYTE:
+            glType = GL_BYTE;
+            break;
+        case IGraphicsAPI::DataType::SHORT:
+            glType = GL_SHORT;
+            break;
+        case IGraphicsAPI::DataType::USHORT:
+            glType = GL_UNSIGNED_SHORT;
+            break;
+        case IGraphicsAPI::DataType::HALF_FLOAT:
+            glType = GL_HALF_FLOAT;
+            break;
         default:
             throw std::runtime_error("Invalid Vertex Type");
         }
@@ -442,6 +586,9 @@ namespace clay {
         case IGraphicsAPI::DataType::INT:
             glType = GL_INT;
             break;
+        case IGraphicsAPI::DataType::USHORT:
+            glType = GL_UNSIGNED_SHORT;
+            break;
         case IGraphicsAPI::DataType::UINT:
             glType = GL_UNSIGNED_INT;
             break;
@@ -469,6 +616,16 @@ namespace clay {
     void GraphicsAPIOpenGL::deleteTexture(unsigned int n, unsigned int* textureId) {
         // TODO FIX THIS Error: OpenGL error in glDeleteTextures(n, textureId): 1282
         GL_CALL(glDeleteTextures(n, textureId));
+        // Deleted textures are unbound from every unit
+        for (unsigned int i = 0; i < n; ++i) {
+            for (auto& unitTextures : mBoundTextures_) {
+                for (auto& boundTexture : unitTextures) {
+                    if (boundTexture == textureId[i]) {
+                        boundTexture = 0;
+                    }
+                }
+            }
+        }
     }
 
     void GraphicsAPIOpenGL::genTextures(unsigned int count, unsigned int* textures) {
@@ -538,6 +695,21 @@ namespace clay {
             case IGraphicsAPI::TextureParameterOption::REPEAT: 
                 glParamValue = GL_REPEAT;
                 break;
+            case IGraphicsAPI::TextureParameterOption::MIRRORED_REPEAT: 
+                glParamValue = GL_MIRRORED_REPEAT;
+                break;
+            case IGraphicsAPI::TextureParameterOption::NEAREST_MIPMAP_NEAREST: 
+                glParamValue = GL_NEAREST_MIPMAP_NEAREST;
+                break;
+            case IGraphicsAPI::TextureParameterOption::LINEAR_MIPMAP_NEAREST: 
+                glParamValue = GL_LINEAR_MIPMAP_NEAREST;
+                break;
+            case IGraphicsAPI::TextureParameterOption::NEAREST_MIPMAP_LINEAR: 
+                glParamValue = GL_NEAREST_MIPMAP_LINEAR;
+                break;
+            case IGraphicsAPI::TextureParameterOption::LINEAR_MIPMAP_LINEAR: 
+                glParamValue = GL_LINEAR_MIPMAP_LINEAR;
+                break;
             default:
                 throw std::runtime_error("Invalid Texture Parameter Value");
         }
@@ -545,6 +717,36 @@ namespace clay {
         GL_CALL(glTexParameteri(glTarget, glParamName, glParamValue));
     }
 
+    void GraphicsAPIOpenGL::texParameteri(TextureTarget target, TextureParameterType paramName, int value) {
+        GLenum glTarget;
+
+        switch (target) {
+            case IGraphicsAPI::TextureTarget::TEXTURE_2D: 
+                glTarget = GL_TEXTURE_2D;
+                break;
+            case IGraphicsAPI::TextureTarget::TEXTURE_2D_ARRAY: 
+                glTarget = GL_TEXTURE_2D_ARRAY;
+                break;
+            default:
+                throw std::runtime_error("Invalid Texture target");
+        }
+
+        GLenum glParamName;
+
+        switch (paramName) {
+            case IGraphicsAPI::TextureParameterType::TEXTURE_BASE_LEVEL: 
+                glParamName = GL_TEXTURE_BASE_LEVEL;
+                break;
+            case IGraphicsAPI::TextureParameterType::TEXTURE_MAX_LEVEL: 
+                glParamName = GL_TEXTURE_MAX_LEVEL;
+                break;
+            default:
+                throw std::runtime_error("Invalid Texture Parameter");
+        }
+
+        GL_CALL(glTexParameteri(glTarget, glParamName, value));
+    }
+
     void GraphicsAPIOpenGL::texImage2D(IGraphicsAPI::TextureTarget target,
                             unsigned int level,
                             TextureFormat internalFormat,
@@ -649,6 +851,60 @@ namespace clay {
         GL_CALL(glTexImage2D(glTarget, level, glInternalFormat, width, height, border, glFormat, glDataType, data));
     }
 
+    void GraphicsAPIOpenGL::texSubImage2D(TextureTarget target,
+                            unsigned int level,
+                            unsigned int xOffset,
+                            unsigned int yOffset,
+                            unsigned int width,
+                            unsigned int height,
+                            TextureFormat format,
+                            DataType dataType,
+                            const void* data) {
+        GLenum glTarget;
+
+        switch (target) {
+            case IGraphicsAPI::TextureTarget::TEXTURE_2D: 
+                glTarget = GL_TEXTURE_2D;
+                break;
+            case IGraphicsAPI::TextureTarget::TEXTURE_2D_ARRAY: 
+                glTarget = GL_TEXTURE_2D_ARRAY;
+                break;
+            default:
+                throw std::runtime_error("Invalid Texture target");
+        }
+
+        GLenum glFormat;
+
+        switch (format) {
+            case IGraphicsAPI::TextureFormat::RGB: 
+                glFormat = GL_RGB;
+                break;
+            case IGraphicsAPI::TextureFormat::RGBA: 
+                glFormat = GL_RGBA;
+                break;
+            case IGraphicsAPI::TextureFormat::RED: 
+                glFormat = GL_RED;
+                break;
+            default:
+                throw std::runtime_error("Invalid Texture input format");
+        }
+
+        GLenum glDataType;
+
+        switch (dataType) {
+            case IGraphicsAPI::DataType::UBYTE: 
+                glDataType = GL_UNSIGNED_BYTE;
+                break;
+            case IGraphicsAPI::DataType::FLOAT: 
+                glDataType = GL_FLOAT;
+                break;
+            default:
+                throw std::runtime_error("Invalid Texture Data type");
+        }
+
+        GL_CALL(glTexSubImage2D(glTarget, level, xOffset, yOffset, width, height, glFormat, glDataType, data));
+    }
+
     void GraphicsAPIOpenGL::bindTexture(TextureTarget target, unsigned int textureId) {
         GLenum glTarget;
 
@@ -671,14 +927,24 @@ namespace clay {
             case IGraphicsAPI::TextureTarget::TEXTURE_2D_MULTISAMPLE_ARRAY: 
                 glTarget = GL_TEXTURE_2D_MULTISAMPLE_ARRAY;
                 break;
+            case IGraphicsAPI::TextureTarget::TEXTURE_BUFFER: 
+                glTarget = GL_TEXTURE_BUFFER;
+                break;
             default:
                 throw std::runtime_error("Invalid Texture target");
         }
 
-        GL_CALL(glBindTexture(glTarget, textureId));
+        if (mActiveTextureUnit_ < MAX_SHADOWED_TEXTURE_UNITS) {
+            if (updateShadow(mBoundTextures_[mActiveTextureUnit_][static_cast<size_t>(target)], textureId)) {
+                GL_CALL(glBindTexture(glTarget, textureId));
+            }
+        } else {
+            ++mStateFilterStats_.forwarded;
+            GL_CALL(glBindTexture(glTarget, textureId));
+        }
     }
 
-    void GraphicsAPIOpenGL::getTexImage(TextureTarget target, unsigned int level, TextureFormat format, DataType dataType, void* pixels) {
+    void GraphicsAPIOpenGL::generateMipmap(TextureTarget target) {
         GLenum glTarget;
 
         switch (target) {
@@ -704,95 +970,345 @@ namespace clay {
                 throw std::runtime_error("Invalid Texture target");
         }
 
-        GLenum glFormat;
+        GL_CALL(glGenerateMipmap(glTarget));
+    }
 
-        switch (format) {
-            case IGraphicsAPI::TextureFormat::SRGB: 
-                glFormat = GL_SRGB;
-                break;
-            case IGraphicsAPI::TextureFormat::SRGB_ALPHA: 
-                glFormat = GL_SRGB_ALPHA;
-                break;
-            case IGraphicsAPI::TextureFormat::RGB: 
-                glFormat = GL_RGB;
+    void GraphicsAPIOpenGL::genSamplers(unsigned int count, unsigned int* samplers) {
+        GL_CALL(glGenSamplers(count, samplers));
+    }
+
+    void GraphicsAPIOpenGL::deleteSamplers(unsigned int count, unsigned int* samplers) {
+        GL_CALL(glDeleteSamplers(count, samplers));
+        // Deleted samplers are unbound from every unit
+        for (unsigned int i = 0; i < count; ++i) {
+            for (auto& boundSampler : mBoundSamplers_) {
+                if (boundSampler == samplers[i]) {
+                    boundSampler = 0;
+                }
+            }
+        }
+    }
+
+    void GraphicsAPIOpenGL::bindSampler(unsigned int textureUnit, unsigned int sampler) {
+        if (textureUnit < MAX_SHADOWED_TEXTURE_UNITS) {
+            if (updateShadow(mBoundSamplers_[textureUnit], sampler)) {
+                GL_CALL(glBindSampler(textureUnit, sampler));
+            }
+        } else {
+            ++mStateFilterStats_.forwarded;
+            GL_CALL(glBindSampler(textureUnit, sampler));
+        }
+    }
+
+    void GraphicsAPIOpenGL::samplerParameter(unsigned int sampler, TextureParameterType paramName, TextureParameterOption paramValue) {
+        GLenum glParamName;
+
+        switch (paramName) {
+            case IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_S: 
+                glParamName = GL_TEXTURE_WRAP_S;
                 break;
-            case IGraphicsAPI::TextureFormat::RGBA: 
-                glFormat = GL_RGBA;
+            case IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_T: 
+                glParamName = GL_TEXTURE_WRAP_T;
                 break;
-            case IGraphicsAPI::TextureFormat::RED: 
-                glFormat = GL_RED;
+            case IGraphicsAPI::TextureParameterType::TEXTURE_MIN_FILTER: 
+                glParamName = GL_TEXTURE_MIN_FILTER;
                 break;
-            case IGraphicsAPI::TextureFormat::RGBA16F: 
-                glFormat = GL_RGBA16F;
+            case IGraphicsAPI::TextureParameterType::TEXTURE_MAG_FILTER: 
+                glParamName = GL_TEXTURE_MAG_FILTER;
                 break;
             default:
-                throw std::runtime_error("Invalid Texture input format");
+                throw std::runtime_error("Invalid Texture Parameter");
         }
 
-        GLenum glDataType;
+        GLenum glParamValue;
 
-        switch (dataType) {
-            case IGraphicsAPI::DataType::BYTE: 
-                glDataType = GL_BYTE;
+        switch (paramValue) {
+            case IGraphicsAPI::TextureParameterOption::CLAMP_TO_BORDER: 
+                glParamValue = GL_CLAMP_TO_BORDER;
                 break;
-            case IGraphicsAPI::DataType::UBYTE: 
-                glDataType = GL_UNSIGNED_BYTE;
+            case IGraphicsAPI::TextureParameterOption::NEAREST: 
+                glParamValue = GL_NEAREST;
                 break;
-            case IGraphicsAPI::DataType::FLOAT: 
-                glDataType = GL_FLOAT;
+            case IGraphicsAPI::TextureParameterOption::LINEAR: 
+                glParamValue = GL_LINEAR;
+                break;
+            case IGraphicsAPI::TextureParameterOption::CLAMP_TO_EDGE: 
+                glParamValue = GL_CLAMP_TO_EDGE;
+                break;
+            case IGraphicsAPI::TextureParameterOption::REPEAT: 
+                glParamValue = GL_REPEAT;
+                break;
+            case IGraphicsAPI::TextureParameterOption::MIRRORED_REPEAT: 
+                glParamValue = GL_MIRRORED_REPEAT;
+                break;
+            case IGraphicsAPI::TextureParameterOption::NEAREST_MIPMAP_NEAREST: 
+                glParamValue = GL_NEAREST_MIPMAP_NEAREST;
+                break;
+            case IGraphicsAPI::TextureParameterOption::LINEAR_MIPMAP_NEAREST: 
+                glParamValue = GL_LINEAR_MIPMAP_NEAREST;
+                break;
+            case IGraphicsAPI::TextureParameterOption::NEAREST_MIPMAP_LINEAR: 
+                glParamValue = GL_NEAREST_MIPMAP_LINEAR;
+                break;
+            case IGraphicsAPI::TextureParameterOption::LINEAR_MIPMAP_LINEAR: 
+                glParamValue = GL_LINEAR_MIPMAP_LINEAR;
                 break;
             default:
-                throw std::runtime_error("Invalid Texture Data type");
+                throw std::runtime_error("Invalid Texture Parameter Value");
         }
 
-        GL_CALL(glGetTexImage(glTarget, 0, glFormat, glDataType, pixels));
+        GL_CALL(glSamplerParameteri(sampler, glParamName, glParamValue));
     }
 
-    void GraphicsAPIOpenGL::pixelStore(PixelAlignment alignment, unsigned int value) {
-        GLenum GLAlignment;
+    void GraphicsAPIOpenGL::samplerParameterf(unsigned int sampler, TextureParameterType paramName, float value) {
+        GLenum glParamName;
 
-        switch (alignment) {
-        case PixelAlignment::PACK_ALIGNMENT:
-            GLAlignment = GL_PACK_ALIGNMENT;
-            break;
-        case PixelAlignment::UNPACK_ALIGNMENT:
-            GLAlignment = GL_UNPACK_ALIGNMENT;
-            break;
-        default:
-            throw std::runtime_error("Pixel Alignment type");
+        switch (paramName) {
+            case IGraphicsAPI::TextureParameterType::TEXTURE_MAX_ANISOTROPY: 
+                glParamName = GL_TEXTURE_MAX_ANISOTROPY_EXT;
+                break;
+            default:
+                throw std::runtime_error("Invalid Texture Parameter");
         }
-        GL_CALL(glPixelStorei(GLAlignment, value));
+
+        GL_CALL(glSamplerParameterf(sampler, glParamName, value));
     }
 
-    void GraphicsAPIOpenGL::activeTexture(unsigned int textureUnit) {
-        GL_CALL(glActiveTexture(GL_TEXTURE0 + textureUnit));
+    float GraphicsAPIOpenGL::getMaxAnisotropy() {
+        if (!GLEW_EXT_texture_filter_anisotropic && !GLEW_ARB_texture_filter_anisotropic) {
+            return 1.0f;
+        }
+        float maxAnisotropy = 1.0f;
+        GL_CALL(glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy));
+        return maxAnisotropy;
     }
 
-    void GraphicsAPIOpenGL::bindBufferRange(BufferTarget target, unsigned int index, unsigned int buffer, size_t offset, size_t size) {
+    void GraphicsAPIOpenGL::compressedTexImage2D(TextureTarget target,
+                            unsigned int level,
+                            CompressedFormat format,
+                            unsigned int width,
+                            unsigned int height,
+                            size_t imageSize,
+                            const void* data) {
         GLenum glTarget;
 
         switch (target) {
-        case IGraphicsAPI::BufferTarget::ARRAY_BUFFER:
-            glTarget = GL_ARRAY_BUFFER;
-            break;
-        case IGraphicsAPI::BufferTarget::ATOMIC_COUNTER_BUFFER:
-            glTarget = GL_ATOMIC_COUNTER_BUFFER;
-            break;
-        case IGraphicsAPI::BufferTarget::COPY_READ_BUFFER:
-            glTarget = GL_COPY_READ_BUFFER;
-            break;
-        case IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER:
-            glTarget = GL_COPY_WRITE_BUFFER;
-            break;
-        case IGraphicsAPI::BufferTarget::DISPATCH_INDIRECT_BUFFER:
-            glTarget = GL_DISPATCH_INDIRECT_BUFFER;
-            break;
-        case IGraphicsAPI::BufferTarget::DRAW_INDIRECT_BUFFER:
-            glTarget = GL_DRAW_INDIRECT_BUFFER;
-            break;
-        case IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER:
-            glTarget = GL_ELEMENT_ARRAY_BUFFER;
-            break;
+            case IGraphicsAPI::TextureTarget::TEXTURE_2D: 
+                glTarget = GL_TEXTURE_2D;
+                break;
+            case IGraphicsAPI::TextureTarget::TEXTURE_2D_ARRAY: 
+                glTarget = GL_TEXTURE_2D_ARRAY;
+                break;
+            default:
+                throw std::runtime_error("Invalid Texture target");
+        }
+
+        GLenum glInternalFormat;
+
+        switch (format) {
+            case IGraphicsAPI::CompressedFormat::BC1_RGB: 
+                glInternalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+                break;
+            case IGraphicsAPI::CompressedFormat::BC1_SRGB: 
+                glInternalFormat = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+                break;
+            case IGraphicsAPI::CompressedFormat::BC1_RGBA: 
+                glInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+                break;
+            case IGraphicsAPI::CompressedFormat::BC1_SRGB_ALPHA: 
+                glInternalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+                break;
+            case IGraphicsAPI::CompressedFormat::BC3_RGBA: 
+                glInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                break;
+            case IGraphicsAPI::CompressedFormat::BC3_SRGB_ALPHA: 
+                glInternalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+                break;
+            case IGraphicsAPI::CompressedFormat::BC4_R: 
+                glInternalFormat = GL_COMPRESSED_RED_RGTC1;
+                break;
+            case IGraphicsAPI::CompressedFormat::BC5_RG: 
+                glInternalFormat = GL_COMPRESSED_RG_RGTC2;
+                break;
+            case IGraphicsAPI::CompressedFormat::BC7_RGBA: 
+                glInternalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+                break;
+            case IGraphicsAPI::CompressedFormat::BC7_SRGB_ALPHA: 
+                glInternalFormat = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+                break;
+            case IGraphicsAPI::CompressedFormat::ETC2_RGB: 
+                glInternalFormat = GL_COMPRESSED_RGB8_ETC2;
+                break;
+            case IGraphicsAPI::CompressedFormat::ETC2_SRGB: 
+                glInternalFormat = GL_COMPRESSED_SRGB8_ETC2;
+                break;
+            case IGraphicsAPI::CompressedFormat::ETC2_RGBA: 
+                glInternalFormat = GL_COMPRESSED_RGBA8_ETC2_EAC;
+                break;
+            case IGraphicsAPI::CompressedFormat::ETC2_SRGB_ALPHA: 
+                glInternalFormat = GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+                break;
+            case IGraphicsAPI::CompressedFormat::ASTC_4x4_RGBA: 
+                glInternalFormat = GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+                break;
+            case IGraphicsAPI::CompressedFormat::ASTC_4x4_SRGB_ALPHA: 
+                glInternalFormat = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR;
+                break;
+            default:
+                throw std::runtime_error("Invalid Compressed texture format");
+        }
+
+        GL_CALL(glCompressedTexImage2D(glTarget, level, glInternalFormat, width, height, 0, static_cast<GLsizei>(imageSize), data));
+    }
+
+    bool GraphicsAPIOpenGL::isCompressedFormatSupported(CompressedFormat format) {
+        switch (format) {
+            case IGraphicsAPI::CompressedFormat::BC1_RGB: 
+            case IGraphicsAPI::CompressedFormat::BC1_RGBA: 
+            case IGraphicsAPI::CompressedFormat::BC3_RGBA: 
+                return GLEW_EXT_texture_compression_s3tc != 0;
+            case IGraphicsAPI::CompressedFormat::BC1_SRGB: 
+            case IGraphicsAPI::CompressedFormat::BC1_SRGB_ALPHA: 
+            case IGraphicsAPI::CompressedFormat::BC3_SRGB_ALPHA: 
+                // The sRGB S3TC formats come from EXT_texture_sRGB on top of S3TC
+                return GLEW_EXT_texture_compression_s3tc != 0 && GLEW_EXT_texture_sRGB != 0;
+            case IGraphicsAPI::CompressedFormat::BC4_R: 
+            case IGraphicsAPI::CompressedFormat::BC5_RG: 
+                // RGTC is core since OpenGL 3.0
+                return true;
+            case IGraphicsAPI::CompressedFormat::BC7_RGBA: 
+            case IGraphicsAPI::CompressedFormat::BC7_SRGB_ALPHA: 
+                return GLEW_ARB_texture_compression_bptc != 0;
+            case IGraphicsAPI::CompressedFormat::ETC2_RGB: 
+            case IGraphicsAPI::CompressedFormat::ETC2_SRGB: 
+            case IGraphicsAPI::CompressedFormat::ETC2_RGBA: 
+            case IGraphicsAPI::CompressedFormat::ETC2_SRGB_ALPHA: 
+                return GLEW_ARB_ES3_compatibility != 0;
+            case IGraphicsAPI::CompressedFormat::ASTC_4x4_RGBA: 
+            case IGraphicsAPI::CompressedFormat::ASTC_4x4_SRGB_ALPHA: 
+                return GLEW_KHR_texture_compression_astc_ldr != 0;
+            default:
+                throw std::runtime_error("Invalid Compressed texture format");
+        }
+    }
+
+    void GraphicsAPIOpenGL::getTexImage(TextureTarget target, unsigned int level, TextureFormat format, DataType dataType, void* pixels) {
+        GLenum glTarget;
+
+        switch (target) {
+            case IGraphicsAPI::TextureTarget::TEXTURE_1D: 
+                glTarget = GL_TEXTURE_1D;
+                break;
+            case IGraphicsAPI::TextureTarget::TEXTURE_1D_ARRAY: 
+                glTarget = GL_TEXTURE_1D_ARRAY;
+                break;
+            case IGraphicsAPI::TextureTarget::TEXTURE_2D: 
+                glTarget = GL_TEXTURE_2D;
+                break;
+            case IGraphicsAPI::TextureTarget::TEXTURE_2D_ARRAY: 
+                glTarget = GL_TEXTURE_2D_ARRAY;
+                break;
+            case IGraphicsAPI::TextureTarget::TEXTURE_2D_MULTISAMPLE: 
+                glTarget = GL_TEXTURE_2D_MULTISAMPLE;
+                break;
+            case IGraphicsAPI::TextureTarget::TEXTURE_2D_MULTISAMPLE_ARRAY: 
+                glTarget = GL_TEXTURE_2D_MULTISAMPLE_ARRAY;
+                break;
+            default:
+                throw std::runtime_error("Invalid Texture target");
+        }
+
+        GLenum glFormat;
+
+        switch (format) {
+            case IGraphicsAPI::TextureFormat::SRGB: 
+                glFormat = GL_SRGB;
+                break;
+            case IGraphicsAPI::TextureFormat::SRGB_ALPHA: 
+                glFormat = GL_SRGB_ALPHA;
+                break;
+            case IGraphicsAPI::TextureFormat::RGB: 
+                glFormat = GL_RGB;
+                break;
+            case IGraphicsAPI::TextureFormat::RGBA: 
+                glFormat = GL_RGBA;
+                break;
+            case IGraphicsAPI::TextureFormat::RED: 
+                glFormat = GL_RED;
+                break;
+            case IGraphicsAPI::TextureFormat::RGBA16F: 
+                glFormat = GL_RGBA16F;
+                break;
+            default:
+                throw std::runtime_error("Invalid Texture input format");
+        }
+
+        GLenum glDataType;
+
+        switch (dataType) {
+            case IGraphicsAPI::DataType::BYTE: 
+                glDataType = GL_BYTE;
+                break;
+            case IGraphicsAPI::DataType::UBYTE: 
+                glDataType = GL_UNSIGNED_BYTE;
+                break;
+            case IGraphicsAPI::DataType::FLOAT: 
+                glDataType = GL_FLOAT;
+                break;
+            default:
+                throw std::runtime_error("Invalid Texture Data type");
+        }
+
+        GL_CALL(glGetTexImage(glTarget, 0, glFormat, glDataType, pixels));
+    }
+
+    void GraphicsAPIOpenGL::pixelStore(PixelAlignment alignment, unsigned int value) {
+        GLenum GLAlignment;
+
+        switch (alignment) {
+        case PixelAlignment::PACK_ALIGNMENT:
+            GLAlignment = GL_PACK_ALIGNMENT;
+            break;
+        case PixelAlignment::UNPACK_ALIGNMENT:
+            GLAlignment = GL_UNPACK_ALIGNMENT;
+            break;
+        default:
+            throw std::runtime_error("Pixel Alignment type");
+        }
+        GL_CALL(glPixelStorei(GLAlignment, value));
+    }
+
+    void GraphicsAPIOpenGL::activeTexture(unsigned int textureUnit) {
+        if (updateShadow(mActiveTextureUnit_, textureUnit)) {
+            GL_CALL(glActiveTexture(GL_TEXTURE0 + textureUnit));
+        }
+    }
+
+    void GraphicsAPIOpenGL::bindBufferRange(BufferTarget target, unsigned int index, unsigned int buffer, size_t offset, size_t size) {
+        GLenum glTarget;
+
+        switch (target) {
+        case IGraphicsAPI::BufferTarget::ARRAY_BUFFER:
+            glTarget = GL_ARRAY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::ATOMIC_COUNTER_BUFFER:
+            glTarget = GL_ATOMIC_COUNTER_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::COPY_READ_BUFFER:
+            glTarget = GL_COPY_READ_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER:
+            glTarget = GL_COPY_WRITE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::DISPATCH_INDIRECT_BUFFER:
+            glTarget = GL_DISPATCH_INDIRECT_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::DRAW_INDIRECT_BUFFER:
+            glTarget = GL_DRAW_INDIRECT_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER:
+            glTarget = GL_ELEMENT_ARRAY_BUFFER;
+            break;
         case IGraphicsAPI::BufferTarget::PIXEL_PACK_BUFFER:
             glTarget = GL_PIXEL_PACK_BUFFER;
             break;
@@ -819,6 +1335,8 @@ namespace clay {
         }
 
         GL_CALL(glBindBufferRange(glTarget, index, buffer, offset, size));
+        // Also binds the buffer to the generic binding point of the target
+        mBoundBuffers_[static_cast<size_t>(target)] = buffer;
     }
 
     void GraphicsAPIOpenGL::genFrameBuffers(unsigned int count, unsigned int* fbos) {
@@ -983,6 +1501,509 @@ namespace clay {
         GL_CALL(glDrawBuffer(GL_COLOR_ATTACHMENT0 + bufferId));
     }
 
+    void GraphicsAPIOpenGL::vertexAttribDivisor(unsigned int index, unsigned int divisor) {
+        GL_CALL(glVertexAttribDivisor(index, divisor));
+    }
+
+    void GraphicsAPIOpenGL::drawElementsInstanced(PrimitiveTopology mode, int count, DataType type, const void* indices, unsigned int instanceCount) {
+        GLenum glMode;
+
+        switch (mode) {
+        case IGraphicsAPI::PrimitiveTopology::POINT_LIST:
+            glMode = GL_POINTS;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LIST:
+            glMode = GL_LINES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_STRIP:
+            glMode = GL_LINE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LOOP:
+            glMode = GL_LINE_LOOP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST:
+            glMode = GL_TRIANGLES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_STRIP:
+            glMode = GL_TRIANGLE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_FAN:
+            glMode = GL_TRIANGLE_FAN;
+            break;
+        default:
+            throw std::runtime_error("Invalid PrimitiveTopology Type");
+        }
+
+        GLenum glType;
+
+        switch (type) {
+        case IGraphicsAPI::DataType::UBYTE:
+            glType = GL_UNSIGNED_BYTE;
+            break;
+        case IGraphicsAPI::DataType::USHORT:
+            glType = GL_UNSIGNED_SHORT;
+            break;
+        case IGraphicsAPI::DataType::UINT:
+            glType = GL_UNSIGNED_INT;
+            break;
+        default:
+            throw std::runtime_error("Invalid Index Type");
+        }
+
+        GL_CALL(glDrawElementsInstanced(glMode, count, glType, indices, instanceCount));
+    }
+
+    void GraphicsAPIOpenGL::blendFunc(BlendFactor srcFactor, BlendFactor dstFactor) {
+        GLenum glSrc;
+        GLenum glDst;
+        GLenum* factors[2] = {&glSrc, &glDst};
+        const BlendFactor inputs[2] = {srcFactor, dstFactor};
+
+        for (int i = 0; i < 2; ++i) {
+            switch (inputs[i]) {
+            case IGraphicsAPI::BlendFactor::ZERO:
+                *factors[i] = GL_ZERO;
+                break;
+            case IGraphicsAPI::BlendFactor::ONE:
+                *factors[i] = GL_ONE;
+                break;
+            case IGraphicsAPI::BlendFactor::SRC_ALPHA:
+                *factors[i] = GL_SRC_ALPHA;
+                break;
+            case IGraphicsAPI::BlendFactor::ONE_MINUS_SRC_ALPHA:
+                *factors[i] = GL_ONE_MINUS_SRC_ALPHA;
+                break;
+            default:
+                throw std::runtime_error("Invalid BlendFactor");
+            }
+        }
+        GL_CALL(glBlendFunc(glSrc, glDst));
+    }
+
+    void GraphicsAPIOpenGL::viewport(int x, int y, int width, int height) {
+        GL_CALL(glViewport(x, y, width, height));
+    }
+
+    void GraphicsAPIOpenGL::getViewport(int* outViewport) {
+        GL_CALL(glGetIntegerv(GL_VIEWPORT, outViewport));
+    }
+
+    void GraphicsAPIOpenGL::texBuffer(TextureFormat internalFormat, unsigned int buffer) {
+        GLenum glInternalFormat;
+
+        switch (internalFormat) {
+            case IGraphicsAPI::TextureFormat::RGBA32F:
+                glInternalFormat = GL_RGBA32F;
+                break;
+            case IGraphicsAPI::TextureFormat::R16UI:
+                glInternalFormat = GL_R16UI;
+                break;
+            case IGraphicsAPI::TextureFormat::RG32UI:
+                glInternalFormat = GL_RG32UI;
+                break;
+            default:
+                throw std::runtime_error("Invalid Texture buffer format");
+        }
+
+        GL_CALL(glTexBuffer(GL_TEXTURE_BUFFER, glInternalFormat, buffer));
+    }
+
+    bool GraphicsAPIOpenGL::isBufferStorageSupported() {
+        return GLEW_ARB_buffer_storage != 0;
+    }
+
+    void GraphicsAPIOpenGL::bufferStorage(BufferTarget target, size_t size, const void* data, const std::vector<BufferAccess>& access) {
+        GLenum glTarget;
+
+        switch (target) {
+        case IGraphicsAPI::BufferTarget::ARRAY_BUFFER:
+            glTarget = GL_ARRAY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::ATOMIC_COUNTER_BUFFER:
+            glTarget = GL_ATOMIC_COUNTER_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::COPY_READ_BUFFER:
+            glTarget = GL_COPY_READ_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER:
+            glTarget = GL_COPY_WRITE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::DISPATCH_INDIRECT_BUFFER:
+            glTarget = GL_DISPATCH_INDIRECT_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::DRAW_INDIRECT_BUFFER:
+            glTarget = GL_DRAW_INDIRECT_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER:
+            glTarget = GL_ELEMENT_ARRAY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::PIXEL_PACK_BUFFER:
+            glTarget = GL_PIXEL_PACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::PIXEL_UNPACK_BUFFER:
+            glTarget = GL_PIXEL_UNPACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::QUERY_BUFFER:
+            glTarget = GL_QUERY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::SHADER_STORAGE_BUFFER:
+            glTarget = GL_SHADER_STORAGE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::TEXTURE_BUFFER:
+            glTarget = GL_TEXTURE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::TRANSFORM_FEEDBACK_BUFFER:
+            glTarget = GL_TRANSFORM_FEEDBACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::UNIFORM_BUFFER:
+            glTarget = GL_UNIFORM_BUFFER;
+            break;
+        default:
+            throw std::runtime_error("Invalid buffer target");
+        }
+
+        GLbitfield glFlags = 0;
+        for (IGraphicsAPI::BufferAccess flag : access) {
+            switch (flag) {
+            case IGraphicsAPI::BufferAccess::READ:
+                glFlags |= GL_MAP_READ_BIT;
+                break;
+            case IGraphicsAPI::BufferAccess::WRITE:
+                glFlags |= GL_MAP_WRITE_BIT;
+                break;
+            case IGraphicsAPI::BufferAccess::PERSISTENT:
+                glFlags |= GL_MAP_PERSISTENT_BIT;
+                break;
+            case IGraphicsAPI::BufferAccess::COHERENT:
+                glFlags |= GL_MAP_COHERENT_BIT;
+                break;
+            default:
+                throw std::runtime_error("Invalid buffer storage flag");
+            }
+        }
+
+        GL_CALL(glBufferStorage(glTarget, size, data, glFlags));
+    }
+
+    void* GraphicsAPIOpenGL::mapBufferRange(BufferTarget target, size_t offset, size_t size, const std::vector<BufferAccess>& access) {
+        GLenum glTarget;
+
+        switch (target) {
+        case IGraphicsAPI::BufferTarget::ARRAY_BUFFER:
+            glTarget = GL_ARRAY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::ATOMIC_COUNTER_BUFFER:
+            glTarget = GL_ATOMIC_COUNTER_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::COPY_READ_BUFFER:
+            glTarget = GL_COPY_READ_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER:
+            glTarget = GL_COPY_WRITE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::DISPATCH_INDIRECT_BUFFER:
+            glTarget = GL_DISPATCH_INDIRECT_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::DRAW_INDIRECT_BUFFER:
+            glTarget = GL_DRAW_INDIRECT_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER:
+            glTarget = GL_ELEMENT_ARRAY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::PIXEL_PACK_BUFFER:
+            glTarget = GL_PIXEL_PACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::PIXEL_UNPACK_BUFFER:
+            glTarget = GL_PIXEL_UNPACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::QUERY_BUFFER:
+            glTarget = GL_QUERY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::SHADER_STORAGE_BUFFER:
+            glTarget = GL_SHADER_STORAGE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::TEXTURE_BUFFER:
+            glTarget = GL_TEXTURE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::TRANSFORM_FEEDBACK_BUFFER:
+            glTarget = GL_TRANSFORM_FEEDBACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::UNIFORM_BUFFER:
+            glTarget = GL_UNIFORM_BUFFER;
+            break;
+        default:
+            throw std::runtime_error("Invalid buffer target");
+        }
+
+        GLbitfield glFlags = 0;
+        for (IGraphicsAPI::BufferAccess flag : access) {
+            switch (flag) {
+            case IGraphicsAPI::BufferAccess::READ:
+                glFlags |= GL_MAP_READ_BIT;
+                break;
+            case IGraphicsAPI::BufferAccess::WRITE:
+                glFlags |= GL_MAP_WRITE_BIT;
+                break;
+            case IGraphicsAPI::BufferAccess::PERSISTENT:
+                glFlags |= GL_MAP_PERSISTENT_BIT;
+                break;
+            case IGraphicsAPI::BufferAccess::COHERENT:
+                glFlags |= GL_MAP_COHERENT_BIT;
+                break;
+            case IGraphicsAPI::BufferAccess::INVALIDATE_RANGE:
+                glFlags |= GL_MAP_INVALIDATE_RANGE_BIT;
+                break;
+            case IGraphicsAPI::BufferAccess::UNSYNCHRONIZED:
+                glFlags |= GL_MAP_UNSYNCHRONIZED_BIT;
+                break;
+            default:
+                throw std::runtime_error("Invalid buffer access flag");
+            }
+        }
+
+        void* mapped = nullptr;
+        GL_CALL(mapped = glMapBufferRange(glTarget, offset, size, glFlags));
+        return mapped;
+    }
+
+    void GraphicsAPIOpenGL::unmapBuffer(BufferTarget target) {
+        GLenum glTarget;
+
+        switch (target) {
+        case IGraphicsAPI::BufferTarget::ARRAY_BUFFER:
+            glTarget = GL_ARRAY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::ATOMIC_COUNTER_BUFFER:
+            glTarget = GL_ATOMIC_COUNTER_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::COPY_READ_BUFFER:
+            glTarget = GL_COPY_READ_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER:
+            glTarget = GL_COPY_WRITE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::DISPATCH_INDIRECT_BUFFER:
+            glTarget = GL_DISPATCH_INDIRECT_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::DRAW_INDIRECT_BUFFER:
+            glTarget = GL_DRAW_INDIRECT_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER:
+            glTarget = GL_ELEMENT_ARRAY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::PIXEL_PACK_BUFFER:
+            glTarget = GL_PIXEL_PACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::PIXEL_UNPACK_BUFFER:
+            glTarget = GL_PIXEL_UNPACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::QUERY_BUFFER:
+            glTarget = GL_QUERY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::SHADER_STORAGE_BUFFER:
+            glTarget = GL_SHADER_STORAGE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::TEXTURE_BUFFER:
+            glTarget = GL_TEXTURE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::TRANSFORM_FEEDBACK_BUFFER:
+            glTarget = GL_TRANSFORM_FEEDBACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::UNIFORM_BUFFER:
+            glTarget = GL_UNIFORM_BUFFER;
+            break;
+        default:
+            throw std::runtime_error("Invalid buffer target");
+        }
+
+        GL_CALL(glUnmapBuffer(glTarget));
+    }
+
+    void GraphicsAPIOpenGL::deleteBuffer(int size, unsigned int* buffers) {
+        GL_CALL(glDeleteBuffers(size, buffers));
+        // Deleting a bound buffer reverts the binding to 0, and the name can be handed out again
+        for (int i = 0; i < size; ++i) {
+            for (unsigned int& bound : mBoundBuffers_) {
+                if (bound == buffers[i]) {
+                    bound = 0;
+                }
+            }
+        }
+    }
+
+    void* GraphicsAPIOpenGL::fenceSync() {
+        GLsync sync = nullptr;
+        GL_CALL(sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        return sync;
+    }
+
+    bool GraphicsAPIOpenGL::clientWaitSync(void* sync, uint64_t timeoutNanoseconds) {
+        GLenum result;
+        GL_CALL(result = glClientWaitSync(static_cast<GLsync>(sync), GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNanoseconds));
+        if (result == GL_WAIT_FAILED) {
+            LOG_E("glClientWaitSync failed");
+            return true;
+        }
+        return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+    }
+
+    void GraphicsAPIOpenGL::deleteSync(void* sync) {
+        GL_CALL(glDeleteSync(static_cast<GLsync>(sync)));
+    }
+
+    void GraphicsAPIOpenGL::drawElementsBaseVertex(PrimitiveTopology mode, int count, DataType type, const void* indices, int baseVertex) {
+        GLenum glMode;
+
+        switch (mode) {
+        case IGraphicsAPI::PrimitiveTopology::POINT_LIST:
+            glMode = GL_POINTS;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LIST:
+            glMode = GL_LINES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_STRIP:
+            glMode = GL_LINE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LOOP:
+            glMode = GL_LINE_LOOP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST:
+            glMode = GL_TRIANGLES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_STRIP:
+            glMode = GL_TRIANGLE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_FAN:
+            glMode = GL_TRIANGLE_FAN;
+            break;
+        default:
+            throw std::runtime_error("Invalid PrimitiveTopology Type");
+        }
+
+        GLenum glType;
+
+        switch (type) {
+        case IGraphicsAPI::DataType::UBYTE:
+            glType = GL_UNSIGNED_BYTE;
+            break;
+        case IGraphicsAPI::DataType::USHORT:
+            glType = GL_UNSIGNED_SHORT;
+            break;
+        case IGraphicsAPI::DataType::UINT:
+            glType = GL_UNSIGNED_INT;
+            break;
+        default:
+            throw std::runtime_error("Invalid Index Type");
+        }
+
+        GL_CALL(glDrawElementsBaseVertex(glMode, count, glType, indices, baseVertex));
+    }
+
+    void GraphicsAPIOpenGL::drawElementsInstancedBaseVertex(PrimitiveTopology mode, int count, DataType type, const void* indices, unsigned int instanceCount, int baseVertex) {
+        GLenum glMode;
+
+        switch (mode) {
+        case IGraphicsAPI::PrimitiveTopology::POINT_LIST:
+            glMode = GL_POINTS;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LIST:
+            glMode = GL_LINES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_STRIP:
+            glMode = GL_LINE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LOOP:
+            glMode = GL_LINE_LOOP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST:
+            glMode = GL_TRIANGLES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_STRIP:
+            glMode = GL_TRIANGLE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_FAN:
+            glMode = GL_TRIANGLE_FAN;
+            break;
+        default:
+            throw std::runtime_error("Invalid PrimitiveTopology Type");
+        }
+
+        GLenum glType;
+
+        switch (type) {
+        case IGraphicsAPI::DataType::UBYTE:
+            glType = GL_UNSIGNED_BYTE;
+            break;
+        case IGraphicsAPI::DataType::USHORT:
+            glType = GL_UNSIGNED_SHORT;
+            break;
+        case IGraphicsAPI::DataType::UINT:
+            glType = GL_UNSIGNED_INT;
+            break;
+        default:
+            throw std::runtime_error("Invalid Index Type");
+        }
+
+        GL_CALL(glDrawElementsInstancedBaseVertex(glMode, count, glType, indices, instanceCount, baseVertex));
+    }
+
+    void GraphicsAPIOpenGL::copyBufferSubData(size_t readOffset, size_t writeOffset, size_t size) {
+        GL_CALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, readOffset, writeOffset, size));
+    }
+
+    bool GraphicsAPIOpenGL::isMultiDrawIndirectSupported() {
+        // The commands select their instance data with baseInstance, which must be 0 without ARB_base_instance
+        return GLEW_ARB_multi_draw_indirect != 0 && GLEW_ARB_base_instance != 0;
+    }
+
+    void GraphicsAPIOpenGL::multiDrawElementsIndirect(PrimitiveTopology mode, DataType type, const void* indirect, unsigned int drawCount, size_t stride) {
+        GLenum glMode;
+
+        switch (mode) {
+        case IGraphicsAPI::PrimitiveTopology::POINT_LIST:
+            glMode = GL_POINTS;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LIST:
+            glMode = GL_LINES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_STRIP:
+            glMode = GL_LINE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LOOP:
+            glMode = GL_LINE_LOOP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST:
+            glMode = GL_TRIANGLES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_STRIP:
+            glMode = GL_TRIANGLE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_FAN:
+            glMode = GL_TRIANGLE_FAN;
+            break;
+        default:
+            throw std::runtime_error("Invalid PrimitiveTopology Type");
+        }
+
+        GLenum glType;
+
+        switch (type) {
+        case IGraphicsAPI::DataType::UBYTE:
+            glType = GL_UNSIGNED_BYTE;
+            break;
+        case IGraphicsAPI::DataType::USHORT:
+            glType = GL_UNSIGNED_SHORT;
+            break;
+        case IGraphicsAPI::DataType::UINT:
+            glType = GL_UNSIGNED_INT;
+            break;
+        default:
+            throw std::runtime_error("Invalid Index Type");
+        }
+
+        GL_CALL(glMultiDrawElementsIndirect(glMode, glType, indirect, drawCount, static_cast<GLsizei>(stride)));
+    }
+
 } // namespace clay
 
 #endif
\ No newline at end of file
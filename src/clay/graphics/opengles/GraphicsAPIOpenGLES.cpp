@@ -746,6 +746,21 @@ unsigned int GraphicsAPIOpenGLES::getUniformLocation(unsigned int programId, con
     return uniformLocation;
 }
 
+int GraphicsAPIOpenGLES::getActiveUniformCount(unsigned int programId) {
+    GLint count = 0;
+    GL_CALL(glGetProgramiv(programId, GL_ACTIVE_UNIFORMS, &count));
+    return count;
+}
+
+std::string GraphicsAPIOpenGLES::getActiveUniformName(unsigned int programId, unsigned int index) {
+    char name[256];
+    GLsizei length = 0;
+    GLint size;
+    GLenum type;
+    GL_CALL(glGetActiveUniform(programId, index, sizeof(name), &length, &size, &type, name));
+    return std::string(name, length);
+}
+
 void GraphicsAPIOpenGLES::uniform1i(unsigned int location, int value) {
     GL_CALL(glUniform1i(location, value));
 }
@@ -824,6 +839,9 @@ void GraphicsAPIOpenGLES::enable(IGraphicsAPI::Capability capability) {
 //        case IGraphicsAPI::Capability::FRAMEBUFFER_SRGB:
 //            glCapability = GL_FRAMEBUFFER_SRGB;
 //            break;
+//        case IGraphicsAPI::Capability::DEPTH_TEST:
+//            glCapability = GL_DEPTH_TEST;
+//            break;
 //        default:
 //            throw std::runtime_error("Invalid capability");
 //    }
@@ -841,6 +859,9 @@ void GraphicsAPIOpenGLES::disable(IGraphicsAPI::Capability capability) {
 //        case IGraphicsAPI::Capability::FRAMEBUFFER_SRGB:
 //            glCapability = GL_FRAMEBUFFER_SRGB;
 //            break;
+//        case IGraphicsAPI::Capability::DEPTH_TEST:
+//            glCapability = GL_DEPTH_TEST;
+//            break;
 //        default:
 //            throw std::runtime_error("Invalid capability");
 //    }
@@ -848,10 +869,24 @@ void GraphicsAPIOpenGLES::disable(IGraphicsAPI::Capability capability) {
 //    GL_CALL(glDisable(glCapability));
 }
 
+bool GraphicsAPIOpenGLES::isEnabled(IGraphicsAPI::Capability capability) {
+    // Multisampling and sRGB writes are not toggled on GLES
+    if (capability != IGraphicsAPI::Capability::DEPTH_TEST) {
+        return false;
+    }
+    GLboolean enabled;
+    GL_CALL(enabled = glIsEnabled(GL_DEPTH_TEST));
+    return enabled == GL_TRUE;
+}
+
 void GraphicsAPIOpenGLES::genVertexArrays(unsigned int n, unsigned int* arrays) {
     GL_CALL(glGenVertexArrays(n, arrays));
 }
 
+void GraphicsAPIOpenGLES::deleteVertexArrays(unsigned int n, unsigned int* arrays) {
+    GL_CALL(glDeleteVertexArrays(n, arrays));
+}
+
 void GraphicsAPIOpenGLES::bindVertexArray(unsigned int vao) {
     GL_CALL(glBindVertexArray(vao));
 }
@@ -1015,6 +1050,21 @@ void GraphicsAPIOpenGLES::vertexAttribPointer(unsigned int index, int size, IGra
         case IGraphicsAPI::DataType::INT:
             glType = GL_INT;
             break;
+        case IGraphicsAPI::DataType::UBYTE:
+            glType = GL_UNSIGNED_BYTE;
+            break;
+        case IGraphicsAPI::DataType::BYTE:
+            glType = GL_BYTE;
+            break;
+        case IGraphicsAPI::DataType::SHORT:
+            glType = GL_SHORT;
+            break;
+        case IGraphicsAPI::DataType::USHORT:
+            glType = GL_UNSIGNED_SHORT;
+            break;
+        case IGraphicsAPI::DataType::HALF_FLOAT:
+            glType = GL_HALF_FLOAT;
+            break;
         default:
             throw std::runtime_error("Invalid Vertex Type");
     }
@@ -1060,6 +1110,9 @@ void GraphicsAPIOpenGLES::drawElements(IGraphicsAPI::PrimitiveTopology mode, int
         case IGraphicsAPI::DataType::INT:
             glType = GL_INT;
             break;
+        case IGraphicsAPI::DataType::USHORT:
+            glType = GL_UNSIGNED_SHORT;
+            break;
         case IGraphicsAPI::DataType::UINT:
             glType = GL_UNSIGNED_INT;
             break;
@@ -1156,6 +1209,21 @@ void GraphicsAPIOpenGLES::texParameter(IGraphicsAPI::TextureTarget target, IGrap
         case IGraphicsAPI::TextureParameterOption::REPEAT:
             glParamValue = GL_REPEAT;
             break;
+        case IGraphicsAPI::TextureParameterOption::MIRRORED_REPEAT:
+            glParamValue = GL_MIRRORED_REPEAT;
+            break;
+        case IGraphicsAPI::TextureParameterOption::NEAREST_MIPMAP_NEAREST:
+            glParamValue = GL_NEAREST_MIPMAP_NEAREST;
+            break;
+        case IGraphicsAPI::TextureParameterOption::LINEAR_MIPMAP_NEAREST:
+            glParamValue = GL_LINEAR_MIPMAP_NEAREST;
+            break;
+        case IGraphicsAPI::TextureParameterOption::NEAREST_MIPMAP_LINEAR:
+            glParamValue = GL_NEAREST_MIPMAP_LINEAR;
+            break;
+        case IGraphicsAPI::TextureParameterOption::LINEAR_MIPMAP_LINEAR:
+            glParamValue = GL_LINEAR_MIPMAP_LINEAR;
+            break;
         default:
             throw std::runtime_error("Invalid Texture Parameter Value");
     }
@@ -1163,6 +1231,36 @@ void GraphicsAPIOpenGLES::texParameter(IGraphicsAPI::TextureTarget target, IGrap
     GL_CALL(glTexParameteri(glTarget, glParamName, glParamValue));
 }
 
+void GraphicsAPIOpenGLES::texParameteri(IGraphicsAPI::TextureTarget target, IGraphicsAPI::TextureParameterType paramName, int value) {
+    GLenum glTarget;
+
+    switch (target) {
+        case IGraphicsAPI::TextureTarget::TEXTURE_2D:
+            glTarget = GL_TEXTURE_2D;
+            break;
+        case IGraphicsAPI::TextureTarget::TEXTURE_2D_ARRAY:
+            glTarget = GL_TEXTURE_2D_ARRAY;
+            break;
+        default:
+            throw std::runtime_error("Invalid Texture target");
+    }
+
+    GLenum glParamName;
+
+    switch (paramName) {
+        case IGraphicsAPI::TextureParameterType::TEXTURE_BASE_LEVEL:
+            glParamName = GL_TEXTURE_BASE_LEVEL;
+            break;
+        case IGraphicsAPI::TextureParameterType::TEXTURE_MAX_LEVEL:
+            glParamName = GL_TEXTURE_MAX_LEVEL;
+            break;
+        default:
+            throw std::runtime_error("Invalid Texture Parameter");
+    }
+
+    GL_CALL(glTexParameteri(glTarget, glParamName, value));
+}
+
 void GraphicsAPIOpenGLES::texImage2D(IGraphicsAPI::TextureTarget target,
                                    unsigned int level,
                                    TextureFormat internalFormat,
@@ -1267,6 +1365,60 @@ void GraphicsAPIOpenGLES::texImage2D(IGraphicsAPI::TextureTarget target,
     GL_CALL(glTexImage2D(glTarget, level, glInternalFormat, width, height, border, glFormat, glDataType, data));
 }
 
+void GraphicsAPIOpenGLES::texSubImage2D(IGraphicsAPI::TextureTarget target,
+                                      unsigned int level,
+                                      unsigned int xOffset,
+                                      unsigned int yOffset,
+                                      unsigned int width,
+                                      unsigned int height,
+                                      IGraphicsAPI::TextureFormat format,
+                                      IGraphicsAPI::DataType dataType,
+                                      const void* data) {
+    GLenum glTarget;
+
+    switch (target) {
+        case IGraphicsAPI::TextureTarget::TEXTURE_2D:
+            glTarget = GL_TEXTURE_2D;
+            break;
+        case IGraphicsAPI::TextureTarget::TEXTURE_2D_ARRAY:
+            glTarget = GL_TEXTURE_2D_ARRAY;
+            break;
+        default:
+            throw std::runtime_error("Invalid Texture target");
+    }
+
+    GLenum glFormat;
+
+    switch (format) {
+        case IGraphicsAPI::TextureFormat::RGB:
+            glFormat = GL_RGB;
+            break;
+        case IGraphicsAPI::TextureFormat::RGBA:
+            glFormat = GL_RGBA;
+            break;
+        case IGraphicsAPI::TextureFormat::RED:
+            glFormat = GL_LUMINANCE;
+            break;
+        default:
+            throw std::runtime_error("Invalid Texture input format");
+    }
+
+    GLenum glDataType;
+
+    switch (dataType) {
+        case IGraphicsAPI::DataType::UBYTE:
+            glDataType = GL_UNSIGNED_BYTE;
+            break;
+        case IGraphicsAPI::DataType::FLOAT:
+            glDataType = GL_FLOAT;
+            break;
+        default:
+            throw std::runtime_error("Invalid Texture Data type");
+    }
+
+    GL_CALL(glTexSubImage2D(glTarget, level, xOffset, yOffset, width, height, glFormat, glDataType, data));
+}
+
 void GraphicsAPIOpenGLES::bindTexture(TextureTarget target, unsigned int textureId) {
     GLenum glTarget;
 
@@ -1289,6 +1441,9 @@ void GraphicsAPIOpenGLES::bindTexture(TextureTarget target, unsigned int texture
         case IGraphicsAPI::TextureTarget::TEXTURE_2D_MULTISAMPLE_ARRAY:
             glTarget = GL_TEXTURE_2D_MULTISAMPLE_ARRAY;
             break;
+        case IGraphicsAPI::TextureTarget::TEXTURE_BUFFER:
+            glTarget = GL_TEXTURE_BUFFER;
+            break;
         default:
             throw std::runtime_error("Invalid Texture target");
     }
@@ -1296,6 +1451,183 @@ void GraphicsAPIOpenGLES::bindTexture(TextureTarget target, unsigned int texture
     GL_CALL(glBindTexture(glTarget, textureId));
 }
 
+void GraphicsAPIOpenGLES::generateMipmap(IGraphicsAPI::TextureTarget target) {
+    GLenum glTarget;
+
+    switch (target) {
+        case IGraphicsAPI::TextureTarget::TEXTURE_1D:
+            glTarget = GL_TEXTURE_1D;
+            break;
+        case IGraphicsAPI::TextureTarget::TEXTURE_1D_ARRAY:
+            glTarget = GL_TEXTURE_1D_ARRAY;
+            break;
+        case IGraphicsAPI::TextureTarget::TEXTURE_2D:
+            glTarget = GL_TEXTURE_2D;
+            break;
+        case IGraphicsAPI::TextureTarget::TEXTURE_2D_ARRAY:
+            glTarget = GL_TEXTURE_2D_ARRAY;
+            break;
+        case IGraphicsAPI::TextureTarget::TEXTURE_2D_MULTISAMPLE:
+            glTarget = GL_TEXTURE_2D_MULTISAMPLE;
+            break;
+        case IGraphicsAPI::TextureTarget::TEXTURE_2D_MULTISAMPLE_ARRAY:
+            glTarget = GL_TEXTURE_2D_MULTISAMPLE_ARRAY;
+            break;
+        default:
+            throw std::runtime_error("Invalid Texture target");
+    }
+
+    GL_CALL(glGenerateMipmap(glTarget));
+}
+
+void GraphicsAPIOpenGLES::genSamplers(unsigned int count, unsigned int* samplers) {
+    GL_CALL(glGenSamplers(count, samplers));
+}
+
+void GraphicsAPIOpenGLES::deleteSamplers(unsigned int count, unsigned int* samplers) {
+    GL_CALL(glDeleteSamplers(count, samplers));
+}
+
+void GraphicsAPIOpenGLES::bindSampler(unsigned int textureUnit, unsigned int sampler) {
+    GL_CALL(glBindSampler(textureUnit, sampler));
+}
+
+void GraphicsAPIOpenGLES::samplerParameter(unsigned int sampler, IGraphicsAPI::TextureParameterType paramName, IGraphicsAPI::TextureParameterOption paramValue) {
+    GLenum glParamName;
+
+    switch (paramName) {
+        case IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_S:
+            glParamName = GL_TEXTURE_WRAP_S;
+            break;
+        case IGraphicsAPI::TextureParameterType::TEXTURE_WRAP_T:
+            glParamName = GL_TEXTURE_WRAP_T;
+            break;
+        case IGraphicsAPI::TextureParameterType::TEXTURE_MIN_FILTER:
+            glParamName = GL_TEXTURE_MIN_FILTER;
+            break;
+        case IGraphicsAPI::TextureParameterType::TEXTURE_MAG_FILTER:
+            glParamName = GL_TEXTURE_MAG_FILTER;
+            break;
+        default:
+            throw std::runtime_error("Invalid Texture Parameter");
+    }
+
+    GLenum glParamValue;
+
+    switch (paramValue) {
+        case IGraphicsAPI::TextureParameterOption::CLAMP_TO_BORDER:
+            glParamValue = GL_CLAMP_TO_BORDER;
+            break;
+        case IGraphicsAPI::TextureParameterOption::NEAREST:
+            glParamValue = GL_NEAREST;
+            break;
+        case IGraphicsAPI::TextureParameterOption::LINEAR:
+            glParamValue = GL_LINEAR;
+            break;
+        case IGraphicsAPI::TextureParameterOption::CLAMP_TO_EDGE:
+            glParamValue = GL_CLAMP_TO_EDGE;
+            break;
+        case IGraphicsAPI::TextureParameterOption::REPEAT:
+            glParamValue = GL_REPEAT;
+            break;
+        case IGraphicsAPI::TextureParameterOption::MIRRORED_REPEAT:
+            glParamValue = GL_MIRRORED_REPEAT;
+            break;
+        case IGraphicsAPI::TextureParameterOption::NEAREST_MIPMAP_NEAREST:
+            glParamValue = GL_NEAREST_MIPMAP_NEAREST;
+            break;
+        case IGraphicsAPI::TextureParameterOption::LINEAR_MIPMAP_NEAREST:
+            glParamValue = GL_LINEAR_MIPMAP_NEAREST;
+            break;
+        case IGraphicsAPI::TextureParameterOption::NEAREST_MIPMAP_LINEAR:
+            glParamValue = GL_NEAREST_MIPMAP_LINEAR;
+            break;
+        case IGraphicsAPI::TextureParameterOption::LINEAR_MIPMAP_LINEAR:
+            glParamValue = GL_LINEAR_MIPMAP_LINEAR;
+            break;
+        default:
+            throw std::runtime_error("Invalid Texture Parameter Value");
+    }
+
+    GL_CALL(glSamplerParameteri(sampler, glParamName, glParamValue));
+}
+
+void GraphicsAPIOpenGLES::samplerParameterf(unsigned int sampler, IGraphicsAPI::TextureParameterType paramName, float value) {
+    // Anisotropic filtering is the only float parameter and is only an extension in OpenGL ES
+    throw std::runtime_error("Invalid Texture Parameter");
+}
+
+float GraphicsAPIOpenGLES::getMaxAnisotropy() {
+    return 1.0f;
+}
+
+void GraphicsAPIOpenGLES::compressedTexImage2D(IGraphicsAPI::TextureTarget target,
+                                             unsigned int level,
+                                             IGraphicsAPI::CompressedFormat format,
+                                             unsigned int width,
+                                             unsigned int height,
+                                             size_t imageSize,
+                                             const void* data) {
+    GLenum glTarget;
+
+    switch (target) {
+        case IGraphicsAPI::TextureTarget::TEXTURE_2D:
+            glTarget = GL_TEXTURE_2D;
+            break;
+        case IGraphicsAPI::TextureTarget::TEXTURE_2D_ARRAY:
+            glTarget = GL_TEXTURE_2D_ARRAY;
+            break;
+        default:
+            throw std::runtime_error("Invalid Texture target");
+    }
+
+    GLenum glInternalFormat;
+
+    switch (format) {
+        case IGraphicsAPI::CompressedFormat::ETC2_RGB:
+            glInternalFormat = GL_COMPRESSED_RGB8_ETC2;
+            break;
+        case IGraphicsAPI::CompressedFormat::ETC2_SRGB:
+            glInternalFormat = GL_COMPRESSED_SRGB8_ETC2;
+            break;
+        case IGraphicsAPI::CompressedFormat::ETC2_RGBA:
+            glInternalFormat = GL_COMPRESSED_RGBA8_ETC2_EAC;
+            break;
+        case IGraphicsAPI::CompressedFormat::ETC2_SRGB_ALPHA:
+            glInternalFormat = GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+            break;
+        case IGraphicsAPI::CompressedFormat::ASTC_4x4_RGBA:
+            glInternalFormat = GL_COMPRESSED_RGBA_ASTC_4x4;
+            break;
+        case IGraphicsAPI::CompressedFormat::ASTC_4x4_SRGB_ALPHA:
+            glInternalFormat = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4;
+            break;
+        default:
+            // BCn formats are only extensions in OpenGL ES
+            throw std::runtime_error("Invalid Compressed texture format");
+    }
+
+    GL_CALL(glCompressedTexImage2D(glTarget, level, glInternalFormat, width, height, 0, static_cast<GLsizei>(imageSize), data));
+}
+
+bool GraphicsAPIOpenGLES::isCompressedFormatSupported(IGraphicsAPI::CompressedFormat format) {
+    switch (format) {
+        case IGraphicsAPI::CompressedFormat::ETC2_RGB:
+        case IGraphicsAPI::CompressedFormat::ETC2_SRGB:
+        case IGraphicsAPI::CompressedFormat::ETC2_RGBA:
+        case IGraphicsAPI::CompressedFormat::ETC2_SRGB_ALPHA:
+            // ETC2 is core since OpenGL ES 3.0
+            return true;
+        case IGraphicsAPI::CompressedFormat::ASTC_4x4_RGBA:
+        case IGraphicsAPI::CompressedFormat::ASTC_4x4_SRGB_ALPHA:
+            // ASTC LDR is core since OpenGL ES 3.2
+            return true;
+        default:
+            // BCn formats are only extensions in OpenGL ES
+            return false;
+    }
+}
+
 void GraphicsAPIOpenGLES::getTexImage(IGraphicsAPI::TextureTarget target, unsigned int level, IGraphicsAPI::TextureFormat format, DataType dataType, void* pixels) {
 //    GLenum glTarget;
 //
@@ -1601,6 +1933,384 @@ void GraphicsAPIOpenGLES::drawBuffer(unsigned int bufferId) {
     //GL_CALL(glDrawBuffer(GL_COLOR_ATTACHMENT0 + bufferId));
 }
 
+void GraphicsAPIOpenGLES::vertexAttribDivisor(unsigned int index, unsigned int divisor) {
+    GL_CALL(glVertexAttribDivisor(index, divisor));
+}
+
+void GraphicsAPIOpenGLES::drawElementsInstanced(IGraphicsAPI::PrimitiveTopology mode, int count, IGraphicsAPI::DataType type, const void* indices, unsigned int instanceCount) {
+    GLenum glMode;
+
+    switch (mode) {
+        case IGraphicsAPI::PrimitiveTopology::POINT_LIST:
+            glMode = GL_POINTS;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LIST:
+            glMode = GL_LINES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_STRIP:
+            glMode = GL_LINE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LOOP:
+            glMode = GL_LINE_LOOP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST:
+            glMode = GL_TRIANGLES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_STRIP:
+            glMode = GL_TRIANGLE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_FAN:
+            glMode = GL_TRIANGLE_FAN;
+            break;
+        default:
+            throw std::runtime_error("Invalid PrimitiveTopology Type");
+    }
+
+    GLenum glType;
+
+    switch (type) {
+        case IGraphicsAPI::DataType::UBYTE:
+            glType = GL_UNSIGNED_BYTE;
+            break;
+        case IGraphicsAPI::DataType::USHORT:
+            glType = GL_UNSIGNED_SHORT;
+            break;
+        case IGraphicsAPI::DataType::UINT:
+            glType = GL_UNSIGNED_INT;
+            break;
+        default:
+            throw std::runtime_error("Invalid Index Type");
+    }
+
+    GL_CALL(glDrawElementsInstanced(glMode, count, glType, indices, instanceCount));
+}
+
+void GraphicsAPIOpenGLES::blendFunc(IGraphicsAPI::BlendFactor srcFactor, IGraphicsAPI::BlendFactor dstFactor) {
+    GLenum glSrc;
+    GLenum glDst;
+    GLenum* factors[2] = {&glSrc, &glDst};
+    const IGraphicsAPI::BlendFactor inputs[2] = {srcFactor, dstFactor};
+
+    for (int i = 0; i < 2; ++i) {
+        switch (inputs[i]) {
+            case IGraphicsAPI::BlendFactor::ZERO:
+                *factors[i] = GL_ZERO;
+                break;
+            case IGraphicsAPI::BlendFactor::ONE:
+                *factors[i] = GL_ONE;
+                break;
+            case IGraphicsAPI::BlendFactor::SRC_ALPHA:
+                *factors[i] = GL_SRC_ALPHA;
+                break;
+            case IGraphicsAPI::BlendFactor::ONE_MINUS_SRC_ALPHA:
+                *factors[i] = GL_ONE_MINUS_SRC_ALPHA;
+                break;
+            default:
+                throw std::runtime_error("Invalid BlendFactor");
+        }
+    }
+    GL_CALL(glBlendFunc(glSrc, glDst));
+}
+
+void GraphicsAPIOpenGLES::viewport(int x, int y, int width, int height) {
+    GL_CALL(glViewport(x, y, width, height));
+}
+
+void GraphicsAPIOpenGLES::getViewport(int* outViewport) {
+    GL_CALL(glGetIntegerv(GL_VIEWPORT, outViewport));
+}
+
+void GraphicsAPIOpenGLES::texBuffer(IGraphicsAPI::TextureFormat internalFormat, unsigned int buffer) {
+    GLenum glInternalFormat;
+
+    switch (internalFormat) {
+        case IGraphicsAPI::TextureFormat::RGBA32F:
+            glInternalFormat = GL_RGBA32F;
+            break;
+        case IGraphicsAPI::TextureFormat::R16UI:
+            glInternalFormat = GL_R16UI;
+            break;
+        case IGraphicsAPI::TextureFormat::RG32UI:
+            glInternalFormat = GL_RG32UI;
+            break;
+        default:
+            throw std::runtime_error("Invalid Texture buffer format");
+    }
+
+    GL_CALL(glTexBuffer(GL_TEXTURE_BUFFER, glInternalFormat, buffer));
+}
+
+bool GraphicsAPIOpenGLES::isBufferStorageSupported() {
+    // Buffer storage is only an extension in OpenGL ES
+    return false;
+}
+
+void GraphicsAPIOpenGLES::bufferStorage(IGraphicsAPI::BufferTarget target, size_t size, const void* data, const std::vector<IGraphicsAPI::BufferAccess>& access) {
+    throw std::runtime_error("Buffer storage is not supported");
+}
+
+void* GraphicsAPIOpenGLES::mapBufferRange(IGraphicsAPI::BufferTarget target, size_t offset, size_t size, const std::vector<IGraphicsAPI::BufferAccess>& access) {
+    GLenum glTarget;
+
+    switch (target) {
+        case IGraphicsAPI::BufferTarget::ARRAY_BUFFER:
+            glTarget = GL_ARRAY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::ATOMIC_COUNTER_BUFFER:
+            glTarget = GL_ATOMIC_COUNTER_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::COPY_READ_BUFFER:
+            glTarget = GL_COPY_READ_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER:
+            glTarget = GL_COPY_WRITE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::DISPATCH_INDIRECT_BUFFER:
+            glTarget = GL_DISPATCH_INDIRECT_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::DRAW_INDIRECT_BUFFER:
+            glTarget = GL_DRAW_INDIRECT_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER:
+            glTarget = GL_ELEMENT_ARRAY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::PIXEL_PACK_BUFFER:
+            glTarget = GL_PIXEL_PACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::PIXEL_UNPACK_BUFFER:
+            glTarget = GL_PIXEL_UNPACK_BUFFER;
+            break;
+//        case IGraphicsAPI::BufferTarget::QUERY_BUFFER:
+//            glTarget = GL_QUERY_BUFFER;
+//            break;
+        case IGraphicsAPI::BufferTarget::SHADER_STORAGE_BUFFER:
+            glTarget = GL_SHADER_STORAGE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::TEXTURE_BUFFER:
+            glTarget = GL_TEXTURE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::TRANSFORM_FEEDBACK_BUFFER:
+            glTarget = GL_TRANSFORM_FEEDBACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::UNIFORM_BUFFER:
+            glTarget = GL_UNIFORM_BUFFER;
+            break;
+        default:
+            throw std::runtime_error("Invalid buffer target");
+    }
+
+    GLbitfield glFlags = 0;
+    for (IGraphicsAPI::BufferAccess flag : access) {
+        switch (flag) {
+            case IGraphicsAPI::BufferAccess::READ:
+                glFlags |= GL_MAP_READ_BIT;
+                break;
+            case IGraphicsAPI::BufferAccess::WRITE:
+                glFlags |= GL_MAP_WRITE_BIT;
+                break;
+            case IGraphicsAPI::BufferAccess::INVALIDATE_RANGE:
+                glFlags |= GL_MAP_INVALIDATE_RANGE_BIT;
+                break;
+            case IGraphicsAPI::BufferAccess::UNSYNCHRONIZED:
+                glFlags |= GL_MAP_UNSYNCHRONIZED_BIT;
+                break;
+            default:
+                throw std::runtime_error("Invalid buffer access flag");
+        }
+    }
+
+    void* mapped = nullptr;
+    GL_CALL(mapped = glMapBufferRange(glTarget, offset, size, glFlags));
+    return mapped;
+}
+
+void GraphicsAPIOpenGLES::unmapBuffer(IGraphicsAPI::BufferTarget target) {
+    GLenum glTarget;
+
+    switch (target) {
+        case IGraphicsAPI::BufferTarget::ARRAY_BUFFER:
+            glTarget = GL_ARRAY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::ATOMIC_COUNTER_BUFFER:
+            glTarget = GL_ATOMIC_COUNTER_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::COPY_READ_BUFFER:
+            glTarget = GL_COPY_READ_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::COPY_WRITE_BUFFER:
+            glTarget = GL_COPY_WRITE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::DISPATCH_INDIRECT_BUFFER:
+            glTarget = GL_DISPATCH_INDIRECT_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::DRAW_INDIRECT_BUFFER:
+            glTarget = GL_DRAW_INDIRECT_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::ELEMENT_ARRAY_BUFFER:
+            glTarget = GL_ELEMENT_ARRAY_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::PIXEL_PACK_BUFFER:
+            glTarget = GL_PIXEL_PACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::PIXEL_UNPACK_BUFFER:
+            glTarget = GL_PIXEL_UNPACK_BUFFER;
+            break;
+//        case IGraphicsAPI::BufferTarget::QUERY_BUFFER:
+//            glTarget = GL_QUERY_BUFFER;
+//            break;
+        case IGraphicsAPI::BufferTarget::SHADER_STORAGE_BUFFER:
+            glTarget = GL_SHADER_STORAGE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::TEXTURE_BUFFER:
+            glTarget = GL_TEXTURE_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::TRANSFORM_FEEDBACK_BUFFER:
+            glTarget = GL_TRANSFORM_FEEDBACK_BUFFER;
+            break;
+        case IGraphicsAPI::BufferTarget::UNIFORM_BUFFER:
+            glTarget = GL_UNIFORM_BUFFER;
+            break;
+        default:
+            throw std::runtime_error("Invalid buffer target");
+    }
+
+    GL_CALL(glUnmapBuffer(glTarget));
+}
+
+void GraphicsAPIOpenGLES::deleteBuffer(int size, unsigned int* buffers) {
+    GL_CALL(glDeleteBuffers(size, buffers));
+}
+
+void* GraphicsAPIOpenGLES::fenceSync() {
+    GLsync sync = nullptr;
+    GL_CALL(sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    return sync;
+}
+
+bool GraphicsAPIOpenGLES::clientWaitSync(void* sync, uint64_t timeoutNanoseconds) {
+    GLenum result;
+    GL_CALL(result = glClientWaitSync(static_cast<GLsync>(sync), GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNanoseconds));
+    if (result == GL_WAIT_FAILED) {
+        LOG_E("glClientWaitSync failed");
+        return true;
+    }
+    return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+void GraphicsAPIOpenGLES::deleteSync(void* sync) {
+    GL_CALL(glDeleteSync(static_cast<GLsync>(sync)));
+}
+
+void GraphicsAPIOpenGLES::drawElementsBaseVertex(IGraphicsAPI::PrimitiveTopology mode, int count, IGraphicsAPI::DataType type, const void* indices, int baseVertex) {
+    GLenum glMode;
+
+    switch (mode) {
+        case IGraphicsAPI::PrimitiveTopology::POINT_LIST:
+            glMode = GL_POINTS;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LIST:
+            glMode = GL_LINES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_STRIP:
+            glMode = GL_LINE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LOOP:
+            glMode = GL_LINE_LOOP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST:
+            glMode = GL_TRIANGLES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_STRIP:
+            glMode = GL_TRIANGLE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_FAN:
+            glMode = GL_TRIANGLE_FAN;
+            break;
+        default:
+            throw std::runtime_error("Invalid PrimitiveTopology Type");
+    }
+
+    GLenum glType;
+
+    switch (type) {
+        case IGraphicsAPI::DataType::UBYTE:
+            glType = GL_UNSIGNED_BYTE;
+            break;
+        case IGraphicsAPI::DataType::USHORT:
+            glType = GL_UNSIGNED_SHORT;
+            break;
+        case IGraphicsAPI::DataType::UINT:
+            glType = GL_UNSIGNED_INT;
+            break;
+        default:
+            throw std::runtime_error("Invalid Index Type");
+    }
+
+    GL_CALL(glDrawElementsBaseVertex(glMode, count, glType, indices, baseVertex));
+}
+
+void GraphicsAPIOpenGLES::drawElementsInstancedBaseVertex(IGraphicsAPI::PrimitiveTopology mode, int count, IGraphicsAPI::DataType type, const void* indices, unsigned int instanceCount, int baseVertex) {
+    GLenum glMode;
+
+    switch (mode) {
+        case IGraphicsAPI::PrimitiveTopology::POINT_LIST:
+            glMode = GL_POINTS;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LIST:
+            glMode = GL_LINES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_STRIP:
+            glMode = GL_LINE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::LINE_LOOP:
+            glMode = GL_LINE_LOOP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_LIST:
+            glMode = GL_TRIANGLES;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_STRIP:
+            glMode = GL_TRIANGLE_STRIP;
+            break;
+        case IGraphicsAPI::PrimitiveTopology::TRIANGLE_FAN:
+            glMode = GL_TRIANGLE_FAN;
+            break;
+        default:
+            throw std::runtime_error("Invalid PrimitiveTopology Type");
+    }
+
+    GLenum glType;
+
+    switch (type) {
+        case IGraphicsAPI::DataType::UBYTE:
+            glType = GL_UNSIGNED_BYTE;
+            break;
+        case IGraphicsAPI::DataType::USHORT:
+            glType = GL_UNSIGNED_SHORT;
+            break;
+        case IGraphicsAPI::DataType::UINT:
+            glType = GL_UNSIGNED_INT;
+            break;
+        default:
+            throw std::runtime_error("Invalid Index Type");
+    }
+
+    GL_CALL(glDrawElementsInstancedBaseVertex(glMode, count, glType, indices, instanceCount, baseVertex));
+}
+
+void GraphicsAPIOpenGLES::copyBufferSubData(size_t readOffset, size_t writeOffset, size_t size) {
+    GL_CALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, readOffset, writeOffset, size));
+}
+
+bool GraphicsAPIOpenGLES::isMultiDrawIndirectSupported() {
+    // Multi draw indirect is only an extension in OpenGL ES
+    return false;
+}
+
+void GraphicsAPIOpenGLES::multiDrawElementsIndirect(IGraphicsAPI::PrimitiveTopology mode, IGraphicsAPI::DataType type, const void* indirect, unsigned int drawCount, size_t stride) {
+    throw std::runtime_error("Multi draw indirect is not supported");
+}
+
+
 
 
 
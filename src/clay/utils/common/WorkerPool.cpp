@@ -0,0 +1,80 @@
+// standard lib
+#include <algorithm>
+// class
+#include "clay/utils/common/WorkerPool.h"
+
+namespace clay::utils {
+
+WorkerPool::WorkerPool(unsigned int threadCount) {
+    threadCount = std::max(threadCount, 1u);
+    mWorkers_.reserve(threadCount - 1);
+    for (unsigned int i = 1; i < threadCount; ++i) {
+        mWorkers_.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mJobMutex_);
+        mStopping_ = true;
+    }
+    mJobCondition_.notify_all();
+    for (std::thread& worker : mWorkers_) {
+        worker.join();
+    }
+}
+
+void WorkerPool::run(const std::function<void(unsigned int)>& job) {
+    if (mWorkers_.empty()) {
+        job(0);
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(mRunMutex_);
+    {
+        std::lock_guard<std::mutex> lock(mJobMutex_);
+        mpJob_ = &job;
+        mPendingWorkers_ = mWorkers_.size();
+        ++mRun_;
+    }
+    mJobCondition_.notify_all();
+
+    job(0);
+
+    std::unique_lock<std::mutex> lock(mJobMutex_);
+    mJobDoneCondition_.wait(lock, [this] { return mPendingWorkers_ == 0; });
+    mpJob_ = nullptr;
+}
+
+unsigned int WorkerPool::getThreadCount() const {
+    return static_cast<unsigned int>(mWorkers_.size()) + 1;
+}
+
+void WorkerPool::workerLoop(unsigned int threadIndex) {
+    uint64_t lastRun = 0;
+    while (true) {
+        const std::function<void(unsigned int)>* job;
+        {
+            std::unique_lock<std::mutex> lock(mJobMutex_);
+            mJobCondition_.wait(lock, [this, lastRun] { return mStopping_ || mRun_ != lastRun; });
+            if (mStopping_) {
+                return;
+            }
+            lastRun = mRun_;
+            job = mpJob_;
+        }
+
+        (*job)(threadIndex);
+
+        bool done;
+        {
+            std::lock_guard<std::mutex> lock(mJobMutex_);
+            done = --mPendingWorkers_ == 0;
+        }
+        if (done) {
+            mJobDoneCondition_.notify_one();
+        }
+    }
+}
+
+} // namespace clay::utils
@@ -116,6 +116,27 @@ namespace clay::utils {
         return imageData;
     }
 
+    std::vector<unsigned char> decodeImage(utils::FileData& imageFile, int& outWidth, int& outHeight, int& outChannels) {
+        unsigned char* pixels = SOIL_load_image_from_memory(
+            imageFile.data.get(),
+            imageFile.size,
+            &outWidth,
+            &outHeight,
+            &outChannels,
+            SOIL_LOAD_AUTO
+        );
+
+        if (pixels == nullptr) {
+            const char* errorMessage = SOIL_last_result();
+            LOG_E("SOIL error: %s", errorMessage != nullptr ? errorMessage : "unknown");
+            throw std::runtime_error("Texture load failed");
+        }
+
+        std::vector<unsigned char> decoded(pixels, pixels + static_cast<size_t>(outWidth) * outHeight * outChannels);
+        SOIL_free_image_data(pixels);
+        return decoded;
+    }
+
 
 }// namespace clay::utils
 
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+// standard lib
+#include <cstring>
+#include <stdexcept>
+// ClayEngine
+#include <clay/graphics/common/CompressedImage.h>
+
+namespace {
+    /** VkFormat of BC1 RGB, 8 bytes per block */
+    constexpr uint32_t VK_FORMAT_BC1_RGB_UNORM_BLOCK = 131;
+    /** Size of the header and index before the level index */
+    constexpr size_t HEADER_SIZE = 80;
+    /** Size of a level index entry */
+    constexpr size_t LEVEL_ENTRY_SIZE = 24;
+
+    void writeU32(unsigned char* data, uint32_t value) {
+        std::memcpy(data, &value, sizeof(value));
+    }
+
+    void writeU64(unsigned char* data, uint64_t value) {
+        std::memcpy(data, &value, sizeof(value));
+    }
+
+    /**
+     * @brief Make a single level BC1 KTX2 file
+     *
+     * @param width Width written in the header
+     * @param height Height written in the header
+     * @param levelSize Size of the level data that follows the level index
+     */
+    clay::utils::FileData makeKtx2(uint32_t width, uint32_t height, size_t levelSize) {
+        const unsigned char identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+        const size_t levelOffset = HEADER_SIZE + LEVEL_ENTRY_SIZE;
+
+        clay::utils::FileData fileData;
+        fileData.size = levelOffset + levelSize;
+        fileData.data = std::make_unique<unsigned char[]>(fileData.size);
+        unsigned char* data = fileData.data.get();
+        std::memset(data, 0, fileData.size);
+        std::memcpy(data, identifier, sizeof(identifier));
+        writeU32(data + 12, VK_FORMAT_BC1_RGB_UNORM_BLOCK);
+        writeU32(data + 20, width);
+        writeU32(data + 24, height);
+        writeU32(data + 36, 1);
+        writeU32(data + 40, 1);
+        writeU64(data + HEADER_SIZE, levelOffset);
+        writeU64(data + HEADER_SIZE + 8, levelSize);
+        return fileData;
+    }
+}
+
+TEST(CompressedImageTest, ParseKtx2) {
+    const clay::CompressedImage image = clay::CompressedImage::parseKtx2(makeKtx2(8, 4, 16));
+    EXPECT_EQ(image.getWidth(), 8u);
+    EXPECT_EQ(image.getHeight(), 4u);
+    ASSERT_EQ(image.getLevels().size(), 1u);
+    EXPECT_EQ(image.getLevels()[0].size, 16u);
+}
+
+TEST(CompressedImageTest, RejectHugeDimensions) {
+    // The block count of this width wraps in 32 bits, making the expected level size 0
+    EXPECT_THROW(clay::CompressedImage::parseKtx2(makeKtx2(0xFFFFFFFD, 4, 0)), std::runtime_error);
+    EXPECT_THROW(clay::CompressedImage::parseKtx2(makeKtx2(4, 0x80000000, 0)), std::runtime_error);
+    EXPECT_THROW(clay::CompressedImage::parseKtx2(makeKtx2(16388, 4, 4097 * 8)), std::runtime_error);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+// ClayEngine
+#include <clay/graphics/common/DynamicRingBuffer.h>
+#include <clay/graphics/common/Mesh.h>
+#include <clay/graphics/common/Renderer.h>
+// test
+#include "FakeGraphicsAPI.h"
+
+namespace {
+    /** Check the allocations of every frame region are aligned in the whole buffer */
+    void checkAlignmentInEveryRegion(bool persistent) {
+        clay::FakeGraphicsAPI graphicsAPI(persistent);
+        clay::DynamicRingBuffer streamBuffer(graphicsAPI, clay::Renderer::STREAM_BUFFER_FRAME_SIZE);
+        ASSERT_EQ(streamBuffer.isPersistent(), persistent);
+
+        const size_t alignments[] = {16, sizeof(clay::Mesh::Instance), clay::DynamicRingBuffer::UNIFORM_ALIGNMENT, 4};
+        for (unsigned int frame = 0; frame < clay::DynamicRingBuffer::FRAME_COUNT * 2; ++frame) {
+            for (size_t alignment : alignments) {
+                const clay::DynamicRingBuffer::Allocation allocation = streamBuffer.allocate(100, alignment);
+                EXPECT_EQ(allocation.offset % alignment, 0u) << "frame " << frame << ", alignment " << alignment;
+            }
+            streamBuffer.endFrame();
+        }
+    }
+}
+
+TEST(DynamicRingBufferTest, AlignedInEveryRegion) {
+    checkAlignmentInEveryRegion(true);
+}
+
+TEST(DynamicRingBufferTest, AlignedInEveryRegionWithoutBufferStorage) {
+    checkAlignmentInEveryRegion(false);
+}
+
+TEST(DynamicRingBufferTest, AlignedAfterGrowing) {
+    clay::FakeGraphicsAPI graphicsAPI(true);
+    clay::DynamicRingBuffer streamBuffer(graphicsAPI, clay::Renderer::STREAM_BUFFER_FRAME_SIZE);
+    streamBuffer.endFrame();
+
+    // Larger than a region, grows to a size that is not a multiple of the alignments
+    const size_t instanceSize = sizeof(clay::Mesh::Instance);
+    streamBuffer.allocate(clay::Renderer::STREAM_BUFFER_FRAME_SIZE + 1000, instanceSize);
+    for (unsigned int frame = 0; frame < clay::DynamicRingBuffer::FRAME_COUNT; ++frame) {
+        streamBuffer.endFrame();
+        const clay::DynamicRingBuffer::Allocation cameraData = streamBuffer.allocate(128, clay::DynamicRingBuffer::UNIFORM_ALIGNMENT);
+        EXPECT_EQ(cameraData.offset % clay::DynamicRingBuffer::UNIFORM_ALIGNMENT, 0u);
+        const clay::DynamicRingBuffer::Allocation instanceData = streamBuffer.allocate(10 * instanceSize, instanceSize);
+        EXPECT_EQ(instanceData.offset % instanceSize, 0u);
+    }
+}
@@ -0,0 +1,143 @@
+#pragma once
+// standard lib
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+// ClayEngine
+#include <clay/graphics/common/IGraphicsAPI.h>
+
+namespace clay {
+
+/**
+ * @brief Graphics API without a context for testing classes that only manage buffers. Buffers created with
+ * bufferStorage are backed by CPU memory so they can be mapped, fences are always signaled and every other
+ * call does nothing
+ */
+class FakeGraphicsAPI : public IGraphicsAPI {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param bufferStorageSupported Value returned by isBufferStorageSupported
+     */
+    explicit FakeGraphicsAPI(bool bufferStorageSupported)
+        : mBufferStorageSupported_(bufferStorageSupported) {}
+
+    unsigned int createShader(ShaderCreateInfo::Type) override { return 0; }
+    void compileShader(unsigned int shaderID, const std::string& source) override {}
+    void attachShader(unsigned int programID, unsigned int shaderID) override {}
+    unsigned int createProgram() override { return 0; }
+    void linkProgram(unsigned int programID) override {}
+    void useProgram(unsigned int programID) override {}
+    void deleteShader(unsigned int shaderID) override {}
+    void deleteProgram(unsigned int programID) override {}
+    std::string getShaderLog(unsigned int shaderID) override { return {}; }
+    std::string getProgramLog(unsigned int programID) override { return {}; }
+    unsigned int getUniformLocation(unsigned int programId, const std::string& name) override { return 0; }
+    int getActiveUniformCount(unsigned int programId) override { return 0; }
+    std::string getActiveUniformName(unsigned int programId, unsigned int index) override { return {}; }
+    void uniform1i(unsigned int location, int value) override {}
+    void uniform1f(unsigned int location, float value) override {}
+    void uniform2fv(unsigned int location, const float* value) override {}
+    void uniform2f(unsigned int location, float v0, float v1) override {}
+    void uniform3fv(unsigned int location, const float* value) override {}
+    void uniform3f(unsigned int location, float v0, float v1, float v2) override {}
+    void uniform4fv(unsigned int location, const float* value) override {}
+    void uniform4f(unsigned int location, float v0, float v1, float v2, float v3) override {}
+    void uniformMatrix2fv(unsigned int location, const float* value) override {}
+    void uniformMatrix3fv(unsigned int location, const float* value) override {}
+    void uniformMatrix4fv(unsigned int location, const float* value) override {}
+    void clearColor(float r, float g, float b, float a) override {}
+    void bindFrameBuffer(FrameBufferTarget target, unsigned int bufferId) override {}
+    void enable(Capability capability) override {}
+    void disable(Capability capability) override {}
+    bool isEnabled(Capability capability) override { return false; }
+    void bindVertexArray(unsigned int vao) override {}
+    void genBuffer(int size, unsigned int* vaos) override {
+        for (int i = 0; i < size; ++i) {
+            vaos[i] = ++mLastBuffer_;
+        }
+    }
+    void bindBuffer(BufferTarget target, unsigned int bufferId) override { mBoundBuffer_ = bufferId; }
+    void bufferData(BufferTarget target, size_t size, void* data, DataUsage usage) override {}
+    void enableVertexAttribArray(unsigned int index) override {}
+    void vertexAttribPointer(unsigned int index, int size, DataType type, bool normalized, size_t stride, const void* offset) override {}
+    void drawElements(PrimitiveTopology mode, int count, DataType type, const void* indices) override {}
+    void genVertexArrays(unsigned int n, unsigned int* arrays) override {}
+    void deleteVertexArrays(unsigned int n, unsigned int* arrays) override {}
+    unsigned int getUniformBlockIndex(unsigned int programId, const char* uniformBlockName) override { return 0; }
+    void uniformBlockBinding(unsigned int programId, unsigned int uniformBlockIndex, unsigned int uniformBlockBinding) override {}
+    void deleteTexture(unsigned int n, unsigned int* textureId) override {}
+    void genTextures(unsigned int count, unsigned int* textures) override {}
+    void texParameter(TextureTarget target, TextureParameterType paramName, TextureParameterOption paramOption) override {}
+    void texParameteri(TextureTarget target, TextureParameterType paramName, int value) override {}
+    void texImage2D(TextureTarget target, unsigned int level, TextureFormat internalFormat, unsigned int width, unsigned int height, unsigned int border, TextureFormat format, DataType dataType, const void * data) override {}
+    void texSubImage2D(TextureTarget target, unsigned int level, unsigned int xOffset, unsigned int yOffset, unsigned int width, unsigned int height, TextureFormat format, DataType dataType, const void* data) override {}
+    void bindTexture(TextureTarget target, unsigned int textureId) override {}
+    void compressedTexImage2D(TextureTarget target, unsigned int level, CompressedFormat format, unsigned int width, unsigned int height, size_t imageSize, const void* data) override {}
+    bool isCompressedFormatSupported(CompressedFormat format) override { return false; }
+    void generateMipmap(TextureTarget target) override {}
+    void genSamplers(unsigned int count, unsigned int* samplers) override {}
+    void deleteSamplers(unsigned int count, unsigned int* samplers) override {}
+    void bindSampler(unsigned int textureUnit, unsigned int sampler) override {}
+    void samplerParameter(unsigned int sampler, TextureParameterType paramName, TextureParameterOption paramOption) override {}
+    void samplerParameterf(unsigned int sampler, TextureParameterType paramName, float value) override {}
+    float getMaxAnisotropy() override { return 1.0f; }
+    void pixelStore(PixelAlignment alignment, unsigned int value) override {}
+    void activeTexture(unsigned int textureUnit) override {}
+    void getTexImage(TextureTarget target, unsigned int level, TextureFormat format, DataType type, void* pixels) override {}
+    void bindBufferRange(BufferTarget target, unsigned int index, unsigned int buffer, size_t offset, size_t size) override {}
+    void genFrameBuffers(unsigned int count, unsigned int* fbos) override {}
+    void framebufferTexture2D(IGraphicsAPI::FrameBufferTarget target, unsigned int attachment, FBOTextureTarget texTarget, unsigned int textureId, unsigned int level) override {}
+    void genRenderBuffer(unsigned int n, unsigned int* rbos) override {}
+    void bindRenderBuffer(RenderBufferTarget target, unsigned int renderBuffer) override {}
+    void renderBufferStorage(RenderBufferTarget target, RenderBufferFormat format, unsigned int width, unsigned int height) override {}
+    void frameBufferRenderBuffer(FrameBufferTarget frameBufferTarget, FrameBufferAttachment attachment, RenderBufferTarget renderBufferTarget, unsigned int rbo) override {}
+    void drawBuffers(unsigned int n, unsigned int* bufs) override {}
+    void bufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) override {}
+    void drawArrays(PrimitiveTopology mode, unsigned int start, unsigned int count) override {}
+    void clearBuffers(const std::vector<ClearBufferTarget>& targets) override {}
+    void polygonMode(PolygonModeFace face, PolygonModeType mode) override {}
+    void drawBuffer(unsigned int bufferId) override {}
+    void vertexAttribDivisor(unsigned int index, unsigned int divisor) override {}
+    void drawElementsInstanced(PrimitiveTopology mode, int count, DataType type, const void* indices, unsigned int instanceCount) override {}
+    void blendFunc(BlendFactor srcFactor, BlendFactor dstFactor) override {}
+    void viewport(int x, int y, int width, int height) override {}
+    void getViewport(int* outViewport) override {}
+    void texBuffer(TextureFormat internalFormat, unsigned int buffer) override {}
+    bool isBufferStorageSupported() override { return mBufferStorageSupported_; }
+    void bufferStorage(BufferTarget target, size_t size, const void* data, const std::vector<BufferAccess>& access) override {
+        mBufferData_[mBoundBuffer_].resize(size);
+    }
+    void* mapBufferRange(BufferTarget target, size_t offset, size_t size, const std::vector<BufferAccess>& access) override {
+        return mBufferData_[mBoundBuffer_].data() + offset;
+    }
+    void unmapBuffer(BufferTarget target) override {}
+    void deleteBuffer(int size, unsigned int* buffers) override {
+        for (int i = 0; i < size; ++i) {
+            mBufferData_.erase(buffers[i]);
+        }
+    }
+    void* fenceSync() override { return &mFence_; }
+    bool clientWaitSync(void* sync, uint64_t timeoutNanoseconds) override { return true; }
+    void deleteSync(void* sync) override {}
+    void drawElementsBaseVertex(PrimitiveTopology mode, int count, DataType type, const void* indices, int baseVertex) override {}
+    void drawElementsInstancedBaseVertex(PrimitiveTopology mode, int count, DataType type, const void* indices, unsigned int instanceCount, int baseVertex) override {}
+    void copyBufferSubData(size_t readOffset, size_t writeOffset, size_t size) override {}
+    bool isMultiDrawIndirectSupported() override { return false; }
+    void multiDrawElementsIndirect(PrimitiveTopology mode, DataType type, const void* indirect, unsigned int drawCount, size_t stride) override {}
+
+private:
+    /** Value returned by isBufferStorageSupported */
+    bool mBufferStorageSupported_;
+    /** Last buffer id handed out */
+    unsigned int mLastBuffer_ = 0;
+    /** Buffer bound by the last bindBuffer, targets are not told apart */
+    unsigned int mBoundBuffer_ = 0;
+    /** CPU storage of the buffers created with bufferStorage */
+    std::unordered_map<unsigned int, std::vector<uint8_t>> mBufferData_;
+    /** Address handed out as the fence */
+    int mFence_ = 0;
+};
+
+} // namespace clay